@@ -0,0 +1,149 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
+#include "Model/ExactBrushGeometry.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+namespace
+{
+constexpr size_t NumIterations = 10'000;
+
+const auto worldBounds = vm::bbox3{8192.0};
+
+size_t createClippedBrushGeometry(const std::vector<BrushFace>& faces)
+{
+  auto geometry = BrushGeometry{worldBounds};
+  for (size_t i = 0u; i < faces.size(); ++i)
+  {
+    const auto result = geometry.clip(faces[i].boundary());
+    if (result.success())
+    {
+      result.face()->setPayload(i);
+    }
+  }
+
+  geometry.correctVertexPositions();
+  geometry.healEdges();
+  return geometry.vertexCount();
+}
+
+size_t createExactBrushGeometry(const std::vector<BrushFace>& faces)
+{
+  const auto geometry = Model::createExactBrushGeometry(faces, worldBounds);
+  return geometry ? geometry->vertexCount() : 0u;
+}
+
+void benchmarkBrush(const std::string& name, const std::vector<BrushFace>& faces)
+{
+  REQUIRE(createExactBrushGeometry(faces) == createClippedBrushGeometry(faces));
+
+  auto vertexCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumIterations; ++i)
+      {
+        vertexCount += createClippedBrushGeometry(faces);
+      }
+    },
+    "clip " + name + " (" + std::to_string(faces.size()) + " faces)");
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumIterations; ++i)
+      {
+        vertexCount -= createExactBrushGeometry(faces);
+      }
+    },
+    "build exact " + name + " (" + std::to_string(faces.size()) + " faces)");
+
+  CHECK(vertexCount == 0u);
+}
+} // namespace
+
+TEST_CASE("ExactBrushGeometryBenchmark.createGeometry")
+{
+  auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  benchmarkBrush(
+    "cuboid",
+    builder.createCuboid(vm::bbox3{{-8.5, 16.0, 0.25}, {32.0, 17.0, 1024.0}}, "")
+      .value()
+      .faces());
+
+  benchmarkBrush(
+    "cuboid with redundant faces",
+    kdl::vec_concat(
+      builder.createCuboid(vm::bbox3{64.0}, "").value().faces(),
+      builder.createCuboid(vm::bbox3{32.0}, "").value().faces()));
+
+  benchmarkBrush(
+    "wedge",
+    builder
+      .createBrush(
+        std::vector<vm::vec3>{
+          {-64, -64, -64},
+          {64, -64, -64},
+          {-64, 64, -64},
+          {64, 64, -64},
+          {-64, -64, 64},
+          {-64, 64, 64}},
+        "")
+      .value()
+      .faces());
+
+  benchmarkBrush(
+    "parallelepiped",
+    builder
+      .createBrush(
+        std::vector<vm::vec3>{
+          {0, 0, 0},
+          {64, 0, 0},
+          {0, 64, 0},
+          {64, 64, 0},
+          {32, 0, 64},
+          {96, 0, 64},
+          {32, 64, 64},
+          {96, 64, 64}},
+        "")
+      .value()
+      .faces());
+}
+} // namespace Model
+} // namespace TrenchBroom
@@ -0,0 +1,199 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "FloatType.h"
+#include "IO/NodeReader.h"
+#include "IO/TestParserStatus.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/PatchNode.h"
+#include "Model/WorldNode.h"
+#include "aabb_tree.h"
+#include "octree.h"
+
+#include <kdl/overload.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+namespace
+{
+constexpr size_t NumQueries = 100'000;
+
+std::vector<std::unique_ptr<Node>> readNodes(const std::filesystem::path& path)
+{
+  auto stream = std::ifstream{path};
+  auto str = std::stringstream{};
+  str << stream.rdbuf();
+
+  const auto worldBounds = vm::bbox3{8192.0};
+  auto status = IO::TestParserStatus{};
+  return kdl::vec_transform(
+    IO::NodeReader::read(str.str(), MapFormat::Standard, worldBounds, {}, status),
+    [](auto* node) { return std::unique_ptr<Node>{node}; });
+}
+
+std::vector<Node*> collectTreeNodes(const std::vector<std::unique_ptr<Node>>& nodes)
+{
+  auto result = std::vector<Node*>{};
+  for (const auto& node : nodes)
+  {
+    node->accept(kdl::overload(
+      [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+      [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+      [](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
+      [&](auto&& thisLambda, EntityNode* entity) {
+        result.push_back(entity);
+        entity->visitChildren(thisLambda);
+      },
+      [&](BrushNode* brush) { result.push_back(brush); },
+      [&](PatchNode* patch) { result.push_back(patch); }));
+  }
+  return result;
+}
+
+template <typename Tree>
+void benchmarkNodeTree(
+  Tree& tree,
+  const std::string& name,
+  const std::vector<Node*>& nodes,
+  const std::vector<vm::ray3>& rays,
+  const std::vector<vm::vec3>& points)
+{
+  timeLambda(
+    [&]() {
+      for (auto* node : nodes)
+      {
+        tree.insert(node->physicalBounds(), node);
+      }
+    },
+    name + ": insert " + std::to_string(nodes.size()) + " nodes");
+
+  auto hits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        hits += tree.find_intersectors(ray).size();
+      }
+    },
+    name + ": find_intersectors for " + std::to_string(rays.size()) + " rays");
+
+  auto containers = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& point : points)
+      {
+        containers += tree.find_containers(point).size();
+      }
+    },
+    name + ": find_containers for " + std::to_string(points.size()) + " points");
+
+  // prevent the queries from being optimized away
+  CHECK(hits > 0u);
+  CHECK(containers > 0u);
+
+  timeLambda(
+    [&]() {
+      for (auto* node : nodes)
+      {
+        tree.update(node->physicalBounds().translate(vm::vec3{1, 2, 3}), node);
+      }
+    },
+    name + ": update " + std::to_string(nodes.size()) + " nodes by a small offset");
+
+  timeLambda(
+    [&]() {
+      for (auto* node : nodes)
+      {
+        tree.update(node->physicalBounds().translate(vm::vec3{1024, 0, 0}), node);
+      }
+    },
+    name + ": update " + std::to_string(nodes.size()) + " nodes by a large offset");
+
+  timeLambda(
+    [&]() {
+      for (auto* node : nodes)
+      {
+        tree.remove(node);
+      }
+    },
+    name + ": remove " + std::to_string(nodes.size()) + " nodes");
+}
+} // namespace
+
+TEST_CASE("NodeTreeBenchmark.compareOctreeAndAABBTree")
+{
+  const auto path =
+    std::filesystem::current_path() / "fixture/test/IO/Map/rtz_q1.map";
+  const auto nodes = readNodes(path);
+  const auto treeNodes = collectTreeNodes(nodes);
+  REQUIRE(!treeNodes.empty());
+
+  auto bounds = treeNodes.front()->physicalBounds();
+  for (const auto* node : treeNodes)
+  {
+    bounds = vm::merge(bounds, node->physicalBounds());
+  }
+
+  // generate random rays from points inside the map in random directions, like picking
+  // does, and random points for containment queries
+  auto rng = std::mt19937{0};
+  auto x = std::uniform_real_distribution<FloatType>{bounds.min.x(), bounds.max.x()};
+  auto y = std::uniform_real_distribution<FloatType>{bounds.min.y(), bounds.max.y()};
+  auto z = std::uniform_real_distribution<FloatType>{bounds.min.z(), bounds.max.z()};
+  auto d = std::uniform_real_distribution<FloatType>{-1.0, 1.0};
+
+  auto rays = std::vector<vm::ray3>{};
+  auto points = std::vector<vm::vec3>{};
+  for (size_t i = 0; i < NumQueries; ++i)
+  {
+    const auto point = vm::vec3{x(rng), y(rng), z(rng)};
+    rays.emplace_back(point, vm::normalize(vm::vec3{d(rng), d(rng), d(rng)}));
+    points.push_back(point);
+  }
+
+  auto octreeNodeTree = octree<FloatType, Node*>{256.0};
+  benchmarkNodeTree(octreeNodeTree, "octree", treeNodes, rays, points);
+
+  auto aabbNodeTree = aabb_tree<FloatType, Node*>{};
+  benchmarkNodeTree(aabbNodeTree, "aabb_tree", treeNodes, rays, points);
+}
+} // namespace Model
+} // namespace TrenchBroom
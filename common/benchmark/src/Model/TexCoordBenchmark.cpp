@@ -0,0 +1,126 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "Assets/Texture.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+#include "Model/TexCoordSystem.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+namespace
+{
+constexpr size_t NumBrushes = 64'000;
+constexpr size_t NumTextures = 256;
+constexpr size_t NumIterations = 10;
+
+std::vector<Brush> makeBrushes(std::vector<Assets::Texture>& textures)
+{
+  const auto worldBounds = vm::bbox3{4096.0};
+  auto builder = BrushBuilder{MapFormat::Valve, worldBounds};
+
+  auto result = std::vector<Brush>{};
+  result.reserve(NumBrushes);
+
+  auto currentTextureIndex = size_t(0);
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    auto brush = builder.createCube(64.0, "").value();
+    for (auto& face : brush.faces())
+    {
+      face.setTexture(&textures[(currentTextureIndex++) % NumTextures]);
+    }
+    result.push_back(std::move(brush));
+  }
+
+  return result;
+}
+} // namespace
+
+TEST_CASE("TexCoordBenchmark.projectTexCoords")
+{
+  auto textures = std::vector<Assets::Texture>{};
+  textures.reserve(NumTextures);
+  for (size_t i = 0; i < NumTextures; ++i)
+  {
+    textures.emplace_back("texture " + std::to_string(i), 64, 128);
+  }
+
+  const auto brushes = makeBrushes(textures);
+
+  auto sum = vm::vec2f{0, 0};
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumIterations; ++i)
+      {
+        for (const auto& brush : brushes)
+        {
+          for (const auto& face : brush.faces())
+          {
+            for (const auto* vertex : face.vertices())
+            {
+              sum = sum + face.textureCoords(vertex->position());
+            }
+          }
+        }
+      }
+    },
+    "compute texture coordinates per vertex");
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumIterations; ++i)
+      {
+        for (const auto& brush : brushes)
+        {
+          for (const auto& face : brush.faces())
+          {
+            const auto projection = face.textureCoordsProjection();
+            for (const auto* vertex : face.vertices())
+            {
+              sum = sum - projection(vertex->position());
+            }
+          }
+        }
+      }
+    },
+    "compute texture coordinates per face");
+
+  // prevent the loops from being optimized away
+  CHECK(sum.x() == sum.x());
+}
+} // namespace Model
+} // namespace TrenchBroom
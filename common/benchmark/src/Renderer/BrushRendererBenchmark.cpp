@@ -29,6 +29,7 @@
 #include "Model/MapFormat.h"
 #include "Model/WorldNode.h"
 #include "Renderer/BrushRenderer.h"
+#include "Renderer/BrushRendererBrushCache.h"
 
 #include <kdl/result.h>
 
@@ -154,5 +155,33 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
   kdl::vec_clear_and_delete(brushes);
   kdl::vec_clear_and_delete(textures);
 }
+TEST_CASE("BrushRendererBenchmark.benchParallelValidation")
+{
+  auto brushesTextures = makeBrushes();
+  std::vector<Model::BrushNode*> brushes = brushesTextures.first;
+  std::vector<Assets::Texture*> textures = brushesTextures.second;
+
+  for (const auto parallelValidation : {false, true})
+  {
+    BrushRenderer r;
+    r.setParallelValidation(parallelValidation);
+
+    // makeBrushes has cached the vertices, but building the vertex caches is the part
+    // that is done in parallel
+    for (auto* brush : brushes)
+    {
+      brush->brushRendererBrushCache().invalidateVertexCache();
+      r.addBrush(brush);
+    }
+
+    timeLambda(
+      [&]() { r.validate(); },
+      std::string{parallelValidation ? "parallel" : "serial"} + " validate of "
+        + std::to_string(brushes.size()) + " brushes with invalid vertex caches");
+  }
+
+  kdl::vec_clear_and_delete(brushes);
+  kdl::vec_clear_and_delete(textures);
+}
 } // namespace Renderer
 } // namespace TrenchBroom
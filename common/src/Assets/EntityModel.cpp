@@ -24,6 +24,7 @@
 #include "Renderer/PrimType.h"
 #include "Renderer/TexturedIndexRangeMap.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
+#include "Renderer/VertexArray.h"
 #include "octree.h"
 
 #include <kdl/vector_utils.h>
@@ -31,13 +32,223 @@
 #include <vecmath/bbox.h>
 #include <vecmath/forward.h>
 #include <vecmath/intersection.h>
+#include <vecmath/vec.h>
 
+#include <algorithm>
+#include <array>
+#include <map>
+#include <set>
 #include <string>
 
 namespace TrenchBroom
 {
 namespace Assets
 {
+namespace
+{
+// meshes with fewer triangles are not simplified
+constexpr auto MinLodTriangleCount = size_t(256);
+
+// the grid sizes used to simplify the meshes of levels of detail 1 and up
+constexpr auto LodGridSizes = std::array<size_t, EntityModelLodCount - 1u>{24u, 8u};
+
+// a level of detail is only used if it has at most this fraction of the triangles of the
+// previous level
+constexpr auto MaxLodTriangleRatio = 0.75;
+
+using Triangle = std::array<size_t, 3>;
+
+void addTriangles(
+  const Renderer::PrimType primType,
+  const size_t index,
+  const size_t count,
+  std::vector<Triangle>& triangles)
+{
+  switch (primType)
+  {
+  case Renderer::PrimType::Points:
+  case Renderer::PrimType::Lines:
+  case Renderer::PrimType::LineStrip:
+  case Renderer::PrimType::LineLoop:
+    break;
+  case Renderer::PrimType::Triangles:
+    for (size_t i = 0; i + 2 < count; i += 3)
+    {
+      triangles.push_back({index + i, index + i + 1, index + i + 2});
+    }
+    break;
+  case Renderer::PrimType::Polygon:
+  case Renderer::PrimType::TriangleFan:
+    for (size_t i = 1; i + 1 < count; ++i)
+    {
+      triangles.push_back({index, index + i, index + i + 1});
+    }
+    break;
+  case Renderer::PrimType::Quads:
+    for (size_t i = 0; i + 3 < count; i += 4)
+    {
+      triangles.push_back({index + i, index + i + 1, index + i + 2});
+      triangles.push_back({index + i, index + i + 2, index + i + 3});
+    }
+    break;
+  case Renderer::PrimType::QuadStrip:
+  case Renderer::PrimType::TriangleStrip:
+    for (size_t i = 0; i + 2 < count; ++i)
+    {
+      if (i % 2 == 0)
+      {
+        triangles.push_back({index + i, index + i + 1, index + i + 2});
+      }
+      else
+      {
+        triangles.push_back({index + i, index + i + 2, index + i + 1});
+      }
+    }
+    break;
+    switchDefault();
+  }
+}
+
+/**
+ * Returns the number of triangles that addTriangles adds for the given primitive.
+ */
+size_t countTriangles(const Renderer::PrimType primType, const size_t count)
+{
+  switch (primType)
+  {
+  case Renderer::PrimType::Points:
+  case Renderer::PrimType::Lines:
+  case Renderer::PrimType::LineStrip:
+  case Renderer::PrimType::LineLoop:
+    return 0u;
+  case Renderer::PrimType::Triangles:
+    return count / 3u;
+  case Renderer::PrimType::Polygon:
+  case Renderer::PrimType::TriangleFan:
+  case Renderer::PrimType::QuadStrip:
+  case Renderer::PrimType::TriangleStrip:
+    return count > 2u ? count - 2u : 0u;
+  case Renderer::PrimType::Quads:
+    return count / 4u * 2u;
+    switchDefault();
+  }
+}
+
+vm::bbox3f meshBounds(const std::vector<EntityModelVertex>& vertices)
+{
+  auto bounds = vm::bbox3f::builder{};
+  for (const auto& vertex : vertices)
+  {
+    bounds.add(Renderer::getVertexComponent<0>(vertex));
+  }
+  return bounds.initialized() ? bounds.bounds() : vm::bbox3f{};
+}
+
+/**
+ * Merges the vertices of the given triangles by grid cell and returns the vertices of
+ * the triangles that do not collapse. Each cell is represented by the average position
+ * of its vertices and the texture coordinates of the first of its vertices.
+ */
+std::vector<EntityModelVertex> clusterTriangles(
+  const std::vector<EntityModelVertex>& vertices,
+  const std::vector<Triangle>& triangles,
+  const vm::bbox3f& bounds,
+  const size_t gridSize)
+{
+  const auto cellSize = vm::get_max_component(bounds.size()) / float(gridSize);
+  if (cellSize <= 0.0f)
+  {
+    return {};
+  }
+
+  struct Cell
+  {
+    vm::vec3f position;
+    vm::vec2f texCoords;
+    size_t count;
+  };
+
+  auto cells = std::vector<Cell>{};
+  auto cellIndices = std::map<vm::vec3i, size_t>{};
+  auto vertexCells = std::vector<size_t>(vertices.size());
+
+  for (const auto& triangle : triangles)
+  {
+    for (const auto index : triangle)
+    {
+      const auto& vertex = vertices[index];
+      const auto& position = Renderer::getVertexComponent<0>(vertex);
+      // vertices on the max boundary belong to the last cell
+      const auto key = vm::min(
+        vm::vec3i{vm::floor((position - bounds.min) / cellSize)},
+        vm::vec3i::fill(int(gridSize) - 1));
+
+      const auto [it, inserted] = cellIndices.try_emplace(key, cells.size());
+      if (inserted)
+      {
+        cells.push_back(
+          Cell{vm::vec3f::zero(), Renderer::getVertexComponent<1>(vertex), 0u});
+      }
+
+      // a vertex can be visited several times, but it must only be counted once
+      if (vertexCells[index] != it->second + 1u)
+      {
+        auto& cell = cells[it->second];
+        cell.position = cell.position + position;
+        cell.count += 1u;
+        vertexCells[index] = it->second + 1u;
+      }
+    }
+  }
+
+  auto result = std::vector<EntityModelVertex>{};
+  auto emitted = std::set<Triangle>{};
+  for (const auto& triangle : triangles)
+  {
+    auto clustered = Triangle{
+      vertexCells[triangle[0]] - 1u,
+      vertexCells[triangle[1]] - 1u,
+      vertexCells[triangle[2]] - 1u};
+    if (
+      clustered[0] == clustered[1] || clustered[1] == clustered[2]
+      || clustered[2] == clustered[0])
+    {
+      continue;
+    }
+
+    // rotate the smallest index to the front to detect duplicates, preserving the
+    // winding order so that both sides of thin geometry are kept
+    std::rotate(
+      clustered.begin(),
+      std::min_element(clustered.begin(), clustered.end()),
+      clustered.end());
+    if (emitted.insert(clustered).second)
+    {
+      for (const auto cellIndex : clustered)
+      {
+        const auto& cell = cells[cellIndex];
+        result.emplace_back(cell.position / float(cell.count), cell.texCoords);
+      }
+    }
+  }
+  return result;
+}
+} // namespace
+
+std::vector<EntityModelVertex> decimateMesh(
+  const std::vector<EntityModelVertex>& vertices,
+  const EntityModelIndices& indices,
+  const size_t gridSize)
+{
+  auto triangles = std::vector<Triangle>{};
+  indices.forEachPrimitive(
+    [&](const Renderer::PrimType primType, const size_t index, const size_t count) {
+      addTriangles(primType, index, count, triangles);
+    });
+
+  return clusterTriangles(vertices, triangles, meshBounds(vertices), gridSize);
+}
+
 // EntityModelFrame
 
 EntityModelFrame::EntityModelFrame(const size_t index)
@@ -280,6 +491,24 @@ public:
   virtual ~EntityModelMesh() = default;
 
 public:
+  /**
+   * Returns the number of vertices of this mesh.
+   */
+  size_t vertexCount() const { return m_vertices.size(); }
+
+  /**
+   * Returns the number of triangles of this mesh.
+   */
+  virtual size_t triangleCount() const = 0;
+
+  /**
+   * Returns a simplified version of this mesh, see decimateMesh.
+   *
+   * @param gridSize the number of grid cells along the longest axis of the mesh bounds
+   * @return the simplified mesh, or null if all of its triangles collapse
+   */
+  virtual std::unique_ptr<EntityModelMesh> decimate(size_t gridSize) const = 0;
+
   /**
    * Returns a renderer that renders this mesh with the given texture.
    *
@@ -315,6 +544,20 @@ private:
   EntityModelIndices m_indices;
 
 public:
+  /**
+   * Creates a new mesh with the given vertices and indices that does not belong to a
+   * frame. Used for the levels of detail of a frame mesh.
+   *
+   * @param vertices the vertices
+   * @param indices the indices
+   */
+  EntityModelIndexedMesh(
+    std::vector<EntityModelVertex> vertices, EntityModelIndices indices)
+    : EntityModelMesh{std::move(vertices)}
+    , m_indices{std::move(indices)}
+  {
+  }
+
   /**
    * Creates a new frame mesh with the given vertices and indices.
    *
@@ -326,8 +569,7 @@ public:
     EntityModelLoadedFrame& frame,
     std::vector<EntityModelVertex> vertices,
     EntityModelIndices indices)
-    : EntityModelMesh{std::move(vertices)}
-    , m_indices{std::move(indices)}
+    : EntityModelIndexedMesh{std::move(vertices), std::move(indices)}
   {
     m_indices.forEachPrimitive(
       [&](const Renderer::PrimType primType, const size_t index, const size_t count) {
@@ -335,6 +577,30 @@ public:
       });
   }
 
+  size_t triangleCount() const override
+  {
+    auto result = size_t(0);
+    m_indices.forEachPrimitive(
+      [&](const Renderer::PrimType primType, const size_t, const size_t count) {
+        result += countTriangles(primType, count);
+      });
+    return result;
+  }
+
+  std::unique_ptr<EntityModelMesh> decimate(const size_t gridSize) const override
+  {
+    auto vertices = decimateMesh(m_vertices, m_indices, gridSize);
+    if (vertices.empty())
+    {
+      return nullptr;
+    }
+
+    const auto vertexCount = vertices.size();
+    return std::make_unique<EntityModelIndexedMesh>(
+      std::move(vertices),
+      EntityModelIndices{Renderer::PrimType::Triangles, 0, vertexCount});
+  }
+
 private:
   std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(
     const Texture* skin, const Renderer::VertexArray& vertices) override
@@ -357,6 +623,20 @@ private:
   EntityModelTexturedIndices m_indices;
 
 public:
+  /**
+   * Creates a new mesh with the given vertices and per texture indices that does not
+   * belong to a frame. Used for the levels of detail of a frame mesh.
+   *
+   * @param vertices the vertices
+   * @param indices the per texture indices
+   */
+  EntityModelTexturedMesh(
+    std::vector<EntityModelVertex> vertices, EntityModelTexturedIndices indices)
+    : EntityModelMesh{std::move(vertices)}
+    , m_indices{std::move(indices)}
+  {
+  }
+
   /**
    * Creates a new frame mesh with the given vertices and per texture indices.
    *
@@ -368,8 +648,7 @@ public:
     EntityModelLoadedFrame& frame,
     std::vector<EntityModelVertex> vertices,
     EntityModelTexturedIndices indices)
-    : EntityModelMesh{std::move(vertices)}
-    , m_indices{std::move(indices)}
+    : EntityModelTexturedMesh{std::move(vertices), std::move(indices)}
   {
     m_indices.forEachPrimitive([&](
                                  const Texture* /* texture */,
@@ -380,6 +659,58 @@ public:
     });
   }
 
+  size_t triangleCount() const override
+  {
+    auto result = size_t(0);
+    m_indices.forEachPrimitive([&](
+                                 const Texture* /* texture */,
+                                 const Renderer::PrimType primType,
+                                 const size_t /* index */,
+                                 const size_t count) {
+      result += countTriangles(primType, count);
+    });
+    return result;
+  }
+
+  std::unique_ptr<EntityModelMesh> decimate(const size_t gridSize) const override
+  {
+    // the triangles of each texture are simplified separately, but on a common grid
+    auto trianglesByTexture = std::map<const Texture*, std::vector<Triangle>>{};
+    m_indices.forEachPrimitive([&](
+                                 const Texture* texture,
+                                 const Renderer::PrimType primType,
+                                 const size_t index,
+                                 const size_t count) {
+      addTriangles(primType, index, count, trianglesByTexture[texture]);
+    });
+
+    const auto bounds = meshBounds(m_vertices);
+
+    auto vertices = std::vector<EntityModelVertex>{};
+    auto indices = EntityModelTexturedIndices{};
+    for (const auto& [texture, triangles] : trianglesByTexture)
+    {
+      const auto textureVertices =
+        clusterTriangles(m_vertices, triangles, bounds, gridSize);
+      if (!textureVertices.empty())
+      {
+        indices.add(
+          texture,
+          Renderer::PrimType::Triangles,
+          vertices.size(),
+          textureVertices.size());
+        vertices = kdl::vec_concat(std::move(vertices), textureVertices);
+      }
+    }
+
+    if (vertices.empty())
+    {
+      return nullptr;
+    }
+    return std::make_unique<EntityModelTexturedMesh>(
+      std::move(vertices), std::move(indices));
+  }
+
 private:
   std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(
     const Texture* /* skin */, const Renderer::VertexArray& vertices) override
@@ -388,6 +719,32 @@ private:
   }
 };
 
+namespace
+{
+void addLevelsOfDetail(std::vector<std::unique_ptr<EntityModelMesh>>& meshes)
+{
+  // the meshes may use strips and fans, so compare their triangles and not their vertices
+  auto triangleCount = meshes.front()->triangleCount();
+  if (triangleCount < MinLodTriangleCount)
+  {
+    return;
+  }
+
+  for (const auto gridSize : LodGridSizes)
+  {
+    auto mesh = meshes.front()->decimate(gridSize);
+    if (
+      !mesh
+      || double(mesh->triangleCount()) > MaxLodTriangleRatio * double(triangleCount))
+    {
+      break;
+    }
+    triangleCount = mesh->triangleCount();
+    meshes.push_back(std::move(mesh));
+  }
+}
+} // namespace
+
 // EntityModel::Surface
 
 EntityModelSurface::EntityModelSurface(std::string name, const size_t frameCount)
@@ -420,8 +777,11 @@ void EntityModelSurface::addIndexedMesh(
   EntityModelIndices indices)
 {
   assert(frame.index() < frameCount());
-  m_meshes[frame.index()] = std::make_unique<EntityModelIndexedMesh>(
-    frame, std::move(vertices), std::move(indices));
+  auto& meshes = m_meshes[frame.index()];
+  meshes.clear();
+  meshes.push_back(std::make_unique<EntityModelIndexedMesh>(
+    frame, std::move(vertices), std::move(indices)));
+  addLevelsOfDetail(meshes);
 }
 
 void EntityModelSurface::addTexturedMesh(
@@ -430,8 +790,11 @@ void EntityModelSurface::addTexturedMesh(
   EntityModelTexturedIndices indices)
 {
   assert(frame.index() < frameCount());
-  m_meshes[frame.index()] = std::make_unique<EntityModelTexturedMesh>(
-    frame, std::move(vertices), std::move(indices));
+  auto& meshes = m_meshes[frame.index()];
+  meshes.clear();
+  meshes.push_back(std::make_unique<EntityModelTexturedMesh>(
+    frame, std::move(vertices), std::move(indices)));
+  addLevelsOfDetail(meshes);
 }
 
 void EntityModelSurface::setSkins(std::vector<Texture> skins)
@@ -459,20 +822,27 @@ const Texture* EntityModelSurface::skin(const size_t index) const
   return m_skins->textureByIndex(index);
 }
 
+size_t EntityModelSurface::lodCount(const size_t frameIndex) const
+{
+  assert(frameIndex < frameCount());
+  return m_meshes[frameIndex].size();
+}
+
 std::unique_ptr<Renderer::TexturedIndexRangeRenderer> EntityModelSurface::buildRenderer(
-  const size_t skinIndex, const size_t frameIndex)
+  const size_t skinIndex, const size_t frameIndex, const size_t lodIndex)
 {
   assert(frameIndex < frameCount());
   assert(skinIndex < skinCount());
 
-  if (m_meshes[frameIndex] == nullptr)
+  const auto& meshes = m_meshes[frameIndex];
+  if (meshes.empty())
   {
     return nullptr;
   }
   else
   {
     const auto* skin = this->skin(skinIndex);
-    return m_meshes[frameIndex]->buildRenderer(skin);
+    return meshes[std::min(lodIndex, meshes.size() - 1u)]->buildRenderer(skin);
   }
 }
 
@@ -488,7 +858,7 @@ EntityModel::EntityModel(
 }
 
 std::unique_ptr<Renderer::TexturedRenderer> EntityModel::buildRenderer(
-  const size_t skinIndex, const size_t frameIndex) const
+  const size_t skinIndex, const size_t frameIndex, const size_t lodIndex) const
 {
   std::vector<std::unique_ptr<Renderer::TexturedIndexRangeRenderer>> renderers;
   if (frameIndex >= frameCount())
@@ -503,7 +873,8 @@ std::unique_ptr<Renderer::TexturedRenderer> EntityModel::buildRenderer(
     // If an out of range skin is requested, use the first skin as a fallback
     const auto correctedSkinIndex =
       actualSkinIndex < surface->skinCount() ? actualSkinIndex : 0;
-    if (auto renderer = surface->buildRenderer(correctedSkinIndex, frameIndex))
+    if (
+      auto renderer = surface->buildRenderer(correctedSkinIndex, frameIndex, lodIndex))
     {
       renderers.push_back(std::move(renderer));
     }
@@ -519,6 +890,62 @@ std::unique_ptr<Renderer::TexturedRenderer> EntityModel::buildRenderer(
   }
 }
 
+std::unique_ptr<Renderer::TexturedRenderer> EntityModel::buildImpostorRenderer(
+  const size_t skinIndex, const size_t frameIndex) const
+{
+  if (frameIndex >= frameCount() || !m_frames[frameIndex]->loaded())
+  {
+    return nullptr;
+  }
+
+  const auto& frame = this->frame(frameIndex);
+  const auto actualSkinIndex = skinIndex + frame->skinOffset();
+
+  const auto* skin = static_cast<const Texture*>(nullptr);
+  for (const auto& surface : m_surfaces)
+  {
+    if (surface->skinCount() > 0u)
+    {
+      skin = surface->skin(actualSkinIndex < surface->skinCount() ? actualSkinIndex : 0);
+      break;
+    }
+  }
+
+  auto vertices = std::vector<EntityModelVertex>{};
+  vertices.reserve(36);
+  frame->bounds().for_each_face([&](
+                                  const vm::vec3f& p1,
+                                  const vm::vec3f& p2,
+                                  const vm::vec3f& p3,
+                                  const vm::vec3f& p4,
+                                  const vm::vec3f& /* normal */) {
+    const auto v1 = EntityModelVertex{p1, vm::vec2f{0, 0}};
+    const auto v2 = EntityModelVertex{p2, vm::vec2f{1, 0}};
+    const auto v3 = EntityModelVertex{p3, vm::vec2f{1, 1}};
+    const auto v4 = EntityModelVertex{p4, vm::vec2f{0, 1}};
+    vertices.insert(vertices.end(), {v1, v2, v3, v1, v3, v4});
+  });
+
+  const auto vertexCount = vertices.size();
+  return std::make_unique<Renderer::TexturedIndexRangeRenderer>(
+    Renderer::VertexArray::move(std::move(vertices)),
+    skin,
+    Renderer::IndexRangeMap{Renderer::PrimType::Triangles, 0, vertexCount});
+}
+
+size_t EntityModel::lodCount(const size_t frameIndex) const
+{
+  auto result = size_t(0);
+  if (frameIndex < frameCount())
+  {
+    for (const auto& surface : m_surfaces)
+    {
+      result = std::max(result, surface->lodCount(frameIndex));
+    }
+  }
+  return result;
+}
+
 vm::bbox3f EntityModel::bounds(const size_t frameIndex) const
 {
   if (frameIndex >= m_frames.size())
@@ -71,6 +71,28 @@ enum class Orientation
   ViewPlaneParallelOriented,
 };
 
+/**
+ * The maximum number of levels of detail of an entity model mesh. Level 0 is the mesh as
+ * it was loaded, and each further level is a simplified version of it with fewer
+ * triangles. Simplified levels are only generated for meshes with many triangles.
+ */
+constexpr size_t EntityModelLodCount = 3u;
+
+/**
+ * Simplifies the given mesh by merging all vertices that fall into the same cell of a
+ * regular grid that is laid over the bounds of the mesh. Triangles that collapse into a
+ * line or a point are removed. Each remaining triangle is returned as three vertices.
+ *
+ * @param vertices the mesh vertices
+ * @param indices the primitives of the mesh
+ * @param gridSize the number of grid cells along the longest axis of the mesh bounds
+ * @return the vertices of the remaining triangles
+ */
+std::vector<EntityModelVertex> decimateMesh(
+  const std::vector<EntityModelVertex>& vertices,
+  const EntityModelIndices& indices,
+  size_t gridSize);
+
 /**
  * One frame of the model. Since frames are loaded on demand, each frame has two possible
  * states: loaded and unloaded. These states are modeled as subclasses of this class.
@@ -220,13 +242,15 @@ class EntityModelTexturedMesh;
  * with one skin per surface.
  *
  * Each surface contains per frame meshes. The number of per frame meshes should match the
- * number of frames in the model.
+ * number of frames in the model. When a mesh is added, simplified versions of it are
+ * generated for the levels of detail.
  */
 class EntityModelSurface
 {
 private:
   std::string m_name;
-  std::vector<std::unique_ptr<EntityModelMesh>> m_meshes;
+  // the meshes of each frame, indexed by level of detail
+  std::vector<std::vector<std::unique_ptr<EntityModelMesh>>> m_meshes;
   std::unique_ptr<TextureCollection> m_skins;
 
 public:
@@ -326,8 +350,21 @@ public:
    */
   const Texture* skin(size_t index) const;
 
+  /**
+   * Returns the number of levels of detail of the mesh of the given frame, or 0 if the
+   * frame has no mesh.
+   *
+   * @param frameIndex the index of the frame
+   * @return the number of levels of detail
+   */
+  size_t lodCount(size_t frameIndex) const;
+
+  /**
+   * Creates a renderer for the mesh of the given frame at the given level of detail. If
+   * the mesh has fewer levels of detail, the coarsest level is used.
+   */
   std::unique_ptr<Renderer::TexturedIndexRangeRenderer> buildRenderer(
-    size_t skinIndex, size_t frameIndex);
+    size_t skinIndex, size_t frameIndex, size_t lodIndex = 0);
 };
 
 /**
@@ -362,11 +399,33 @@ public:
    *
    * @param skinIndex the index of the skin to use
    * @param frameIndex the index of the frame to render
+   * @param lodIndex the level of detail to render
    * @return the renderer
    */
   std::unique_ptr<Renderer::TexturedRenderer> buildRenderer(
+    size_t skinIndex, size_t frameIndex, size_t lodIndex = 0) const;
+
+  /**
+   * Creates a renderer that renders the bounds of the given frame as a box textured with
+   * the skin with the given index. Used in place of the model when it is too far away to
+   * make out any details.
+   *
+   * @param skinIndex the index of the skin to use
+   * @param frameIndex the index of the frame whose bounds to render
+   * @return the renderer
+   */
+  std::unique_ptr<Renderer::TexturedRenderer> buildImpostorRenderer(
     size_t skinIndex, size_t frameIndex) const;
 
+  /**
+   * Returns the number of levels of detail of the given frame, which is the maximum
+   * number of levels of detail of the frame's meshes in all surfaces.
+   *
+   * @param frameIndex the index of the frame
+   * @return the number of levels of detail
+   */
+  size_t lodCount(size_t frameIndex) const;
+
   /**
    * Returns the bounds of the given frame of this model.
    *
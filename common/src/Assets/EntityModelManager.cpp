@@ -74,7 +74,34 @@ void EntityModelManager::setLoader(const IO::EntityModelLoader* loader)
 }
 
 Renderer::TexturedRenderer* EntityModelManager::renderer(
+  const Assets::ModelSpecification& spec, const size_t lodIndex) const
+{
+  assert(lodIndex < EntityModelLodCount);
+  return findOrBuildRenderer(spec, lodIndex, [&](const EntityModel& entityModel) {
+    return entityModel.buildRenderer(spec.skinIndex, spec.frameIndex, lodIndex);
+  });
+}
+
+Renderer::TexturedRenderer* EntityModelManager::impostorRenderer(
   const Assets::ModelSpecification& spec) const
+{
+  return findOrBuildRenderer(
+    spec, EntityModelLodCount, [&](const EntityModel& entityModel) {
+      return entityModel.buildImpostorRenderer(spec.skinIndex, spec.frameIndex);
+    });
+}
+
+size_t EntityModelManager::lodCount(const Assets::ModelSpecification& spec) const
+{
+  const auto* entityModel = safeGetModel(spec.path);
+  return entityModel ? entityModel->lodCount(spec.frameIndex) : 0u;
+}
+
+Renderer::TexturedRenderer* EntityModelManager::findOrBuildRenderer(
+  const Assets::ModelSpecification& spec,
+  const size_t lodIndex,
+  const std::function<std::unique_ptr<Renderer::TexturedRenderer>(const EntityModel&)>&
+    buildRenderer) const
 {
   auto* entityModel = safeGetModel(spec.path);
 
@@ -83,21 +110,22 @@ Renderer::TexturedRenderer* EntityModelManager::renderer(
     return nullptr;
   }
 
-  auto it = m_renderers.find(spec);
+  const auto key = RendererKey{spec, lodIndex};
+  auto it = m_renderers.find(key);
   if (it != std::end(m_renderers))
   {
     return it->second.get();
   }
 
-  if (m_rendererMismatches.count(spec) > 0)
+  if (m_rendererMismatches.count(key) > 0)
   {
     return nullptr;
   }
 
-  auto renderer = entityModel->buildRenderer(spec.skinIndex, spec.frameIndex);
+  auto renderer = buildRenderer(*entityModel);
   if (renderer != nullptr)
   {
-    const auto [pos, success] = m_renderers.emplace(spec, std::move(renderer));
+    const auto [pos, success] = m_renderers.emplace(key, std::move(renderer));
     assert(success);
     unused(success);
 
@@ -108,7 +136,7 @@ Renderer::TexturedRenderer* EntityModelManager::renderer(
   }
   else
   {
-    m_rendererMismatches.insert(spec);
+    m_rendererMismatches.insert(key);
     m_logger.error() << "Failed to construct entity model renderer for " << spec
                      << ", check the skin and frame indices";
     return nullptr;
@@ -137,6 +165,11 @@ const EntityModelFrame* EntityModelManager::frame(
   }
 }
 
+bool EntityModelManager::isModelLoaded(const std::filesystem::path& path) const
+{
+  return path.empty() || m_models.count(path) > 0 || m_modelMismatches.count(path) > 0;
+}
+
 EntityModel* EntityModelManager::model(const std::filesystem::path& path) const
 {
   if (path.empty())
@@ -155,6 +188,12 @@ EntityModel* EntityModelManager::model(const std::filesystem::path& path) const
     return nullptr;
   }
 
+  if (m_loader == nullptr)
+  {
+    // the model is loaded once a loader is set, so don't record a mismatch
+    return nullptr;
+  }
+
   try
   {
     const auto [pos, success] = m_models.emplace(path, loadModel(path));
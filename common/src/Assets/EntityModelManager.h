@@ -22,8 +22,10 @@
 #include <kdl/vector_set.h>
 
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -60,9 +62,12 @@ private:
   using ModelMismatches = kdl::vector_set<std::filesystem::path>;
   using ModelList = std::vector<EntityModel*>;
 
+  // renderers are cached by model specification and level of detail, with the impostor
+  // renderers stored at level of detail EntityModelLodCount
+  using RendererKey = std::pair<ModelSpecification, size_t>;
   using RendererCache =
-    std::map<ModelSpecification, std::unique_ptr<Renderer::TexturedRenderer>>;
-  using RendererMismatches = kdl::vector_set<ModelSpecification>;
+    std::map<RendererKey, std::unique_ptr<Renderer::TexturedRenderer>>;
+  using RendererMismatches = kdl::vector_set<RendererKey>;
   using RendererList = std::vector<Renderer::TexturedRenderer*>;
 
   Logger& m_logger;
@@ -87,12 +92,44 @@ public:
   void clear();
 
   void setTextureMode(int minFilter, int magFilter);
+
+  /**
+   * Sets the loader used to read models and clears all loaded models and renderers.
+   *
+   * While no loader is set, no models are loaded and the functions below behave as if
+   * the requested model could not be found.
+   */
   void setLoader(const IO::EntityModelLoader* loader);
-  Renderer::TexturedRenderer* renderer(const ModelSpecification& spec) const;
+
+  Renderer::TexturedRenderer* renderer(
+    const ModelSpecification& spec, size_t lodIndex = 0) const;
+
+  /**
+   * Returns a renderer that draws the bounds of the given model frame, see
+   * EntityModel::buildImpostorRenderer.
+   */
+  Renderer::TexturedRenderer* impostorRenderer(const ModelSpecification& spec) const;
+
+  /**
+   * Returns the number of levels of detail of the given model frame, or 0 if the model
+   * cannot be loaded.
+   */
+  size_t lodCount(const ModelSpecification& spec) const;
 
   const EntityModelFrame* frame(const ModelSpecification& spec) const;
 
+  /**
+   * Indicates whether the model with the given path was already loaded or failed to load,
+   * i.e. whether requesting a frame of the model will not read the model file again.
+   */
+  bool isModelLoaded(const std::filesystem::path& path) const;
+
 private:
+  Renderer::TexturedRenderer* findOrBuildRenderer(
+    const ModelSpecification& spec,
+    size_t lodIndex,
+    const std::function<std::unique_ptr<Renderer::TexturedRenderer>(const EntityModel&)>&
+      buildRenderer) const;
   EntityModel* model(const std::filesystem::path& path) const;
   EntityModel* safeGetModel(const std::filesystem::path& path) const;
   std::unique_ptr<EntityModel> loadModel(const std::filesystem::path& path) const;
@@ -385,7 +385,7 @@ void Texture::prepare(const GLuint textureId, const int minFilter, const int mag
     glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
     glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
 
-    glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
+    glBindTextureCached(GL_TEXTURE_2D, textureId);
     glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
     glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
     glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
@@ -476,7 +476,7 @@ void Texture::activate() const
 {
   if (isPrepared())
   {
-    glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+    glBindTextureCached(GL_TEXTURE_2D, m_textureId);
 
     switch (m_culling)
     {
@@ -535,7 +535,7 @@ void Texture::deactivate() const
       break;
     }
 
-    glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+    glBindTextureCached(GL_TEXTURE_2D, 0);
   }
 }
 
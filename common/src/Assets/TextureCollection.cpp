@@ -59,6 +59,7 @@ TextureCollection::~TextureCollection()
     glAssert(glDeleteTextures(
       static_cast<GLsizei>(m_textureIds.size()),
       static_cast<GLuint*>(&m_textureIds.front())));
+    glResetStateCache();
     m_textureIds.clear();
   }
 }
@@ -68,7 +68,10 @@ public:
 
   void reload(const IO::FileSystem& fs, const Model::TextureConfig& textureConfig);
 
-  // for testing
+  /**
+   * Adds the given texture collections, which have already been loaded, e.g. by
+   * IO::loadTextureCollections.
+   */
   void setTextureCollections(std::vector<TextureCollection> collections);
 
 private:
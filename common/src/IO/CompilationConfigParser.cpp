@@ -28,12 +28,72 @@
 
 #include <kdl/vector_utils.h>
 
+#include <cmath>
 #include <string>
 
 namespace TrenchBroom
 {
 namespace IO
 {
+namespace
+{
+size_t parseIndex(const EL::Value& value)
+{
+  expectType(value, EL::ValueType::Number);
+
+  const auto number = value.numberValue();
+  if (number < 0.0 || number != std::floor(number))
+  {
+    throw ParserException{
+      value.line(),
+      value.column(),
+      "Expected a non-negative integer, but got '" + value.asString() + "'"};
+  }
+  return static_cast<size_t>(number);
+}
+
+size_t parseJobCount(const EL::Value& value)
+{
+  const auto jobCount = parseIndex(value);
+  if (jobCount == 0)
+  {
+    throw ParserException{
+      value.line(), value.column(), "Expected a job count of at least 1"};
+  }
+  return jobCount;
+}
+
+Model::CompilationTaskDependencies parseDependencies(
+  const EL::Value& value, const size_t taskIndex)
+{
+  if (!value.contains("dependencies"))
+  {
+    return std::nullopt;
+  }
+
+  const auto& dependenciesValue = value["dependencies"];
+  expectType(dependenciesValue, EL::ValueType::Array);
+
+  auto result = std::vector<size_t>{};
+  result.reserve(dependenciesValue.length());
+
+  for (size_t i = 0; i < dependenciesValue.length(); ++i)
+  {
+    const auto dependency = parseIndex(dependenciesValue[i]);
+    if (dependency >= taskIndex)
+    {
+      throw ParserException{
+        dependenciesValue[i].line(),
+        dependenciesValue[i].column(),
+        "Task " + std::to_string(taskIndex) + " can only depend on earlier tasks"};
+    }
+    result.push_back(dependency);
+  }
+
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+}
+} // namespace
+
 CompilationConfigParser::CompilationConfigParser(
   const std::string_view str, std::filesystem::path path)
   : ConfigParserBase{str, std::move(path)}
@@ -71,12 +131,16 @@ Model::CompilationProfile CompilationConfigParser::parseProfile(
   const EL::Value& value) const
 {
   expectStructure(
-    value, "[ {'name': 'String', 'workdir': 'String', 'tasks': 'Array'}, {} ]");
+    value,
+    "[ {'name': 'String', 'workdir': 'String', 'tasks': 'Array'}, { 'jobs': 'Number' } "
+    "]");
 
+  const auto jobCount = value.contains("jobs") ? parseJobCount(value["jobs"]) : 1u;
   return {
     value["name"].stringValue(),
     value["workdir"].stringValue(),
-    parseTasks(value["tasks"])};
+    parseTasks(value["tasks"]),
+    jobCount};
 }
 
 std::vector<Model::CompilationTask> CompilationConfigParser::parseTasks(
@@ -87,7 +151,10 @@ std::vector<Model::CompilationTask> CompilationConfigParser::parseTasks(
 
   for (size_t i = 0; i < value.length(); ++i)
   {
-    result.push_back(parseTask(value[i]));
+    auto task = parseTask(value[i]);
+    std::visit(
+      [&](auto& t) { t.dependencies = parseDependencies(value[i], i); }, task);
+    result.push_back(std::move(task));
   }
   return result;
 }
@@ -125,7 +192,9 @@ Model::CompilationExportMap CompilationConfigParser::parseExportTask(
   const EL::Value& value) const
 {
   expectStructure(
-    value, "[ {'type': 'String', 'target': 'String'}, { 'enabled': 'Boolean' } ]");
+    value,
+    "[ {'type': 'String', 'target': 'String'}, { 'enabled': 'Boolean', 'dependencies': "
+    "'Array' } ]");
 
   const auto enabled = value.contains("enabled") ? value["enabled"].booleanValue() : true;
   return {enabled, value["target"].stringValue()};
@@ -137,7 +206,7 @@ Model::CompilationCopyFiles CompilationConfigParser::parseCopyTask(
   expectStructure(
     value,
     "[ {'type': 'String', 'source': 'String', 'target': 'String'}, { 'enabled': "
-    "'Boolean' } ]");
+    "'Boolean', 'dependencies': 'Array' } ]");
 
   const auto enabled = value.contains("enabled") ? value["enabled"].booleanValue() : true;
   return {enabled, value["source"].stringValue(), value["target"].stringValue()};
@@ -149,7 +218,7 @@ Model::CompilationRenameFile CompilationConfigParser::parseRenameTask(
   expectStructure(
     value,
     "[ {'type': 'String', 'source': 'String', 'target': 'String'}, { 'enabled': "
-    "'Boolean' } ]");
+    "'Boolean', 'dependencies': 'Array' } ]");
 
   const auto enabled = value.contains("enabled") ? value["enabled"].booleanValue() : true;
   return {enabled, value["source"].stringValue(), value["target"].stringValue()};
@@ -159,7 +228,9 @@ Model::CompilationDeleteFiles CompilationConfigParser::parseDeleteTask(
   const EL::Value& value) const
 {
   expectStructure(
-    value, "[ {'type': 'String', 'target': 'String'}, { 'enabled': 'Boolean' } ]");
+    value,
+    "[ {'type': 'String', 'target': 'String'}, { 'enabled': 'Boolean', 'dependencies': "
+    "'Array' } ]");
 
   const auto enabled = value.contains("enabled") ? value["enabled"].booleanValue() : true;
   return {enabled, value["target"].stringValue()};
@@ -171,7 +242,8 @@ Model::CompilationRunTool CompilationConfigParser::parseToolTask(
   expectStructure(
     value,
     "[ {'type': 'String', 'tool': 'String', 'parameters': 'String'}, { 'enabled': "
-    "'Boolean', 'treatNonZeroResultCodeAsError': 'Boolean' } ]");
+    "'Boolean', 'treatNonZeroResultCodeAsError': 'Boolean', 'dependencies': 'Array' } "
+    "]");
 
   const auto enabled = value.contains("enabled") ? value["enabled"].booleanValue() : true;
   const auto treatNonZeroResultCodeAsError =
@@ -35,6 +35,21 @@ namespace TrenchBroom
 {
 namespace IO
 {
+namespace
+{
+void writeDependencies(
+  EL::MapType& map, const Model::CompilationTaskDependencies& dependencies)
+{
+  if (dependencies)
+  {
+    map["dependencies"] =
+      EL::Value{kdl::vec_transform(*dependencies, [](const auto dependency) {
+        return EL::Value{static_cast<EL::NumberType>(dependency)};
+      })};
+  }
+}
+} // namespace
+
 CompilationConfigWriter::CompilationConfigWriter(
   const Model::CompilationConfig& config, std::ostream& stream)
   : m_config{config}
@@ -61,11 +76,16 @@ EL::Value CompilationConfigWriter::writeProfiles(
 EL::Value CompilationConfigWriter::writeProfile(
   const Model::CompilationProfile& profile) const
 {
-  return EL::Value{EL::MapType{
+  auto map = EL::MapType{
     {"name", EL::Value{profile.name}},
     {"workdir", EL::Value{profile.workDirSpec}},
     {"tasks", writeTasks(profile)},
-  }};
+  };
+  if (profile.jobCount != 1)
+  {
+    map["jobs"] = EL::Value{static_cast<EL::NumberType>(profile.jobCount)};
+  }
+  return EL::Value{std::move(map)};
 }
 
 EL::Value CompilationConfigWriter::writeTasks(
@@ -82,6 +102,7 @@ EL::Value CompilationConfigWriter::writeTasks(
           }
           map["type"] = EL::Value{"export"};
           map["target"] = EL::Value{exportMap.targetSpec};
+          writeDependencies(map, exportMap.dependencies);
           return EL::Value{std::move(map)};
         },
         [](const Model::CompilationCopyFiles& copyFiles) {
@@ -93,6 +114,7 @@ EL::Value CompilationConfigWriter::writeTasks(
           map["type"] = EL::Value{"copy"};
           map["source"] = EL::Value{copyFiles.sourceSpec};
           map["target"] = EL::Value{copyFiles.targetSpec};
+          writeDependencies(map, copyFiles.dependencies);
           return EL::Value{std::move(map)};
         },
         [](const Model::CompilationRenameFile& renameFile) {
@@ -104,6 +126,7 @@ EL::Value CompilationConfigWriter::writeTasks(
           map["type"] = EL::Value{"rename"};
           map["source"] = EL::Value{renameFile.sourceSpec};
           map["target"] = EL::Value{renameFile.targetSpec};
+          writeDependencies(map, renameFile.dependencies);
           return EL::Value{std::move(map)};
         },
         [](const Model::CompilationDeleteFiles& deleteFiles) {
@@ -114,6 +137,7 @@ EL::Value CompilationConfigWriter::writeTasks(
           }
           map["type"] = EL::Value{"delete"};
           map["target"] = EL::Value{deleteFiles.targetSpec};
+          writeDependencies(map, deleteFiles.dependencies);
           return EL::Value{std::move(map)};
         },
         [](const Model::CompilationRunTool& runTool) {
@@ -129,6 +153,7 @@ EL::Value CompilationConfigWriter::writeTasks(
           map["type"] = EL::Value{"tool"};
           map["tool"] = EL::Value{runTool.toolSpec};
           map["parameters"] = EL::Value{runTool.parameterSpec};
+          writeDependencies(map, runTool.dependencies);
           return EL::Value{std::move(map)};
         }),
       task);
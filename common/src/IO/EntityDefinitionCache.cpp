@@ -0,0 +1,147 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityDefinitionCache.h"
+
+#include "Error.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/ParserStatus.h"
+
+#include <kdl/result.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <system_error>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+std::optional<std::string> readFile(const std::filesystem::path& path)
+{
+  return Disk::openFile(path)
+    .transform([](auto file) -> std::optional<std::string> {
+      auto reader = file->reader().buffer();
+      return std::string{reader.stringView()};
+    })
+    .transform_error(
+      [](const auto&) -> std::optional<std::string> { return std::nullopt; })
+    .value();
+}
+
+bool isUnchanged(const EntityDefinitionFile& file)
+{
+  // only read a file again if its size is unchanged
+  if (file.contents)
+  {
+    auto error = std::error_code{};
+    const auto fileSize = std::filesystem::file_size(file.path, error);
+    if (error || fileSize != file.contents->size())
+    {
+      return false;
+    }
+  }
+  return readFile(file.path) == file.contents;
+}
+
+size_t hashContents(const std::string_view contents)
+{
+  return std::hash<std::string_view>{}(contents);
+}
+} // namespace
+
+std::optional<std::vector<EntityDefinitionClassInfo>> EntityDefinitionCache::find(
+  const std::filesystem::path& path,
+  const std::string_view contents,
+  ParserStatus& status)
+{
+  const auto contentsHash = hashContents(contents);
+
+  auto entry = std::shared_ptr<const Entry>{};
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    const auto it = m_entries.find(path);
+    if (it == m_entries.end() || it->second.entry->contentsHash != contentsHash)
+    {
+      return std::nullopt;
+    }
+    it->second.lastUsed = ++m_useCount;
+    entry = it->second.entry;
+  }
+
+  // validate without holding the lock, the included files must be read from disk
+  if (
+    entry->contents != contents
+    || !std::all_of(
+      entry->includedFiles.begin(), entry->includedFiles.end(), isUnchanged))
+  {
+    return std::nullopt;
+  }
+
+  for (const auto& message : entry->messages)
+  {
+    status.logMessage(message.level, message.message);
+  }
+
+  return entry->classInfos;
+}
+
+void EntityDefinitionCache::insert(
+  const std::filesystem::path& path,
+  const std::string_view contents,
+  std::vector<EntityDefinitionFile> includedFiles,
+  std::vector<EntityDefinitionClassInfo> classInfos,
+  std::vector<ParserStatusMessage> messages)
+{
+  const auto lock = std::lock_guard{m_mutex};
+  if (m_entries.count(path) == 0 && m_entries.size() >= MaxEntries)
+  {
+    const auto leastRecentlyUsed = std::min_element(
+      m_entries.begin(), m_entries.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second.lastUsed < rhs.second.lastUsed;
+      });
+    m_entries.erase(leastRecentlyUsed);
+  }
+
+  m_entries[path] = CachedEntry{
+    std::make_shared<const Entry>(Entry{
+      hashContents(contents),
+      std::string{contents},
+      std::move(includedFiles),
+      std::move(classInfos),
+      std::move(messages)}),
+    ++m_useCount};
+}
+
+size_t EntityDefinitionCache::size() const
+{
+  const auto lock = std::lock_guard{m_mutex};
+  return m_entries.size();
+}
+
+void EntityDefinitionCache::clear()
+{
+  const auto lock = std::lock_guard{m_mutex};
+  m_entries.clear();
+}
+
+} // namespace TrenchBroom::IO
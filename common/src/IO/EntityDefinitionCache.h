@@ -0,0 +1,119 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/EntityDefinitionClassInfo.h"
+#include "IO/EntityDefinitionParser.h"
+#include "IO/RecordingParserStatus.h"
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+class ParserStatus;
+
+/**
+ * Caches the resolved class infos of entity definition files so that loading another map
+ * which uses the same entity definition file does not parse it again.
+ *
+ * A cache entry records the contents of the entity definition file and of all files it
+ * includes. The entry is only used if none of these files has changed since it was
+ * created. The contents of the entity definition file are compared by their hash first,
+ * and the included files are only read if their sizes are unchanged. The messages that
+ * were logged while parsing are stored with the entry and replayed when it is used.
+ *
+ * The cache holds at most MaxEntries entries and evicts the least recently used entry
+ * when it is full. Since each entry keeps the file contents, this bounds its memory use
+ * to a small multiple of the size of the entity definition files in use.
+ *
+ * This class is thread safe.
+ */
+class EntityDefinitionCache
+{
+public:
+  static constexpr size_t MaxEntries = 16;
+
+private:
+  /**
+   * An entry is immutable once it was created, so it can be validated and copied from
+   * without holding the lock.
+   */
+  struct Entry
+  {
+    size_t contentsHash;
+    std::string contents;
+    std::vector<EntityDefinitionFile> includedFiles;
+    std::vector<EntityDefinitionClassInfo> classInfos;
+    std::vector<ParserStatusMessage> messages;
+  };
+
+  struct CachedEntry
+  {
+    std::shared_ptr<const Entry> entry;
+    size_t lastUsed;
+  };
+
+  mutable std::mutex m_mutex;
+  std::map<std::filesystem::path, CachedEntry> m_entries;
+  size_t m_useCount = 0;
+
+public:
+  /**
+   * Returns the cached class infos for the entity definition file at the given path, or
+   * nothing if there is no entry for the file or if the entry is stale.
+   *
+   * If an entry is found, the messages that were logged when it was parsed are logged
+   * to the given status again.
+   *
+   * @param path the absolute path of the entity definition file
+   * @param contents the current contents of the entity definition file
+   * @param status the status to replay the parser messages to
+   */
+  std::optional<std::vector<EntityDefinitionClassInfo>> find(
+    const std::filesystem::path& path, std::string_view contents, ParserStatus& status);
+
+  /**
+   * Adds or replaces the cache entry for the entity definition file at the given path.
+   *
+   * @param path the absolute path of the entity definition file
+   * @param contents the contents of the entity definition file that were parsed
+   * @param includedFiles the other files read while parsing the entity definition file
+   * @param classInfos the resolved class infos
+   * @param messages the messages logged while parsing the entity definition file
+   */
+  void insert(
+    const std::filesystem::path& path,
+    std::string_view contents,
+    std::vector<EntityDefinitionFile> includedFiles,
+    std::vector<EntityDefinitionClassInfo> classInfos,
+    std::vector<ParserStatusMessage> messages);
+
+  size_t size() const;
+  void clear();
+};
+
+} // namespace TrenchBroom::IO
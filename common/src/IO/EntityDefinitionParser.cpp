@@ -27,6 +27,7 @@
 #include "Macros.h"
 #include "Model/EntityProperties.h"
 
+#include <kdl/reflection_impl.h>
 #include <kdl/vector_utils.h>
 
 #include <unordered_map>
@@ -34,6 +35,8 @@
 
 namespace TrenchBroom::IO
 {
+kdl_reflect_impl(EntityDefinitionFile);
+
 static const auto DefaultSize = vm::bbox3(-8, +8);
 
 EntityDefinitionParser::EntityDefinitionParser(const Color& defaultEntityColor)
@@ -453,16 +456,14 @@ std::unique_ptr<Assets::EntityDefinition> createDefinition(
   };
 }
 
+} // namespace
+
 std::vector<std::unique_ptr<Assets::EntityDefinition>> createDefinitions(
-  ParserStatus& status,
-  const std::vector<EntityDefinitionClassInfo>& classInfos,
+  const std::vector<EntityDefinitionClassInfo>& resolvedClassInfos,
   const Color& defaultEntityColor)
 {
-  const auto resolvedClasses =
-    resolveInheritance(status, filterRedundantClasses(status, classInfos));
-
   auto result = std::vector<std::unique_ptr<Assets::EntityDefinition>>{};
-  for (auto classInfo : resolvedClasses)
+  for (auto classInfo : resolvedClassInfos)
   {
     if (auto definition = createDefinition(std::move(classInfo), defaultEntityColor))
     {
@@ -473,13 +474,22 @@ std::vector<std::unique_ptr<Assets::EntityDefinition>> createDefinitions(
   return result;
 }
 
-} // namespace
-
 std::vector<std::unique_ptr<Assets::EntityDefinition>> EntityDefinitionParser::
   parseDefinitions(ParserStatus& status)
+{
+  return createDefinitions(parseResolvedClassInfos(status), m_defaultEntityColor);
+}
+
+std::vector<EntityDefinitionClassInfo> EntityDefinitionParser::parseResolvedClassInfos(
+  ParserStatus& status)
 {
   const auto classInfos = parseClassInfos(status);
-  return createDefinitions(status, classInfos, m_defaultEntityColor);
+  return resolveInheritance(status, filterRedundantClasses(status, classInfos));
+}
+
+std::vector<EntityDefinitionFile> EntityDefinitionParser::includedFiles() const
+{
+  return {};
 }
 
 } // namespace TrenchBroom::IO
@@ -21,7 +21,11 @@
 
 #include "Color.h"
 
+#include <kdl/reflection_decl.h>
+
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -37,10 +41,30 @@ namespace TrenchBroom::IO
 struct EntityDefinitionClassInfo;
 class ParserStatus;
 
+/**
+ * A file that was read while parsing entity definitions. The contents are empty if the
+ * file could not be opened.
+ */
+struct EntityDefinitionFile
+{
+  std::filesystem::path path;
+  std::optional<std::string> contents;
+
+  kdl_reflect_decl(EntityDefinitionFile, path, contents);
+};
+
 // exposed for testing
 std::vector<EntityDefinitionClassInfo> resolveInheritance(
   ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos);
 
+/**
+ * Creates entity definitions from class infos returned by
+ * EntityDefinitionParser::parseResolvedClassInfos.
+ */
+std::vector<std::unique_ptr<Assets::EntityDefinition>> createDefinitions(
+  const std::vector<EntityDefinitionClassInfo>& resolvedClassInfos,
+  const Color& defaultEntityColor);
+
 class EntityDefinitionParser
 {
 private:
@@ -53,6 +77,19 @@ public:
   std::vector<std::unique_ptr<Assets::EntityDefinition>> parseDefinitions(
     ParserStatus& status);
 
+  /**
+   * Parses the class infos, removes redundant classes and resolves inheritance. The
+   * returned class infos do not depend on the default entity color and can be turned into
+   * entity definitions by calling createDefinitions.
+   */
+  std::vector<EntityDefinitionClassInfo> parseResolvedClassInfos(ParserStatus& status);
+
+  /**
+   * Returns the files other than the parsed string that were read while parsing, e.g.
+   * included files.
+   */
+  virtual std::vector<EntityDefinitionFile> includedFiles() const;
+
 private:
   virtual std::vector<EntityDefinitionClassInfo> parseClassInfos(
     ParserStatus& status) = 0;
@@ -23,6 +23,7 @@
 #include <kdl/reflection_decl.h>
 
 #include <filesystem>
+#include <optional>
 #include <variant>
 
 namespace TrenchBroom
@@ -49,7 +50,26 @@ struct ObjExportOptions
   std::filesystem::path exportPath;
   ObjMtlPathMode mtlPathMode;
 
-  kdl_reflect_decl(ObjExportOptions, exportPath, mtlPathMode);
+  /**
+   * Write each object as soon as it is serialized instead of collecting the entire export
+   * in memory. The objects are serialized in parallel chunks, and each object refers only
+   * to its own vertex data.
+   */
+  bool streaming = false;
+
+  /**
+   * The number of significant digits of the exported coordinates. If unset, the shortest
+   * representation that converts back to the same value is used.
+   */
+  std::optional<int> precision = std::nullopt;
+
+  /**
+   * Whether equal vertex positions, texture coordinates and normals share their indices.
+   */
+  bool deduplicate = true;
+
+  kdl_reflect_decl(
+    ObjExportOptions, exportPath, mtlPathMode, streaming, precision, deduplicate);
 };
 
 using ExportOptions = std::variant<MapExportOptions, ObjExportOptions>;
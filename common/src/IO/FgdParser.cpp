@@ -172,6 +172,11 @@ FgdParser::FgdParser(std::string_view str, const Color& defaultEntityColor)
 
 FgdParser::~FgdParser() = default;
 
+std::vector<EntityDefinitionFile> FgdParser::includedFiles() const
+{
+  return m_includedFiles;
+}
+
 FgdParser::TokenNameMap FgdParser::tokenNames() const
 {
   using namespace FgdToken;
@@ -1085,6 +1090,7 @@ std::vector<EntityDefinitionClassInfo> FgdParser::handleInclude(
     m_tokenizer.line(), fmt::format("Parsing included file '{}'", path.string()));
 
   const auto filePath = currentRoot() / path;
+  const auto absoluteFilePath = m_fs->makeAbsolute(filePath).value_or(filePath);
   return m_fs->openFile(filePath)
     .transform([&](auto file) {
       status.debug(
@@ -1104,10 +1110,12 @@ std::vector<EntityDefinitionClassInfo> FgdParser::handleInclude(
 
       const auto pushIncludePath = PushIncludePath{*this, filePath};
       auto reader = file->reader().buffer();
+      m_includedFiles.push_back({absoluteFilePath, std::string{reader.stringView()}});
       m_tokenizer.replaceState(reader.stringView());
       return parseClassInfos(status);
     })
     .transform_error([&](auto e) {
+      m_includedFiles.push_back({absoluteFilePath, std::nullopt});
       status.error(
         m_tokenizer.line(), fmt::format("Failed to parse included file: {}", e.msg));
       return std::vector<EntityDefinitionClassInfo>{};
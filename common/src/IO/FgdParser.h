@@ -80,6 +80,7 @@ private:
 
   std::vector<std::filesystem::path> m_paths;
   std::unique_ptr<FileSystem> m_fs;
+  std::vector<EntityDefinitionFile> m_includedFiles;
 
   FgdTokenizer m_tokenizer;
 
@@ -92,6 +93,8 @@ public:
 
   ~FgdParser() override;
 
+  std::vector<EntityDefinitionFile> includedFiles() const override;
+
 private:
   class PushIncludePath;
   void pushIncludePath(std::filesystem::path path);
@@ -224,4 +224,33 @@ Result<Assets::TextureCollection> loadTextureCollection(
     });
 }
 
+std::vector<Assets::TextureCollection> loadTextureCollections(
+  const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger)
+{
+  return findTextureCollections(gameFS, textureConfig)
+    .transform([&](const auto& paths) {
+      return kdl::vec_transform(paths, [&](const auto& path) {
+        return loadTextureCollection(path, gameFS, textureConfig, logger)
+          .transform([&](auto collection) {
+            if (!collection.textures().empty())
+            {
+              logger.info() << "Loaded texture collection '" << path << "'";
+            }
+            return collection;
+          })
+          .transform_error([&](const auto& error) {
+            logger.error() << "Could not load texture collection '" << path
+                           << "': " << error.msg;
+            return Assets::TextureCollection{path};
+          })
+          .value();
+      });
+    })
+    .transform_error([&](const auto& error) {
+      logger.error() << "Could not find texture collections: " << error.msg;
+      return std::vector<Assets::TextureCollection>{};
+    })
+    .value();
+}
+
 } // namespace TrenchBroom::IO
@@ -54,4 +54,14 @@ Result<Assets::TextureCollection> loadTextureCollection(
   const Model::TextureConfig& textureConfig,
   Logger& logger);
 
+/**
+ * Finds and loads all texture collections of the given game file system. Collections that
+ * cannot be loaded are logged and returned without any textures.
+ *
+ * This function does not share any state with a texture manager and can be called on a
+ * worker thread, provided that the file system is not modified concurrently.
+ */
+std::vector<Assets::TextureCollection> loadTextureCollections(
+  const FileSystem& gameFS, const Model::TextureConfig& textureConfig, Logger& logger);
+
 } // namespace TrenchBroom::IO
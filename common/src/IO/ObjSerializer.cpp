@@ -27,18 +27,28 @@
 #include "Model/BrushNode.h"
 #include "Model/PatchNode.h"
 #include "Model/Polyhedron.h"
+#include "Model/TexCoordSystem.h"
 
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 
 #include <fmt/format.h>
 
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <utility>
 
 namespace TrenchBroom
 {
 namespace IO
 {
+/**
+ * The number of objects that are serialized in parallel when streaming. The objects are
+ * buffered until a chunk is full, and only one chunk is kept in memory at a time.
+ */
+static constexpr auto StreamChunkSize = size_t(1024);
+
 std::ostream& operator<<(std::ostream& str, const ObjSerializer::IndexedVertex& vertex)
 {
   str << " " << (vertex.vertex + 1u) << "/" << (vertex.texCoords + 1u) << "/"
@@ -97,12 +107,138 @@ ObjSerializer::ObjSerializer(
   , m_mtlStream{mtlStream}
   , m_mtlFilename{std::move(mtlFilename)}
   , m_options{std::move(options)}
+  , m_vertices{m_options.deduplicate}
+  , m_texCoords{m_options.deduplicate}
+  , m_normals{m_options.deduplicate}
+  , m_vertexCount{0}
+  , m_texCoordsCount{0}
+  , m_normalCount{0}
 {
   ensure(m_objStream.good(), "obj stream is good");
   ensure(m_mtlStream.good(), "mtl stream is good");
 }
 
-void ObjSerializer::doBeginFile(const std::vector<const Model::Node*>& /* rootNodes */) {}
+static ObjSerializer::BrushFace makeBrushFace(
+  const Model::BrushFace& face,
+  ObjSerializer::IndexMap<vm::vec3>& vertices,
+  ObjSerializer::IndexMap<vm::vec2f>& texCoords,
+  ObjSerializer::IndexMap<vm::vec3>& normals)
+{
+  const vm::vec3& normal = face.boundary().normal;
+  const size_t normalIndex = normals.index(normal);
+
+  const auto positions = face.vertexPositions();
+  const auto faceTexCoords = face.textureCoordsProjection()(positions);
+
+  auto indexedVertices = std::vector<ObjSerializer::IndexedVertex>{};
+  indexedVertices.reserve(positions.size());
+
+  for (size_t i = 0; i < positions.size(); ++i)
+  {
+    const size_t vertexIndex = vertices.index(positions[i]);
+    const size_t texCoordsIndex = texCoords.index(faceTexCoords[i]);
+
+    indexedVertices.push_back(
+      ObjSerializer::IndexedVertex{vertexIndex, texCoordsIndex, normalIndex});
+  }
+
+  return ObjSerializer::BrushFace{
+    std::move(indexedVertices), face.attributes().textureName(), face.texture()};
+}
+
+static ObjSerializer::BrushObject makeBrushObject(
+  const Model::BrushNode& brushNode,
+  const size_t entityNo,
+  const size_t brushNo,
+  ObjSerializer::IndexMap<vm::vec3>& vertices,
+  ObjSerializer::IndexMap<vm::vec2f>& texCoords,
+  ObjSerializer::IndexMap<vm::vec3>& normals)
+{
+  auto brushObject = ObjSerializer::BrushObject{entityNo, brushNo, {}};
+  brushObject.faces.reserve(brushNode.brush().faceCount());
+
+  // Vertex positions inserted from now on should get new indices
+  vertices.clearIndices();
+
+  for (const Model::BrushFace& face : brushNode.brush().faces())
+  {
+    brushObject.faces.push_back(makeBrushFace(face, vertices, texCoords, normals));
+  }
+
+  return brushObject;
+}
+
+static ObjSerializer::PatchObject makePatchObject(
+  const Model::PatchNode& patchNode,
+  const size_t entityNo,
+  const size_t patchNo,
+  ObjSerializer::IndexMap<vm::vec3>& vertices,
+  ObjSerializer::IndexMap<vm::vec2f>& texCoords,
+  ObjSerializer::IndexMap<vm::vec3>& normals)
+{
+  const auto& patch = patchNode.patch();
+  auto patchObject = ObjSerializer::PatchObject{
+    entityNo, patchNo, {}, patch.textureName(), patch.texture()};
+
+  // export patches at full detail regardless of how they are tessellated for rendering
+  const auto patchGrid = Model::makePatchGrid(patch, Model::MaxSubdivisionsPerSurface);
+  patchObject.quads.reserve(patchGrid.quadRowCount() * patchGrid.quadColumnCount());
+
+  // Vertex positions inserted from now on should get new indices
+  vertices.clearIndices();
+
+  const auto makeIndexedVertex = [&](const auto& p) {
+    const size_t positionIndex = vertices.index(p.position);
+    const size_t texCoordsIndex = texCoords.index(vm::vec2f{p.texCoords});
+    const size_t normalIndex = normals.index(p.normal);
+
+    return ObjSerializer::IndexedVertex{positionIndex, texCoordsIndex, normalIndex};
+  };
+
+  for (size_t row = 0u; row < patchGrid.pointRowCount - 1u; ++row)
+  {
+    for (size_t col = 0u; col < patchGrid.pointColumnCount - 1u; ++col)
+    {
+      // counter clockwise order
+      patchObject.quads.push_back(ObjSerializer::PatchQuad{{
+        makeIndexedVertex(patchGrid.point(row, col)),
+        makeIndexedVertex(patchGrid.point(row + 1u, col)),
+        makeIndexedVertex(patchGrid.point(row + 1u, col + 1u)),
+        makeIndexedVertex(patchGrid.point(row, col + 1u)),
+      }});
+    }
+  }
+
+  return patchObject;
+}
+
+static void writeMaterial(
+  std::ostream& str,
+  const std::string& textureName,
+  const Assets::Texture* texture,
+  const IO::ObjExportOptions& options)
+{
+  str << "newmtl " << textureName << "\n";
+  if (texture)
+  {
+    switch (options.mtlPathMode)
+    {
+    case ObjMtlPathMode::RelativeToGamePath:
+      str << "map_Kd " << texture->relativePath().generic_string() << "\n";
+      break;
+    case ObjMtlPathMode::RelativeToExportPath:
+      // textures loaded from image files (pak files) don't have absolute paths
+      if (!texture->absolutePath().empty())
+      {
+        const auto basePath = options.exportPath.parent_path();
+        const auto mtlPath = texture->absolutePath().lexically_relative(basePath);
+        str << "map_Kd " << mtlPath.generic_string() << "\n";
+      }
+      break;
+    }
+  }
+  str << "\n";
+}
 
 static void writeMtlFile(
   std::ostream& str,
@@ -127,66 +263,92 @@ static void writeMtlFile(
       object);
   }
 
-  const auto basePath = options.exportPath.parent_path();
   for (const auto& [textureName, texture] : usedTextures)
   {
-    str << "newmtl " << textureName << "\n";
-    if (texture)
-    {
-      switch (options.mtlPathMode)
-      {
-      case ObjMtlPathMode::RelativeToGamePath:
-        str << "map_Kd " << texture->relativePath().generic_string() << "\n";
-        break;
-      case ObjMtlPathMode::RelativeToExportPath:
-        // textures loaded from image files (pak files) don't have absolute paths
-        if (!texture->absolutePath().empty())
-        {
-          const auto mtlPath = texture->absolutePath().lexically_relative(basePath);
-          str << "map_Kd " << mtlPath.generic_string() << "\n";
-        }
-        break;
-      }
-    }
-    str << "\n";
+    writeMaterial(str, textureName, texture, options);
   }
 }
 
-static void writeVertices(std::ostream& str, const std::vector<vm::vec3>& vertices)
+template <typename T>
+static void writeValue(
+  std::ostream& str, const T value, const std::optional<int>& precision)
+{
+  if (precision)
+  {
+    fmt::format_to(std::ostreambuf_iterator<char>(str), " {:.{}g}", value, *precision);
+  }
+  else
+  {
+    fmt::format_to(std::ostreambuf_iterator<char>(str), " {}", value);
+  }
+}
+
+static void writeVertex(
+  std::ostream& str, const vm::vec3& vertex, const std::optional<int>& precision)
+{
+  // no idea why I have to switch Y and Z
+  str << "v";
+  writeValue(str, vertex.x(), precision);
+  writeValue(str, vertex.z(), precision);
+  writeValue(str, -vertex.y(), precision);
+  str << "\n";
+}
+
+static void writeTexCoord(
+  std::ostream& str, const vm::vec2f& texCoords, const std::optional<int>& precision)
+{
+  // multiplying Y by -1 needed to get the UV's to appear correct in Blender and UE4
+  // (see: https://github.com/TrenchBroom/TrenchBroom/issues/2851 )
+  str << "vt";
+  writeValue(str, texCoords.x(), precision);
+  writeValue(str, -texCoords.y(), precision);
+  str << "\n";
+}
+
+static void writeNormal(
+  std::ostream& str, const vm::vec3& normal, const std::optional<int>& precision)
+{
+  // no idea why I have to switch Y and Z
+  str << "vn";
+  writeValue(str, normal.x(), precision);
+  writeValue(str, normal.z(), precision);
+  writeValue(str, -normal.y(), precision);
+  str << "\n";
+}
+
+static void writeVertices(
+  std::ostream& str,
+  const std::vector<vm::vec3>& vertices,
+  const std::optional<int>& precision)
 {
   str << "# vertices\n";
   for (const vm::vec3& elem : vertices)
   {
-    // no idea why I have to switch Y and Z
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(str), "v {} {} {}\n", elem.x(), elem.z(), -elem.y());
+    writeVertex(str, elem, precision);
   }
 }
 
-static void writeTexCoords(std::ostream& str, const std::vector<vm::vec2f>& texCoords)
+static void writeTexCoords(
+  std::ostream& str,
+  const std::vector<vm::vec2f>& texCoords,
+  const std::optional<int>& precision)
 {
   str << "# texture coordinates\n";
   for (const vm::vec2f& elem : texCoords)
   {
-    // multiplying Y by -1 needed to get the UV's to appear correct in Blender and UE4
-    // (see: https://github.com/TrenchBroom/TrenchBroom/issues/2851 )
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(str), "vt {} {}\n", elem.x(), -elem.y());
+    writeTexCoord(str, elem, precision);
   }
 }
 
-static void writeNormals(std::ostream& str, const std::vector<vm::vec3>& normals)
+static void writeNormals(
+  std::ostream& str,
+  const std::vector<vm::vec3>& normals,
+  const std::optional<int>& precision)
 {
   str << "# normals\n";
   for (const vm::vec3& elem : normals)
   {
-    // no idea why I have to switch Y and Z
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(str),
-      "vn {} {} {}\n",
-      elem.x(),
-      elem.z(),
-      -elem.y());
+    writeNormal(str, elem, precision);
   }
 }
 
@@ -196,15 +358,16 @@ static void writeObjFile(
   const std::vector<vm::vec3>& vertices,
   const std::vector<vm::vec2f>& texCoords,
   const std::vector<vm::vec3>& normals,
-  const std::vector<ObjSerializer::Object>& objects)
+  const std::vector<ObjSerializer::Object>& objects,
+  const std::optional<int>& precision)
 {
 
   str << "mtllib " << mtlFilename << "\n";
-  writeVertices(str, vertices);
+  writeVertices(str, vertices, precision);
   str << "\n";
-  writeTexCoords(str, texCoords);
+  writeTexCoords(str, texCoords, precision);
   str << "\n";
-  writeNormals(str, normals);
+  writeNormals(str, normals, precision);
   str << "\n";
 
   for (const auto& object : objects)
@@ -214,8 +377,22 @@ static void writeObjFile(
   }
 }
 
+void ObjSerializer::doBeginFile(const std::vector<const Model::Node*>& /* rootNodes */)
+{
+  if (m_options.streaming)
+  {
+    m_objStream << "mtllib " << m_mtlFilename << "\n\n";
+  }
+}
+
 void ObjSerializer::doEndFile()
 {
+  if (m_options.streaming)
+  {
+    writePendingObjects();
+    return;
+  }
+
   writeMtlFile(m_mtlStream, m_objects, m_options);
   writeObjFile(
     m_objStream,
@@ -223,7 +400,8 @@ void ObjSerializer::doEndFile()
     m_vertices.list(),
     m_texCoords.list(),
     m_normals.list(),
-    m_objects);
+    m_objects,
+    m_options.precision);
 }
 
 void ObjSerializer::doBeginEntity(const Model::Node* /* node */) {}
@@ -232,6 +410,16 @@ void ObjSerializer::doEntityProperty(const Model::EntityProperty& /* property */
 
 void ObjSerializer::doBrush(const Model::BrushNode* brush)
 {
+  if (m_options.streaming)
+  {
+    m_pendingObjects.push_back({brush, entityNo(), brushNo()});
+    if (m_pendingObjects.size() >= StreamChunkSize)
+    {
+      writePendingObjects();
+    }
+    return;
+  }
+
   m_currentBrush = BrushObject{entityNo(), brushNo(), {}};
   m_currentBrush->faces.reserve(brush->brush().faceCount());
 
@@ -249,62 +437,122 @@ void ObjSerializer::doBrush(const Model::BrushNode* brush)
 
 void ObjSerializer::doBrushFace(const Model::BrushFace& face)
 {
-  const vm::vec3& normal = face.boundary().normal;
-  const size_t normalIndex = m_normals.index(normal);
-
-  auto indexedVertices = std::vector<IndexedVertex>{};
-  indexedVertices.reserve(face.vertexCount());
+  m_currentBrush->faces.push_back(
+    makeBrushFace(face, m_vertices, m_texCoords, m_normals));
+}
 
-  for (const Model::BrushVertex* vertex : face.vertices())
+void ObjSerializer::doPatch(const Model::PatchNode* patchNode)
+{
+  if (m_options.streaming)
   {
-    const vm::vec3& position = vertex->position();
-    const vm::vec2f texCoords = face.textureCoords(position);
-
-    const size_t vertexIndex = m_vertices.index(position);
-    const size_t texCoordsIndex = m_texCoords.index(texCoords);
-
-    indexedVertices.push_back(IndexedVertex{vertexIndex, texCoordsIndex, normalIndex});
+    m_pendingObjects.push_back({patchNode, entityNo(), brushNo()});
+    if (m_pendingObjects.size() >= StreamChunkSize)
+    {
+      writePendingObjects();
+    }
+    return;
   }
 
-  m_currentBrush->faces.push_back(BrushFace{
-    std::move(indexedVertices), face.attributes().textureName(), face.texture()});
+  m_objects.push_back(makePatchObject(
+    *patchNode, entityNo(), brushNo(), m_vertices, m_texCoords, m_normals));
 }
 
-void ObjSerializer::doPatch(const Model::PatchNode* patchNode)
+void ObjSerializer::writePendingObjects()
 {
-  const auto& patch = patchNode->patch();
-  auto patchObject =
-    PatchObject{entityNo(), brushNo(), {}, patch.textureName(), patch.texture()};
-
-  const auto& patchGrid = patchNode->grid();
-  patchObject.quads.reserve(patchGrid.quadRowCount() * patchGrid.quadColumnCount());
-
-  // Vertex positions inserted from now on should get new indices
-  m_vertices.clearIndices();
-
-  const auto makeIndexedVertex = [&](const auto& p) {
-    const size_t positionIndex = m_vertices.index(p.position);
-    const size_t texCoordsIndex = m_texCoords.index(vm::vec2f{p.texCoords});
-    const size_t normalIndex = m_normals.index(p.normal);
+  const auto& options = m_options;
+  auto streamedObjects =
+    kdl::vec_parallel_transform(m_pendingObjects, [&](const auto& pendingObject) {
+      auto vertices = IndexMap<vm::vec3>{options.deduplicate};
+      auto texCoords = IndexMap<vm::vec2f>{options.deduplicate};
+      auto normals = IndexMap<vm::vec3>{options.deduplicate};
+
+      const auto entityNo = pendingObject.entityNo;
+      const auto objectNo = pendingObject.objectNo;
+      auto object = std::visit(
+        kdl::overload(
+          [&](const Model::BrushNode* brushNode) -> Object {
+            return makeBrushObject(
+              *brushNode, entityNo, objectNo, vertices, texCoords, normals);
+          },
+          [&](const Model::PatchNode* patchNode) -> Object {
+            return makePatchObject(
+              *patchNode, entityNo, objectNo, vertices, texCoords, normals);
+          }),
+        pendingObject.node);
+
+      auto vertexData = std::ostringstream{};
+      for (const auto& vertex : vertices.list())
+      {
+        writeVertex(vertexData, vertex, options.precision);
+      }
+      for (const auto& texCoord : texCoords.list())
+      {
+        writeTexCoord(vertexData, texCoord, options.precision);
+      }
+      for (const auto& normal : normals.list())
+      {
+        writeNormal(vertexData, normal, options.precision);
+      }
 
-    return IndexedVertex{positionIndex, texCoordsIndex, normalIndex};
-  };
+      return StreamedObject{
+        std::move(object),
+        vertexData.str(),
+        vertices.list().size(),
+        texCoords.list().size(),
+        normals.list().size()};
+    });
+  m_pendingObjects.clear();
 
-  for (size_t row = 0u; row < patchGrid.pointRowCount - 1u; ++row)
+  for (auto& streamedObject : streamedObjects)
   {
-    for (size_t col = 0u; col < patchGrid.pointColumnCount - 1u; ++col)
+    writeStreamedObject(std::move(streamedObject));
+  }
+}
+
+void ObjSerializer::writeStreamedObject(StreamedObject streamedObject)
+{
+  // the object's indices refer to its own vertex data, so they must be offset by the
+  // vertex data that was written before
+  const auto offsetIndices = [&](auto& verts) {
+    for (auto& vertex : verts)
     {
-      // counter clockwise order
-      patchObject.quads.push_back(PatchQuad{{
-        makeIndexedVertex(patchGrid.point(row, col)),
-        makeIndexedVertex(patchGrid.point(row + 1u, col)),
-        makeIndexedVertex(patchGrid.point(row + 1u, col + 1u)),
-        makeIndexedVertex(patchGrid.point(row, col + 1u)),
-      }});
+      vertex.vertex += m_vertexCount;
+      vertex.texCoords += m_texCoordsCount;
+      vertex.normal += m_normalCount;
     }
-  }
+  };
+
+  std::visit(
+    kdl::overload(
+      [&](BrushObject& brushObject) {
+        for (auto& face : brushObject.faces)
+        {
+          offsetIndices(face.verts);
+          if (m_writtenMaterials.insert(face.textureName).second)
+          {
+            writeMaterial(m_mtlStream, face.textureName, face.texture, m_options);
+          }
+        }
+      },
+      [&](PatchObject& patchObject) {
+        for (auto& quad : patchObject.quads)
+        {
+          offsetIndices(quad.verts);
+        }
+        if (m_writtenMaterials.insert(patchObject.textureName).second)
+        {
+          writeMaterial(
+            m_mtlStream, patchObject.textureName, patchObject.texture, m_options);
+        }
+      }),
+    streamedObject.object);
+
+  m_objStream << streamedObject.vertexData;
+  m_objStream << streamedObject.object << "\n";
 
-  m_objects.push_back(std::move(patchObject));
+  m_vertexCount += streamedObject.vertexCount;
+  m_texCoordsCount += streamedObject.texCoordsCount;
+  m_normalCount += streamedObject.normalCount;
 }
 } // namespace IO
 } // namespace TrenchBroom
@@ -29,6 +29,7 @@
 #include <iosfwd>
 #include <map>
 #include <optional>
+#include <set>
 #include <string>
 #include <variant>
 #include <vector>
@@ -59,12 +60,24 @@ public:
   private:
     std::map<V, size_t> m_map;
     std::vector<V> m_list;
+    bool m_deduplicate;
 
   public:
+    explicit IndexMap(const bool deduplicate = true)
+      : m_deduplicate{deduplicate}
+    {
+    }
+
     const std::vector<V>& list() const { return m_list; }
 
     size_t index(const V& v)
     {
+      if (!m_deduplicate)
+      {
+        m_list.push_back(v);
+        return m_list.size() - 1u;
+      }
+
       const auto it = m_map.emplace(v, m_list.size()).first;
       const size_t index = it->second;
       if (index == m_list.size())
@@ -118,6 +131,19 @@ public:
 
   using Object = std::variant<BrushObject, PatchObject>;
 
+  /**
+   * A brush or patch that was serialized ahead of time for streaming. Its vertex data is
+   * already formatted, and the indices of the object refer to its own vertex data.
+   */
+  struct StreamedObject
+  {
+    Object object;
+    std::string vertexData;
+    size_t vertexCount;
+    size_t texCoordsCount;
+    size_t normalCount;
+  };
+
   friend std::ostream& operator<<(std::ostream& str, const IndexedVertex& vertex);
   friend std::ostream& operator<<(std::ostream& str, const BrushFace& face);
   friend std::ostream& operator<<(std::ostream& str, const BrushObject& object);
@@ -138,6 +164,20 @@ private:
   std::optional<BrushObject> m_currentBrush;
   std::vector<Object> m_objects;
 
+  // only used when streaming
+  struct PendingObject
+  {
+    std::variant<const Model::BrushNode*, const Model::PatchNode*> node;
+    size_t entityNo;
+    size_t objectNo;
+  };
+
+  std::vector<PendingObject> m_pendingObjects;
+  size_t m_vertexCount;
+  size_t m_texCoordsCount;
+  size_t m_normalCount;
+  std::set<std::string> m_writtenMaterials;
+
 public:
   ObjSerializer(
     std::ostream& objStream,
@@ -157,6 +197,9 @@ private:
   void doBrushFace(const Model::BrushFace& face) override;
 
   void doPatch(const Model::PatchNode* patchNode) override;
+
+  void writePendingObjects();
+  void writeStreamedObject(StreamedObject streamedObject);
 };
 } // namespace IO
 } // namespace TrenchBroom
@@ -123,6 +123,11 @@ void ParserStatus::errorAndThrow(const std::string& str)
   throw ParserException(buildMessage(str));
 }
 
+void ParserStatus::logMessage(const LogLevel level, const std::string& str)
+{
+  doLog(level, m_prefix.empty() ? str : m_prefix + ": " + str);
+}
+
 void ParserStatus::log(
   const LogLevel level, const size_t line, const size_t column, const std::string& str)
 {
@@ -61,6 +61,12 @@ public:
   void error(const std::string& str);
   [[noreturn]] void errorAndThrow(const std::string& str);
 
+  /**
+   * Logs a message that already contains its position, e.g. a message that was recorded
+   * by another parser status. Only this status's prefix is prepended.
+   */
+  void logMessage(LogLevel level, const std::string& str);
+
 private:
   void log(LogLevel level, size_t line, size_t column, const std::string& str);
   std::string buildMessage(size_t line, size_t column, const std::string& str) const;
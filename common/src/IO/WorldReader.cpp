@@ -77,7 +77,7 @@ WorldReader::WorldReader(
   , m_worldNode{std::make_unique<Model::WorldNode>(
       entityPropertyConfig, Model::Entity{}, sourceAndTargetMapFormat)}
 {
-  m_worldNode->disableNodeTreeUpdates();
+  m_worldNode->beginNodeTreeBatch();
 }
 
 std::unique_ptr<Model::WorldNode> WorldReader::tryRead(
@@ -187,8 +187,7 @@ std::unique_ptr<Model::WorldNode> WorldReader::read(
   readEntities(worldBounds, status);
   sanitizeLayerSortIndicies(*m_worldNode, status);
   setLinkIds(*m_worldNode, status);
-  m_worldNode->rebuildNodeTree();
-  m_worldNode->enableNodeTreeUpdates();
+  m_worldNode->commitNodeTreeBatch();
   return std::move(m_worldNode);
 }
 
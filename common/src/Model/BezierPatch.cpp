@@ -29,7 +29,9 @@
 #include <vecmath/bezier_surface.h>
 #include <vecmath/vec_io.h>
 
+#include <array>
 #include <cassert>
+#include <optional>
 
 namespace TrenchBroom::Model
 {
@@ -259,16 +261,59 @@ void evaluateSurface(
 
 std::vector<BezierPatch::Point> BezierPatch::evaluate(
   const size_t subdivisionsPerSurface) const
+{
+  return evaluate(subdivisionsPerSurface, subdivisionsPerSurface);
+}
+
+namespace
+{
+using BernsteinWeights = std::array<FloatType, 3>;
+
+/**
+ * Computes the weights of the quadratic Bernstein polynomials at x = i / quadCount for
+ * every 0 <= i <= quadCount.
+ */
+std::vector<BernsteinWeights> computeBernsteinWeights(const size_t quadCount)
+{
+  auto result = std::vector<BernsteinWeights>{};
+  result.reserve(quadCount + 1u);
+
+  for (size_t i = 0u; i <= quadCount; ++i)
+  {
+    const auto x = static_cast<FloatType>(i) / static_cast<FloatType>(quadCount);
+    result.push_back(
+      {FloatType(1) - FloatType(2) * x + (x * x), FloatType(2) * (x - (x * x)), x * x});
+  }
+
+  return result;
+}
+
+// Computed in the same way as vm::evaluate_quadratic_bezier_surface to get identical
+// results.
+BezierPatch::Point interpolate(
+  const BernsteinWeights& weights, const std::array<BezierPatch::Point, 3>& points)
+{
+  auto result = BezierPatch::Point{};
+  result = result + weights[0] * points[0];
+  result = result + weights[1] * points[1];
+  result = result + weights[2] * points[2];
+  return result;
+}
+} // namespace
+
+std::vector<BezierPatch::Point> BezierPatch::evaluate(
+  const size_t rowSubdivisionsPerSurface, const size_t columnSubdivisionsPerSurface) const
 {
   // collect the control points for each surface in this patch
   const auto allSurfaceControlPoints =
     collectAllSurfaceControlPoints(m_controlPoints, m_pointRowCount, m_pointColumnCount);
 
-  const auto quadsPerSurfaceSide = (1u << subdivisionsPerSurface);
+  const auto quadsPerSurfaceRow = size_t(1) << rowSubdivisionsPerSurface;
+  const auto quadsPerSurfaceColumn = size_t(1) << columnSubdivisionsPerSurface;
 
   // determine dimensions of the resulting point grid
-  const size_t gridPointRowCount = surfaceRowCount() * quadsPerSurfaceSide + 1u;
-  const size_t gridPointColumnCount = surfaceColumnCount() * quadsPerSurfaceSide + 1u;
+  const size_t gridPointRowCount = surfaceRowCount() * quadsPerSurfaceRow + 1u;
+  const size_t gridPointColumnCount = surfaceColumnCount() * quadsPerSurfaceColumn + 1u;
 
   auto grid = std::vector<BezierPatch::Point>{};
   grid.reserve(gridPointRowCount * gridPointColumnCount);
@@ -321,25 +366,54 @@ std::vector<BezierPatch::Point> BezierPatch::evaluate(
   value of v
   */
 
+  /*
+  The values of u and v repeat for every surface, so the Bernstein weights are computed
+  only once for each of them. Furthermore, for each row of surfaces, the control points of
+  every surface are first interpolated along u for all values of u. Each grid point is
+  then computed by interpolating three of these points along v.
+  */
+
+  const auto uWeights = computeBernsteinWeights(quadsPerSurfaceColumn);
+  const auto vWeights = computeBernsteinWeights(quadsPerSurfaceRow);
+
+  // for every surface in the current surface row and every value of u, the control
+  // points of the surface interpolated along u
+  auto uPoints = std::vector<std::array<Point, 3>>{};
+  uPoints.resize(surfaceColumnCount() * (quadsPerSurfaceColumn + 1u));
+  auto currentSurfaceRow = std::optional<size_t>{};
+
   for (size_t gridRow = 0u; gridRow < gridPointRowCount; ++gridRow)
   {
     const size_t surfaceRow =
-      (gridRow > 0u ? gridRow - 1u : gridRow) / quadsPerSurfaceSide;
-    const FloatType v = static_cast<FloatType>(gridRow - surfaceRow * quadsPerSurfaceSide)
-                        / static_cast<FloatType>(quadsPerSurfaceSide);
+      (gridRow > 0u ? gridRow - 1u : gridRow) / quadsPerSurfaceRow;
+    const size_t vIndex = gridRow - surfaceRow * quadsPerSurfaceRow;
+
+    if (surfaceRow != currentSurfaceRow)
+    {
+      for (size_t surfaceCol = 0u; surfaceCol < surfaceColumnCount(); ++surfaceCol)
+      {
+        const auto& surfaceControlPoints =
+          allSurfaceControlPoints[surfaceRow * surfaceColumnCount() + surfaceCol];
+        for (size_t uIndex = 0u; uIndex <= quadsPerSurfaceColumn; ++uIndex)
+        {
+          auto& points = uPoints[surfaceCol * (quadsPerSurfaceColumn + 1u) + uIndex];
+          for (size_t i = 0u; i < 3u; ++i)
+          {
+            points[i] = interpolate(uWeights[uIndex], surfaceControlPoints[i]);
+          }
+        }
+      }
+      currentSurfaceRow = surfaceRow;
+    }
 
     for (size_t gridCol = 0u; gridCol < gridPointColumnCount; ++gridCol)
     {
       const size_t surfaceCol =
-        (gridCol > 0u ? gridCol - 1u : gridCol) / quadsPerSurfaceSide;
-      const FloatType u =
-        static_cast<FloatType>(gridCol - surfaceCol * quadsPerSurfaceSide)
-        / static_cast<FloatType>(quadsPerSurfaceSide);
-
-      const auto& surfaceControlPoints =
-        allSurfaceControlPoints[surfaceRow * surfaceColumnCount() + surfaceCol];
-      auto point = vm::evaluate_quadratic_bezier_surface(surfaceControlPoints, u, v);
-      grid.push_back(std::move(point));
+        (gridCol > 0u ? gridCol - 1u : gridCol) / quadsPerSurfaceColumn;
+      const size_t uIndex = gridCol - surfaceCol * quadsPerSurfaceColumn;
+
+      grid.push_back(interpolate(
+        vWeights[vIndex], uPoints[surfaceCol * (quadsPerSurfaceColumn + 1u) + uIndex]));
     }
   }
 
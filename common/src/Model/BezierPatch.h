@@ -106,6 +106,14 @@ public: // control points:
   void transform(const vm::mat4x4& transformation);
 
   std::vector<Point> evaluate(size_t subdivisionsPerSurface) const;
+
+  /**
+   * Evaluates this patch on a grid where each surface is subdivided into 2^n rows and 2^m
+   * columns of quads, with n = rowSubdivisionsPerSurface and m =
+   * columnSubdivisionsPerSurface. The grid points are returned row by row.
+   */
+  std::vector<Point> evaluate(
+    size_t rowSubdivisionsPerSurface, size_t columnSubdivisionsPerSurface) const;
 };
 
 } // namespace TrenchBroom::Model
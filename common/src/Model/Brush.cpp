@@ -24,6 +24,7 @@
 #include "FloatType.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
+#include "Model/ExactBrushGeometry.h"
 #include "Model/MapFormat.h"
 #include "Model/TexCoordSystem.h"
 #include "Polyhedron.h"
@@ -114,49 +115,61 @@ Result<Brush> Brush::create(const vm::bbox3& worldBounds, std::vector<BrushFace>
 
 Result<void> Brush::updateGeometryFromFaces(const vm::bbox3& worldBounds)
 {
-  // First, add all faces to the brush geometry
   BrushFace::sortFaces(m_faces);
 
-  auto geometry = std::make_unique<BrushGeometry>(worldBounds);
-
-  for (size_t i = 0u; i < m_faces.size(); ++i)
+  // Axis-aligned and integer brushes can be built directly without clipping
+  auto geometry = createExactBrushGeometry(m_faces, worldBounds);
+  if (!geometry)
   {
-    BrushFace& face = m_faces[i];
-    const auto result = geometry->clip(face.boundary());
-    if (result.success())
+    // First, add all faces to the brush geometry
+    geometry = std::make_unique<BrushGeometry>(worldBounds);
+
+    for (size_t i = 0u; i < m_faces.size(); ++i)
     {
-      BrushFaceGeometry* faceGeometry = result.face();
-      face.setGeometry(faceGeometry);
-      faceGeometry->setPayload(i);
+      const auto result = geometry->clip(m_faces[i].boundary());
+      if (result.success())
+      {
+        result.face()->setPayload(i);
+      }
+      else if (result.empty())
+      {
+        return Error{"Brush is empty"};
+      }
     }
-    else if (result.empty())
+
+    // Correct vertex positions and heal short edges
+    geometry->correctVertexPositions();
+    if (!geometry->healEdges())
     {
-      return Error{"Brush is empty"};
+      return Error{"Brush is invalid"};
     }
   }
 
-  // Correct vertex positions and heal short edges
-  geometry->correctVertexPositions();
-  if (!geometry->healEdges())
+  // Now collect all faces which still remain, keeping them in sorted order
+  auto faceGeometries = std::vector<BrushFaceGeometry*>(m_faces.size(), nullptr);
+  for (BrushFaceGeometry* faceGeometry : geometry->faces())
   {
-    return Error{"Brush is invalid"};
+    if (const auto faceIndex = faceGeometry->payload())
+    {
+      faceGeometries[*faceIndex] = faceGeometry;
+    }
+    else
+    {
+      return Error{"Brush is incomplete"};
+    }
   }
 
-  // Now collect all faces which still remain
   std::vector<BrushFace> remainingFaces;
   remainingFaces.reserve(m_faces.size());
 
-  for (BrushFaceGeometry* faceGeometry : geometry->faces())
+  for (size_t i = 0u; i < m_faces.size(); ++i)
   {
-    if (const auto faceIndex = faceGeometry->payload())
+    if (BrushFaceGeometry* faceGeometry = faceGeometries[i])
     {
-      remainingFaces.push_back(std::move(m_faces[*faceIndex]));
+      remainingFaces.push_back(std::move(m_faces[i]));
+      remainingFaces.back().setGeometry(faceGeometry);
       faceGeometry->setPayload(remainingFaces.size() - 1u);
     }
-    else
-    {
-      return Error{"Brush is incomplete"};
-    }
   }
 
   m_faces = std::move(remainingFaces);
@@ -842,6 +842,11 @@ vm::vec2f BrushFace::textureCoords(const vm::vec3& point) const
   return m_texCoordSystem->getTexCoords(point, m_attributes, textureSize());
 }
 
+TexCoordProjection BrushFace::textureCoordsProjection() const
+{
+  return m_texCoordSystem->getTexCoordProjection(m_attributes, textureSize());
+}
+
 FloatType BrushFace::intersectWithRay(const vm::ray3& ray) const
 {
   ensure(m_geometry != nullptr, "geometry is null");
@@ -46,6 +46,7 @@ class Texture;
 
 namespace TrenchBroom::Model
 {
+class TexCoordProjection;
 class TexCoordSystem;
 class TexCoordSystemSnapshot;
 enum class WrapStyle;
@@ -264,6 +265,12 @@ public:
 
   vm::vec2f textureCoords(const vm::vec3& point) const;
 
+  /**
+   * Returns a projection that computes the texture coordinates of points on this face.
+   * Prefer this over textureCoords when computing the texture coordinates of many points.
+   */
+  TexCoordProjection textureCoordsProjection() const;
+
   FloatType intersectWithRay(const vm::ray3& ray) const;
 
 private:
@@ -274,7 +281,7 @@ private:
 public: // brush renderer
   /**
    * This is used to cache results of evaluating the BrushRenderer Filter.
-   * It's only valid within a call to `BrushRenderer::validateBrush`.
+   * It's only valid within a call to `BrushRenderer::validate`.
    *
    * @param marked    whether the face is going to be rendered.
    */
@@ -34,8 +34,9 @@ struct CompilationProfile
   std::string name;
   std::string workDirSpec;
   std::vector<CompilationTask> tasks;
+  size_t jobCount = 1;
 
-  kdl_reflect_decl(CompilationProfile, name, workDirSpec, tasks);
+  kdl_reflect_decl(CompilationProfile, name, workDirSpec, tasks, jobCount);
 };
 } // namespace Model
 } // namespace TrenchBroom
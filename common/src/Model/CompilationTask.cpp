@@ -20,6 +20,9 @@
 #include "CompilationTask.h"
 
 #include <kdl/reflection_impl.h>
+#include <kdl/vector_utils.h>
+
+#include <cassert>
 
 namespace TrenchBroom
 {
@@ -42,5 +45,91 @@ std::ostream& operator<<(std::ostream& lhs, const CompilationTask& rhs)
   return lhs;
 }
 
+bool isEnabled(const CompilationTask& task)
+{
+  return std::visit([](const auto& t) { return t.enabled; }, task);
+}
+
+const CompilationTaskDependencies& dependencies(const CompilationTask& task)
+{
+  return std::visit(
+    [](const auto& t) -> const CompilationTaskDependencies& { return t.dependencies; },
+    task);
+}
+
+size_t taskNumberForIndex(const size_t taskIndex)
+{
+  return taskIndex + 1u;
+}
+
+std::optional<size_t> taskIndexForNumber(const size_t taskNumber)
+{
+  return taskNumber > 0u ? std::optional{taskNumber - 1u} : std::nullopt;
+}
+
+std::vector<std::vector<size_t>> resolveDependencies(
+  const std::vector<CompilationTask>& tasks)
+{
+  auto result = std::vector<std::vector<size_t>>{};
+  result.reserve(tasks.size());
+
+  for (size_t i = 0; i < tasks.size(); ++i)
+  {
+    const auto& declaredDependencies = dependencies(tasks[i]);
+    const auto directDependencies =
+      declaredDependencies ? *declaredDependencies
+      : i > 0              ? std::vector<size_t>{i - 1}
+                           : std::vector<size_t>{};
+
+    auto resolvedDependencies = std::vector<size_t>{};
+    for (const auto dependency : directDependencies)
+    {
+      // dependencies on later tasks are rejected when parsing and editing
+      assert(dependency < i);
+      if (isEnabled(tasks[dependency]))
+      {
+        resolvedDependencies.push_back(dependency);
+      }
+      else
+      {
+        resolvedDependencies =
+          kdl::vec_concat(std::move(resolvedDependencies), result[dependency]);
+      }
+    }
+
+    result.push_back(
+      kdl::vec_sort_and_remove_duplicates(std::move(resolvedDependencies)));
+  }
+
+  return result;
+}
+
+std::vector<CompilationTask> remapDependencies(
+  std::vector<CompilationTask> tasks,
+  const std::function<std::optional<size_t>(size_t)>& mapIndex)
+{
+  for (size_t i = 0; i < tasks.size(); ++i)
+  {
+    std::visit(
+      [&](auto& t) {
+        if (t.dependencies)
+        {
+          auto remappedDependencies = std::vector<size_t>{};
+          for (const auto dependency : *t.dependencies)
+          {
+            if (const auto newIndex = mapIndex(dependency); newIndex && *newIndex < i)
+            {
+              remappedDependencies.push_back(*newIndex);
+            }
+          }
+          t.dependencies =
+            kdl::vec_sort_and_remove_duplicates(std::move(remappedDependencies));
+        }
+      },
+      tasks[i]);
+  }
+  return tasks;
+}
+
 } // namespace Model
 } // namespace TrenchBroom
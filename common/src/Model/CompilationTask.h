@@ -23,19 +23,31 @@
 
 #include <kdl/reflection_decl.h>
 
+#include <functional>
+#include <optional>
 #include <string>
 #include <variant>
+#include <vector>
 
 namespace TrenchBroom
 {
 namespace Model
 {
+/**
+ * The dependencies of a compilation task are the indices of earlier tasks of the same
+ * profile which must have finished before the task can run. If no dependencies are
+ * given, the task depends on the task immediately preceding it, so that profiles without
+ * any declared dependencies run their tasks one after another.
+ */
+using CompilationTaskDependencies = std::optional<std::vector<size_t>>;
+
 struct CompilationExportMap
 {
   bool enabled;
   std::string targetSpec;
+  CompilationTaskDependencies dependencies = std::nullopt;
 
-  kdl_reflect_decl(CompilationExportMap, enabled, targetSpec);
+  kdl_reflect_decl(CompilationExportMap, enabled, targetSpec, dependencies);
 };
 
 struct CompilationCopyFiles
@@ -43,8 +55,10 @@ struct CompilationCopyFiles
   bool enabled;
   std::string sourceSpec;
   std::string targetSpec;
+  CompilationTaskDependencies dependencies = std::nullopt;
 
-  kdl_reflect_decl(CompilationCopyFiles, enabled, sourceSpec, targetSpec);
+  kdl_reflect_decl(
+    CompilationCopyFiles, enabled, sourceSpec, targetSpec, dependencies);
 };
 
 struct CompilationRenameFile
@@ -52,16 +66,19 @@ struct CompilationRenameFile
   bool enabled;
   std::string sourceSpec;
   std::string targetSpec;
+  CompilationTaskDependencies dependencies = std::nullopt;
 
-  kdl_reflect_decl(CompilationRenameFile, enabled, sourceSpec, targetSpec);
+  kdl_reflect_decl(
+    CompilationRenameFile, enabled, sourceSpec, targetSpec, dependencies);
 };
 
 struct CompilationDeleteFiles
 {
   bool enabled;
   std::string targetSpec;
+  CompilationTaskDependencies dependencies = std::nullopt;
 
-  kdl_reflect_decl(CompilationDeleteFiles, enabled, targetSpec);
+  kdl_reflect_decl(CompilationDeleteFiles, enabled, targetSpec, dependencies);
 };
 
 struct CompilationRunTool
@@ -70,9 +87,15 @@ struct CompilationRunTool
   std::string toolSpec;
   std::string parameterSpec;
   bool treatNonZeroResultCodeAsError;
+  CompilationTaskDependencies dependencies = std::nullopt;
 
   kdl_reflect_decl(
-    CompilationRunTool, enabled, toolSpec, parameterSpec, treatNonZeroResultCodeAsError);
+    CompilationRunTool,
+    enabled,
+    toolSpec,
+    parameterSpec,
+    treatNonZeroResultCodeAsError,
+    dependencies);
 };
 
 using CompilationTask = std::variant<
@@ -84,5 +107,39 @@ using CompilationTask = std::variant<
 
 std::ostream& operator<<(std::ostream& lhs, const CompilationTask& rhs);
 
+bool isEnabled(const CompilationTask& task);
+const CompilationTaskDependencies& dependencies(const CompilationTask& task);
+
+/**
+ * Tasks are referred to by their zero based index in the model and in the compilation
+ * config file, including in task dependencies. The UI numbers tasks starting at one
+ * instead. These functions are the only place where one is converted into the other.
+ */
+size_t taskNumberForIndex(size_t taskIndex);
+
+/**
+ * Returns the index of the task with the given number, or nothing if the given number is
+ * not a valid task number.
+ */
+std::optional<size_t> taskIndexForNumber(size_t taskNumber);
+
+/**
+ * Returns for each of the given tasks the indices of the enabled tasks that must have
+ * finished before it can run. If a task depends on a disabled task, it inherits the
+ * dependencies of the disabled task instead.
+ */
+std::vector<std::vector<size_t>> resolveDependencies(
+  const std::vector<CompilationTask>& tasks);
+
+/**
+ * Updates the dependencies of the given tasks after they were inserted, removed or
+ * reordered. The given function maps the index that a task had before to the index it
+ * has now, or to nothing if the task was removed. Dependencies on removed tasks and
+ * dependencies that no longer refer to an earlier task are dropped.
+ */
+std::vector<CompilationTask> remapDependencies(
+  std::vector<CompilationTask> tasks,
+  const std::function<std::optional<size_t>(size_t)>& mapIndex);
+
 } // namespace Model
 } // namespace TrenchBroom
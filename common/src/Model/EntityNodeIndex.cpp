@@ -24,11 +24,11 @@
 #include "Model/EntityNodeBase.h"
 #include "Model/EntityProperties.h"
 
-#include <kdl/compact_trie.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <iterator>
-#include <list>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -36,6 +36,97 @@ namespace TrenchBroom
 {
 namespace Model
 {
+void EntityNodeStringIndex::insert(const std::string& str, EntityNodeBase* node)
+{
+  auto [it, inserted] = m_nodes.try_emplace(str);
+  it->second.push_back(node);
+  if (inserted)
+  {
+    m_sortedStringsValid = false;
+  }
+}
+
+void EntityNodeStringIndex::remove(const std::string& str, EntityNodeBase* node)
+{
+  auto it = m_nodes.find(str);
+  if (it == std::end(m_nodes))
+  {
+    return;
+  }
+
+  // the order of the nodes is irrelevant, so we can avoid shifting the remaining nodes
+  auto& nodes = it->second;
+  auto nodeIt = std::find(std::begin(nodes), std::end(nodes), node);
+  if (nodeIt != std::end(nodes))
+  {
+    *nodeIt = nodes.back();
+    nodes.pop_back();
+  }
+
+  if (nodes.empty())
+  {
+    m_nodes.erase(it);
+    m_sortedStringsValid = false;
+  }
+}
+
+void EntityNodeStringIndex::findExact(
+  const std::string& str, std::vector<EntityNodeBase*>& result) const
+{
+  if (const auto it = m_nodes.find(str); it != std::end(m_nodes))
+  {
+    result.insert(std::end(result), std::begin(it->second), std::end(it->second));
+  }
+}
+
+template <typename P>
+void EntityNodeStringIndex::findWithPrefix(
+  const std::string& prefix,
+  const P& predicate,
+  std::vector<EntityNodeBase*>& result) const
+{
+  const auto& strings = sortedStrings();
+  auto it = std::lower_bound(
+    std::begin(strings), std::end(strings), prefix, [](const auto* lhs, const auto& rhs) {
+      return *lhs < rhs;
+    });
+
+  for (; it != std::end(strings) && (*it)->compare(0, prefix.size(), prefix) == 0; ++it)
+  {
+    if (predicate(**it))
+    {
+      const auto& nodes = m_nodes.at(**it);
+      result.insert(std::end(result), std::begin(nodes), std::end(nodes));
+    }
+  }
+}
+
+std::vector<std::string> EntityNodeStringIndex::strings() const
+{
+  return kdl::vec_transform(sortedStrings(), [](const auto* str) { return *str; });
+}
+
+const std::vector<const std::string*>& EntityNodeStringIndex::sortedStrings() const
+{
+  const auto lock = std::lock_guard<std::mutex>{m_sortedStringsMutex};
+  if (!m_sortedStringsValid)
+  {
+    // the keys of an unordered_map are never moved, so we can refer to them directly
+    m_sortedStrings.clear();
+    m_sortedStrings.reserve(m_nodes.size());
+    for (const auto& [str, nodes] : m_nodes)
+    {
+      m_sortedStrings.push_back(&str);
+    }
+    std::sort(
+      std::begin(m_sortedStrings),
+      std::end(m_sortedStrings),
+      [](const auto* lhs, const auto* rhs) { return *lhs < *rhs; });
+    m_sortedStringsValid = true;
+  }
+  return m_sortedStrings;
+}
+
 EntityNodeIndexQuery EntityNodeIndexQuery::exact(const std::string& pattern)
 {
   return EntityNodeIndexQuery(Type_Exact, pattern);
@@ -56,26 +147,29 @@ EntityNodeIndexQuery EntityNodeIndexQuery::any()
   return EntityNodeIndexQuery(Type_Any);
 }
 
-std::set<EntityNodeBase*> EntityNodeIndexQuery::execute(
+std::vector<EntityNodeBase*> EntityNodeIndexQuery::execute(
   const EntityNodeStringIndex& index) const
 {
-  std::set<EntityNodeBase*> result;
+  auto result = std::vector<EntityNodeBase*>{};
   switch (m_type)
   {
   case Type_Exact:
-    index.find_matches(m_pattern, std::inserter(result, std::end(result)));
+    index.findExact(m_pattern, result);
     break;
   case Type_Prefix:
-    index.find_matches(m_pattern + "*", std::inserter(result, std::end(result)));
+    index.findWithPrefix(m_pattern, [](const auto&) { return true; }, result);
     break;
   case Type_Numbered:
-    index.find_matches(m_pattern + "%*", std::inserter(result, std::end(result)));
+    index.findWithPrefix(
+      m_pattern,
+      [&](const auto& key) { return isNumberedProperty(m_pattern, key); },
+      result);
     break;
   case Type_Any:
     break;
     switchDefault();
   }
-  return result;
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
 }
 
 bool EntityNodeIndexQuery::execute(
@@ -119,14 +213,6 @@ EntityNodeIndexQuery::EntityNodeIndexQuery(const Type type, const std::string& p
 {
 }
 
-EntityNodeIndex::EntityNodeIndex()
-  : m_keyIndex(std::make_unique<EntityNodeStringIndex>())
-  , m_valueIndex(std::make_unique<EntityNodeStringIndex>())
-{
-}
-
-EntityNodeIndex::~EntityNodeIndex() = default;
-
 void EntityNodeIndex::addEntityNode(EntityNodeBase* node)
 {
   for (const EntityProperty& property : node->entity().properties())
@@ -142,15 +228,15 @@ void EntityNodeIndex::removeEntityNode(EntityNodeBase* node)
 void EntityNodeIndex::addProperty(
   EntityNodeBase* node, const std::string& key, const std::string& value)
 {
-  m_keyIndex->insert(key, node);
-  m_valueIndex->insert(value, node);
+  m_keyIndex.insert(key, node);
+  m_valueIndex.insert(value, node);
 }
 
 void EntityNodeIndex::removeProperty(
   EntityNodeBase* node, const std::string& key, const std::string& value)
 {
-  m_keyIndex->remove(key, node);
-  m_valueIndex->remove(value, node);
+  m_keyIndex.remove(key, node);
+  m_valueIndex.remove(value, node);
 }
 
 std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
@@ -158,7 +244,7 @@ std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
 {
   // first, find Nodes which have `value` as the value for any key
   std::vector<EntityNodeBase*> result;
-  m_valueIndex->find_matches(value, std::back_inserter(result));
+  m_valueIndex.findExact(value, result);
   if (result.empty())
   {
     return {};
@@ -167,24 +253,19 @@ std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
   result = kdl::vec_sort_and_remove_duplicates(std::move(result));
 
   // next, remove results from the result set that don't match `keyQuery`
-  auto it = std::begin(result);
-  while (it != std::end(result))
-  {
-    const EntityNodeBase* node = *it;
-    if (!keyQuery.execute(node, value))
-      it = result.erase(it);
-    else
-      ++it;
-  }
+  result.erase(
+    std::remove_if(
+      std::begin(result),
+      std::end(result),
+      [&](const auto* node) { return !keyQuery.execute(node, value); }),
+    std::end(result));
 
   return result;
 }
 
 std::vector<std::string> EntityNodeIndex::allKeys() const
 {
-  std::vector<std::string> result;
-  m_keyIndex->get_keys(std::back_inserter(result));
-  return result;
+  return m_keyIndex.strings();
 }
 
 std::vector<std::string> EntityNodeIndex::allValuesForKeys(
@@ -192,7 +273,7 @@ std::vector<std::string> EntityNodeIndex::allValuesForKeys(
 {
   std::vector<std::string> result;
 
-  const std::set<EntityNodeBase*> nameResult = keyQuery.execute(*m_keyIndex);
+  const auto nameResult = keyQuery.execute(m_keyIndex);
   for (const auto node : nameResult)
   {
     const auto matchingProperties = keyQuery.execute(node);
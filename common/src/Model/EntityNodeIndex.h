@@ -19,11 +19,9 @@
 
 #pragma once
 
-#include <kdl/compact_trie_forward.h>
-
-#include <memory>
-#include <set>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -33,7 +31,52 @@ namespace Model
 class EntityNodeBase;
 class EntityProperty;
 
-using EntityNodeStringIndex = kdl::compact_trie<EntityNodeBase*>;
+/**
+ * Maps strings to the entity nodes that use them as a property key or value. A node is
+ * stored once for each property that uses a string, so it must be removed as often as it
+ * was inserted.
+ *
+ * Exact lookups are hash lookups. Prefix lookups use a sorted list of all distinct
+ * strings which is only rebuilt when a string is added or removed completely. The list
+ * is rebuilt lazily by the const queries, which may run concurrently, so rebuilding it
+ * is guarded by a mutex. Modifying the index while it is being queried is not allowed.
+ */
+class EntityNodeStringIndex
+{
+private:
+  std::unordered_map<std::string, std::vector<EntityNodeBase*>> m_nodes;
+  mutable std::vector<const std::string*> m_sortedStrings;
+  mutable bool m_sortedStringsValid = true;
+  mutable std::mutex m_sortedStringsMutex;
+
+public:
+  void insert(const std::string& str, EntityNodeBase* node);
+  void remove(const std::string& str, EntityNodeBase* node);
+
+  /**
+   * Appends the nodes stored for the given string to the given vector. Nodes may appear
+   * more than once.
+   */
+  void findExact(const std::string& str, std::vector<EntityNodeBase*>& result) const;
+
+  /**
+   * Appends the nodes stored for every string that starts with the given prefix and
+   * satisfies the given predicate to the given vector. Nodes may appear more than once.
+   */
+  template <typename P>
+  void findWithPrefix(
+    const std::string& prefix,
+    const P& predicate,
+    std::vector<EntityNodeBase*>& result) const;
+
+  /**
+   * Returns all distinct strings in this index in ascending order.
+   */
+  std::vector<std::string> strings() const;
+
+private:
+  const std::vector<const std::string*>& sortedStrings() const;
+};
 
 class EntityNodeIndexQuery
 {
@@ -56,7 +99,10 @@ public:
   static EntityNodeIndexQuery numbered(const std::string& pattern);
   static EntityNodeIndexQuery any();
 
-  std::set<EntityNodeBase*> execute(const EntityNodeStringIndex& index) const;
+  /**
+   * Returns the nodes with a key matching this query, sorted and without duplicates.
+   */
+  std::vector<EntityNodeBase*> execute(const EntityNodeStringIndex& index) const;
   bool execute(const EntityNodeBase* node, const std::string& value) const;
   std::vector<Model::EntityProperty> execute(const EntityNodeBase* node) const;
 
@@ -67,13 +113,10 @@ private:
 class EntityNodeIndex
 {
 private:
-  std::unique_ptr<EntityNodeStringIndex> m_keyIndex;
-  std::unique_ptr<EntityNodeStringIndex> m_valueIndex;
+  EntityNodeStringIndex m_keyIndex;
+  EntityNodeStringIndex m_valueIndex;
 
 public:
-  EntityNodeIndex();
-  ~EntityNodeIndex();
-
   void addEntityNode(EntityNodeBase* node);
   void removeEntityNode(EntityNodeBase* node);
 
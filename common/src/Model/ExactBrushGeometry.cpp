@@ -0,0 +1,547 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ExactBrushGeometry.h"
+
+#include "Model/BrushFace.h"
+#include "Model/Polyhedron.h"
+
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <optional>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+using IntVec = vm::vec<std::int64_t, 3>;
+
+/**
+ * The bounds below guarantee that no intermediate value computed during vertex
+ * construction overflows a 64 bit integer:
+ *
+ * - face normals have components of at most 2^12 after being reduced
+ * - face points have components of at most 2^20, so plane distances are less than 2^34
+ * - numerators of plane intersections are thus at most 6 * 2^34 * 2^24 < 2^61
+ */
+constexpr auto MaxPointComponent = std::int64_t(1) << 20;
+constexpr auto MaxNormalComponent = std::int64_t(1) << 12;
+
+/**
+ * Axis-aligned brushes with more faces than this are rare and are left to the clipping
+ * algorithm.
+ */
+constexpr auto MaxFaceCount = size_t(32);
+
+/**
+ * The number of plane triples to examine grows cubically with the number of faces, and
+ * building the convex hull of the vertices is not cheap either. Beyond this many faces,
+ * clipping is faster.
+ */
+constexpr auto MaxIntegerFaceCount = size_t(6);
+
+/**
+ * Axis-aligned brushes thinner than this would be rejected by edge healing.
+ */
+constexpr auto MinEdgeLength = FloatType(0.01);
+
+struct IntPlane
+{
+  IntVec normal;
+  std::int64_t distance;
+};
+
+std::optional<IntVec> toIntVec(const vm::vec3& v)
+{
+  auto result = IntVec{};
+  for (size_t i = 0; i < 3; ++i)
+  {
+    const auto c = v[i];
+    if (
+      c != std::trunc(c) || c < -FloatType(MaxPointComponent)
+      || c > FloatType(MaxPointComponent))
+    {
+      return std::nullopt;
+    }
+    result[i] = static_cast<std::int64_t>(c);
+  }
+  return result;
+}
+
+vm::vec3 toVec(const IntVec& v)
+{
+  return vm::vec3{FloatType(v.x()), FloatType(v.y()), FloatType(v.z())};
+}
+
+std::optional<IntPlane> makeIntPlane(const BrushFace& face)
+{
+  const auto& points = face.points();
+  const auto p0 = toIntVec(points[0]);
+  const auto p1 = toIntVec(points[1]);
+  const auto p2 = toIntVec(points[2]);
+  if (!p0 || !p1 || !p2)
+  {
+    return std::nullopt;
+  }
+
+  auto normal = vm::cross(*p2 - *p0, *p1 - *p0);
+  const auto divisor = std::gcd(
+    std::gcd(std::abs(normal.x()), std::abs(normal.y())), std::abs(normal.z()));
+  if (divisor == 0)
+  {
+    return std::nullopt;
+  }
+  normal = normal / divisor;
+
+  // don't rely on the winding of the points, the boundary is authoritative
+  if (vm::dot(toVec(normal), face.boundary().normal) < FloatType(0))
+  {
+    normal = -normal;
+  }
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    if (std::abs(normal[i]) > MaxNormalComponent)
+    {
+      return std::nullopt;
+    }
+  }
+
+  return IntPlane{normal, vm::dot(normal, *p0)};
+}
+
+std::optional<std::vector<IntPlane>> makeIntPlanes(const std::vector<BrushFace>& faces)
+{
+  auto result = std::vector<IntPlane>{};
+  result.reserve(faces.size());
+
+  for (const auto& face : faces)
+  {
+    auto plane = makeIntPlane(face);
+    if (!plane)
+    {
+      return std::nullopt;
+    }
+    result.push_back(*plane);
+  }
+
+  return result;
+}
+
+bool isInside(const IntVec& point, const std::vector<IntPlane>& planes)
+{
+  for (const auto& plane : planes)
+  {
+    if (vm::dot(plane.normal, point) > plane.distance)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool mayBeInside(const vm::vec3& point, const std::vector<IntPlane>& planes)
+{
+  constexpr auto epsilon = FloatType(0.5);
+  for (const auto& plane : planes)
+  {
+    if (vm::dot(toVec(plane.normal), point) > FloatType(plane.distance) + epsilon)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isStrictlyInside(const vm::vec3& point, const vm::bbox3& bounds)
+{
+  for (size_t i = 0; i < 3; ++i)
+  {
+    if (point[i] <= bounds.min[i] || point[i] >= bounds.max[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Computes the vertices of the polyhedron bounded by the given planes by intersecting all
+ * triples of planes. Returns nothing if any vertex of the polyhedron is not an integer
+ * point within the supported range.
+ */
+std::optional<std::vector<vm::vec3>> computeIntegerVertices(
+  const std::vector<IntPlane>& planes)
+{
+  auto vertices = std::vector<IntVec>{};
+
+  const auto count = planes.size();
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t j = i + 1; j < count; ++j)
+    {
+      const auto& pi = planes[i];
+      const auto& pj = planes[j];
+      const auto cij = vm::cross(pi.normal, pj.normal);
+      if (cij == IntVec::zero())
+      {
+        continue;
+      }
+
+      for (size_t k = j + 1; k < count; ++k)
+      {
+        const auto& pk = planes[k];
+        const auto det = vm::dot(pk.normal, cij);
+        if (det == 0)
+        {
+          continue;
+        }
+
+        const auto cjk = vm::cross(pj.normal, pk.normal);
+        const auto cki = vm::cross(pk.normal, pi.normal);
+        const auto numerator = pi.distance * cjk + pj.distance * cki + pk.distance * cij;
+
+        if (
+          numerator.x() % det == 0 && numerator.y() % det == 0
+          && numerator.z() % det == 0)
+        {
+          const auto vertex = numerator / det;
+          if (
+            std::abs(vertex.x()) <= MaxPointComponent
+            && std::abs(vertex.y()) <= MaxPointComponent
+            && std::abs(vertex.z()) <= MaxPointComponent)
+          {
+            if (isInside(vertex, planes))
+            {
+              vertices.push_back(vertex);
+            }
+            continue;
+          }
+        }
+
+        // the intersection is not a point we can represent exactly, but we only need it
+        // if it belongs to the polyhedron
+        const auto approximateVertex = toVec(numerator) / FloatType(det);
+        if (mayBeInside(approximateVertex, planes))
+        {
+          return std::nullopt;
+        }
+      }
+    }
+  }
+
+  vertices = kdl::vec_sort_and_remove_duplicates(std::move(vertices));
+  return kdl::vec_transform(vertices, toVec);
+}
+
+std::unique_ptr<BrushGeometry> createIntegerBrushGeometry(
+  const std::vector<BrushFace>& faces,
+  const std::vector<IntPlane>& planes,
+  const vm::bbox3& worldBounds)
+{
+  auto vertices = computeIntegerVertices(planes);
+  if (!vertices || vertices->size() < 4u)
+  {
+    return nullptr;
+  }
+
+  for (const auto& vertex : *vertices)
+  {
+    if (!isStrictlyInside(vertex, worldBounds))
+    {
+      return nullptr;
+    }
+  }
+
+  auto geometry = std::make_unique<BrushGeometry>(std::move(*vertices));
+  if (!geometry->polyhedron() || !geometry->closed())
+  {
+    return nullptr;
+  }
+
+  // Assign each geometry face to the first brush face with the same plane.
+  auto assigned = std::vector<bool>(faces.size(), false);
+  for (auto* faceGeometry : geometry->faces())
+  {
+    const auto faceVertices = kdl::vec_transform(
+      faceGeometry->vertexPositions(), [](const auto& v) { return *toIntVec(v); });
+    const auto normal = faceGeometry->normal();
+
+    auto faceIndex = std::optional<size_t>{};
+    for (size_t i = 0; i < planes.size() && !faceIndex; ++i)
+    {
+      const auto& plane = planes[i];
+      if (
+        vm::dot(toVec(plane.normal), normal) > FloatType(0)
+        && std::all_of(
+          std::begin(faceVertices), std::end(faceVertices), [&](const auto& v) {
+            return vm::dot(plane.normal, v) == plane.distance;
+          }))
+      {
+        faceIndex = i;
+      }
+    }
+
+    if (!faceIndex || assigned[*faceIndex])
+    {
+      return nullptr;
+    }
+
+    assigned[*faceIndex] = true;
+    faceGeometry->setPayload(*faceIndex);
+    faceGeometry->setPlane(faces[*faceIndex].boundary());
+  }
+
+  return geometry;
+}
+
+std::optional<size_t> axisDirection(const vm::vec3& normal)
+{
+  for (size_t i = 0; i < 3; ++i)
+  {
+    if (
+      normal[(i + 1) % 3] == FloatType(0) && normal[(i + 2) % 3] == FloatType(0)
+      && std::abs(normal[i]) == FloatType(1))
+    {
+      return normal[i] > FloatType(0) ? 2 * i : 2 * i + 1;
+    }
+  }
+  return std::nullopt;
+}
+
+/**
+ * Clipping a cuboid with an axis-aligned plane that intersects it always changes its
+ * topology in the same way, regardless of where exactly the plane is. Therefore, the
+ * order of the vertices, edges and faces of an axis-aligned brush built by clipping
+ * depends only on the sequence of directions of the planes that actually clipped it.
+ *
+ * For each such sequence, we clip a template cuboid once and cache the result. The
+ * geometry of a brush is then a copy of the template with the vertices moved to the
+ * brush's bounds, which is identical to the geometry built by clipping the world bounds,
+ * including the order of its elements.
+ */
+class AxisAlignedTemplates
+{
+private:
+  static constexpr auto TemplateSize = FloatType(2 * MaxFaceCount + 2);
+
+  std::mutex m_mutex;
+  std::map<std::vector<size_t>, std::unique_ptr<BrushGeometry>> m_templates;
+
+public:
+  /**
+   * Returns the template for the given sequence of directions. The payload of each face
+   * of the template is the index of the clip that created it.
+   *
+   * A missing template is built without holding the lock, so that threads creating
+   * brushes in parallel do not wait for each other. If two threads build the same
+   * template, the first one to be inserted is kept.
+   */
+  const BrushGeometry& get(const std::vector<size_t>& directions)
+  {
+    {
+      const auto lock = std::lock_guard<std::mutex>{m_mutex};
+      if (const auto it = m_templates.find(directions); it != m_templates.end())
+      {
+        return *it->second;
+      }
+    }
+
+    auto geometry = buildTemplate(directions);
+
+    const auto lock = std::lock_guard<std::mutex>{m_mutex};
+    auto& result = m_templates[directions];
+    if (!result)
+    {
+      result = std::move(geometry);
+    }
+    return *result;
+  }
+
+private:
+  static std::unique_ptr<BrushGeometry> buildTemplate(
+    const std::vector<size_t>& directions)
+  {
+    auto result = std::make_unique<BrushGeometry>(vm::bbox3{TemplateSize});
+
+    // each clip in the same direction must be tighter than the previous one
+    auto clipCounts = std::array<size_t, 6>{};
+    for (size_t i = 0; i < directions.size(); ++i)
+    {
+      const auto direction = directions[i];
+      const auto axis = direction / 2;
+      const auto sign = direction % 2 == 0 ? FloatType(1) : FloatType(-1);
+
+      auto normal = vm::vec3::zero();
+      normal[axis] = sign;
+      const auto distance = TemplateSize / 2 - FloatType(clipCounts[direction]++);
+
+      const auto clipResult = result->clip(vm::plane3{distance, normal});
+      assert(clipResult.success());
+      clipResult.face()->setPayload(i);
+    }
+
+    return result;
+  }
+};
+
+AxisAlignedTemplates& axisAlignedTemplates()
+{
+  static auto templates = AxisAlignedTemplates{};
+  return templates;
+}
+
+class CopyAxisAlignedTemplate : public BrushGeometry::CopyCallback
+{
+private:
+  const std::vector<BrushFace>& m_faces;
+  const std::vector<size_t>& m_clipFaces;
+  const vm::bbox3& m_bounds;
+
+public:
+  CopyAxisAlignedTemplate(
+    const std::vector<BrushFace>& faces,
+    const std::vector<size_t>& clipFaces,
+    const vm::bbox3& bounds)
+    : m_faces{faces}
+    , m_clipFaces{clipFaces}
+    , m_bounds{bounds}
+  {
+  }
+
+  void vertexWasCopied(const BrushVertex* original, BrushVertex* copy) const override
+  {
+    const auto& position = original->position();
+    copy->setPosition(vm::vec3{
+      position.x() > FloatType(0) ? m_bounds.max.x() : m_bounds.min.x(),
+      position.y() > FloatType(0) ? m_bounds.max.y() : m_bounds.min.y(),
+      position.z() > FloatType(0) ? m_bounds.max.z() : m_bounds.min.z()});
+  }
+
+  void faceWasCopied(const BrushFaceGeometry* original, BrushFaceGeometry* copy) const
+    override
+  {
+    const auto faceIndex = m_clipFaces[*original->payload()];
+    copy->setPayload(faceIndex);
+    copy->setPlane(m_faces[faceIndex].boundary());
+  }
+};
+
+std::unique_ptr<BrushGeometry> createAxisAlignedBrushGeometry(
+  const std::vector<BrushFace>& faces, const vm::bbox3& worldBounds)
+{
+  // Determine which faces would clip the brush, in order. A face does not clip it if the
+  // brush already has a face with the same direction that is at least as tight.
+  auto directions = std::vector<size_t>{};
+  auto clipFaces = std::vector<size_t>{};
+  auto faceForDirection = std::array<std::optional<size_t>, 6>{};
+  for (size_t i = 0; i < faces.size(); ++i)
+  {
+    const auto& boundary = faces[i].boundary();
+    const auto direction = axisDirection(boundary.normal);
+    if (!direction)
+    {
+      return nullptr;
+    }
+
+    auto& current = faceForDirection[*direction];
+    if (
+      !current
+      || boundary.distance < faces[*current].boundary().distance
+                               - vm::constants<FloatType>::point_status_epsilon())
+    {
+      current = i;
+      directions.push_back(*direction);
+      clipFaces.push_back(i);
+    }
+  }
+
+  auto bounds = vm::bbox3{};
+  for (size_t i = 0; i < 3; ++i)
+  {
+    const auto& maxFace = faceForDirection[2 * i];
+    const auto& minFace = faceForDirection[2 * i + 1];
+    if (!maxFace || !minFace)
+    {
+      return nullptr;
+    }
+
+    bounds.max[i] = vm::correct(faces[*maxFace].boundary().distance);
+    bounds.min[i] = vm::correct(-faces[*minFace].boundary().distance);
+    if (bounds.max[i] - bounds.min[i] < MinEdgeLength)
+    {
+      return nullptr;
+    }
+  }
+
+  if (
+    !isStrictlyInside(bounds.min, worldBounds)
+    || !isStrictlyInside(bounds.max, worldBounds))
+  {
+    return nullptr;
+  }
+
+  return std::make_unique<BrushGeometry>(
+    axisAlignedTemplates().get(directions),
+    CopyAxisAlignedTemplate{faces, clipFaces, bounds});
+}
+
+} // namespace
+
+std::unique_ptr<BrushGeometry> createExactBrushGeometry(
+  const std::vector<BrushFace>& faces, const vm::bbox3& worldBounds)
+{
+  if (faces.size() < 4u || faces.size() > MaxFaceCount)
+  {
+    return nullptr;
+  }
+
+  if (std::all_of(std::begin(faces), std::end(faces), [](const auto& face) {
+        return axisDirection(face.boundary().normal).has_value();
+      }))
+  {
+    return createAxisAlignedBrushGeometry(faces, worldBounds);
+  }
+
+  if (faces.size() > MaxIntegerFaceCount)
+  {
+    return nullptr;
+  }
+
+  if (const auto planes = makeIntPlanes(faces))
+  {
+    return createIntegerBrushGeometry(faces, *planes, worldBounds);
+  }
+
+  return nullptr;
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,60 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+#include "Model/BrushGeometry.h"
+
+#include <vecmath/forward.h>
+
+#include <memory>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+class BrushFace;
+
+/**
+ * Builds the geometry of a brush directly from its faces if all faces are axis-aligned or
+ * if the brush has at most six faces and all face points are integer points. Integer
+ * brushes are built using exact integer arithmetic, so no vertex correction or edge
+ * healing is required.
+ *
+ * Axis-aligned brushes are copied from a cached template that was built by clipping, so
+ * their vertices, edges and faces are in the same order as if the brush had been built by
+ * clipping. The geometry of other integer brushes is the convex hull of their vertices,
+ * which enumerates the same vertices and faces in a different order.
+ *
+ * The payload of each face of the returned geometry is set to the index of the brush face
+ * that it belongs to. Brush faces which do not contribute to the geometry are not
+ * assigned to any geometry face, just like when the geometry is built by clipping.
+ *
+ * Returns null if the given faces are not eligible, or if they do not form a valid closed
+ * polyhedron that lies strictly within the given world bounds. In that case, the caller
+ * must fall back to building the geometry by clipping, which also reports the error.
+ *
+ * @param faces the brush faces, expected to be sorted by BrushFace::sortFaces
+ * @param worldBounds the world bounds
+ * @return the brush geometry or null
+ */
+std::unique_ptr<BrushGeometry> createExactBrushGeometry(
+  const std::vector<BrushFace>& faces, const vm::bbox3& worldBounds);
+
+} // namespace TrenchBroom::Model
@@ -20,6 +20,7 @@
 #include "Game.h"
 
 #include "Assets/EntityDefinitionFileSpec.h"
+#include "Assets/TextureCollection.h"
 #include "Error.h"
 #include "IO/ExportOptions.h"
 #include "Model/BrushFace.h"
@@ -151,6 +152,11 @@ void Game::loadTextureCollections(Assets::TextureManager& textureManager) const
   doLoadTextureCollections(textureManager);
 }
 
+std::vector<Assets::TextureCollection> Game::loadTextureCollections(Logger& logger) const
+{
+  return doLoadTextureCollections(logger);
+}
+
 const std::optional<std::string>& Game::wadProperty() const
 {
   return doGetWadProperty();
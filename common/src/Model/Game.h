@@ -46,6 +46,7 @@ class Logger;
 namespace TrenchBroom::Assets
 {
 class EntityDefinitionFileSpec;
+class TextureCollection;
 class TextureManager;
 } // namespace TrenchBroom::Assets
 
@@ -136,6 +137,13 @@ public: // parsing and serializing objects
 public: // texture collection handling
   void loadTextureCollections(Assets::TextureManager& textureManagerr) const;
 
+  /**
+   * Loads the texture collections without adding them to a texture manager. This can be
+   * called on a worker thread as long as the game's file system is not modified
+   * concurrently, e.g. by reloading wads or changing the search paths.
+   */
+  std::vector<Assets::TextureCollection> loadTextureCollections(Logger& logger) const;
+
   const std::optional<std::string>& wadProperty() const;
   void reloadWads(
     const std::filesystem::path& documentPath,
@@ -211,6 +219,8 @@ private: // subclassing interface
     std::ostream& stream) const = 0;
 
   virtual void doLoadTextureCollections(Assets::TextureManager& textureManager) const = 0;
+  virtual std::vector<Assets::TextureCollection> doLoadTextureCollections(
+    Logger& logger) const = 0;
   virtual const std::optional<std::string>& doGetWadProperty() const = 0;
   virtual void doReloadWads(
     const std::filesystem::path& documentPath,
@@ -23,6 +23,7 @@
 #include "Assets/EntityDefinitionFileSpec.h"
 #include "Assets/EntityModel.h"
 #include "Assets/Palette.h"
+#include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
 #include "Ensure.h"
 #include "Error.h"
@@ -36,6 +37,7 @@
 #include "IO/DiskIO.h"
 #include "IO/DkmParser.h"
 #include "IO/EntParser.h"
+#include "IO/EntityDefinitionCache.h"
 #include "IO/ExportOptions.h"
 #include "IO/FgdParser.h"
 #include "IO/File.h"
@@ -50,6 +52,7 @@
 #include "IO/NodeWriter.h"
 #include "IO/ObjSerializer.h"
 #include "IO/PathInfo.h"
+#include "IO/RecordingParserStatus.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/SprParser.h"
 #include "IO/SystemPaths.h"
@@ -75,8 +78,11 @@
 
 #include <vecmath/vec_io.h>
 
+#include <fmt/format.h>
+
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace TrenchBroom::Model
@@ -326,6 +332,12 @@ void GameImpl::doLoadTextureCollections(Assets::TextureManager& textureManager)
   textureManager.reload(m_fs, m_config.textureConfig);
 }
 
+std::vector<Assets::TextureCollection> GameImpl::doLoadTextureCollections(
+  Logger& logger) const
+{
+  return IO::loadTextureCollections(m_fs, m_config.textureConfig, logger);
+}
+
 const std::optional<std::string>& GameImpl::doGetWadProperty() const
 {
   return m_config.textureConfig.property;
@@ -409,38 +421,72 @@ std::filesystem::path GameImpl::doFindEntityDefinitionFile(
   return IO::Disk::resolvePath(searchPaths, path);
 }
 
+namespace
+{
+IO::EntityDefinitionCache& entityDefinitionCache()
+{
+  static auto cache = IO::EntityDefinitionCache{};
+  return cache;
+}
+
+std::vector<std::unique_ptr<Assets::EntityDefinition>> parseEntityDefinitions(
+  IO::EntityDefinitionParser& parser,
+  IO::ParserStatus& status,
+  const std::filesystem::path& path,
+  const std::string_view contents,
+  const Color& defaultColor)
+{
+  auto recordingStatus = IO::RecordingParserStatus{status};
+  auto classInfos = parser.parseResolvedClassInfos(recordingStatus);
+  auto definitions = IO::createDefinitions(classInfos, defaultColor);
+  entityDefinitionCache().insert(
+    path,
+    contents,
+    parser.includedFiles(),
+    std::move(classInfos),
+    recordingStatus.messages());
+  return definitions;
+}
+} // namespace
+
 Result<std::vector<std::unique_ptr<Assets::EntityDefinition>>> GameImpl::
   loadEntityDefinitions(IO::ParserStatus& status, const std::filesystem::path& path) const
 {
   const auto extension = path.extension().string();
   const auto& defaultColor = m_config.entityConfig.defaultColor;
 
-  if (kdl::ci::str_is_equal(".fgd", extension))
-  {
-    return IO::Disk::openFile(path).transform([&](auto file) {
-      auto reader = file->reader().buffer();
-      auto parser = IO::FgdParser{reader.stringView(), defaultColor, path};
-      return parser.parseDefinitions(status);
-    });
-  }
-  if (kdl::ci::str_is_equal(".def", extension))
+  const auto isFgd = kdl::ci::str_is_equal(".fgd", extension);
+  const auto isDef = kdl::ci::str_is_equal(".def", extension);
+  const auto isEnt = kdl::ci::str_is_equal(".ent", extension);
+  if (!isFgd && !isDef && !isEnt)
   {
-    return IO::Disk::openFile(path).transform([&](auto file) {
-      auto reader = file->reader().buffer();
-      auto parser = IO::DefParser{reader.stringView(), defaultColor};
-      return parser.parseDefinitions(status);
-    });
-  }
-  if (kdl::ci::str_is_equal(".ent", extension))
-  {
-    return IO::Disk::openFile(path).transform([&](auto file) {
-      auto reader = file->reader().buffer();
-      auto parser = IO::EntParser{reader.stringView(), defaultColor};
-      return parser.parseDefinitions(status);
-    });
+    return Error{"Unknown entity definition format: '" + path.string() + "'"};
   }
 
-  return Error{"Unknown entity definition format: '" + path.string() + "'"};
+  return IO::Disk::openFile(path).transform([&](auto file) {
+    auto reader = file->reader().buffer();
+    const auto contents = reader.stringView();
+
+    if (auto classInfos = entityDefinitionCache().find(path, contents, status))
+    {
+      status.debug(
+        fmt::format("Using cached entity definitions for '{}'", path.string()));
+      return IO::createDefinitions(*classInfos, defaultColor);
+    }
+
+    if (isFgd)
+    {
+      auto parser = IO::FgdParser{contents, defaultColor, path};
+      return parseEntityDefinitions(parser, status, path, contents, defaultColor);
+    }
+    if (isDef)
+    {
+      auto parser = IO::DefParser{contents, defaultColor};
+      return parseEntityDefinitions(parser, status, path, contents, defaultColor);
+    }
+    auto parser = IO::EntParser{contents, defaultColor};
+    return parseEntityDefinitions(parser, status, path, contents, defaultColor);
+  });
 }
 
 std::unique_ptr<Assets::EntityModel> GameImpl::doInitializeModel(
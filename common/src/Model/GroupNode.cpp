@@ -48,6 +48,8 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom::Model
@@ -122,6 +124,99 @@ bool GroupNode::hasPendingChanges() const
 void GroupNode::setHasPendingChanges(const bool hasPendingChanges)
 {
   m_hasPendingChanges = hasPendingChanges;
+  m_pendingChanges = m_hasPendingChanges
+                       ? std::nullopt
+                       : std::optional<std::vector<PendingChange>>{std::in_place};
+}
+
+const std::optional<std::vector<PendingChange>>& GroupNode::pendingChanges() const
+{
+  return m_pendingChanges;
+}
+
+namespace
+{
+bool isAnyOrDescendantOfAny(
+  const Node* node, const std::unordered_set<const Node*>& ancestors)
+{
+  for (; node; node = node->parent())
+  {
+    if (ancestors.count(node) > 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Discards the recorded changes to the given nodes and their descendants. Returns the
+ * nodes whose additions were discarded.
+ */
+std::unordered_set<const Node*> discardChanges(
+  std::vector<PendingChange>& pendingChanges,
+  const std::unordered_set<const Node*>& removedNodes)
+{
+  auto discardedAdditions = std::unordered_set<const Node*>{};
+  const auto isDiscarded = [&](const auto& pendingChange) {
+    return std::visit(
+      kdl::overload(
+        [&](const NodeContentsChange& change) {
+          return isAnyOrDescendantOfAny(change.node, removedNodes);
+        },
+        [&](const NodeAddition& change) {
+          if (removedNodes.count(change.node) > 0)
+          {
+            discardedAdditions.insert(change.node);
+            return true;
+          }
+          return isAnyOrDescendantOfAny(change.parent, removedNodes);
+        },
+        [&](const NodeRemoval& change) {
+          return isAnyOrDescendantOfAny(change.parent, removedNodes);
+        }),
+      pendingChange);
+  };
+
+  pendingChanges = kdl::vec_erase_if(std::move(pendingChanges), isDiscarded);
+  return discardedAdditions;
+}
+} // namespace
+
+void GroupNode::addPendingChanges(std::vector<PendingChange> changes)
+{
+  m_hasPendingChanges = true;
+  if (!m_pendingChanges)
+  {
+    return;
+  }
+
+  auto removedNodes = std::unordered_set<const Node*>{};
+  for (const auto& change : changes)
+  {
+    if (const auto* removal = std::get_if<NodeRemoval>(&change))
+    {
+      removedNodes.insert(removal->node);
+    }
+  }
+
+  if (!removedNodes.empty())
+  {
+    const auto discardedAdditions = discardChanges(*m_pendingChanges, removedNodes);
+    changes = kdl::vec_erase_if(std::move(changes), [&](const auto& change) {
+      const auto* removal = std::get_if<NodeRemoval>(&change);
+      return removal && discardedAdditions.count(removal->node) > 0;
+    });
+  }
+
+  m_pendingChanges = kdl::vec_concat(std::move(*m_pendingChanges), std::move(changes));
+}
+
+void GroupNode::setPendingChanges(
+  std::optional<std::vector<PendingChange>> pendingChanges)
+{
+  m_hasPendingChanges = true;
+  m_pendingChanges = std::move(pendingChanges);
 }
 
 void GroupNode::setEditState(const EditState editState)
@@ -33,11 +33,41 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom::Model
 {
 
+/**
+ * The contents of the given node have changed.
+ */
+struct NodeContentsChange
+{
+  Node* node;
+};
+
+/**
+ * The given node was added to the given parent.
+ */
+struct NodeAddition
+{
+  Node* parent;
+  Node* node;
+};
+
+/**
+ * The given node with the given link ID was removed from the given parent.
+ */
+struct NodeRemoval
+{
+  Node* parent;
+  Node* node;
+  std::string linkId;
+};
+
+using PendingChange = std::variant<NodeContentsChange, NodeAddition, NodeRemoval>;
+
 /**
  * A group of nodes that can be edited as one.
  *
@@ -70,6 +100,15 @@ private:
 
   bool m_hasPendingChanges = false;
 
+  /**
+   * The changes to the descendants of this group since its pending changes were last
+   * propagated to its linked groups, in the order in which they were made. If this is
+   * std::nullopt, then at least one change was not recorded and the entire group must be
+   * propagated.
+   */
+  std::optional<std::vector<PendingChange>> m_pendingChanges =
+    std::vector<PendingChange>{};
+
 public:
   explicit GroupNode(Group group);
 
@@ -89,6 +128,29 @@ public:
   bool hasPendingChanges() const;
   void setHasPendingChanges(bool hasPendingChanges);
 
+  /**
+   * Returns the recorded pending changes of this group, or std::nullopt if any of its
+   * pending changes was not recorded.
+   */
+  const std::optional<std::vector<PendingChange>>& pendingChanges() const;
+
+  /**
+   * Marks this group as having pending changes and records the given changes.
+   *
+   * Recording the removal of a node discards the recorded changes to that node and its
+   * descendants. If the node was added since the pending changes were last propagated,
+   * then its addition and removal cancel out and the removal is not recorded.
+   *
+   * Removals must be recorded before the nodes are actually removed.
+   */
+  void addPendingChanges(std::vector<PendingChange> changes);
+
+  /**
+   * Marks this group as having pending changes and replaces its recorded changes with the
+   * given changes, e.g. to restore them when a transaction is rolled back.
+   */
+  void setPendingChanges(std::optional<std::vector<PendingChange>> pendingChanges);
+
 private:
   void setEditState(EditState editState);
   void setAncestorEditState(EditState editState);
@@ -33,8 +33,14 @@
 #include <kdl/result_fold.h>
 #include <kdl/zip_iterator.h>
 
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <variant>
 
 namespace TrenchBroom::Model
 {
@@ -258,14 +264,17 @@ Result<std::unique_ptr<Node>> cloneAndTransformRecursive(
 }
 
 /**
- * Given a node, clones its children recursively and applies the given transform.
+ * Given some nodes, clones them recursively and applies the given transform.
  *
- * Returns a vector of the cloned direct children of `node`.
+ * Returns a vector of the clones of `nodes`.
  */
-Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
-  const Node& node, const vm::bbox3& worldBounds, const vm::mat4x4& transformation)
+Result<std::vector<std::unique_ptr<Node>>> cloneAndTransform(
+  const std::vector<const Node*>& nodes,
+  const vm::bbox3& worldBounds,
+  const vm::mat4x4& transformation)
 {
-  auto nodesToClone = collectDescendants(std::vector{&node});
+  auto nodesToClone =
+    kdl::vec_concat(nodes, kdl::vec_static_cast<const Node*>(collectDescendants(nodes)));
 
   using TransformResult = Result<std::pair<const Node*, NodeContents>>;
 
@@ -321,12 +330,24 @@ Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
         // creating a matching tree structure, and move in the contents
         // we've transformed above.
         return kdl::fold_results(
-          kdl::vec_transform(node.children(), [&](const auto* childNode) {
-            return cloneAndTransformRecursive(childNode, resultsMap, worldBounds);
+          kdl::vec_transform(nodes, [&](const auto* nodeToClone) {
+            return cloneAndTransformRecursive(nodeToClone, resultsMap, worldBounds);
           }));
       });
 }
 
+/**
+ * Given a node, clones its children recursively and applies the given transform.
+ *
+ * Returns a vector of the cloned direct children of `node`.
+ */
+Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
+  const Node& node, const vm::bbox3& worldBounds, const vm::mat4x4& transformation)
+{
+  return cloneAndTransform(
+    kdl::vec_static_cast<const Node*>(node.children()), worldBounds, transformation);
+}
+
 auto makeLinkIdToNodeMap(const std::vector<Node*>& nodes)
 {
   auto result = std::unordered_map<std::string_view, const Node*>{};
@@ -396,24 +417,15 @@ void preserveGroupNames(
 }
 
 void preserveEntityProperties(
-  EntityNode& clonedEntityNode, const EntityNode& correspondingEntityNode)
+  Entity& clonedEntity,
+  const EntityPropertyConfig& entityPropertyConfig,
+  const Entity& correspondingEntity)
 {
-  if (
-    clonedEntityNode.entity().protectedProperties().empty()
-    && correspondingEntityNode.entity().protectedProperties().empty())
-  {
-    return;
-  }
-
-  auto clonedEntity = clonedEntityNode.entity();
-  const auto& correspondingEntity = correspondingEntityNode.entity();
-
   const auto allProtectedProperties = kdl::vec_sort_and_remove_duplicates(kdl::vec_concat(
     clonedEntity.protectedProperties(), correspondingEntity.protectedProperties()));
 
   clonedEntity.setProtectedProperties(correspondingEntity.protectedProperties());
 
-  const auto entityPropertyConfig = clonedEntityNode.entityPropertyConfig();
   for (const auto& propertyKey : allProtectedProperties)
   {
     // this can change the order of properties
@@ -423,7 +435,23 @@ void preserveEntityProperties(
       clonedEntity.addOrUpdateProperty(entityPropertyConfig, propertyKey, *propertyValue);
     }
   }
+}
+
+void preserveEntityProperties(
+  EntityNode& clonedEntityNode, const EntityNode& correspondingEntityNode)
+{
+  if (
+    clonedEntityNode.entity().protectedProperties().empty()
+    && correspondingEntityNode.entity().protectedProperties().empty())
+  {
+    return;
+  }
 
+  auto clonedEntity = clonedEntityNode.entity();
+  preserveEntityProperties(
+    clonedEntity,
+    clonedEntityNode.entityPropertyConfig(),
+    correspondingEntityNode.entity());
   clonedEntityNode.setEntity(std::move(clonedEntity));
 }
 
@@ -455,6 +483,279 @@ void preserveEntityProperties(
       [](const BrushNode*) {},
       [](const PatchNode*) {}));
 }
+
+/**
+ * Returns the first child of the given node with the given link ID that is not one of the
+ * given ignored children, or nullptr if there is none.
+ */
+Node* findChildWithLinkId(
+  const Node& node,
+  const std::string_view linkId,
+  const std::unordered_set<const Node*>& ignoredChildren = {})
+{
+  const auto& children = node.children();
+  const auto it = std::find_if(children.begin(), children.end(), [&](const auto* child) {
+    return ignoredChildren.count(child) == 0 && getLinkId(*child) == linkId;
+  });
+  return it != children.end() ? *it : nullptr;
+}
+
+/**
+ * Returns the child of the given target node that corresponds to the given child of the
+ * given source node, or nullptr if there is none. Since linked groups usually have the
+ * same structure, the target child at the position of the source child is checked first.
+ */
+Node* findCorrespondingChild(
+  const Node& sourceNode, const Node& sourceChild, const Node& targetNode)
+{
+  const auto& sourceChildren = sourceNode.children();
+  const auto& targetChildren = targetNode.children();
+
+  const auto linkId = getLinkId(sourceChild);
+  const auto index = size_t(std::distance(
+    sourceChildren.begin(),
+    std::find(sourceChildren.begin(), sourceChildren.end(), &sourceChild)));
+  if (index < targetChildren.size() && getLinkId(*targetChildren[index]) == linkId)
+  {
+    return targetChildren[index];
+  }
+
+  return findChildWithLinkId(targetNode, linkId);
+}
+
+/**
+ * Returns the node in the given target group node that corresponds to the given source
+ * node by following the path from the source group node to the source node.
+ *
+ * Returns nullptr if the source node is not a descendant of the source group node or if
+ * any node on the path has no corresponding node in the target group node.
+ */
+Node* findCorrespondingNode(
+  const GroupNode& sourceGroupNode, const Node& sourceNode, GroupNode& targetGroupNode)
+{
+  auto path = std::vector<const Node*>{};
+  for (const auto* node = &sourceNode; node != &sourceGroupNode; node = node->parent())
+  {
+    if (!node)
+    {
+      return nullptr;
+    }
+    path.push_back(node);
+  }
+
+  Node* targetNode = &targetGroupNode;
+  const Node* sourceParent = &sourceGroupNode;
+  for (auto it = path.rbegin(); it != path.rend() && targetNode; ++it)
+  {
+    targetNode = findCorrespondingChild(*sourceParent, **it, *targetNode);
+    sourceParent = *it;
+  }
+  return targetNode;
+}
+
+/**
+ * Transforms the contents of the given source node into its corresponding target node in
+ * the same way as cloneAndTransformChildren would, and preserves the group names and
+ * protected entity properties of the target node.
+ */
+Result<NodeContents> transformNodeContents(
+  const Node& sourceNode,
+  const Node& targetNode,
+  const vm::bbox3& worldBounds,
+  const vm::mat4x4& transformation)
+{
+  const auto checkBounds = [&](const vm::bbox3& bounds) -> Result<void> {
+    if (!worldBounds.contains(bounds))
+    {
+      return Error{"Updating a linked node would exceed world bounds"};
+    }
+    return kdl::void_success;
+  };
+
+  return sourceNode.accept(kdl::overload(
+    [](const WorldNode*) -> Result<NodeContents> {
+      ensure(false, "Linked group structure is valid");
+    },
+    [](const LayerNode*) -> Result<NodeContents> {
+      ensure(false, "Linked group structure is valid");
+    },
+    [&](const GroupNode* groupNode) -> Result<NodeContents> {
+      auto group = groupNode->group();
+      group.transform(transformation);
+      group.setName(static_cast<const GroupNode&>(targetNode).group().name());
+      return NodeContents{std::move(group)};
+    },
+    [&](const EntityNode* entityNode) -> Result<NodeContents> {
+      const auto& targetEntity = static_cast<const EntityNode&>(targetNode).entity();
+
+      auto entity = entityNode->entity();
+      entity.transform(entityNode->entityPropertyConfig(), transformation);
+      if (
+        !entity.protectedProperties().empty()
+        || !targetEntity.protectedProperties().empty())
+      {
+        preserveEntityProperties(
+          entity, entityNode->entityPropertyConfig(), targetEntity);
+      }
+
+      // use the bounds of a new entity node, like cloneAndTransformRecursive does
+      return checkBounds(EntityNode{entity}.logicalBounds()).transform([&]() {
+        return NodeContents{std::move(entity)};
+      });
+    },
+    [&](const BrushNode* brushNode) -> Result<NodeContents> {
+      auto brush = brushNode->brush();
+      return brush.transform(worldBounds, transformation, true)
+        .or_else([](const auto&) -> Result<void> {
+          return Error{"Failed to transform a linked node"};
+        })
+        .and_then([&]() { return checkBounds(brush.bounds()); })
+        .transform([&]() { return NodeContents{std::move(brush)}; });
+    },
+    [&](const PatchNode* patchNode) -> Result<NodeContents> {
+      auto patch = patchNode->patch();
+      patch.transform(transformation);
+      return checkBounds(patch.bounds()).transform([&]() {
+        return NodeContents{std::move(patch)};
+      });
+    }));
+}
+
+/**
+ * Replays the given changes of the given source group node in the given target group
+ * node. Returns std::nullopt if the changes cannot be replayed.
+ */
+Result<std::optional<UpdateLinkedNodesResult>> updateLinkedNodes(
+  const GroupNode& sourceGroupNode,
+  const std::vector<PendingChange>& changes,
+  GroupNode& targetGroupNode,
+  const vm::bbox3& worldBounds,
+  const vm::mat4x4& transformation)
+{
+  auto result = UpdateLinkedNodesResult{};
+
+  auto addedSourceNodes = std::unordered_set<const Node*>{};
+  auto updatedSourceNodes = std::unordered_set<const Node*>{};
+  auto removedTargetNodes = std::unordered_set<const Node*>{};
+
+  // nodes that are moved within the group are removed and added again, so the group names
+  // and protected entity properties of the added nodes are taken from the removed nodes
+  auto removedTargetNodesByLinkId = std::unordered_map<std::string_view, const Node*>{};
+
+  // the added nodes are cloned with all of their descendants, so changes to them are
+  // already accounted for
+  const auto isAddedOrDescendantOfAdded = [&](const Node* node) {
+    for (; node && node != &sourceGroupNode; node = node->parent())
+    {
+      if (addedSourceNodes.count(node) > 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // replays a change and returns false if it cannot be replayed
+  const auto replayChange = [&](const PendingChange& change) {
+    return std::visit(
+      kdl::overload(
+        [&](const NodeContentsChange& contentsChange) -> Result<bool> {
+          const auto* sourceNode = contentsChange.node;
+          if (
+            isAddedOrDescendantOfAdded(sourceNode)
+            || !updatedSourceNodes.insert(sourceNode).second)
+          {
+            return true;
+          }
+
+          auto* targetNode =
+            findCorrespondingNode(sourceGroupNode, *sourceNode, targetGroupNode);
+          if (!targetNode)
+          {
+            return false;
+          }
+
+          return transformNodeContents(
+                   *sourceNode, *targetNode, worldBounds, transformation)
+            .transform([&](auto contents) {
+              result.nodesToUpdate.emplace_back(targetNode, std::move(contents));
+              return true;
+            });
+        },
+        [&](const NodeAddition& addition) -> Result<bool> {
+          if (isAddedOrDescendantOfAdded(addition.parent))
+          {
+            return true;
+          }
+
+          auto* targetParent =
+            addition.node->parent() == addition.parent
+              ? findCorrespondingNode(sourceGroupNode, *addition.parent, targetGroupNode)
+              : nullptr;
+          if (
+            !targetParent
+            || findChildWithLinkId(
+              *targetParent, getLinkId(*addition.node), removedTargetNodes))
+          {
+            return false;
+          }
+
+          return cloneAndTransform({addition.node}, worldBounds, transformation)
+            .transform([&](auto clones) {
+              addedSourceNodes.insert(addition.node);
+              result.nodesToAdd.emplace_back(targetParent, std::move(clones.front()));
+              return true;
+            });
+        },
+        [&](const NodeRemoval& removal) -> Result<bool> {
+          if (isAddedOrDescendantOfAdded(removal.parent))
+          {
+            return true;
+          }
+
+          auto* targetParent =
+            findCorrespondingNode(sourceGroupNode, *removal.parent, targetGroupNode);
+          auto* targetNode =
+            targetParent
+              ? findChildWithLinkId(*targetParent, removal.linkId, removedTargetNodes)
+              : nullptr;
+          if (!targetNode)
+          {
+            return false;
+          }
+
+          removedTargetNodes.insert(targetNode);
+          removedTargetNodesByLinkId.merge(makeLinkIdToNodeMap({targetNode}));
+          result.nodesToRemove.emplace_back(targetParent, targetNode);
+          return true;
+        }),
+      change);
+  };
+
+  auto replayed = Result<bool>{true};
+  for (const auto& change : changes)
+  {
+    replayed = std::move(replayed).and_then([&](const bool replayedPrevious) {
+      return replayedPrevious ? replayChange(change) : Result<bool>{false};
+    });
+  }
+
+  return std::move(replayed).transform(
+    [&](const bool replayedAll) -> std::optional<UpdateLinkedNodesResult> {
+      if (!replayedAll)
+      {
+        return std::nullopt;
+      }
+
+      const auto addedTargetNodes = kdl::vec_transform(
+        result.nodesToAdd, [](const auto& p) { return p.second.get(); });
+      preserveGroupNames(addedTargetNodes, removedTargetNodesByLinkId);
+      preserveEntityProperties(addedTargetNodes, removedTargetNodesByLinkId);
+
+      return std::move(result);
+    });
+}
+
 } // namespace
 
 Result<UpdateLinkedGroupsResult> updateLinkedGroups(
@@ -470,13 +771,14 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
     return Error{"Group transformation is not invertible"};
   }
 
-  const auto _invertedSourceTransformation = invertedSourceTransformation;
   const auto targetGroupNodesToUpdate =
     kdl::vec_erase(targetGroupNodes, &sourceGroupNode);
-  return kdl::fold_results(
-    kdl::vec_transform(targetGroupNodesToUpdate, [&](auto* targetGroupNode) {
+  return kdl::fold_results(kdl::vec_transform(
+    targetGroupNodesToUpdate,
+    [&, invertedSourceTransformation = invertedSourceTransformation](
+      auto* targetGroupNode) {
       const auto transformation =
-        targetGroupNode->group().transformation() * _invertedSourceTransformation;
+        targetGroupNode->group().transformation() * invertedSourceTransformation;
       return cloneAndTransformChildren(sourceGroupNode, worldBounds, transformation)
         .transform([&](auto newChildren) {
           const auto linkIdToNodeMap = makeLinkIdToNodeMap(targetGroupNode->children());
@@ -487,6 +789,55 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
     }));
 }
 
+Result<std::optional<UpdateLinkedNodesResult>> updateLinkedNodes(
+  const GroupNode& sourceGroupNode,
+  const std::vector<PendingChange>& changes,
+  const std::vector<GroupNode*>& targetGroupNodes,
+  const vm::bbox3& worldBounds)
+{
+  const auto& sourceGroup = sourceGroupNode.group();
+  const auto [success, invertedSourceTransformation] =
+    vm::invert(sourceGroup.transformation());
+  if (!success)
+  {
+    return Error{"Group transformation is not invertible"};
+  }
+
+  auto targetResults = kdl::vec_parallel_transform(
+    kdl::vec_erase(targetGroupNodes, &sourceGroupNode),
+    [&, invertedSourceTransformation = invertedSourceTransformation](
+      GroupNode* targetGroupNode) {
+      const auto transformation =
+        targetGroupNode->group().transformation() * invertedSourceTransformation;
+      return updateLinkedNodes(
+        sourceGroupNode, changes, *targetGroupNode, worldBounds, transformation);
+    });
+
+  return kdl::fold_results(std::move(targetResults)).transform([](auto targetUpdates) {
+    return mergeLinkedNodeUpdates(std::move(targetUpdates));
+  });
+}
+
+std::optional<UpdateLinkedNodesResult> mergeLinkedNodeUpdates(
+  std::vector<std::optional<UpdateLinkedNodesResult>> updates)
+{
+  auto result = UpdateLinkedNodesResult{};
+  for (auto& update : updates)
+  {
+    if (!update)
+    {
+      return std::nullopt;
+    }
+    result.nodesToRemove =
+      kdl::vec_concat(std::move(result.nodesToRemove), std::move(update->nodesToRemove));
+    result.nodesToAdd =
+      kdl::vec_concat(std::move(result.nodesToAdd), std::move(update->nodesToAdd));
+    result.nodesToUpdate =
+      kdl::vec_concat(std::move(result.nodesToUpdate), std::move(update->nodesToUpdate));
+  }
+  return result;
+}
+
 namespace
 {
 
@@ -666,6 +1017,81 @@ void setLinkIds(
 
 } // namespace
 
+std::optional<std::vector<PendingChange>> collectPendingChanges(
+  const GroupNode& groupNode)
+{
+  auto result = groupNode.pendingChanges();
+
+  // the changes of nested groups that were added are accounted for by their addition
+  auto addedNodes = std::unordered_set<const Node*>{};
+  if (result)
+  {
+    for (const auto& change : *result)
+    {
+      if (const auto* addition = std::get_if<NodeAddition>(&change))
+      {
+        addedNodes.insert(addition->node);
+      }
+    }
+  }
+
+  const auto isAddedOrDescendantOfAdded = [&](const Node* node) {
+    for (; node && node != &groupNode; node = node->parent())
+    {
+      if (addedNodes.count(node) > 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  groupNode.visitChildren(kdl::overload(
+    [](const WorldNode*) {},
+    [](const LayerNode*) {},
+    [&](auto&& thisLambda, const GroupNode* childGroupNode) {
+      if (
+        result && childGroupNode->hasPendingChanges()
+        && !isAddedOrDescendantOfAdded(childGroupNode))
+      {
+        // the order of the changes of different groups is unknown, so only changed
+        // contents can be merged
+        const auto& childChanges = childGroupNode->pendingChanges();
+        if (
+          !childChanges
+          || !kdl::all_of(*childChanges, [](const auto& change) {
+               return std::holds_alternative<NodeContentsChange>(change);
+             }))
+        {
+          result = std::nullopt;
+          return;
+        }
+        result = kdl::vec_concat(std::move(*result), *childChanges);
+      }
+      childGroupNode->visitChildren(thisLambda);
+    },
+    [](const EntityNode*) {},
+    [](const BrushNode*) {},
+    [](const PatchNode*) {}));
+
+  if (result && result->empty())
+  {
+    return std::nullopt;
+  }
+  return result;
+}
+
+std::string getLinkId(const Node& node)
+{
+  return node.accept(kdl::overload(
+    [](const WorldNode*) { return std::string{}; },
+    [](const LayerNode*) { return std::string{}; },
+    [](const GroupNode* groupNode) { return groupNode->group().linkId(); },
+    [](const EntityNode* entityNode) { return entityNode->entity().linkId(); },
+    [](const BrushNode* brushNode) { return brushNode->brush().linkId(); },
+    [](const PatchNode* patchNode) { return patchNode->patch().linkId(); }));
+}
+
 std::vector<Error> initializeLinkIds(const std::vector<Node*>& nodes)
 {
   const auto allGroupNodes =
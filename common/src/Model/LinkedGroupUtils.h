@@ -25,6 +25,7 @@
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/NodeContents.h"
 #include "Model/NodeVisitor.h"
 #include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
@@ -35,6 +36,8 @@
 #include "kdl/vector_utils.h"
 
 #include <memory>
+#include <optional>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -146,6 +149,82 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   const std::vector<Model::GroupNode*>& targetGroupNodes,
   const vm::bbox3& worldBounds);
 
+/**
+ * The updates to apply to the nodes of the target groups of updateLinkedNodes.
+ */
+struct UpdateLinkedNodesResult
+{
+  /**
+   * Pairs of a target node and a child of it that should be removed.
+   */
+  std::vector<std::pair<Node*, Node*>> nodesToRemove;
+
+  /**
+   * Pairs of a target node and a new child that should be added to it.
+   */
+  std::vector<std::pair<Node*, std::unique_ptr<Node>>> nodesToAdd;
+
+  /**
+   * Pairs of a target node and its new contents.
+   */
+  std::vector<std::pair<Node*, NodeContents>> nodesToUpdate;
+};
+
+/**
+ * Updates the target group nodes by replaying the given changes of the given source group
+ * node.
+ *
+ * Unlike updateLinkedGroups, this does not clone all of the source group node's children,
+ * but only the nodes that were added, and it only transforms the contents of the nodes
+ * that were changed. The nodes corresponding to the changed nodes are found by following
+ * the path from the source group node to each changed node through each target group,
+ * matching nodes by their link IDs, so the cost depends on the number of changes and the
+ * depth of the changed nodes rather than the size of the groups. The target groups are
+ * processed in parallel.
+ *
+ * The changed and added nodes are transformed like in updateLinkedGroups, and nested
+ * group names and protected entity properties are preserved in the same way.
+ *
+ * If this operation fails for any changed node and target group, then an error is
+ * returned under the same conditions as for updateLinkedGroups. If a node corresponding
+ * to a changed node cannot be found in any target group, if a changed node is no longer
+ * a descendant of the source group node, or if an added node already exists in a target
+ * group, then std::nullopt is returned and the caller must use updateLinkedGroups
+ * instead.
+ *
+ * Removing the nodes to remove, then adding the nodes to add and finally swapping in the
+ * new contents yields the same structure as updateLinkedGroups.
+ */
+Result<std::optional<UpdateLinkedNodesResult>> updateLinkedNodes(
+  const GroupNode& sourceGroupNode,
+  const std::vector<PendingChange>& changes,
+  const std::vector<GroupNode*>& targetGroupNodes,
+  const vm::bbox3& worldBounds);
+
+/**
+ * Concatenates the given updates in order. Returns std::nullopt if any of the given
+ * updates is std::nullopt.
+ */
+std::optional<UpdateLinkedNodesResult> mergeLinkedNodeUpdates(
+  std::vector<std::optional<UpdateLinkedNodesResult>> updates);
+
+/**
+ * Returns the recorded pending changes of the given group node, including the changed
+ * nodes recorded in nested groups.
+ *
+ * Returns std::nullopt if the changes of the given group node or of any nested group
+ * with pending changes were not recorded, if nested groups have recorded additions or
+ * removals, or if no changes were recorded. The changes of nested groups that were added
+ * to the given group node are not collected since they are replayed by adding them.
+ */
+std::optional<std::vector<PendingChange>> collectPendingChanges(
+  const GroupNode& groupNode);
+
+/**
+ * Returns the link ID of the given node, or an empty string if the node cannot be linked.
+ */
+std::string getLinkId(const Node& node);
+
 std::vector<Error> initializeLinkIds(const std::vector<Node*>& nodes);
 
 
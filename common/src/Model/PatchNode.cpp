@@ -40,15 +40,25 @@
 #include <vecmath/intersection.h>
 #include <vecmath/vec_io.h>
 
+#include <algorithm>
 #include <cassert>
 #include <ostream>
 #include <string>
+#include <utility>
 
 namespace TrenchBroom
 {
 namespace Model
 {
-constexpr static size_t DefaultSubdivisionsPerSurface = 3u;
+namespace
+{
+/**
+ * The maximum distance between a tessellated patch and the actual surface, in world units
+ * for positions and in texture space for texture coordinates.
+ */
+constexpr auto MaxTessellationPositionError = FloatType(0.1);
+constexpr auto MaxTessellationTexCoordsError = FloatType(0.001);
+} // namespace
 
 kdl_reflect_impl(PatchGrid::Point);
 
@@ -268,16 +278,199 @@ std::vector<vm::vec3> computeGridNormals(
   return normals;
 }
 
-PatchGrid makePatchGrid(const BezierPatch& patch, const size_t subdivisionsPerSurface)
+namespace
 {
-  const size_t gridPointRowCount =
-    patch.surfaceRowCount() * (size_t(1) << subdivisionsPerSurface) + 1u;
-  const size_t gridPointColumnCount =
-    patch.surfaceColumnCount() * (size_t(1) << subdivisionsPerSurface) + 1u;
+/**
+ * Returns how often a quadratic curve with the given control points must be subdivided so
+ * that its chords do not deviate from it by more than the maximum tessellation errors.
+ *
+ * The largest distance between a quadratic curve and its chord is |p0 - 2p1 + p2| / 4,
+ * and each subdivision reduces it by a factor of 4. If includeTexCoords is false, only
+ * the positions of the control points are taken into account.
+ */
+size_t computeSubdivisions(
+  const BezierPatch::Point& p0,
+  const BezierPatch::Point& p1,
+  const BezierPatch::Point& p2,
+  const bool includeTexCoords = true)
+{
+  const auto d = (p0 - FloatType(2) * p1 + p2) / FloatType(4);
+  auto positionError = vm::length(vm::slice<3>(d, 0));
+  auto texCoordsError = includeTexCoords ? vm::length(vm::slice<2>(d, 3)) : FloatType(0);
+
+  auto subdivisions = size_t(0);
+  while (
+    subdivisions < MaxSubdivisionsPerSurface
+    && (
+      positionError > MaxTessellationPositionError
+      || texCoordsError > MaxTessellationTexCoordsError))
+  {
+    positionError /= FloatType(4);
+    texCoordsError /= FloatType(4);
+    ++subdivisions;
+  }
+  return subdivisions;
+}
+} // namespace
+
+SubdivisionsPerSurface computeSubdivisionsPerSurface(const BezierPatch& patch)
+{
+  /*
+  Every curve along a row or column of a surface is a convex combination of the curves
+  defined by the rows or columns of its control points, so it cannot deviate from its
+  chords more than these.
+  */
+  const auto& controlPoints = patch.controlPoints();
+  const auto pointColumnCount = patch.pointColumnCount();
+  const auto point = [&](const size_t row, const size_t col) -> const auto& {
+    return controlPoints[row * pointColumnCount + col];
+  };
 
-  const auto patchGrid = patch.evaluate(subdivisionsPerSurface);
-  const auto normals =
-    computeGridNormals(patchGrid, gridPointRowCount, gridPointColumnCount);
+  auto rowSubdivisions = size_t(0);
+  auto columnSubdivisions = size_t(0);
+
+  for (size_t row = 0u; row < patch.pointRowCount(); ++row)
+  {
+    for (size_t col = 0u; col + 2u < pointColumnCount; col += 2u)
+    {
+      columnSubdivisions = std::max(
+        columnSubdivisions,
+        computeSubdivisions(point(row, col), point(row, col + 1u), point(row, col + 2u)));
+    }
+  }
+
+  for (size_t col = 0u; col < pointColumnCount; ++col)
+  {
+    for (size_t row = 0u; row + 2u < patch.pointRowCount(); row += 2u)
+    {
+      rowSubdivisions = std::max(
+        rowSubdivisions,
+        computeSubdivisions(point(row, col), point(row + 1u, col), point(row + 2u, col)));
+    }
+  }
+
+  return {rowSubdivisions, columnSubdivisions};
+}
+
+namespace
+{
+/**
+ * Evaluates the quadratic curve with the given control points at the given parameter.
+ *
+ * The control points are put into a canonical order by their positions first, so that the
+ * resulting positions are bit-identical for adjacent patches which share the curve, no
+ * matter in which direction they traverse it.
+ */
+BezierPatch::Point evaluateBoundaryCurve(
+  BezierPatch::Point p0, const BezierPatch::Point& p1, BezierPatch::Point p2, FloatType t)
+{
+  if (vm::compare(vm::slice<3>(p2, 0), vm::slice<3>(p0, 0)) < 0)
+  {
+    std::swap(p0, p2);
+    t = FloatType(1) - t;
+  }
+
+  const auto s = FloatType(1) - t;
+  return s * s * p0 + FloatType(2) * s * t * p1 + t * t * p2;
+}
+
+/**
+ * Moves the grid points on one boundary of a patch onto the tessellation of the boundary
+ * curve, which is subdivided depending only on the positions of its control points.
+ *
+ * Each surface of the boundary is tessellated with 2^subdivisions segments, but the
+ * boundary curve might need fewer. Then every grid point is moved to the nearest point of
+ * the boundary tessellation, leaving degenerate triangles along the boundary. Adjacent
+ * patches which share a boundary curve end up with the same distinct points along it even
+ * if their surfaces are subdivided differently, so there are no cracks between them.
+ *
+ * @param grid the grid points of the patch
+ * @param surfaceCount the number of surfaces along the boundary
+ * @param subdivisions the number of subdivisions per surface along the boundary
+ * @param controlPoint returns the control point with the given index along the boundary
+ * @param gridIndex returns the index into grid of the grid point with the given index
+ * along the boundary
+ */
+template <typename C, typename G>
+void stitchBoundary(
+  std::vector<BezierPatch::Point>& grid,
+  const size_t surfaceCount,
+  const size_t subdivisions,
+  const C& controlPoint,
+  const G& gridIndex)
+{
+  const auto segmentsPerSurface = size_t(1) << subdivisions;
+  for (size_t surface = 0u; surface < surfaceCount; ++surface)
+  {
+    const auto& p0 = controlPoint(2u * surface);
+    const auto& p1 = controlPoint(2u * surface + 1u);
+    const auto& p2 = controlPoint(2u * surface + 2u);
+
+    const auto boundarySubdivisions =
+      std::min(computeSubdivisions(p0, p1, p2, false), subdivisions);
+    const auto step = size_t(1) << (subdivisions - boundarySubdivisions);
+
+    for (size_t i = 0u; i <= segmentsPerSurface; ++i)
+    {
+      const auto snapped = (i + step / 2u) / step * step;
+      const auto t = FloatType(snapped) / FloatType(segmentsPerSurface);
+      grid[gridIndex(surface * segmentsPerSurface + i)] =
+        evaluateBoundaryCurve(p0, p1, p2, t);
+    }
+  }
+}
+
+void stitchBoundaries(
+  const BezierPatch& patch,
+  const SubdivisionsPerSurface& subdivisionsPerSurface,
+  const size_t gridPointRowCount,
+  const size_t gridPointColumnCount,
+  std::vector<BezierPatch::Point>& grid)
+{
+  const auto [rowSubdivisions, columnSubdivisions] = subdivisionsPerSurface;
+  const auto& controlPoints = patch.controlPoints();
+  const auto pointRowCount = patch.pointRowCount();
+  const auto pointColumnCount = patch.pointColumnCount();
+
+  for (const auto& rows :
+       {std::pair{size_t(0), size_t(0)},
+        std::pair{pointRowCount - 1u, gridPointRowCount - 1u}})
+  {
+    const auto pointRow = rows.first;
+    const auto gridRow = rows.second;
+    stitchBoundary(
+      grid,
+      patch.surfaceColumnCount(),
+      columnSubdivisions,
+      [&](const size_t col) -> const auto& {
+        return controlPoints[pointRow * pointColumnCount + col];
+      },
+      [&](const size_t col) { return gridRow * gridPointColumnCount + col; });
+  }
+
+  for (const auto& cols :
+       {std::pair{size_t(0), size_t(0)},
+        std::pair{pointColumnCount - 1u, gridPointColumnCount - 1u}})
+  {
+    const auto pointCol = cols.first;
+    const auto gridCol = cols.second;
+    stitchBoundary(
+      grid,
+      patch.surfaceRowCount(),
+      rowSubdivisions,
+      [&](const size_t row) -> const auto& {
+        return controlPoints[row * pointColumnCount + pointCol];
+      },
+      [&](const size_t row) { return row * gridPointColumnCount + gridCol; });
+  }
+}
+
+PatchGrid makePatchGrid(
+  const size_t gridPointRowCount,
+  const size_t gridPointColumnCount,
+  const std::vector<BezierPatch::Point>& patchGrid,
+  const std::vector<vm::vec3>& normals)
+{
   assert(patchGrid.size() == normals.size());
 
   auto points = std::vector<PatchGrid::Point>{};
@@ -293,12 +486,55 @@ PatchGrid makePatchGrid(const BezierPatch& patch, const size_t subdivisionsPerSu
   return {
     gridPointRowCount, gridPointColumnCount, std::move(points), boundsBuilder.bounds()};
 }
+} // namespace
+
+PatchGrid makePatchGrid(const BezierPatch& patch, const size_t subdivisionsPerSurface)
+{
+  return makePatchGrid(patch, {subdivisionsPerSurface, subdivisionsPerSurface});
+}
+
+PatchGrid makePatchGrid(
+  const BezierPatch& patch, const SubdivisionsPerSurface& subdivisionsPerSurface)
+{
+  const auto [rowSubdivisions, columnSubdivisions] = subdivisionsPerSurface;
+  const size_t gridPointRowCount =
+    patch.surfaceRowCount() * (size_t(1) << rowSubdivisions) + 1u;
+  const size_t gridPointColumnCount =
+    patch.surfaceColumnCount() * (size_t(1) << columnSubdivisions) + 1u;
+
+  const auto patchGrid = patch.evaluate(rowSubdivisions, columnSubdivisions);
+  const auto normals =
+    computeGridNormals(patchGrid, gridPointRowCount, gridPointColumnCount);
+
+  return makePatchGrid(gridPointRowCount, gridPointColumnCount, patchGrid, normals);
+}
+
+PatchGrid makeAdaptivePatchGrid(const BezierPatch& patch)
+{
+  const auto subdivisionsPerSurface = computeSubdivisionsPerSurface(patch);
+  const auto [rowSubdivisions, columnSubdivisions] = subdivisionsPerSurface;
+  const size_t gridPointRowCount =
+    patch.surfaceRowCount() * (size_t(1) << rowSubdivisions) + 1u;
+  const size_t gridPointColumnCount =
+    patch.surfaceColumnCount() * (size_t(1) << columnSubdivisions) + 1u;
+
+  auto patchGrid = patch.evaluate(rowSubdivisions, columnSubdivisions);
+
+  // the normals are computed from the surface before stitching, since stitching leaves
+  // degenerate triangles along the boundaries
+  const auto normals =
+    computeGridNormals(patchGrid, gridPointRowCount, gridPointColumnCount);
+  stitchBoundaries(
+    patch, subdivisionsPerSurface, gridPointRowCount, gridPointColumnCount, patchGrid);
+
+  return makePatchGrid(gridPointRowCount, gridPointColumnCount, patchGrid, normals);
+}
 
 const HitType::Type PatchNode::PatchHitType = HitType::freeType();
 
 PatchNode::PatchNode(BezierPatch patch)
   : m_patch{std::move(patch)}
-  , m_grid{makePatchGrid(m_patch, DefaultSubdivisionsPerSurface)}
+  , m_grid{makeAdaptivePatchGrid(m_patch)}
 {
 }
 
@@ -339,7 +575,7 @@ BezierPatch PatchNode::setPatch(BezierPatch patch)
   const auto boundsChange = NotifyPhysicalBoundsChange{*this};
 
   auto previousPatch = std::exchange(m_patch, std::move(patch));
-  m_grid = makePatchGrid(m_patch, DefaultSubdivisionsPerSurface);
+  m_grid = makeAdaptivePatchGrid(m_patch);
   return previousPatch;
 }
 
@@ -30,6 +30,7 @@
 #include <vecmath/vec.h>
 
 #include <optional>
+#include <utility>
 
 namespace TrenchBroom
 {
@@ -72,8 +73,39 @@ std::vector<vm::vec3> computeGridNormals(
   size_t pointRowCount,
   size_t pointColumnCount);
 
+/**
+ * The maximum number of times each surface of a patch is subdivided in each direction
+ * when the patch is tessellated.
+ */
+constexpr size_t MaxSubdivisionsPerSurface = 3u;
+
+/**
+ * The number of times each surface of a patch is subdivided in both directions, given as
+ * a pair of the row and column subdivisions.
+ */
+using SubdivisionsPerSurface = std::pair<size_t, size_t>;
+
+/**
+ * Determines how often the surfaces of the given patch must be subdivided in each
+ * direction so that no point of the tessellated patch deviates from the patch by more
+ * than a small tolerance, up to MaxSubdivisionsPerSurface.
+ */
+SubdivisionsPerSurface computeSubdivisionsPerSurface(const BezierPatch& patch);
+
 // public for testing
 PatchGrid makePatchGrid(const BezierPatch& patch, size_t subdivisionsPerSurface);
+PatchGrid makePatchGrid(
+  const BezierPatch& patch, const SubdivisionsPerSurface& subdivisionsPerSurface);
+
+/**
+ * Tessellates the given patch with the subdivisions returned by
+ * computeSubdivisionsPerSurface.
+ *
+ * The boundaries of the patch are tessellated depending only on the control points of
+ * each boundary curve, so adjacent patches which share a boundary curve have the same
+ * points along it and there are no cracks between them.
+ */
+PatchGrid makeAdaptivePatchGrid(const BezierPatch& patch);
 
 class PatchNode : public Node, public Object
 {
@@ -95,6 +127,14 @@ public:
 
   void setTexture(Assets::Texture* texture);
 
+  /**
+   * Returns the tessellated patch, see makeAdaptivePatchGrid.
+   *
+   * The grid is rebuilt synchronously whenever the patch changes, since picking, the
+   * bounds and the brush containment checks depend on it. There is only one grid per
+   * patch because the patch renderer uploads all patches into one vertex buffer that is
+   * shared by all views.
+   */
   const PatchGrid& grid() const;
 
 private: // implement Node interface
@@ -30,14 +30,26 @@
 #include <vecmath/polygon.h>
 #include <vecmath/vec.h>
 
+#include <cassert>
 #include <string>
 
 namespace TrenchBroom::Model
 {
 
-PortalFile::PortalFile(std::vector<vm::polygon3f> portals)
-  : m_portals{std::move(portals)}
+PortalFile::PortalFile(
+  const size_t leafCount,
+  std::vector<vm::polygon3f> portals,
+  std::vector<std::array<size_t, 2>> portalLeafs)
+  : m_leafCount{leafCount}
+  , m_portals{std::move(portals)}
+  , m_portalLeafs{std::move(portalLeafs)}
 {
+  assert(m_portals.size() == m_portalLeafs.size());
+}
+
+size_t PortalFile::leafCount() const
+{
+  return m_leafCount;
 }
 
 const std::vector<vm::polygon3f>& PortalFile::portals() const
@@ -45,6 +57,11 @@ const std::vector<vm::polygon3f>& PortalFile::portals() const
   return m_portals;
 }
 
+const std::vector<std::array<size_t, 2>>& PortalFile::portalLeafs() const
+{
+  return m_portalLeafs;
+}
+
 bool canLoadPortalFile(const std::filesystem::path& path)
 {
   return IO::Disk::withInputStream(
@@ -58,6 +75,7 @@ Result<PortalFile> loadPortalFile(std::istream& stream)
   static const auto lineSplitter = "() \n\t\r";
 
   auto line = std::string{};
+  auto numLeafs = 0ul;
   auto numPortals = 0ul;
   auto prt1ForQ3 = false;
 
@@ -67,7 +85,8 @@ Result<PortalFile> loadPortalFile(std::istream& stream)
 
   if (formatCode == "PRT1")
   {
-    std::getline(stream, line); // number of leafs (ignored)
+    std::getline(stream, line); // number of leafs
+    numLeafs = std::stoul(line);
     std::getline(stream, line); // number of portals
     numPortals = std::stoul(line);
     const auto mark = stream.tellg();
@@ -88,13 +107,15 @@ Result<PortalFile> loadPortalFile(std::istream& stream)
   else if (formatCode == "PRT2")
   {
     std::getline(stream, line); // number of leafs (ignored)
-    std::getline(stream, line); // number of clusters (ignored)
+    std::getline(stream, line); // number of clusters, which the portals connect
+    numLeafs = std::stoul(line);
     std::getline(stream, line); // number of portals
     numPortals = std::stoul(line);
   }
   else if (formatCode == "PRT1-AM")
   {
-    std::getline(stream, line); // number of clusters (ignored)
+    std::getline(stream, line); // number of clusters, which the portals connect
+    numLeafs = std::stoul(line);
     std::getline(stream, line); // number of portals
     numPortals = std::stoul(line);
     std::getline(stream, line); // number of leafs (ignored)
@@ -112,6 +133,8 @@ Result<PortalFile> loadPortalFile(std::istream& stream)
   // read portals
   auto portals = std::vector<vm::polygon3f>{};
   portals.reserve(numPortals);
+  auto portalLeafs = std::vector<std::array<size_t, 2>>{};
+  portalLeafs.reserve(numPortals);
 
   for (size_t i = 0; i < numPortals; ++i)
   {
@@ -140,9 +163,17 @@ Result<PortalFile> loadPortalFile(std::istream& stream)
       ptr += 3;
     }
 
+    const auto leafs =
+      std::array<size_t, 2>{std::stoul(components.at(1)), std::stoul(components.at(2))};
+    if (leafs[0] >= numLeafs || leafs[1] >= numLeafs)
+    {
+      return Error{"Invalid portal leaf index"};
+    }
+
     portals.emplace_back(std::move(verts));
+    portalLeafs.push_back(leafs);
   }
-  return PortalFile{std::move(portals)};
+  return PortalFile{numLeafs, std::move(portals), std::move(portalLeafs)};
 }
 
 
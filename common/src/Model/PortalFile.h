@@ -23,6 +23,8 @@
 
 #include <vecmath/forward.h>
 
+#include <array>
+#include <cstddef>
 #include <filesystem>
 #include <iosfwd>
 #include <vector>
@@ -33,12 +35,29 @@ namespace TrenchBroom::Model
 class PortalFile
 {
 private:
+  size_t m_leafCount;
   std::vector<vm::polygon3f> m_portals;
+  std::vector<std::array<size_t, 2>> m_portalLeafs;
 
 public:
-  explicit PortalFile(std::vector<vm::polygon3f> portals);
+  PortalFile(
+    size_t leafCount,
+    std::vector<vm::polygon3f> portals,
+    std::vector<std::array<size_t, 2>> portalLeafs);
+
+  /**
+   * The number of leafs or clusters that the portals connect, as stated in the file
+   * header. Every index in portalLeafs() is less than this.
+   */
+  size_t leafCount() const;
 
   const std::vector<vm::polygon3f>& portals() const;
+
+  /**
+   * The indices of the two leafs that each portal connects, in the same order as the
+   * portals. Depending on the file format, the indices refer to clusters of leafs.
+   */
+  const std::vector<std::array<size_t, 2>>& portalLeafs() const;
 };
 
 bool canLoadPortalFile(const std::filesystem::path& path);
@@ -39,6 +39,7 @@
 #include <kdl/struct_io.h>
 #include <kdl/vector_utils.h>
 
+#include <mutex>
 #include <ostream>
 #include <vector>
 
@@ -77,6 +78,40 @@ void BrushMatchVisitor::visit(const BrushNode& brush)
   }
 }
 
+NameMatchCache::NameMatchCache() = default;
+
+// the cached results are specific to the owning matcher and must not be shared
+NameMatchCache::NameMatchCache(const NameMatchCache&) {}
+
+NameMatchCache& NameMatchCache::operator=(const NameMatchCache& other)
+{
+  if (this != &other)
+  {
+    const auto lock = std::unique_lock{m_mutex};
+    m_results.clear();
+  }
+  return *this;
+}
+
+bool NameMatchCache::matches(
+  const std::string_view name, const std::function<bool(std::string_view)>& match) const
+{
+  auto key = std::string{name};
+  {
+    const auto lock = std::shared_lock{m_mutex};
+    if (const auto it = m_results.find(key); it != m_results.end())
+    {
+      return it->second;
+    }
+  }
+
+  const auto result = match(name);
+
+  const auto lock = std::unique_lock{m_mutex};
+  m_results.emplace(std::move(key), result);
+  return result;
+}
+
 void TextureTagMatcher::enable(TagMatcherCallback& callback, MapFacade& facade) const
 {
   const auto& textureManager = facade.textureManager();
@@ -171,18 +206,20 @@ bool TextureNameTagMatcher::matchesTexture(const Assets::Texture* texture) const
 
 bool TextureNameTagMatcher::matchesTextureName(std::string_view textureName) const
 {
-  // If the match pattern doesn't contain a slash, match against
-  // only the last component of the texture name.
-  if (m_pattern.find('/') == std::string::npos)
-  {
-    const auto pos = textureName.find_last_of('/');
-    if (pos != std::string::npos)
+  return m_cache.matches(textureName, [&](std::string_view name) {
+    // If the match pattern doesn't contain a slash, match against
+    // only the last component of the texture name.
+    if (m_pattern.find('/') == std::string::npos)
     {
-      textureName = textureName.substr(pos + 1);
+      const auto pos = name.find_last_of('/');
+      if (pos != std::string::npos)
+      {
+        name = name.substr(pos + 1);
+      }
     }
-  }
 
-  return kdl::ci::str_matches_glob(textureName, m_pattern);
+    return kdl::ci::str_matches_glob(name, m_pattern);
+  });
 }
 
 SurfaceParmTagMatcher::SurfaceParmTagMatcher(const std::string& parameter)
@@ -517,7 +554,9 @@ void EntityClassNameTagMatcher::appendToStream(std::ostream& str) const
 
 bool EntityClassNameTagMatcher::matchesClassname(const std::string& classname) const
 {
-  return kdl::ci::str_matches_glob(classname, m_pattern);
+  return m_cache.matches(classname, [&](const std::string_view name) {
+    return kdl::ci::str_matches_glob(name, m_pattern);
+  });
 }
 } // namespace Model
 } // namespace TrenchBroom
@@ -28,8 +28,10 @@
 #include <functional>
 #include <iosfwd>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -84,6 +86,31 @@ public:
   void visit(const BrushNode& brush) override;
 };
 
+/**
+ * Memoizes the results of matching names against a fixed pattern. Many faces share the
+ * same texture name and many entities share the same classname, so the results are
+ * reused across all objects. The cache can be used from multiple threads.
+ */
+class NameMatchCache
+{
+private:
+  mutable std::shared_mutex m_mutex;
+  mutable std::unordered_map<std::string, bool> m_results;
+
+public:
+  NameMatchCache();
+  NameMatchCache(const NameMatchCache& other);
+
+  NameMatchCache& operator=(const NameMatchCache& other);
+
+  /**
+   * Returns the cached result for the given name, or calls the given function to match
+   * the name and caches its result.
+   */
+  bool matches(std::string_view name, const std::function<bool(std::string_view)>& match)
+    const;
+};
+
 class TextureTagMatcher : public TagMatcher
 {
 public:
@@ -99,6 +126,7 @@ class TextureNameTagMatcher : public TextureTagMatcher
 {
 private:
   std::string m_pattern;
+  NameMatchCache m_cache;
 
 public:
   explicit TextureNameTagMatcher(const std::string& pattern);
@@ -180,6 +208,7 @@ private:
    * The texture to set when this tag is enabled.
    */
   std::string m_texture;
+  NameMatchCache m_cache;
 
 public:
   EntityClassNameTagMatcher(const std::string& pattern, const std::string& texture);
@@ -42,6 +42,30 @@ std::unique_ptr<TexCoordSystemSnapshot> TexCoordSystemSnapshot::clone() const
   return doClone();
 }
 
+TexCoordProjection::TexCoordProjection(
+  const vm::vec3& xAxis,
+  const vm::vec3& yAxis,
+  const vm::vec2f& offset,
+  const vm::vec2f& textureSize)
+  : m_xAxis{xAxis}
+  , m_yAxis{yAxis}
+  , m_offset{offset}
+  , m_textureSize{textureSize}
+{
+}
+
+std::vector<vm::vec2f> TexCoordProjection::operator()(
+  const std::vector<vm::vec3>& points) const
+{
+  auto result = std::vector<vm::vec2f>{};
+  result.reserve(points.size());
+  for (const auto& point : points)
+  {
+    result.push_back((*this)(point));
+  }
+  return result;
+}
+
 TexCoordSystem::TexCoordSystem() = default;
 
 TexCoordSystem::~TexCoordSystem() = default;
@@ -108,6 +132,16 @@ vm::vec2f TexCoordSystem::getTexCoords(
   return doGetTexCoords(point, attribs, textureSize);
 }
 
+TexCoordProjection TexCoordSystem::getTexCoordProjection(
+  const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const
+{
+  return TexCoordProjection{
+    safeScaleAxis(getXAxis(), attribs.scale().x()),
+    safeScaleAxis(getYAxis(), attribs.scale().y()),
+    attribs.offset(),
+    textureSize};
+}
+
 void TexCoordSystem::setRotation(
   const vm::vec3& normal, const float oldAngle, const float newAngle)
 {
@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <tuple>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -52,6 +53,39 @@ private:
   friend class ParaxialTexCoordSystem;
 };
 
+/**
+ * Computes the texture coordinates of points on a face. The texture axes, scale, offset
+ * and texture size are combined once per face, so that many points can be projected
+ * without any virtual calls.
+ */
+class TexCoordProjection
+{
+private:
+  vm::vec3 m_xAxis;
+  vm::vec3 m_yAxis;
+  vm::vec2f m_offset;
+  vm::vec2f m_textureSize;
+
+public:
+  TexCoordProjection(
+    const vm::vec3& xAxis,
+    const vm::vec3& yAxis,
+    const vm::vec2f& offset,
+    const vm::vec2f& textureSize);
+
+  vm::vec2f operator()(const vm::vec3& point) const
+  {
+    const auto texCoords =
+      vm::vec2f{float(dot(point, m_xAxis)), float(dot(point, m_yAxis))};
+    return (texCoords + m_offset) / m_textureSize;
+  }
+
+  /**
+   * Computes the texture coordinates of the given points in one pass.
+   */
+  std::vector<vm::vec2f> operator()(const std::vector<vm::vec3>& points) const;
+};
+
 enum class WrapStyle
 {
   Projection,
@@ -86,6 +120,8 @@ public:
     const vm::vec3& point,
     const BrushFaceAttributes& attribs,
     const vm::vec2f& textureSize) const;
+  TexCoordProjection getTexCoordProjection(
+    const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const;
 
   void setRotation(const vm::vec3& normal, float oldAngle, float newAngle);
   void transform(
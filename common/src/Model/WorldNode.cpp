@@ -30,7 +30,7 @@
 #include "Model/TagVisitor.h"
 #include "Model/Validator.h"
 #include "Model/ValidatorRegistry.h"
-#include "octree.h"
+#include "aabb_tree.h"
 
 #include <kdl/overload.h>
 #include <kdl/result.h>
@@ -38,8 +38,10 @@
 
 #include <vecmath/bbox_io.h>
 
+#include <cassert>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -53,7 +55,7 @@ WorldNode::WorldNode(
   , m_defaultLayer{nullptr}
   , m_entityNodeIndex{std::make_unique<EntityNodeIndex>()}
   , m_validatorRegistry{std::make_unique<ValidatorRegistry>()}
-  , m_nodeTree{std::make_unique<NodeTree>(256.0)}
+  , m_nodeTree{std::make_unique<NodeTree>()}
   , m_updateNodeTree{true}
 {
   entity.addOrUpdateProperty(
@@ -249,12 +251,113 @@ void WorldNode::rebuildNodeTree()
     [&](PatchNode* patch) { addNode(patch); }));
 
   m_nodeTree->clear();
+  m_pendingNodeTreeNodes.clear();
+  m_pendingNodeTreeUpdates.clear();
+
   for (auto* node : nodes)
   {
     m_nodeTree->insert(node->physicalBounds(), node);
   }
 }
 
+void WorldNode::beginNodeTreeBatch()
+{
+  ++m_nodeTreeBatchDepth;
+}
+
+void WorldNode::commitNodeTreeBatch()
+{
+  assert(m_nodeTreeBatchDepth > 0);
+  if (--m_nodeTreeBatchDepth > 0)
+  {
+    return;
+  }
+
+  const auto nodes = std::exchange(m_pendingNodeTreeNodes, {});
+  const auto updates = std::exchange(m_pendingNodeTreeUpdates, {});
+
+  // Apply all removals first because the address of a removed node may have been reused
+  // by a node that was added during this batch.
+  for (auto* node : nodes)
+  {
+    const auto update = updates.at(node);
+    if (
+      update == PendingNodeTreeUpdate::Remove || update == PendingNodeTreeUpdate::Update)
+    {
+      removeFromNodeTree(node);
+    }
+  }
+
+  // The bounds of the nodes and their ancestors are recomputed lazily here, so every node
+  // is only recomputed once no matter how often it changed during the batch.
+  for (auto* node : nodes)
+  {
+    const auto update = updates.at(node);
+    if (
+      update == PendingNodeTreeUpdate::Insert || update == PendingNodeTreeUpdate::Update)
+    {
+      insertIntoNodeTree(node);
+    }
+  }
+}
+
+void WorldNode::insertIntoNodeTree(Node* node)
+{
+  if (m_nodeTreeBatchDepth > 0)
+  {
+    auto& update = pendingNodeTreeUpdate(node);
+    update = update == PendingNodeTreeUpdate::Remove ? PendingNodeTreeUpdate::Update
+                                                      : PendingNodeTreeUpdate::Insert;
+  }
+  else
+  {
+    m_nodeTree->insert(node->physicalBounds(), node);
+  }
+}
+
+void WorldNode::removeFromNodeTree(Node* node)
+{
+  if (m_nodeTreeBatchDepth > 0)
+  {
+    auto& update = pendingNodeTreeUpdate(node);
+    update = update == PendingNodeTreeUpdate::Insert ? PendingNodeTreeUpdate::None
+                                                      : PendingNodeTreeUpdate::Remove;
+  }
+  else if (!m_nodeTree->remove(node))
+  {
+    auto str = std::stringstream();
+    str << "Node not found with bounds " << node->physicalBounds() << ": " << node;
+    throw NodeTreeException{str.str()};
+  }
+}
+
+void WorldNode::updateInNodeTree(Node* node)
+{
+  if (m_nodeTreeBatchDepth > 0)
+  {
+    auto& update = pendingNodeTreeUpdate(node);
+    if (update == PendingNodeTreeUpdate::None)
+    {
+      update = PendingNodeTreeUpdate::Update;
+    }
+  }
+  else
+  {
+    m_nodeTree->update(node->physicalBounds(), node);
+  }
+}
+
+WorldNode::PendingNodeTreeUpdate& WorldNode::pendingNodeTreeUpdate(Node* node)
+{
+  const auto [iUpdate, inserted] =
+    m_pendingNodeTreeUpdates.try_emplace(node, PendingNodeTreeUpdate::None);
+  if (inserted)
+  {
+    m_pendingNodeTreeNodes.push_back(node);
+  }
+  return iUpdate->second;
+}
+
 void WorldNode::invalidateAllIssues()
 {
   accept([](auto&& thisLambda, Node* node) {
@@ -361,11 +464,11 @@ void WorldNode::doDescendantWasAdded(Node* node, const size_t /* depth */)
       [&](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
       [&](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
       [&](auto&& thisLambda, EntityNode* entity) {
-        m_nodeTree->insert(entity->physicalBounds(), entity);
+        insertIntoNodeTree(entity);
         entity->visitChildren(thisLambda);
       },
-      [&](BrushNode* brush) { m_nodeTree->insert(brush->physicalBounds(), brush); },
-      [&](PatchNode* patch) { m_nodeTree->insert(patch->physicalBounds(), patch); }));
+      [&](BrushNode* brush) { insertIntoNodeTree(brush); },
+      [&](PatchNode* patch) { insertIntoNodeTree(patch); }));
   }
 
   const auto updatePersistentId = [&](auto* persistentNode) {
@@ -404,26 +507,16 @@ void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
 {
   if (m_updateNodeTree)
   {
-    const auto doRemove = [&](auto* nodeToRemove) {
-      if (!m_nodeTree->remove(nodeToRemove))
-      {
-        auto str = std::stringstream();
-        str << "Node not found with bounds " << nodeToRemove->physicalBounds() << ": "
-            << nodeToRemove;
-        throw NodeTreeException{str.str()};
-      }
-    };
-
     node->accept(kdl::overload(
       [&](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
       [&](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
       [&](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
       [&](auto&& thisLambda, EntityNode* entity) {
-        doRemove(entity);
+        removeFromNodeTree(entity);
         entity->visitChildren(thisLambda);
       },
-      [&](BrushNode* brush) { doRemove(brush); },
-      [&](PatchNode* patch) { doRemove(patch); }));
+      [&](BrushNode* brush) { removeFromNodeTree(brush); },
+      [&](PatchNode* patch) { removeFromNodeTree(patch); }));
   }
 }
 
@@ -435,9 +528,9 @@ void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node)
       [](WorldNode*) {},
       [](LayerNode*) {},
       [](GroupNode*) {},
-      [&](EntityNode* entity) { m_nodeTree->update(entity->physicalBounds(), entity); },
-      [&](BrushNode* brush) { m_nodeTree->update(brush->physicalBounds(), brush); },
-      [&](PatchNode* patch) { m_nodeTree->update(patch->physicalBounds(), patch); }));
+      [&](EntityNode* entity) { updateInNodeTree(entity); },
+      [&](BrushNode* brush) { updateInNodeTree(brush); },
+      [&](PatchNode* patch) { updateInNodeTree(patch); }));
   }
 }
 
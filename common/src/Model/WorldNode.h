@@ -31,12 +31,13 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
 {
 template <typename T, typename U>
-class octree;
+class aabb_tree;
 
 namespace Model
 {
@@ -56,10 +57,22 @@ private:
   std::unique_ptr<EntityNodeIndex> m_entityNodeIndex;
   std::unique_ptr<ValidatorRegistry> m_validatorRegistry;
 
-  using NodeTree = octree<FloatType, Node*>;
+  using NodeTree = aabb_tree<FloatType, Node*>;
   std::unique_ptr<NodeTree> m_nodeTree;
   bool m_updateNodeTree;
 
+  enum class PendingNodeTreeUpdate
+  {
+    None,
+    Insert,
+    Remove,
+    Update
+  };
+
+  size_t m_nodeTreeBatchDepth = 0;
+  std::vector<Node*> m_pendingNodeTreeNodes;
+  std::unordered_map<Node*, PendingNodeTreeUpdate> m_pendingNodeTreeUpdates;
+
   IdType m_nextPersistentId = 1;
 
 public:
@@ -142,7 +155,50 @@ public: // node tree bulk updating
   void enableNodeTreeUpdates();
   void rebuildNodeTree();
 
+  /**
+   * Starts a batch of node tree updates. While a batch is active, nodes that are added,
+   * removed or whose bounds change are only recorded. The recorded changes are applied to
+   * the node tree in a single pass when the outermost batch is committed, and every node
+   * is updated at most once, with its bounds at that time.
+   *
+   * Batches can be nested. The node tree does not reflect any changes made during a batch
+   * until the outermost batch is committed.
+   */
+  void beginNodeTreeBatch();
+
+  /**
+   * Commits the current batch of node tree updates. If this is the outermost batch, all
+   * recorded changes are applied to the node tree.
+   *
+   * @throws NodeTreeException if a recorded node cannot be removed from the node tree
+   */
+  void commitNodeTreeBatch();
+
+  /**
+   * Calls the given function within a batch of node tree updates.
+   */
+  template <typename F>
+  void batchNodeTreeUpdates(const F& f)
+  {
+    beginNodeTreeBatch();
+    try
+    {
+      f();
+    }
+    catch (...)
+    {
+      commitNodeTreeBatch();
+      throw;
+    }
+    commitNodeTreeBatch();
+  }
+
 private:
+  void insertIntoNodeTree(Node* node);
+  void removeFromNodeTree(Node* node);
+  void updateInNodeTree(Node* node);
+  PendingNodeTreeUpdate& pendingNodeTreeUpdate(Node* node);
+
   void invalidateAllIssues();
 
 private: // implement Node interface
@@ -26,7 +26,12 @@
 
 #include <cassert>
 #include <functional>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -269,15 +274,16 @@ public:
 /**
  * RAII style helper tht notifies the given notifier when it is destroyed, passing the
  * given arguments.
+ *
+ * The arguments are stored in this object rather than in a type erased callback so that
+ * creating an instance does not allocate.
  */
-template <typename... A>
+template <typename N, typename Args>
 class NotifyAfter
 {
 private:
-  Notifier<A...>& m_notifier;
-
-protected:
-  std::function<void(Notifier<A...>&)> m_notify;
+  N& m_notifier;
+  std::optional<Args> m_args;
 
 public:
   /**
@@ -292,37 +298,37 @@ public:
    * @param a the arguments to pass to the notifier
    */
   template <typename... NA>
-  explicit NotifyAfter(const bool notify, Notifier<A...>& notifier, NA&&... a)
+  explicit NotifyAfter(const bool notify, N& notifier, NA&&... a)
     : m_notifier{notifier}
-    , m_notify{makeNotify(notify, std::forward<NA>(a)...)}
+    , m_args{
+        notify ? std::optional<Args>{kdl::tup_capture(std::forward<NA>(a)...)}
+               : std::nullopt}
   {
   }
 
-  virtual ~NotifyAfter() { m_notify(m_notifier); }
+  virtual ~NotifyAfter() { notify(m_notifier); }
 
-private:
-  template <typename... NA>
-  static std::function<void(Notifier<A...>&)> makeNotify(const bool notify, NA&&... a)
+protected:
+  void notify(N& notifier) const
   {
-    if (notify)
+    if (m_args)
     {
-      return [args = kdl::tup_capture(std::forward<NA>(a)...)](Notifier<A...>& notifier) {
-        std::apply(notifier, args);
-      };
+      std::apply(notifier, *m_args);
     }
-    return [](Notifier<A...>&) {};
   }
 };
 
 template <typename... AA, typename... NA>
-NotifyAfter(bool, Notifier<AA...>&, NA&&...) -> NotifyAfter<AA...>;
+NotifyAfter(bool, Notifier<AA...>&, NA&&...) -> NotifyAfter<
+  Notifier<AA...>,
+  decltype(kdl::tup_capture(std::declval<NA>()...))>;
 
 /**
  * RAII style helper tht notifies a given notifier immediately and another notifier when
  * it is destroyed, passing the given arguments to either notifier.
  */
-template <typename... A>
-class NotifyBeforeAndAfter : public NotifyAfter<A...>
+template <typename N, typename Args>
+class NotifyBeforeAndAfter : public NotifyAfter<N, Args>
 {
 public:
   /**
@@ -334,11 +340,10 @@ public:
    * @param a the arguments to pass to either notifier
    */
   template <typename... NA>
-  NotifyBeforeAndAfter(
-    const bool notify, Notifier<A...>& before, Notifier<A...>& after, NA&&... a)
-    : NotifyAfter<A...>{notify, after, std::forward<NA>(a)...}
+  NotifyBeforeAndAfter(const bool notify, N& before, N& after, NA&&... a)
+    : NotifyAfter<N, Args>{notify, after, std::forward<NA>(a)...}
   {
-    NotifyAfter<A...>::m_notify(before);
+    NotifyAfter<N, Args>::notify(before);
   }
 
   /**
@@ -349,7 +354,7 @@ public:
    * @param a the arguments to pass to either notifier
    */
   template <typename... NA>
-  NotifyBeforeAndAfter(Notifier<A...>& before, Notifier<A...>& after, NA&&... a)
+  NotifyBeforeAndAfter(N& before, N& after, NA&&... a)
     : NotifyBeforeAndAfter{true, before, after, std::forward<NA>(a)...}
   {
   }
@@ -357,9 +362,141 @@ public:
 
 template <typename... AA, typename... NA>
 NotifyBeforeAndAfter(bool, Notifier<AA...>&, Notifier<AA...>&, NA&&...)
-  -> NotifyBeforeAndAfter<AA...>;
+  -> NotifyBeforeAndAfter<
+    Notifier<AA...>,
+    decltype(kdl::tup_capture(std::declval<NA>()...))>;
 
 template <typename... AA, typename... NA>
 NotifyBeforeAndAfter(Notifier<AA...>&, Notifier<AA...>&, NA&&...)
-  -> NotifyBeforeAndAfter<AA...>;
+  -> NotifyBeforeAndAfter<
+    Notifier<AA...>,
+    decltype(kdl::tup_capture(std::declval<NA>()...))>;
+
+/**
+ * Coalesces the notifications of a pair of notifiers that are sent before and after a
+ * collection of objects changes.
+ *
+ * Notifications are passed on immediately unless a coalescing scope is open. While such
+ * a scope is open, the before notifier is only notified of objects that it has not been
+ * notified of since the scope was opened, and the after notifier is notified once of all
+ * of these objects when the scope is closed or when flush is called. Thereby, observers
+ * that only need to know which objects have changed do not have to repeat their work for
+ * every individual change.
+ *
+ * Scopes can be nested. A scope that does not coalesce suspends coalescing until it is
+ * closed.
+ *
+ * @tparam T the type of the objects, must be hashable
+ */
+template <typename T>
+class NotificationCoalescer
+{
+private:
+  Notifier<const std::vector<T>&>& m_before;
+  Notifier<const std::vector<T>&>& m_after;
+
+  std::vector<bool> m_scopes;
+  std::vector<T> m_pending;
+  std::unordered_set<T> m_pendingSet;
+
+public:
+  /**
+   * Creates a new instance that passes coalesced notifications on to the given
+   * notifiers.
+   */
+  NotificationCoalescer(
+    Notifier<const std::vector<T>&>& before, Notifier<const std::vector<T>&>& after)
+    : m_before{before}
+    , m_after{after}
+  {
+  }
+
+  /**
+   * Indicates whether notifications are currently being coalesced.
+   */
+  bool coalescing() const { return !m_scopes.empty() && m_scopes.back(); }
+
+  /**
+   * Opens a new scope. If the given flag is false and notifications are currently being
+   * coalesced, all pending notifications are sent before the scope is opened.
+   *
+   * @param coalesce whether notifications should be coalesced within the new scope
+   */
+  void beginScope(const bool coalesce)
+  {
+    if (!coalesce)
+    {
+      flush();
+    }
+    m_scopes.push_back(coalesce);
+  }
+
+  /**
+   * Closes the innermost scope. If notifications are no longer being coalesced
+   * afterwards, all pending notifications are sent.
+   */
+  void endScope()
+  {
+    assert(!m_scopes.empty());
+    m_scopes.pop_back();
+    if (!coalescing())
+    {
+      flush();
+    }
+  }
+
+  /**
+   * Notifies the after notifier of all objects that the before notifier was notified of
+   * while coalescing.
+   */
+  void flush()
+  {
+    if (!m_pending.empty())
+    {
+      auto pending = std::move(m_pending);
+      m_pending.clear();
+      m_pendingSet.clear();
+      m_after(pending);
+    }
+  }
+
+  /**
+   * Call this before the given objects change.
+   */
+  void notifyBefore(const std::vector<T>& objects)
+  {
+    if (!coalescing())
+    {
+      m_before(objects);
+      return;
+    }
+
+    const auto firstNew = m_pending.size();
+    for (const auto& object : objects)
+    {
+      if (m_pendingSet.insert(object).second)
+      {
+        m_pending.push_back(object);
+      }
+    }
+
+    if (m_pending.size() > firstNew)
+    {
+      const auto newObjects = std::vector<T>(
+        std::next(std::begin(m_pending), std::ptrdiff_t(firstNew)), std::end(m_pending));
+      m_before(newObjects);
+    }
+  }
+
+  /**
+   * Call this after the given objects have changed.
+   */
+  void notifyAfter(const std::vector<T>& objects)
+  {
+    if (!coalescing())
+    {
+      m_after(objects);
+    }
+  }
+};
 } // namespace TrenchBroom
@@ -128,6 +128,8 @@ extern Preference<Color> GridColor2D;
 extern Preference<int> TextureMinFilter;
 extern Preference<int> TextureMagFilter;
 extern Preference<bool> EnableMSAA;
+extern Preference<bool> OcclusionCulling;
+extern Preference<bool> PortalFileCulling;
 
 extern Preference<bool> TextureLock;
 extern Preference<bool> UVLock;
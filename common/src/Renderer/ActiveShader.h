@@ -41,9 +41,9 @@ public:
   ~ActiveShader();
 
   template <class T>
-  void set(const std::string& name, const T& value)
+  void set(const Uniform& uniform, const T& value)
   {
-    m_program.set(name, value);
+    m_program.set(uniform, value);
   }
 };
 } // namespace Renderer
@@ -31,14 +31,23 @@
 #include "Renderer/BrushRendererBrushCache.h"
 #include "Renderer/RenderContext.h"
 
+#include <kdl/parallel.h>
+
 #include <cassert>
 #include <cstring>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
+namespace
+{
+// validating fewer brushes than this is not worth the overhead of spawning threads
+constexpr auto MinParallelBrushCount = size_t(256);
+} // namespace
+
 // Filter
 
 BrushRenderer::Filter::Filter() = default;
@@ -150,6 +159,7 @@ BrushRenderer::BrushRenderer()
   , m_forceTransparent{false}
   , m_transparencyAlpha{1.0f}
   , m_showHiddenBrushes{false}
+  , m_parallelValidation{true}
 {
   clear();
 }
@@ -377,19 +387,55 @@ void BrushRenderer::validate()
 {
   assert(!valid());
 
+  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
+
+  // evaluate the filter first and only once per brush, it may access the preferences,
+  // which can only be used on the main thread
+  auto brushesToRender =
+    std::vector<std::tuple<const Model::BrushNode*, Filter::RenderSettings>>{};
+  brushesToRender.reserve(m_invalidBrushes.size());
   for (auto* brushNode : m_invalidBrushes)
   {
-    validateBrush(*brushNode);
+    const auto settings = wrapper.markFaces(*brushNode);
+    const auto [facePolicy, edgePolicy] = settings;
+
+    // skipped brushes are not inserted into m_brushInfo
+    if (
+      facePolicy != Filter::FaceRenderPolicy::RenderNone
+      || edgePolicy != Filter::EdgeRenderPolicy::RenderNone)
+    {
+      brushesToRender.emplace_back(brushNode, settings);
+    }
   }
   m_invalidBrushes.clear();
   assert(valid());
 
+  // building the vertex caches only touches the brushes themselves, so it can be done
+  // on worker threads, leaving only the copying into the arrays to this thread
+  if (m_parallelValidation && brushesToRender.size() >= MinParallelBrushCount)
+  {
+    kdl::parallel_for(brushesToRender.size(), [&](const size_t i) {
+      const auto* brushNode = std::get<0>(brushesToRender[i]);
+      brushNode->brushRendererBrushCache().validateVertexCache(*brushNode);
+    });
+  }
+
+  for (const auto& [brushNode, settings] : brushesToRender)
+  {
+    validateBrush(*brushNode, settings);
+  }
+
   m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
   m_transparentFaceRenderer =
     FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
   m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
 }
 
+void BrushRenderer::setParallelValidation(const bool parallelValidation)
+{
+  m_parallelValidation = parallelValidation;
+}
+
 static size_t triIndicesCountForPolygon(const size_t vertexCount)
 {
   assert(vertexCount >= 3);
@@ -503,25 +549,13 @@ bool BrushRenderer::shouldDrawFaceInTransparentPass(
   return false;
 }
 
-void BrushRenderer::validateBrush(const Model::BrushNode& brushNode)
+void BrushRenderer::validateBrush(
+  const Model::BrushNode& brushNode, const Filter::RenderSettings& settings)
 {
   assert(m_allBrushes.find(&brushNode) != std::end(m_allBrushes));
-  assert(m_invalidBrushes.find(&brushNode) != std::end(m_invalidBrushes));
   assert(m_brushInfo.find(&brushNode) == std::end(m_brushInfo));
 
-  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
-
-  // evaluate filter. only evaluate the filter once per brush.
-  const auto settings = wrapper.markFaces(brushNode);
-  const auto [facePolicy, edgePolicy] = settings;
-
-  if (
-    facePolicy == Filter::FaceRenderPolicy::RenderNone
-    && edgePolicy == Filter::EdgeRenderPolicy::RenderNone)
-  {
-    // NOTE: this skips inserting the brush into m_brushInfo
-    return;
-  }
+  const auto edgePolicy = std::get<1>(settings);
 
   BrushInfo& info = m_brushInfo[&brushNode];
 
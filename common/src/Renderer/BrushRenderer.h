@@ -171,6 +171,7 @@ private:
   float m_transparencyAlpha;
 
   bool m_showHiddenBrushes;
+  bool m_parallelValidation;
 
 public:
   template <typename FilterT>
@@ -183,6 +184,7 @@ public:
     , m_forceTransparent{false}
     , m_transparencyAlpha{1.0f}
     , m_showHiddenBrushes{false}
+    , m_parallelValidation{true}
   {
     clear();
   }
@@ -295,10 +297,18 @@ public:
    */
   void validate();
 
+  /**
+   * Specifies whether the vertex caches of many invalid brushes are built on worker
+   * threads when validating. Enabled by default, only exposed for testing and
+   * benchmarking.
+   */
+  void setParallelValidation(bool parallelValidation);
+
 private:
   bool shouldDrawFaceInTransparentPass(
     const Model::BrushNode& brushNode, const Model::BrushFace& face) const;
-  void validateBrush(const Model::BrushNode& brushNode);
+  void validateBrush(
+    const Model::BrushNode& brushNode, const Filter::RenderSettings& settings);
 
 public:
   /**
@@ -22,7 +22,6 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
-#include <stdexcept>
 
 namespace TrenchBroom
 {
@@ -31,63 +30,10 @@ namespace TrenchBroom
 namespace Renderer
 {
 
-// DirtyRangeTracker
-
-DirtyRangeTracker::DirtyRangeTracker(const size_t initial_capacity)
-  : m_dirtyPos(0)
-  , m_dirtySize(0)
-  , m_capacity(initial_capacity)
-{
-}
-
-DirtyRangeTracker::DirtyRangeTracker()
-  : m_dirtyPos(0)
-  , m_dirtySize(0)
-  , m_capacity(0)
-{
-}
-
-void DirtyRangeTracker::expand(const size_t newcap)
-{
-  if (newcap <= m_capacity)
-  {
-    throw std::invalid_argument("new capacity must be greater");
-  }
-
-  const size_t oldcap = m_capacity;
-  m_capacity = newcap;
-  markDirty(oldcap, newcap - oldcap);
-}
-
-size_t DirtyRangeTracker::capacity() const
-{
-  return m_capacity;
-}
-
-void DirtyRangeTracker::markDirty(const size_t pos, const size_t size)
-{
-  // bounds check
-  if (pos + size > m_capacity)
-  {
-    throw std::invalid_argument("markDirty provided range out of bounds");
-  }
-
-  const size_t newPos = std::min(pos, m_dirtyPos);
-  const size_t newEnd = std::max(pos + size, m_dirtyPos + m_dirtySize);
-
-  m_dirtyPos = newPos;
-  m_dirtySize = newEnd - newPos;
-}
-
-bool DirtyRangeTracker::clean() const
-{
-  return m_dirtySize == 0;
-}
-
 // IndexHolder
 
-IndexHolder::IndexHolder()
-  : VboHolder<Index>(VboType::ElementArrayBuffer)
+IndexHolder::IndexHolder(const VboSnapshotPolicy snapshotPolicy)
+  : VboHolder<Index>(VboType::ElementArrayBuffer, snapshotPolicy)
 {
 }
 
@@ -116,12 +62,10 @@ std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index>&
   return std::make_shared<IndexHolder>(elements);
 }
 
-VertexArrayInterface::~VertexArrayInterface() {}
-
 // BrushIndexArray
 
 BrushIndexArray::BrushIndexArray()
-  : m_indexHolder()
+  : m_indexHolder(VboSnapshotPolicy::Discard)
   , m_allocationTracker(0)
 {
 }
@@ -194,7 +138,7 @@ void BrushIndexArray::cleanupIndices()
 // BrushVertexArray
 
 BrushVertexArray::BrushVertexArray()
-  : m_vertexHolder()
+  : m_vertexHolder(VboSnapshotPolicy::Discard)
   , m_allocationTracker(0)
 {
 }
@@ -23,6 +23,7 @@
 #include "Model/BrushGeometry.h"
 #include "Model/BrushNode.h"
 #include "Model/Polyhedron.h"
+#include "Model/TexCoordSystem.h"
 
 #include <algorithm>
 
@@ -83,6 +84,8 @@ void BrushRendererBrushCache::validateVertexCache(const Model::BrushNode& brushN
   for (const auto& face : brush.faces())
   {
     const auto indexOfFirstVertexRelativeToBrush = m_cachedVertices.size();
+    const auto normal = quantizeNormal(vm::vec3f{face.boundary().normal});
+    const auto texCoords = face.textureCoordsProjection();
 
     // The boundary is in CCW order, but the renderer expects CW order:
     auto& boundary = face.geometry()->boundary();
@@ -99,10 +102,7 @@ void BrushRendererBrushCache::validateVertexCache(const Model::BrushNode& brushN
       vertex->setPayload(static_cast<GLuint>(currentIndex));
 
       const auto& position = vertex->position();
-      m_cachedVertices.emplace_back(
-        vm::vec3f{position},
-        vm::vec3f{face.boundary().normal},
-        face.textureCoords(position));
+      m_cachedVertices.emplace_back(vm::vec3f{position}, normal, texCoords(position));
 
       currentHalfEdge = currentHalfEdge->previous();
     }
@@ -41,7 +41,7 @@ namespace Renderer
 class BrushRendererBrushCache
 {
 public:
-  using VertexSpec = Renderer::GLVertexTypes::P3NT2;
+  using VertexSpec = Renderer::GLVertexTypes::P3NBT2;
   using Vertex = VertexSpec::Vertex;
 
   struct CachedFace
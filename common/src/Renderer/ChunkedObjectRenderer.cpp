@@ -0,0 +1,382 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ChunkedObjectRenderer.h"
+
+#include "Assets/Texture.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/EditorContext.h"
+#include "Model/Polyhedron.h"
+#include "Model/TagAttribute.h"
+#include "Renderer/Camera.h"
+#include "Renderer/ObjectRenderer.h"
+#include "Renderer/PortalCuller.h"
+#include "Renderer/RenderContext.h"
+
+#include <kdl/map_utils.h>
+#include <kdl/overload.h>
+
+#include <vecmath/scalar.h>
+
+#include <algorithm>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+// the edge length of the grid cells that nodes are sorted into
+constexpr auto ChunkSize = FloatType(1024);
+
+// brush faces smaller than this are not used as occluders
+constexpr auto MinOccluderArea = FloatType(64 * 64);
+
+// limits the time spent rasterizing occluders in a single frame
+constexpr auto MaxOccludersPerFrame = size_t(1024);
+
+constexpr auto DepthBufferWidth = size_t(256);
+constexpr auto DepthBufferHeight = size_t(160);
+
+bool isOpaque(const Model::BrushFace& face)
+{
+  const auto* texture = face.texture();
+  return !face.hasAttribute(Model::TagAttributes::Transparency)
+         && !(texture && texture->masked());
+}
+} // namespace
+
+ChunkedObjectRenderer::ChunkedObjectRenderer(
+  CreateRenderer createRenderer,
+  SetupRenderer setupRenderer,
+  const Model::EditorContext& editorContext)
+  : m_createRenderer{std::move(createRenderer)}
+  , m_setupRenderer{std::move(setupRenderer)}
+  , m_editorContext{editorContext}
+  , m_occlusionCuller{DepthBufferWidth, DepthBufferHeight}
+{
+}
+
+ChunkedObjectRenderer::~ChunkedObjectRenderer() = default;
+
+void ChunkedObjectRenderer::setOcclusionCulling(const bool occlusionCulling)
+{
+  const auto wasChunked = chunked();
+  m_occlusionCulling = occlusionCulling;
+  updateChunks(wasChunked);
+}
+
+void ChunkedObjectRenderer::setPortalCuller(std::unique_ptr<PortalCuller> portalCuller)
+{
+  const auto wasChunked = chunked();
+  m_portalCuller = std::move(portalCuller);
+  updateChunks(wasChunked);
+}
+
+bool ChunkedObjectRenderer::hasPortalCuller() const
+{
+  return m_portalCuller != nullptr;
+}
+
+void ChunkedObjectRenderer::addNode(Model::Node* node)
+{
+  const auto key = chunkKey(node);
+  auto& chunk = findOrCreateChunk(key);
+  chunk.renderer->addNode(node);
+  chunk.nodes.insert(node);
+  chunk.valid = false;
+
+  m_nodeChunks[node] = key;
+}
+
+void ChunkedObjectRenderer::removeNode(Model::Node* node)
+{
+  if (const auto it = m_nodeChunks.find(node); it != m_nodeChunks.end())
+  {
+    // empty chunks are removed in cull()
+    auto& chunk = m_chunks.at(it->second);
+    chunk.renderer->removeNode(node);
+    chunk.nodes.erase(node);
+    chunk.valid = false;
+
+    m_nodeChunks.erase(it);
+  }
+}
+
+void ChunkedObjectRenderer::invalidateNode(Model::Node* node)
+{
+  if (const auto it = m_nodeChunks.find(node); it != m_nodeChunks.end())
+  {
+    if (chunkKey(node) != it->second)
+    {
+      // the node has moved to another chunk
+      removeNode(node);
+      addNode(node);
+    }
+    else
+    {
+      auto& chunk = m_chunks.at(it->second);
+      chunk.renderer->invalidateNode(node);
+      chunk.valid = false;
+    }
+  }
+}
+
+void ChunkedObjectRenderer::invalidate()
+{
+  for (auto& [key, chunk] : m_chunks)
+  {
+    chunk.renderer->invalidate();
+    chunk.valid = false;
+  }
+}
+
+void ChunkedObjectRenderer::clear()
+{
+  for (auto& [key, chunk] : m_chunks)
+  {
+    chunk.renderer->clear();
+  }
+  m_chunks.clear();
+  m_nodeChunks.clear();
+  m_visibleRenderers.clear();
+}
+
+void ChunkedObjectRenderer::reloadModels()
+{
+  for (auto& [key, chunk] : m_chunks)
+  {
+    chunk.renderer->reloadModels();
+  }
+}
+
+void ChunkedObjectRenderer::setupRenderers()
+{
+  for (auto& [key, chunk] : m_chunks)
+  {
+    m_setupRenderer(*chunk.renderer);
+  }
+}
+
+void ChunkedObjectRenderer::setShowOverlays(const bool showOverlays)
+{
+  for (auto& [key, chunk] : m_chunks)
+  {
+    chunk.renderer->setShowOverlays(showOverlays);
+  }
+}
+
+void ChunkedObjectRenderer::cull(
+  const RenderContext& renderContext, const bool portalCulling)
+{
+  m_visibleRenderers.clear();
+
+  for (auto it = m_chunks.begin(); it != m_chunks.end();)
+  {
+    it = it->second.nodes.empty() ? m_chunks.erase(it) : std::next(it);
+  }
+
+  if (!chunked() || !renderContext.render3D())
+  {
+    for (auto& [key, chunk] : m_chunks)
+    {
+      m_visibleRenderers.push_back(chunk.renderer.get());
+    }
+    return;
+  }
+
+  const auto& camera = renderContext.camera();
+  const auto& position = camera.position();
+  const auto viewProjectionMatrix = camera.projectionMatrix() * camera.viewMatrix();
+
+  auto* portalCuller = portalCulling ? m_portalCuller.get() : nullptr;
+  if (portalCuller)
+  {
+    portalCuller->update(position, viewProjectionMatrix);
+  }
+  if (m_occlusionCulling)
+  {
+    m_occlusionCuller.reset(viewProjectionMatrix);
+  }
+
+  auto chunksByDistance = std::vector<std::pair<float, Chunk*>>{};
+  chunksByDistance.reserve(m_chunks.size());
+  for (auto& [key, chunk] : m_chunks)
+  {
+    if (!chunk.valid)
+    {
+      validateChunk(chunk);
+    }
+
+    const auto& bounds = *chunk.bounds;
+    const auto closest = vm::max(bounds.min, vm::min(bounds.max, position));
+    chunksByDistance.emplace_back(vm::squared_distance(closest, position), &chunk);
+  }
+
+  std::sort(
+    chunksByDistance.begin(),
+    chunksByDistance.end(),
+    [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+  // if faces are not rendered, nothing is occluded
+  const auto addOccluders = m_occlusionCulling && renderContext.showFaces();
+  auto occluderCount = size_t(0);
+
+  for (auto& [distance, chunk] : chunksByDistance)
+  {
+    if (portalCuller && !portalCuller->isVisible(*chunk->bounds))
+    {
+      continue;
+    }
+    if (m_occlusionCulling && !m_occlusionCuller.isVisible(*chunk->bounds))
+    {
+      continue;
+    }
+
+    m_visibleRenderers.push_back(chunk->renderer.get());
+
+    if (addOccluders)
+    {
+      for (const auto& occluder : chunk->occluders)
+      {
+        if (occluderCount == MaxOccludersPerFrame)
+        {
+          break;
+        }
+
+        // only front faces are rendered
+        if (occluder.plane.point_distance(position) > 0.0f)
+        {
+          m_occlusionCuller.addOccluder(occluder.vertices);
+          ++occluderCount;
+        }
+      }
+    }
+  }
+}
+
+void ChunkedObjectRenderer::renderOpaque(
+  RenderContext& renderContext, RenderBatch& renderBatch)
+{
+  for (auto* renderer : m_visibleRenderers)
+  {
+    renderer->renderOpaque(renderContext, renderBatch);
+  }
+}
+
+void ChunkedObjectRenderer::renderTransparent(
+  RenderContext& renderContext, RenderBatch& renderBatch)
+{
+  for (auto* renderer : m_visibleRenderers)
+  {
+    renderer->renderTransparent(renderContext, renderBatch);
+  }
+}
+
+bool ChunkedObjectRenderer::chunked() const
+{
+  return m_occlusionCulling || m_portalCuller;
+}
+
+void ChunkedObjectRenderer::updateChunks(const bool wasChunked)
+{
+  if (chunked() != wasChunked)
+  {
+    const auto nodes = kdl::map_keys(m_nodeChunks);
+    clear();
+
+    for (auto* node : nodes)
+    {
+      addNode(node);
+    }
+  }
+}
+
+vm::vec3i ChunkedObjectRenderer::chunkKey(const Model::Node* node) const
+{
+  if (!chunked())
+  {
+    return vm::vec3i::zero();
+  }
+
+  return vm::vec3i{vm::floor(node->logicalBounds().center() / ChunkSize)};
+}
+
+ChunkedObjectRenderer::Chunk& ChunkedObjectRenderer::findOrCreateChunk(
+  const vm::vec3i& key)
+{
+  auto [it, inserted] = m_chunks.try_emplace(key);
+  if (inserted)
+  {
+    it->second.renderer = m_createRenderer();
+    m_setupRenderer(*it->second.renderer);
+  }
+  return it->second;
+}
+
+void ChunkedObjectRenderer::validateChunk(Chunk& chunk) const
+{
+  chunk.bounds = std::nullopt;
+  chunk.occluders.clear();
+
+  const auto addOccluders = [&](const Model::BrushNode* brushNode) {
+    if (
+      !m_editorContext.visible(brushNode) || !m_editorContext.editable(brushNode)
+      || brushNode->hasAttribute(Model::TagAttributes::Transparency))
+    {
+      return;
+    }
+
+    for (const auto& face : brushNode->brush().faces())
+    {
+      if (
+        face.area() >= MinOccluderArea && !face.selected()
+        && m_editorContext.visible(brushNode, face) && isOpaque(face))
+      {
+        auto vertices = std::vector<vm::vec3f>{};
+        for (const auto* vertex : face.vertices())
+        {
+          vertices.emplace_back(vertex->position());
+        }
+        chunk.occluders.push_back(
+          Occluder{vm::plane3f{face.boundary()}, std::move(vertices)});
+      }
+    }
+  };
+
+  for (auto* node : chunk.nodes)
+  {
+    const auto bounds = vm::bbox3f{node->physicalBounds()};
+    chunk.bounds = chunk.bounds ? vm::merge(*chunk.bounds, bounds) : bounds;
+
+    node->accept(kdl::overload(
+      [](Model::WorldNode*) {},
+      [](Model::LayerNode*) {},
+      [](Model::GroupNode*) {},
+      [](Model::EntityNode*) {},
+      [&](Model::BrushNode* brushNode) { addOccluders(brushNode); },
+      [](Model::PatchNode*) {}));
+  }
+
+  chunk.valid = true;
+}
+} // namespace Renderer
+} // namespace TrenchBroom
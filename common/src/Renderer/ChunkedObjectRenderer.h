@@ -0,0 +1,158 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+#include "Macros.h"
+#include "Renderer/OcclusionCuller.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/forward.h>
+#include <vecmath/plane.h>
+#include <vecmath/vec.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+class EditorContext;
+class Node;
+} // namespace Model
+
+namespace Renderer
+{
+class ObjectRenderer;
+class PortalCuller;
+class RenderBatch;
+class RenderContext;
+
+/**
+ * Distributes nodes over a number of object renderers, one for each cell of a regular
+ * grid, and skips the cells that are outside of the view frustum, in leafs that cannot
+ * be seen from the camera or hidden behind large brush faces when rendering in 3D.
+ *
+ * Leaf visibility is determined by a PortalCuller if a portal file is loaded.
+ *
+ * Occlusion is determined on the CPU by an OcclusionCuller. The chunks are visited front
+ * to back. Each chunk is tested against the occluders of the chunks visited before it,
+ * and if it is visible, its own occluders are rasterized.
+ *
+ * If both kinds of culling are disabled, all nodes are kept in a single chunk.
+ */
+class ChunkedObjectRenderer
+{
+public:
+  using CreateRenderer = std::function<std::unique_ptr<ObjectRenderer>()>;
+  using SetupRenderer = std::function<void(ObjectRenderer&)>;
+
+private:
+  struct Occluder
+  {
+    vm::plane3f plane;
+    std::vector<vm::vec3f> vertices;
+  };
+
+  struct Chunk
+  {
+    std::unique_ptr<ObjectRenderer> renderer;
+    std::unordered_set<Model::Node*> nodes;
+    std::optional<vm::bbox3f> bounds;
+    std::vector<Occluder> occluders;
+    bool valid = false;
+  };
+
+  CreateRenderer m_createRenderer;
+  SetupRenderer m_setupRenderer;
+  const Model::EditorContext& m_editorContext;
+
+  bool m_occlusionCulling = false;
+  std::unique_ptr<PortalCuller> m_portalCuller;
+  std::map<vm::vec3i, Chunk> m_chunks;
+  std::unordered_map<Model::Node*, vm::vec3i> m_nodeChunks;
+
+  OcclusionCuller m_occlusionCuller;
+  std::vector<ObjectRenderer*> m_visibleRenderers;
+
+public:
+  ChunkedObjectRenderer(
+    CreateRenderer createRenderer,
+    SetupRenderer setupRenderer,
+    const Model::EditorContext& editorContext);
+  ~ChunkedObjectRenderer();
+
+  deleteCopyAndMove(ChunkedObjectRenderer);
+
+  /**
+   * Enables or disables occlusion culling. Enabling the first or disabling the last kind
+   * of culling redistributes all nodes over new chunks.
+   */
+  void setOcclusionCulling(bool occlusionCulling);
+
+  /**
+   * Sets the portal culler to use, or disables portal culling if the given culler is
+   * null.
+   */
+  void setPortalCuller(std::unique_ptr<PortalCuller> portalCuller);
+  bool hasPortalCuller() const;
+
+public: // object management
+  void addNode(Model::Node* node);
+  void removeNode(Model::Node* node);
+  void invalidateNode(Model::Node* node);
+  void invalidate();
+  void clear();
+  void reloadModels();
+
+public: // configuration
+  /**
+   * Applies the setup function to every chunk renderer.
+   */
+  void setupRenderers();
+  void setShowOverlays(bool showOverlays);
+
+public: // rendering
+  /**
+   * Determines the chunks to render for the given context. Must be called before
+   * renderOpaque and renderTransparent.
+   *
+   * The portal culler is only used if portalCulling is true, which the caller must only
+   * pass if the camera is in the volume described by the portal file.
+   */
+  void cull(const RenderContext& renderContext, bool portalCulling);
+  void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
+  void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
+
+private:
+  bool chunked() const;
+  void updateChunks(bool wasChunked);
+  vm::vec3i chunkKey(const Model::Node* node) const;
+  Chunk& findOrCreateChunk(const vm::vec3i& key);
+  void validateChunk(Chunk& chunk) const;
+};
+} // namespace Renderer
+} // namespace TrenchBroom
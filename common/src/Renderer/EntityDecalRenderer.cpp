@@ -32,7 +32,7 @@
 #include "Model/TexCoordSystem.h"
 #include "Model/WorldNode.h"
 #include "View/MapDocument.h"
-#include "octree.h"
+#include "aabb_tree.h"
 
 #include <kdl/memory_utils.h>
 #include <kdl/overload.h>
@@ -54,7 +54,7 @@ std::optional<Assets::DecalSpecification> getDecalSpecification(
   return decalSpec.textureName.empty() ? std::nullopt : std::make_optional(decalSpec);
 }
 
-using Vertex = Renderer::GLVertexTypes::P3NT2::Vertex;
+using Vertex = Renderer::GLVertexTypes::P3NBT2::Vertex;
 std::vector<Vertex> createDecalBrushFace(
   const Model::EntityNode* entityNode,
   const Model::BrushNode* brush,
@@ -124,10 +124,10 @@ std::vector<Vertex> createDecalBrushFace(
   }
 
   // convert the geometry into a list of vertices
-  const auto norm = vm::vec3f{plane.normal};
-  return kdl::vec_transform(verts, [&](const auto& v) {
-    return Vertex{vm::vec3f{v}, norm, tex->getTexCoords(v, attrs, textureSize)};
-  });
+  const auto norm = quantizeNormal(vm::vec3f{plane.normal});
+  const auto projection = tex->getTexCoordProjection(attrs, textureSize);
+  return kdl::vec_transform(
+    verts, [&](const auto& v) { return Vertex{vm::vec3f{v}, norm, projection(v)}; });
 }
 
 } // namespace
@@ -33,6 +33,7 @@
 
 #include <kdl/memory_utils.h>
 #include <kdl/overload.h>
+#include <kdl/vector_utils.h>
 
 #include <vecmath/vec.h>
 
@@ -65,6 +66,16 @@ void EntityLinkRenderer::setSelectedColor(const Color& selectedColor)
   }
 }
 
+void EntityLinkRenderer::invalidate()
+{
+  LinkRenderer::invalidate();
+
+  m_sourceLinks.clear();
+  m_sourcesByTarget.clear();
+  m_invalidEntities.clear();
+  m_linkGraphValid = false;
+}
+
 namespace
 {
 
@@ -304,11 +315,231 @@ auto getLinks(
 
   return std::vector<LinkRenderer::LineVertex>{};
 }
+
+void addContainingEntity(
+  const Model::Node& node, std::unordered_set<const Model::EntityNodeBase*>& result)
+{
+  if (const auto* entityNode = dynamic_cast<const Model::EntityNode*>(node.parent()))
+  {
+    result.insert(entityNode);
+  }
+}
+
+auto collectEntities(const std::vector<Model::Node*>& nodes, const bool recursive)
+{
+  auto result = std::unordered_set<const Model::EntityNodeBase*>{};
+
+  for (const auto* node : nodes)
+  {
+    node->accept(kdl::overload(
+      [&](auto&& thisLambda, const Model::WorldNode* worldNode) {
+        if (recursive)
+        {
+          worldNode->visitChildren(thisLambda);
+        }
+      },
+      [&](auto&& thisLambda, const Model::LayerNode* layerNode) {
+        if (recursive)
+        {
+          layerNode->visitChildren(thisLambda);
+        }
+      },
+      [&](auto&& thisLambda, const Model::GroupNode* groupNode) {
+        if (recursive)
+        {
+          groupNode->visitChildren(thisLambda);
+        }
+      },
+      [&](const Model::EntityNode* entityNode) { result.insert(entityNode); },
+      [&](const Model::BrushNode* brushNode) {
+        addContainingEntity(*brushNode, result);
+      },
+      [&](const Model::PatchNode* patchNode) {
+        addContainingEntity(*patchNode, result);
+      }));
+  }
+
+  return result;
+}
 } // namespace
 
+void EntityLinkRenderer::invalidateNodes(
+  const std::vector<Model::Node*>& nodes, const bool recursive)
+{
+  if (m_linkGraphValid)
+  {
+    const auto entities = collectEntities(nodes, recursive);
+    m_invalidEntities.insert(entities.begin(), entities.end());
+  }
+  LinkRenderer::invalidate();
+}
+
+void EntityLinkRenderer::removeNodes(const std::vector<Model::Node*>& nodes)
+{
+  if (m_linkGraphValid)
+  {
+    const auto entities = collectEntities(nodes, true);
+    for (const auto* entity : entities)
+    {
+      m_invalidEntities.erase(entity);
+      removeSourceLinks(entity);
+    }
+
+    // the remaining sources that linked to the removed entities must be updated, and
+    // they must forget the removed entities since their addresses may be reused
+    for (const auto* entity : entities)
+    {
+      if (const auto it = m_sourcesByTarget.find(entity); it != m_sourcesByTarget.end())
+      {
+        for (const auto* source : it->second)
+        {
+          if (entities.count(source) == 0)
+          {
+            if (const auto sourceIt = m_sourceLinks.find(source);
+                sourceIt != m_sourceLinks.end())
+            {
+              auto& targets = sourceIt->second.targets;
+              targets = kdl::vec_erase(std::move(targets), entity);
+            }
+            m_invalidEntities.insert(source);
+          }
+        }
+        m_sourcesByTarget.erase(it);
+      }
+    }
+  }
+  LinkRenderer::invalidate();
+}
+
+void EntityLinkRenderer::validate()
+{
+  if (pref(Preferences::EntityLinkMode) != Preferences::entityLinkModeAll())
+  {
+    // the other modes only show the links of the selection, which are cheap to collect
+    invalidate();
+    LinkRenderer::validate();
+    return;
+  }
+
+  validateLinkGraph(*kdl::mem_lock(m_document));
+}
+
 std::vector<LinkRenderer::LineVertex> EntityLinkRenderer::getLinks()
 {
   return Renderer::getLinks(*kdl::mem_lock(m_document), m_defaultColor, m_selectedColor);
 }
 
+void EntityLinkRenderer::validateLinkGraph(View::MapDocument& document)
+{
+  const auto& editorContext = document.editorContext();
+
+  if (!m_linkGraphValid)
+  {
+    clearLinks();
+    m_sourceLinks.clear();
+    m_sourcesByTarget.clear();
+    m_invalidEntities.clear();
+
+    if (document.world())
+    {
+      document.world()->accept(kdl::overload(
+        [](auto&& thisLambda, const Model::WorldNode* worldNode) {
+          worldNode->visitChildren(thisLambda);
+        },
+        [](auto&& thisLambda, const Model::LayerNode* layerNode) {
+          layerNode->visitChildren(thisLambda);
+        },
+        [](auto&& thisLambda, const Model::GroupNode* groupNode) {
+          groupNode->visitChildren(thisLambda);
+        },
+        [&](const Model::EntityNode* entityNode) {
+          updateSourceLinks(entityNode, editorContext);
+        },
+        [](const Model::BrushNode*) {},
+        [](const Model::PatchNode*) {}));
+    }
+
+    m_linkGraphValid = true;
+    return;
+  }
+
+  auto sources = std::unordered_set<const Model::EntityNodeBase*>{};
+  for (const auto* entity : m_invalidEntities)
+  {
+    sources.insert(entity);
+
+    // the sources that linked to the entity before it changed...
+    if (const auto it = m_sourcesByTarget.find(entity); it != m_sourcesByTarget.end())
+    {
+      sources.insert(it->second.begin(), it->second.end());
+    }
+
+    // ...and the sources that link to it now
+    sources.insert(entity->linkSources().begin(), entity->linkSources().end());
+    sources.insert(entity->killSources().begin(), entity->killSources().end());
+  }
+  m_invalidEntities.clear();
+
+  for (const auto* source : sources)
+  {
+    updateSourceLinks(source, editorContext);
+  }
+}
+
+void EntityLinkRenderer::updateSourceLinks(
+  const Model::EntityNodeBase* source, const Model::EditorContext& editorContext)
+{
+  removeSourceLinks(source);
+
+  // only entities are link sources, see CollectAllLinksVisitor
+  if (!dynamic_cast<const Model::EntityNode*>(source))
+  {
+    return;
+  }
+
+  auto links = std::vector<LinkRenderer::LineVertex>{};
+  auto targets = std::vector<const Model::EntityNodeBase*>{};
+
+  const auto sourceVisible = editorContext.visible(source);
+  const auto addTargets = [&](const auto& targetNodes) {
+    for (const auto* target : targetNodes)
+    {
+      // remember invisible targets, too, so that showing them updates this source
+      targets.push_back(target);
+      m_sourcesByTarget[target].insert(source);
+
+      if (sourceVisible && editorContext.visible(target))
+      {
+        addLink(*source, *target, m_defaultColor, m_selectedColor, links);
+      }
+    }
+  };
+
+  addTargets(source->linkTargets());
+  addTargets(source->killTargets());
+
+  m_sourceLinks.emplace(source, SourceLinks{addLinks(links), std::move(targets)});
+}
+
+void EntityLinkRenderer::removeSourceLinks(const Model::EntityNodeBase* source)
+{
+  if (const auto it = m_sourceLinks.find(source); it != m_sourceLinks.end())
+  {
+    removeLinks(it->second.blocks);
+    for (const auto* target : it->second.targets)
+    {
+      if (const auto targetIt = m_sourcesByTarget.find(target);
+          targetIt != m_sourcesByTarget.end())
+      {
+        targetIt->second.erase(source);
+        if (targetIt->second.empty())
+        {
+          m_sourcesByTarget.erase(targetIt);
+        }
+      }
+    }
+    m_sourceLinks.erase(it);
+  }
+}
+
 } // namespace TrenchBroom::Renderer
@@ -24,8 +24,17 @@
 #include "Renderer/LinkRenderer.h"
 
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+namespace TrenchBroom::Model
+{
+class EditorContext;
+class EntityNodeBase;
+class Node;
+} // namespace TrenchBroom::Model
+
 namespace TrenchBroom::View
 {
 class MapDocument; // FIXME: Renderer should not depend on View
@@ -41,15 +50,54 @@ class EntityLinkRenderer : public LinkRenderer
   Color m_defaultColor = {0.5f, 1.0f, 0.5f, 1.0f};
   Color m_selectedColor = {1.0f, 0.0f, 0.0f, 1.0f};
 
+  struct SourceLinks
+  {
+    LinkBlocks blocks;
+    std::vector<const Model::EntityNodeBase*> targets;
+  };
+
+  /**
+   * In the "all" link mode, the link graph is kept between validations and only the
+   * links of invalidated entities are updated. The graph maps every source entity to its
+   * links and every target to the sources that link to it, so that changing a target
+   * also updates the links pointing to it.
+   */
+  std::unordered_map<const Model::EntityNodeBase*, SourceLinks> m_sourceLinks;
+  std::unordered_map<
+    const Model::EntityNodeBase*,
+    std::unordered_set<const Model::EntityNodeBase*>>
+    m_sourcesByTarget;
+  std::unordered_set<const Model::EntityNodeBase*> m_invalidEntities;
+  bool m_linkGraphValid = false;
+
 public:
   explicit EntityLinkRenderer(std::weak_ptr<View::MapDocument> document);
 
   void setDefaultColor(const Color& color);
   void setSelectedColor(const Color& color);
 
+  void invalidate() override;
+
+  /**
+   * Invalidates the links of the entities among or containing the given nodes. If
+   * recursive is true, the entities contained in the given nodes are invalidated, too.
+   */
+  void invalidateNodes(const std::vector<Model::Node*>& nodes, bool recursive);
+
+  /**
+   * Must be called when the given nodes are removed from the document.
+   */
+  void removeNodes(const std::vector<Model::Node*>& nodes);
+
 private:
+  void validate() override;
   std::vector<LinkRenderer::LineVertex> getLinks() override;
 
+  void validateLinkGraph(View::MapDocument& document);
+  void updateSourceLinks(
+    const Model::EntityNodeBase* source, const Model::EditorContext& editorContext);
+  void removeSourceLinks(const Model::EntityNodeBase* source);
+
   deleteCopy(EntityLinkRenderer);
 };
 
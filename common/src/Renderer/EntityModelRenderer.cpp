@@ -39,14 +39,45 @@
 #include "Renderer/TexturedIndexRangeRenderer.h"
 #include "Renderer/Transformation.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/mat.h>
+#include <vecmath/vec.h>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
+namespace
+{
+const auto OrientationUniform = Uniform{"Orientation"};
+const auto ModelMatrixUniform = Uniform{"ModelMatrix"};
+
+// the minimum size on screen in pixels at which each level of detail is rendered
+constexpr auto LodScreenSizes =
+  std::array<float, Assets::EntityModelLodCount>{160.0f, 48.0f, 0.0f};
+
+// models that are smaller than this on screen are rendered as impostors
+constexpr auto ImpostorScreenSize = 6.0f;
+
+/**
+ * Returns the approximate size of the given entity on screen in pixels.
+ */
+float screenSize(const Model::EntityNode& entityNode, const Camera& camera)
+{
+  const auto bounds = vm::bbox3f{entityNode.physicalBounds()};
+  const auto scalingFactor = std::abs(camera.perspectiveScalingFactor(bounds.center()));
+  return scalingFactor > 0.0f ? vm::length(bounds.size()) / scalingFactor
+                              : std::numeric_limits<float>::max();
+}
+} // namespace
+
 EntityModelRenderer::EntityModelRenderer(
   Logger& logger,
   Assets::EntityModelManager& entityModelManager,
@@ -66,15 +97,10 @@ EntityModelRenderer::~EntityModelRenderer()
 
 void EntityModelRenderer::addEntity(const Model::EntityNode* entityNode)
 {
-  const auto modelSpec =
-    Assets::safeGetModelSpecification(m_logger, entityNode->entity().classname(), [&]() {
-      return entityNode->entity().modelSpecification();
-    });
-
-  auto* renderer = m_entityModelManager.renderer(modelSpec);
-  if (renderer != nullptr)
+  auto renderers = findRenderers(entityNode);
+  if (!renderers.lods.empty())
   {
-    m_entities.emplace(entityNode, renderer);
+    m_entities.emplace(entityNode, std::move(renderers));
   }
 }
 
@@ -85,33 +111,14 @@ void EntityModelRenderer::removeEntity(const Model::EntityNode* entityNode)
 
 void EntityModelRenderer::updateEntity(const Model::EntityNode* entityNode)
 {
-  const auto modelSpec =
-    Assets::safeGetModelSpecification(m_logger, entityNode->entity().classname(), [&]() {
-      return entityNode->entity().modelSpecification();
-    });
-
-  auto* renderer = m_entityModelManager.renderer(modelSpec);
-  auto it = m_entities.find(entityNode);
-
-  if (renderer == nullptr && it == std::end(m_entities))
+  auto renderers = findRenderers(entityNode);
+  if (renderers.lods.empty())
   {
-    return;
-  }
-
-  if (it == std::end(m_entities))
-  {
-    m_entities.emplace(entityNode, renderer);
+    m_entities.erase(entityNode);
   }
   else
   {
-    if (renderer == nullptr)
-    {
-      m_entities.erase(it);
-    }
-    else if (it->second != renderer)
-    {
-      it->second = renderer;
-    }
+    m_entities[entityNode] = std::move(renderers);
   }
 }
 
@@ -155,6 +162,32 @@ void EntityModelRenderer::render(RenderBatch& renderBatch)
   renderBatch.add(this);
 }
 
+EntityModelRenderer::ModelRenderers EntityModelRenderer::findRenderers(
+  const Model::EntityNode* entityNode) const
+{
+  const auto modelSpec =
+    Assets::safeGetModelSpecification(m_logger, entityNode->entity().classname(), [&]() {
+      return entityNode->entity().modelSpecification();
+    });
+
+  auto result = ModelRenderers{};
+  if (auto* renderer = m_entityModelManager.renderer(modelSpec))
+  {
+    result.lods.push_back(renderer);
+
+    const auto lodCount =
+      std::min(m_entityModelManager.lodCount(modelSpec), Assets::EntityModelLodCount);
+    for (size_t lodIndex = 1; lodIndex < lodCount; ++lodIndex)
+    {
+      // keep missing levels as null so that the indices match the screen sizes
+      result.lods.push_back(m_entityModelManager.renderer(modelSpec, lodIndex));
+    }
+
+    result.impostor = m_entityModelManager.impostorRenderer(modelSpec);
+  }
+  return result;
+}
+
 void EntityModelRenderer::doPrepareVertices(VboManager& vboManager)
 {
   m_entityModelManager.prepare(vboManager);
@@ -165,7 +198,7 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
   auto& prefs = PreferenceManager::instance();
 
   glAssert(glEnable(GL_TEXTURE_2D));
-  glAssert(glActiveTexture(GL_TEXTURE0));
+  glActiveTextureCached(GL_TEXTURE0);
 
   auto shader = ActiveShader{renderContext.shaderManager(), Shaders::EntityModelShader};
   shader.set("Brightness", prefs.get(Preferences::Brightness));
@@ -190,7 +223,7 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
   shader.set("CameraUp", renderContext.camera().up());
   shader.set("ViewMatrix", renderContext.camera().viewMatrix());
 
-  for (const auto& [entityNode, renderer] : m_entities)
+  for (const auto& [entityNode, renderers] : m_entities)
   {
     if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
     {
@@ -203,16 +236,41 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
       continue;
     }
 
-    shader.set("Orientation", static_cast<int>(model->orientation()));
+    shader.set(OrientationUniform, static_cast<int>(model->orientation()));
 
     const auto transformation = vm::mat4x4f{entityNode->entity().modelTransformation()};
     const auto multMatrix =
       MultiplyModelMatrix{renderContext.transformation(), transformation};
 
-    shader.set("ModelMatrix", transformation);
+    shader.set(ModelMatrixUniform, transformation);
 
-    renderer->render();
+    const auto size = screenSize(*entityNode, renderContext.camera());
+    if (size < ImpostorScreenSize && renderers.impostor)
+    {
+      renderers.impostor->render();
+    }
+    else
+    {
+      renderers.lods[selectEntityModelLod(size, renderers.lods)]->render();
+    }
+  }
+}
+
+size_t selectEntityModelLod(
+  const float screenSize, const std::vector<TexturedRenderer*>& lods)
+{
+  assert(!lods.empty() && lods.front());
+
+  auto lodIndex = size_t(0);
+  while (lodIndex + 1u < lods.size() && screenSize < LodScreenSizes[lodIndex])
+  {
+    ++lodIndex;
+  }
+  while (!lods[lodIndex])
+  {
+    --lodIndex;
   }
+  return lodIndex;
 }
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -22,7 +22,9 @@
 #include "Color.h"
 #include "Renderer/Renderable.h"
 
+#include <cstddef>
 #include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -53,7 +55,15 @@ private:
   Assets::EntityModelManager& m_entityModelManager;
   const Model::EditorContext& m_editorContext;
 
-  std::unordered_map<const Model::EntityNode*, TexturedRenderer*> m_entities;
+  struct ModelRenderers
+  {
+    // one renderer for each level of detail, starting with the full model, or null if
+    // that level of detail is missing
+    std::vector<TexturedRenderer*> lods;
+    TexturedRenderer* impostor = nullptr;
+  };
+
+  std::unordered_map<const Model::EntityNode*, ModelRenderers> m_entities;
 
   bool m_applyTinting;
   Color m_tintColor;
@@ -110,8 +120,17 @@ public:
   void render(RenderBatch& renderBatch);
 
 private:
+  ModelRenderers findRenderers(const Model::EntityNode* entityNode) const;
+
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
 };
+
+/**
+ * Selects the level of detail for an entity model of the given size on screen in pixels.
+ * The given renderers are indexed by level of detail. If the selected level is missing,
+ * the next more detailed level is used instead. The full model must not be missing.
+ */
+size_t selectEntityModelLod(float screenSize, const std::vector<TexturedRenderer*>& lods);
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -36,6 +36,14 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
+namespace
+{
+const auto ApplyTextureUniform = Uniform{"ApplyTexture"};
+const auto ColorUniform = Uniform{"Color"};
+const auto GridColorUniform = Uniform{"GridColor"};
+const auto EnableMaskedUniform = Uniform{"EnableMasked"};
+} // namespace
+
 struct FaceRenderer::RenderFunc : public TextureRenderFunc
 {
   ActiveShader& shader;
@@ -55,13 +63,13 @@ struct FaceRenderer::RenderFunc : public TextureRenderFunc
     if (texture != nullptr)
     {
       texture->activate();
-      shader.set("ApplyTexture", applyTexture);
-      shader.set("Color", texture->averageColor());
+      shader.set(ApplyTextureUniform, applyTexture);
+      shader.set(ColorUniform, texture->averageColor());
     }
     else
     {
-      shader.set("ApplyTexture", false);
-      shader.set("Color", defaultColor);
+      shader.set(ApplyTextureUniform, false);
+      shader.set(ColorUniform, defaultColor);
     }
   }
 
@@ -176,7 +184,7 @@ void FaceRenderer::doRender(RenderContext& context)
     const bool showFog = context.showFog();
 
     glAssert(glEnable(GL_TEXTURE_2D));
-    glAssert(glActiveTexture(GL_TEXTURE0));
+    glActiveTextureCached(GL_TEXTURE0);
     shader.set("Brightness", prefs.get(Preferences::Brightness));
     shader.set("RenderGrid", context.showGrid());
     shader.set("GridSize", static_cast<float>(context.gridSize()));
@@ -218,8 +226,8 @@ void FaceRenderer::doRender(RenderContext& context)
       const bool enableMasked = texture != nullptr && texture->masked();
 
       // set any per-texture uniforms
-      shader.set("GridColor", gridColorForTexture(texture));
-      shader.set("EnableMasked", enableMasked);
+      shader.set(GridColorUniform, gridColorForTexture(texture));
+      shader.set(EnableMaskedUniform, enableMasked);
 
       func.before(texture);
       brushIndexHolderPtr->setupIndices();
@@ -71,6 +71,7 @@ FontTexture::~FontTexture()
   if (m_textureId != 0)
   {
     glAssert(glDeleteTextures(1, &m_textureId));
+    glResetStateCache();
     m_textureId = 0;
   }
   delete[] m_buffer;
@@ -88,7 +89,7 @@ void FontTexture::activate()
   {
     ensure(m_buffer != nullptr, "buffer is null");
     glAssert(glGenTextures(1, &m_textureId));
-    glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+    glBindTextureCached(GL_TEXTURE_2D, m_textureId);
     glAssert(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
     glAssert(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
     glAssert(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
@@ -108,12 +109,12 @@ void FontTexture::activate()
   }
 
   assert(m_textureId > 0);
-  glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+  glBindTextureCached(GL_TEXTURE_2D, m_textureId);
 }
 
 void FontTexture::deactivate()
 {
-  glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+  glBindTextureCached(GL_TEXTURE_2D, 0);
 }
 
 size_t FontTexture::computeTextureSize(
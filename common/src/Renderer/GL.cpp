@@ -21,6 +21,7 @@
 
 #include "Exceptions.h"
 
+#include <optional>
 #include <string>
 
 namespace TrenchBroom
@@ -143,4 +144,78 @@ std::string glGetEnumName(const GLenum _enum)
     return "Unknown OpenGL enum";
   }
 }
+
+namespace
+{
+struct GLStateCache
+{
+  std::optional<GLuint> arrayBuffer;
+  std::optional<GLuint> elementArrayBuffer;
+  std::optional<GLenum> activeTexture;
+  std::optional<GLuint> texture2D;
+};
+
+GLStateCache& stateCache()
+{
+  static auto cache = GLStateCache{};
+  return cache;
+}
+
+std::optional<GLuint>* cachedBufferBinding(const GLenum target)
+{
+  switch (target)
+  {
+  case GL_ARRAY_BUFFER:
+    return &stateCache().arrayBuffer;
+  case GL_ELEMENT_ARRAY_BUFFER:
+    return &stateCache().elementArrayBuffer;
+  default:
+    return nullptr;
+  }
+}
+} // namespace
+
+void glBindBufferCached(const GLenum target, const GLuint buffer)
+{
+  auto* binding = cachedBufferBinding(target);
+  if (!binding || *binding != buffer)
+  {
+    glAssert(glBindBuffer(target, buffer));
+    if (binding)
+    {
+      *binding = buffer;
+    }
+  }
+}
+
+void glActiveTextureCached(const GLenum unit)
+{
+  auto& cache = stateCache();
+  if (cache.activeTexture != unit)
+  {
+    glAssert(glActiveTexture(unit));
+    cache.activeTexture = unit;
+    // only the bindings of the active unit are shadowed
+    cache.texture2D = std::nullopt;
+  }
+}
+
+void glBindTextureCached(const GLenum target, const GLuint texture)
+{
+  auto& cache = stateCache();
+  if (target != GL_TEXTURE_2D)
+  {
+    glAssert(glBindTexture(target, texture));
+  }
+  else if (cache.texture2D != texture)
+  {
+    glAssert(glBindTexture(target, texture));
+    cache.texture2D = texture;
+  }
+}
+
+void glResetStateCache()
+{
+  stateCache() = GLStateCache{};
+}
 } // namespace TrenchBroom
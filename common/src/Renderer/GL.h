@@ -35,6 +35,18 @@ std::string glGetErrorMessage(GLenum code);
 GLenum glGetEnum(const std::string& name);
 std::string glGetEnumName(GLenum _enum);
 
+/**
+ * Shadowed versions of glBindBuffer, glActiveTexture and glBindTexture that skip the call
+ * if the requested binding is already current.
+ *
+ * The shadowed state is not tied to a context, so it must be reset whenever another
+ * context becomes current and whenever a buffer or texture is deleted.
+ */
+void glBindBufferCached(GLenum target, GLuint buffer);
+void glActiveTextureCached(GLenum unit);
+void glBindTextureCached(GLenum target, GLuint texture);
+void glResetStateCache();
+
 // #define GL_DEBUG 1
 // #define GL_LOG 1
 
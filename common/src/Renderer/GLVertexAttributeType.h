@@ -139,7 +139,8 @@ public:
     const size_t stride,
     const size_t offset)
   {
-    assert(S == 3);
+    // OpenGL always reads three components, a fourth component only pads the attribute
+    assert(S == 3 || S == 4);
     glAssert(glEnableClientState(GL_NORMAL_ARRAY));
     glAssert(glNormalPointer(
       D, static_cast<GLsizei>(stride), reinterpret_cast<GLvoid*>(offset)));
@@ -238,8 +239,19 @@ namespace GLVertexAttributeTypes
 using P2 = GLVertexAttributePosition<GL_FLOAT, 2>;
 using P3 = GLVertexAttributePosition<GL_FLOAT, 3>;
 using N = GLVertexAttributeNormal<GL_FLOAT, 3>;
+// normals with signed byte components, which OpenGL maps to [-1..1], padded to four
+// bytes to keep the following attributes aligned
+using NB = GLVertexAttributeNormal<GL_BYTE, 4>;
 using T02 = GLVertexAttributeTexCoord0<GL_FLOAT, 2>;
 using C4 = GLVertexAttributeColor<GL_FLOAT, 4>;
 } // namespace GLVertexAttributeTypes
+
+/**
+ * Converts the given unit normal into the format of GLVertexAttributeTypes::NB.
+ */
+inline vm::vec<GLbyte, 4> quantizeNormal(const vm::vec3f& normal)
+{
+  return vm::vec<GLbyte, 4>{vm::vec4f{vm::round(normal * 127.0f), 0.0f}};
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -34,6 +34,15 @@ class OrthographicCamera;
 class RenderContext;
 class VboManager;
 
+/**
+ * Renders the grid of a 2D view as a single quad that covers the viewport. The grid lines
+ * are computed analytically by the Grid2D fragment shader from the grid size and the
+ * camera zoom, and grid sizes that would be too dense to see are faded out, so the cost
+ * does not depend on the number of visible grid lines.
+ *
+ * The quad is rebuilt every frame and is meant to be added to a batch with
+ * RenderBatch::addTransient().
+ */
 class GridRenderer : public DirectRenderable
 {
 private:
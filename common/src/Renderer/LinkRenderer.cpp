@@ -30,7 +30,13 @@
 namespace TrenchBroom::Renderer
 {
 
-LinkRenderer::LinkRenderer() = default;
+LinkRenderer::LinkRenderer()
+  : m_lines{std::make_unique<LinkVertexArray<LineVertex>>()}
+  , m_arrows{std::make_unique<LinkVertexArray<ArrowVertex>>()}
+{
+}
+
+LinkRenderer::~LinkRenderer() = default;
 
 void LinkRenderer::render(RenderContext&, RenderBatch& renderBatch)
 {
@@ -42,15 +48,27 @@ void LinkRenderer::invalidate()
   m_valid = false;
 }
 
-void LinkRenderer::doPrepareVertices(VboManager& vboManager)
+std::vector<LinkRenderer::LineVertex> LinkRenderer::lineVertices()
 {
   if (!m_valid)
   {
     validate();
+    m_valid = true;
+  }
+  return m_lines->vertices();
+}
 
-    m_lines.prepare(vboManager);
-    m_arrows.prepare(vboManager);
+void LinkRenderer::doPrepareVertices(VboManager& vboManager)
+{
+  if (!m_valid)
+  {
+    validate();
+    m_valid = true;
   }
+
+  // uploads only the blocks that changed since the last upload, if any
+  m_lines->prepare(vboManager);
+  m_arrows->prepare(vboManager);
 }
 
 void LinkRenderer::doRender(RenderContext& renderContext)
@@ -69,11 +87,11 @@ void LinkRenderer::renderLines(RenderContext& renderContext)
 
   glAssert(glDisable(GL_DEPTH_TEST));
   shader.set("Alpha", 0.4f);
-  m_lines.render(PrimType::Lines);
+  m_lines->render(PrimType::Lines);
 
   glAssert(glEnable(GL_DEPTH_TEST));
   shader.set("Alpha", 1.0f);
-  m_lines.render(PrimType::Lines);
+  m_lines->render(PrimType::Lines);
 }
 
 void LinkRenderer::renderArrows(RenderContext& renderContext)
@@ -86,11 +104,11 @@ void LinkRenderer::renderArrows(RenderContext& renderContext)
 
   glAssert(glDisable(GL_DEPTH_TEST));
   shader.set("Alpha", 0.4f);
-  m_arrows.render(PrimType::Lines);
+  m_arrows->render(PrimType::Lines);
 
   glAssert(glEnable(GL_DEPTH_TEST));
   shader.set("Alpha", 1.0f);
-  m_arrows.render(PrimType::Lines);
+  m_arrows->render(PrimType::Lines);
 }
 
 static void addArrow(
@@ -149,15 +167,27 @@ static std::vector<LinkRenderer::ArrowVertex> getArrows(
   return arrows;
 }
 
-void LinkRenderer::validate()
+LinkRenderer::LinkBlocks LinkRenderer::addLinks(const std::vector<LineVertex>& links)
+{
+  return {m_lines->insert(links), m_arrows->insert(getArrows(links))};
+}
+
+void LinkRenderer::removeLinks(const LinkBlocks& blocks)
 {
-  auto links = getLinks();
-  auto arrows = getArrows(links);
+  m_lines->remove(blocks.lines);
+  m_arrows->remove(blocks.arrows);
+}
 
-  m_lines = VertexArray::move(std::move(links));
-  m_arrows = VertexArray::move(std::move(arrows));
+void LinkRenderer::clearLinks()
+{
+  m_lines = std::make_unique<LinkVertexArray<LineVertex>>();
+  m_arrows = std::make_unique<LinkVertexArray<ArrowVertex>>();
+}
 
-  m_valid = true;
+void LinkRenderer::validate()
+{
+  clearLinks();
+  addLinks(getLinks());
 }
 
 } // namespace TrenchBroom::Renderer
@@ -19,10 +19,20 @@
 
 #pragma once
 
+#include "Renderer/AllocationTracker.h"
 #include "Renderer/GLVertex.h"
 #include "Renderer/GLVertexType.h"
+#include "Renderer/PrimType.h"
 #include "Renderer/Renderable.h"
-#include "Renderer/VertexArray.h"
+#include "Renderer/VertexHolder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom::Renderer
 {
@@ -30,6 +40,115 @@ class RenderContext;
 class RenderBatch;
 class VboManager;
 
+/**
+ * A vertex array that hands out blocks of vertices which can be replaced individually.
+ * Only the changed ranges are uploaded again, and only the allocated blocks are rendered.
+ */
+template <typename V>
+class LinkVertexArray
+{
+private:
+  VertexHolder<V> m_vertexHolder;
+  AllocationTracker m_allocationTracker;
+
+  // the position and size of every allocated block
+  std::map<size_t, size_t> m_blocks;
+
+public:
+  LinkVertexArray()
+    : m_allocationTracker{0}
+  {
+  }
+
+  AllocationTracker::Block* insert(const std::vector<V>& vertices)
+  {
+    if (vertices.empty())
+    {
+      return nullptr;
+    }
+
+    auto* block = m_allocationTracker.allocate(vertices.size());
+    if (block == nullptr)
+    {
+      const auto newSize = std::max(
+        2 * m_allocationTracker.capacity(),
+        m_allocationTracker.capacity() + vertices.size());
+      m_allocationTracker.expand(newSize);
+      m_vertexHolder.resize(newSize);
+
+      block = m_allocationTracker.allocate(vertices.size());
+      assert(block != nullptr);
+    }
+
+    auto* dest = m_vertexHolder.getPointerToWriteElementsTo(block->pos, vertices.size());
+    std::copy(vertices.begin(), vertices.end(), dest);
+    m_blocks.emplace(block->pos, block->size);
+    return block;
+  }
+
+  void remove(AllocationTracker::Block* block)
+  {
+    if (block != nullptr)
+    {
+      // the vertices are left in place since freed blocks are not rendered
+      m_blocks.erase(block->pos);
+      m_allocationTracker.free(block);
+    }
+  }
+
+  /**
+   * Returns the ranges of vertices that are rendered as pairs of position and size.
+   * Adjacent blocks are merged into one range.
+   */
+  std::vector<std::pair<size_t, size_t>> ranges() const
+  {
+    auto result = std::vector<std::pair<size_t, size_t>>{};
+    for (const auto& [pos, size] : m_blocks)
+    {
+      if (!result.empty() && result.back().first + result.back().second == pos)
+      {
+        result.back().second += size;
+      }
+      else
+      {
+        result.emplace_back(pos, size);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Returns the vertices that are rendered, in the order of their positions.
+   */
+  std::vector<V> vertices() const
+  {
+    const auto& snapshot = m_vertexHolder.snapshot();
+
+    auto result = std::vector<V>{};
+    for (const auto& [pos, size] : m_blocks)
+    {
+      const auto first = snapshot.begin() + std::ptrdiff_t(pos);
+      result.insert(result.end(), first, first + std::ptrdiff_t(size));
+    }
+    return result;
+  }
+
+  void prepare(VboManager& vboManager) { m_vertexHolder.prepare(vboManager); }
+
+  void render(const PrimType primType)
+  {
+    if (!m_blocks.empty() && m_vertexHolder.setupVertices())
+    {
+      for (const auto& [pos, size] : ranges())
+      {
+        glAssert(glDrawArrays(
+          toGL(primType), static_cast<GLint>(pos), static_cast<GLsizei>(size)));
+      }
+      m_vertexHolder.cleanupVertices();
+    }
+  }
+};
+
 class LinkRenderer : public DirectRenderable
 {
 public:
@@ -51,17 +170,43 @@ public:
     GLVertexAttributeUser<ArrowPositionName, GL_FLOAT, 3, false>,    // arrow position
     GLVertexAttributeUser<LineDirName, GL_FLOAT, 3, false>>::Vertex; // direction the
                                                                      // arrow is pointing
+protected:
+  /**
+   * The vertices of a group of links that were added together.
+   */
+  struct LinkBlocks
+  {
+    AllocationTracker::Block* lines = nullptr;
+    AllocationTracker::Block* arrows = nullptr;
+  };
+
 private:
-  VertexArray m_lines;
-  VertexArray m_arrows;
+  std::unique_ptr<LinkVertexArray<LineVertex>> m_lines;
+  std::unique_ptr<LinkVertexArray<ArrowVertex>> m_arrows;
 
   bool m_valid = false;
 
 public:
   LinkRenderer();
+  virtual ~LinkRenderer();
 
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
-  void invalidate();
+  virtual void invalidate();
+
+  /**
+   * Returns the vertices of the links that are rendered, bringing the links up to date
+   * first if necessary. Exposed for testing.
+   */
+  std::vector<LineVertex> lineVertices();
+
+protected:
+  /**
+   * Adds the given link vertices, which must contain pairs of source and target anchors.
+   * The returned blocks can be passed to removeLinks() to remove the links again.
+   */
+  LinkBlocks addLinks(const std::vector<LineVertex>& links);
+  void removeLinks(const LinkBlocks& blocks);
+  void clearLinks();
 
 private:
   void doPrepareVertices(VboManager& vboManager) override;
@@ -70,8 +215,14 @@ private:
   void renderLines(RenderContext& renderContext);
   void renderArrows(RenderContext& renderContext);
 
-  void validate();
+protected:
+  /**
+   * Brings the links up to date. By default, all links are replaced with the result of
+   * getLinks().
+   */
+  virtual void validate();
 
+private:
   virtual std::vector<LinkRenderer::LineVertex> getLinks() = 0;
 
   deleteCopy(LinkRenderer);
@@ -33,10 +33,13 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Renderer/BrushRenderer.h"
+#include "Renderer/Camera.h"
+#include "Renderer/ChunkedObjectRenderer.h"
 #include "Renderer/EntityDecalRenderer.h"
 #include "Renderer/EntityLinkRenderer.h"
 #include "Renderer/GroupLinkRenderer.h"
 #include "Renderer/ObjectRenderer.h"
+#include "Renderer/PortalCuller.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/RenderUtils.h"
@@ -48,6 +51,11 @@
 #include <kdl/path_utils.h>
 #include <kdl/vector_set.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -164,6 +172,7 @@ MapRenderer::MapRenderer(std::weak_ptr<View::MapDocument> document)
 {
   connectObservers();
   setupRenderers();
+  updatePortalCuller();
 }
 
 MapRenderer::~MapRenderer()
@@ -171,14 +180,24 @@ MapRenderer::~MapRenderer()
   clear();
 }
 
-std::unique_ptr<ObjectRenderer> MapRenderer::createDefaultRenderer(
+std::unique_ptr<ChunkedObjectRenderer> MapRenderer::createDefaultRenderer(
   std::weak_ptr<View::MapDocument> document)
 {
-  return std::make_unique<ObjectRenderer>(
-    *kdl::mem_lock(document),
-    kdl::mem_lock(document)->entityModelManager(),
-    kdl::mem_lock(document)->editorContext(),
-    UnselectedBrushRendererFilter{kdl::mem_lock(document)->editorContext()});
+  auto createRenderer = [=]() {
+    return std::make_unique<ObjectRenderer>(
+      *kdl::mem_lock(document),
+      kdl::mem_lock(document)->entityModelManager(),
+      kdl::mem_lock(document)->editorContext(),
+      UnselectedBrushRendererFilter{kdl::mem_lock(document)->editorContext()});
+  };
+  auto setupRenderer = [this](ObjectRenderer& renderer) {
+    setupDefaultRenderer(renderer);
+  };
+
+  return std::make_unique<ChunkedObjectRenderer>(
+    std::move(createRenderer),
+    std::move(setupRenderer),
+    kdl::mem_lock(document)->editorContext());
 }
 
 std::unique_ptr<ObjectRenderer> MapRenderer::createSelectionRenderer(
@@ -209,6 +228,7 @@ std::unique_ptr<EntityDecalRenderer> MapRenderer::createEntityDecalRenderer(
 
 void MapRenderer::clear()
 {
+  m_worldBrushBoundsValid = false;
   m_defaultRenderer->clear();
   m_selectionRenderer->clear();
   m_lockedRenderer->clear();
@@ -279,6 +299,10 @@ void MapRenderer::setupGL(RenderBatch& renderBatch)
 void MapRenderer::renderDefaultOpaque(
   RenderContext& renderContext, RenderBatch& renderBatch)
 {
+  m_defaultRenderer->cull(
+    renderContext,
+    renderContext.render3D() && m_defaultRenderer->hasPortalCuller()
+      && isInPlayableVolume(renderContext.camera().position()));
   m_defaultRenderer->setShowOverlays(renderContext.render3D());
   m_defaultRenderer->renderOpaque(renderContext, renderBatch);
 }
@@ -345,7 +369,8 @@ void MapRenderer::renderGroupLinks(RenderContext& renderContext, RenderBatch& re
 
 void MapRenderer::setupRenderers()
 {
-  setupDefaultRenderer(*m_defaultRenderer);
+  m_defaultRenderer->setOcclusionCulling(pref(Preferences::OcclusionCulling));
+  m_defaultRenderer->setupRenderers();
   setupSelectionRenderer(*m_selectionRenderer);
   setupLockedRenderer(*m_lockedRenderer);
 }
@@ -498,7 +523,7 @@ void MapRenderer::updateAndInvalidateNode(Model::Node* node)
     currentRenderers = it->second;
   }
 
-  auto updateForRenderer = [&](const Renderer r, ObjectRenderer* o) {
+  auto updateForRenderer = [&](const Renderer r, auto* o) {
     const auto isRDesired = (desiredRenderers & static_cast<int>(r)) != 0;
     const auto isRCurrent = (currentRenderers & static_cast<int>(r)) != 0;
 
@@ -649,6 +674,72 @@ void MapRenderer::reloadEntityModels()
   m_lockedRenderer->reloadModels();
 }
 
+/**
+ * Creates a portal culler for the default renderer if a portal file is loaded and portal
+ * culling is enabled.
+ */
+void MapRenderer::updatePortalCuller()
+{
+  auto document = kdl::mem_lock(m_document);
+  const auto* portalFile = document->portalFile();
+
+  m_defaultRenderer->setPortalCuller(
+    pref(Preferences::PortalFileCulling) && portalFile
+      ? std::make_unique<PortalCuller>(*portalFile)
+      : nullptr);
+}
+
+/**
+ * Indicates whether the given position is in the playable volume of the map, that is,
+ * within the bounds of the world brushes, but not inside any of them. A portal file only
+ * describes the playable volume, so the portal culler cannot be used anywhere else.
+ */
+bool MapRenderer::isInPlayableVolume(const vm::vec3f& position)
+{
+  auto document = kdl::mem_lock(m_document);
+  auto* world = document->world();
+  if (!world)
+  {
+    return false;
+  }
+
+  if (!m_worldBrushBoundsValid)
+  {
+    auto builder = vm::bbox3::builder{};
+    world->accept(kdl::overload(
+      [](auto&& thisLambda, const Model::WorldNode* worldNode) {
+        worldNode->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const Model::LayerNode* layerNode) {
+        layerNode->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const Model::GroupNode* groupNode) {
+        groupNode->visitChildren(thisLambda);
+      },
+      [](const Model::EntityNode*) {},
+      [&](const Model::BrushNode* brushNode) { builder.add(brushNode->logicalBounds()); },
+      [](const Model::PatchNode*) {}));
+
+    m_worldBrushBounds =
+      builder.initialized() ? std::optional{builder.bounds()} : std::nullopt;
+    m_worldBrushBoundsValid = true;
+  }
+
+  const auto point = vm::vec3{position};
+  if (!m_worldBrushBounds || !m_worldBrushBounds->contains(point))
+  {
+    return false;
+  }
+
+  auto containingNodes = std::vector<Model::Node*>{};
+  world->findNodesContaining(point, containingNodes);
+  return std::none_of(
+    containingNodes.begin(), containingNodes.end(), [&](const auto* node) {
+      const auto* brushNode = dynamic_cast<const Model::BrushNode*>(node);
+      return brushNode && brushNode->entity() == world;
+    });
+}
+
 void MapRenderer::connectObservers()
 {
   assert(!kdl::mem_expired(m_document));
@@ -686,6 +777,10 @@ void MapRenderer::connectObservers()
     document->modsDidChangeNotifier.connect(this, &MapRenderer::modsDidChange);
   m_notifierConnection += document->editorContextDidChangeNotifier.connect(
     this, &MapRenderer::editorContextDidChange);
+  m_notifierConnection += document->portalFileWasLoadedNotifier.connect(
+    this, &MapRenderer::portalFileDidChange);
+  m_notifierConnection += document->portalFileWasUnloadedNotifier.connect(
+    this, &MapRenderer::portalFileDidChange);
 
   auto& prefs = PreferenceManager::instance();
   m_notifierConnection +=
@@ -706,6 +801,7 @@ void MapRenderer::documentWasNewedOrLoaded(View::MapDocument*)
 
 void MapRenderer::nodesWereAdded(const std::vector<Model::Node*>& nodes)
 {
+  m_worldBrushBoundsValid = false;
   for (auto* node : nodes)
   {
     // The nodes passed in don't include recursive children, so we need to visit them
@@ -713,11 +809,12 @@ void MapRenderer::nodesWereAdded(const std::vector<Model::Node*>& nodes)
     updateAndInvalidateNodeRecursive(node);
   }
   invalidateGroupLinkRenderer();
-  invalidateEntityLinkRenderer();
+  m_entityLinkRenderer->invalidateNodes(nodes, true);
 }
 
 void MapRenderer::nodesWereRemoved(const std::vector<Model::Node*>& nodes)
 {
+  m_worldBrushBoundsValid = false;
   for (auto* node : nodes)
   {
     // The nodes passed in don't include recursive children, so we need to visit them
@@ -725,11 +822,12 @@ void MapRenderer::nodesWereRemoved(const std::vector<Model::Node*>& nodes)
     removeNodeRecursive(node);
   }
   invalidateGroupLinkRenderer();
-  invalidateEntityLinkRenderer();
+  m_entityLinkRenderer->removeNodes(nodes);
 }
 
 void MapRenderer::nodesDidChange(const std::vector<Model::Node*>& nodes)
 {
+  m_worldBrushBoundsValid = false;
   for (auto* node : nodes)
   {
     // nodesDidChange() will report ancestors changing, e.g. the world and layer are
@@ -737,7 +835,7 @@ void MapRenderer::nodesDidChange(const std::vector<Model::Node*>& nodes)
     // it would cause the entire map to be invalidated on every change.
     updateAndInvalidateNode(node);
   }
-  invalidateEntityLinkRenderer();
+  m_entityLinkRenderer->invalidateNodes(nodes, false);
   invalidateGroupLinkRenderer();
 }
 
@@ -747,7 +845,7 @@ void MapRenderer::nodeVisibilityDidChange(const std::vector<Model::Node*>& nodes
   {
     updateAndInvalidateNodeRecursive(node);
   }
-  invalidateEntityLinkRenderer();
+  m_entityLinkRenderer->invalidateNodes(nodes, true);
 }
 
 void MapRenderer::nodeLockingDidChange(const std::vector<Model::Node*>& nodes)
@@ -756,7 +854,7 @@ void MapRenderer::nodeLockingDidChange(const std::vector<Model::Node*>& nodes)
   {
     updateAndInvalidateNodeRecursive(node);
   }
-  invalidateEntityLinkRenderer();
+  m_entityLinkRenderer->invalidateNodes(nodes, true);
 }
 
 void MapRenderer::groupWasOpened(Model::GroupNode*)
@@ -800,7 +898,8 @@ void MapRenderer::selectionDidChange(const View::Selection& selection)
     updateAndInvalidateNodeRecursive(node);
   }
 
-  invalidateEntityLinkRenderer();
+  m_entityLinkRenderer->invalidateNodes(selection.deselectedNodes(), true);
+  m_entityLinkRenderer->invalidateNodes(selection.selectedNodes(), true);
   invalidateGroupLinkRenderer();
 }
 
@@ -830,10 +929,20 @@ void MapRenderer::editorContextDidChange()
   invalidateGroupLinkRenderer();
 }
 
+void MapRenderer::portalFileDidChange()
+{
+  updatePortalCuller();
+}
+
 void MapRenderer::preferenceDidChange(const std::filesystem::path& path)
 {
   setupRenderers();
 
+  if (path == Preferences::PortalFileCulling.path())
+  {
+    updatePortalCuller();
+  }
+
   auto document = kdl::mem_lock(m_document);
   if (document->isGamePathPreference(path))
   {
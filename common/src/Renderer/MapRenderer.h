@@ -19,11 +19,16 @@
 
 #pragma once
 
+#include "FloatType.h"
 #include "Macros.h"
 #include "NotifierConnection.h"
 
+#include <vecmath/bbox.h>
+#include <vecmath/forward.h>
+
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -49,6 +54,7 @@ class Node;
 
 namespace Renderer
 {
+class ChunkedObjectRenderer;
 class EntityDecalRenderer;
 class EntityLinkRenderer;
 class GroupLinkRenderer;
@@ -61,7 +67,7 @@ class MapRenderer
 private:
   std::weak_ptr<View::MapDocument> m_document;
 
-  std::unique_ptr<ObjectRenderer> m_defaultRenderer;
+  std::unique_ptr<ChunkedObjectRenderer> m_defaultRenderer;
   std::unique_ptr<ObjectRenderer> m_selectionRenderer;
   std::unique_ptr<ObjectRenderer> m_lockedRenderer;
   std::unique_ptr<EntityDecalRenderer> m_entityDecalRenderer;
@@ -78,6 +84,10 @@ private:
 
   std::unordered_map<Model::Node*, int> m_trackedNodes;
 
+  // the bounds of the world brushes, or nullopt if there are none
+  std::optional<vm::bbox3> m_worldBrushBounds;
+  bool m_worldBrushBoundsValid = false;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -87,7 +97,7 @@ public:
   deleteCopyAndMove(MapRenderer);
 
 private:
-  static std::unique_ptr<ObjectRenderer> createDefaultRenderer(
+  std::unique_ptr<ChunkedObjectRenderer> createDefaultRenderer(
     std::weak_ptr<View::MapDocument> document);
   static std::unique_ptr<ObjectRenderer> createSelectionRenderer(
     std::weak_ptr<View::MapDocument> document);
@@ -134,6 +144,8 @@ private:
   void invalidateEntityLinkRenderer();
   void invalidateGroupLinkRenderer();
   void reloadEntityModels();
+  void updatePortalCuller();
+  bool isInPlayableVolume(const vm::vec3f& position);
 
 private: // notification
   void connectObservers();
@@ -161,6 +173,8 @@ private: // notification
 
   void editorContextDidChange();
 
+  void portalFileDidChange();
+
   void preferenceDidChange(const std::filesystem::path& path);
 };
 } // namespace Renderer
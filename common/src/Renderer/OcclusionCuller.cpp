@@ -0,0 +1,346 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OcclusionCuller.h"
+
+#include "Ensure.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+/**
+ * A line equation a * x + b * y + c that is non-negative on the inner side of a polygon
+ * edge.
+ */
+struct Edge
+{
+  float a;
+  float b;
+  float c;
+
+  float minOverPixel(const float centerX, const float centerY) const
+  {
+    return a * centerX + b * centerY + c - 0.5f * (std::abs(a) + std::abs(b));
+  }
+};
+
+// A point is in front of the near plane if z >= -w.
+float nearPlaneDistance(const vm::vec4f& point)
+{
+  return point.z() + point.w();
+}
+
+std::vector<vm::vec4f> clipAgainstNearPlane(const std::vector<vm::vec4f>& polygon)
+{
+  auto result = std::vector<vm::vec4f>{};
+  result.reserve(polygon.size() + 1u);
+
+  for (size_t i = 0; i < polygon.size(); ++i)
+  {
+    const auto& current = polygon[i];
+    const auto& next = polygon[(i + 1u) % polygon.size()];
+    const auto currentDistance = nearPlaneDistance(current);
+    const auto nextDistance = nearPlaneDistance(next);
+
+    if (currentDistance >= 0.0f)
+    {
+      result.push_back(current);
+    }
+    if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+    {
+      const auto t = currentDistance / (currentDistance - nextDistance);
+      result.push_back(current + t * (next - current));
+    }
+  }
+
+  return result;
+}
+
+enum Outcode
+{
+  Left = 1,
+  Right = 2,
+  Bottom = 4,
+  Top = 8,
+  Near = 16,
+  Far = 32
+};
+
+int outcode(const vm::vec4f& point)
+{
+  auto result = 0;
+  if (point.x() < -point.w())
+  {
+    result |= Outcode::Left;
+  }
+  if (point.x() > point.w())
+  {
+    result |= Outcode::Right;
+  }
+  if (point.y() < -point.w())
+  {
+    result |= Outcode::Bottom;
+  }
+  if (point.y() > point.w())
+  {
+    result |= Outcode::Top;
+  }
+  if (point.z() < -point.w())
+  {
+    result |= Outcode::Near;
+  }
+  if (point.z() > point.w())
+  {
+    result |= Outcode::Far;
+  }
+  return result;
+}
+} // namespace
+
+OcclusionCuller::OcclusionCuller(const size_t width, const size_t height)
+  : m_width{width}
+  , m_height{height}
+  , m_viewProjectionMatrix{vm::mat4x4f::identity()}
+  , m_depthBuffer(width * height, 1.0f)
+{
+  ensure(m_width > 0u && m_height > 0u, "depth buffer must not be empty");
+}
+
+size_t OcclusionCuller::width() const
+{
+  return m_width;
+}
+
+size_t OcclusionCuller::height() const
+{
+  return m_height;
+}
+
+void OcclusionCuller::reset(const vm::mat4x4f& viewProjectionMatrix)
+{
+  m_viewProjectionMatrix = viewProjectionMatrix;
+  std::fill(m_depthBuffer.begin(), m_depthBuffer.end(), 1.0f);
+}
+
+void OcclusionCuller::addOccluder(const std::vector<vm::vec3f>& polygon)
+{
+  if (polygon.size() < 3u)
+  {
+    return;
+  }
+
+  auto clipPolygon = std::vector<vm::vec4f>{};
+  clipPolygon.reserve(polygon.size());
+  for (const auto& point : polygon)
+  {
+    clipPolygon.push_back(m_viewProjectionMatrix * vm::to_homogeneous_coords(point));
+  }
+
+  clipPolygon = clipAgainstNearPlane(clipPolygon);
+  if (clipPolygon.size() < 3u)
+  {
+    return;
+  }
+
+  const auto width = static_cast<float>(m_width);
+  const auto height = static_cast<float>(m_height);
+
+  // window coordinates and depth
+  auto windowPolygon = std::vector<vm::vec3f>{};
+  windowPolygon.reserve(clipPolygon.size());
+  for (const auto& point : clipPolygon)
+  {
+    if (point.w() <= 0.0f)
+    {
+      return;
+    }
+    const auto ndc = vm::to_cartesian_coords(point);
+    windowPolygon.emplace_back(
+      (ndc.x() + 1.0f) * 0.5f * width,
+      (ndc.y() + 1.0f) * 0.5f * height,
+      (ndc.z() + 1.0f) * 0.5f);
+  }
+
+  // Newell's method yields the plane of the polygon in window space, its z component is
+  // twice the signed area of the polygon
+  auto normal = vm::vec3f::zero();
+  auto center = vm::vec3f::zero();
+  for (size_t i = 0; i < windowPolygon.size(); ++i)
+  {
+    const auto& p = windowPolygon[i];
+    const auto& q = windowPolygon[(i + 1u) % windowPolygon.size()];
+    normal[0] += (p.y() - q.y()) * (p.z() + q.z());
+    normal[1] += (p.z() - q.z()) * (p.x() + q.x());
+    normal[2] += (p.x() - q.x()) * (p.y() + q.y());
+    center = center + p;
+  }
+  center = center / static_cast<float>(windowPolygon.size());
+
+  // a polygon that is smaller than a pixel cannot cover any pixel entirely
+  if (std::abs(normal.z()) < 2.0f)
+  {
+    return;
+  }
+
+  const auto orientation = normal.z() > 0.0f ? 1.0f : -1.0f;
+  auto edges = std::vector<Edge>{};
+  edges.reserve(windowPolygon.size());
+
+  auto min = vm::vec2f::fill(std::numeric_limits<float>::max());
+  auto max = vm::vec2f::fill(std::numeric_limits<float>::lowest());
+  for (size_t i = 0; i < windowPolygon.size(); ++i)
+  {
+    const auto& p = windowPolygon[i];
+    const auto& q = windowPolygon[(i + 1u) % windowPolygon.size()];
+    const auto dx = q.x() - p.x();
+    const auto dy = q.y() - p.y();
+    edges.push_back(Edge{
+      -orientation * dy, orientation * dx, orientation * (dy * p.x() - dx * p.y())});
+
+    min = vm::min(min, p.xy());
+    max = vm::max(max, p.xy());
+  }
+
+  const auto depthDX = -normal.x() / normal.z();
+  const auto depthDY = -normal.y() / normal.z();
+  const auto depthSlack = 0.5f * (std::abs(depthDX) + std::abs(depthDY));
+
+  const auto minX = static_cast<size_t>(std::max(0.0f, vm::floor(min.x())));
+  const auto minY = static_cast<size_t>(std::max(0.0f, vm::floor(min.y())));
+  const auto maxX = static_cast<size_t>(std::clamp(vm::ceil(max.x()), 0.0f, width));
+  const auto maxY = static_cast<size_t>(std::clamp(vm::ceil(max.y()), 0.0f, height));
+
+  for (size_t y = minY; y < maxY; ++y)
+  {
+    const auto centerY = static_cast<float>(y) + 0.5f;
+    for (size_t x = minX; x < maxX; ++x)
+    {
+      const auto centerX = static_cast<float>(x) + 0.5f;
+      const auto covered = std::all_of(edges.begin(), edges.end(), [&](const auto& e) {
+        return e.minOverPixel(centerX, centerY) >= 0.0f;
+      });
+
+      if (covered)
+      {
+        const auto depth = center.z() + depthDX * (centerX - center.x())
+                           + depthDY * (centerY - center.y()) + depthSlack;
+        auto& stored = m_depthBuffer[y * m_width + x];
+        stored = std::min(stored, depth);
+      }
+    }
+  }
+}
+
+bool OcclusionCuller::isVisible(const vm::bbox3f& bounds) const
+{
+  using Corner = vm::bbox3f::Corner;
+
+  auto corners = std::vector<vm::vec4f>{};
+  corners.reserve(8u);
+  for (const auto cx : {Corner::min, Corner::max})
+  {
+    for (const auto cy : {Corner::min, Corner::max})
+    {
+      for (const auto cz : {Corner::min, Corner::max})
+      {
+        corners.push_back(
+          m_viewProjectionMatrix * vm::to_homogeneous_coords(bounds.corner(cx, cy, cz)));
+      }
+    }
+  }
+
+  auto allOutcodes = ~0;
+  auto anyOutcodes = 0;
+  for (const auto& corner : corners)
+  {
+    const auto code = outcode(corner);
+    allOutcodes &= code;
+    anyOutcodes |= code;
+  }
+
+  if (allOutcodes != 0)
+  {
+    // all corners are outside of the same frustum plane
+    return false;
+  }
+
+  if ((anyOutcodes & Outcode::Near) != 0)
+  {
+    // the box intersects the near plane, so its projection is unbounded
+    return true;
+  }
+
+  const auto width = static_cast<float>(m_width);
+  const auto height = static_cast<float>(m_height);
+
+  auto min = vm::vec3f::fill(std::numeric_limits<float>::max());
+  auto max = vm::vec3f::fill(std::numeric_limits<float>::lowest());
+  for (const auto& corner : corners)
+  {
+    const auto ndc = vm::to_cartesian_coords(corner);
+    const auto window = vm::vec3f{
+      (ndc.x() + 1.0f) * 0.5f * width,
+      (ndc.y() + 1.0f) * 0.5f * height,
+      (ndc.z() + 1.0f) * 0.5f};
+    min = vm::min(min, window);
+    max = vm::max(max, window);
+  }
+
+  const auto toPixel = [](const float value, const float size) {
+    return static_cast<size_t>(std::clamp(vm::floor(value), 0.0f, size - 1.0f));
+  };
+  const auto minX = toPixel(min.x(), width);
+  const auto minY = toPixel(min.y(), height);
+  const auto maxX = toPixel(max.x(), width);
+  const auto maxY = toPixel(max.y(), height);
+
+  for (size_t y = minY; y <= maxY; ++y)
+  {
+    for (size_t x = minX; x <= maxX; ++x)
+    {
+      if (m_depthBuffer[y * m_width + x] >= min.z())
+      {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+float OcclusionCuller::depth(const size_t x, const size_t y) const
+{
+  assert(x < m_width && y < m_height);
+  return m_depthBuffer[y * m_width + x];
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vecmath/forward.h>
+#include <vecmath/mat.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+/**
+ * A software occlusion culler that rasterizes occluder polygons into a low resolution
+ * depth buffer on the CPU and tests bounding boxes against it.
+ *
+ * The culler is conservative: an occluder only covers the pixels that it covers
+ * entirely, and it writes the farthest depth it has within each such pixel. A bounding
+ * box is only reported as hidden if every pixel its projection touches is covered by
+ * an occluder that is closer than the nearest point of the box.
+ *
+ * Depth values are window space depths in [0, 1], with 1 being the far plane.
+ */
+class OcclusionCuller
+{
+private:
+  size_t m_width;
+  size_t m_height;
+  vm::mat4x4f m_viewProjectionMatrix;
+  std::vector<float> m_depthBuffer;
+
+public:
+  OcclusionCuller(size_t width, size_t height);
+
+  size_t width() const;
+  size_t height() const;
+
+  /**
+   * Clears the depth buffer and sets the matrix that transforms world coordinates into
+   * clip space.
+   */
+  void reset(const vm::mat4x4f& viewProjectionMatrix);
+
+  /**
+   * Rasterizes the given convex planar polygon into the depth buffer. The polygon is
+   * clipped against the near plane. Back facing polygons must be filtered by the
+   * caller.
+   */
+  void addOccluder(const std::vector<vm::vec3f>& polygon);
+
+  /**
+   * Indicates whether any part of the given bounding box may be visible, i.e. whether it
+   * intersects the view frustum and is not entirely hidden behind the occluders added
+   * since the last call to reset().
+   */
+  bool isVisible(const vm::bbox3f& bounds) const;
+
+  /**
+   * Returns the depth stored for the pixel at the given position.
+   */
+  float depth(size_t x, size_t y) const;
+};
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -371,7 +371,7 @@ void PatchRenderer::doRender(RenderContext& context)
   const bool showFog = context.showFog();
 
   glAssert(glEnable(GL_TEXTURE_2D));
-  glAssert(glActiveTexture(GL_TEXTURE0));
+  glActiveTextureCached(GL_TEXTURE0);
   shader.set("Brightness", prefs.get(Preferences::Brightness));
   shader.set("RenderGrid", context.showGrid());
   shader.set("GridSize", static_cast<float>(context.gridSize()));
@@ -0,0 +1,315 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PortalCuller.h"
+
+#include "Model/PortalFile.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/polygon.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+constexpr auto Epsilon = 0.1f;
+
+std::optional<vm::plane3f> portalPlane(const std::vector<vm::vec3f>& vertices)
+{
+  // Newell's method is robust against collinear vertices
+  auto normal = vm::vec3f::zero();
+  for (size_t i = 0; i < vertices.size(); ++i)
+  {
+    const auto& p = vertices[i];
+    const auto& q = vertices[(i + 1u) % vertices.size()];
+    normal[0] += (p.y() - q.y()) * (p.z() + q.z());
+    normal[1] += (p.z() - q.z()) * (p.x() + q.x());
+    normal[2] += (p.x() - q.x()) * (p.y() + q.y());
+  }
+
+  const auto length = vm::length(normal);
+  if (vertices.size() < 3u || length < vm::constants<float>::almost_zero())
+  {
+    return std::nullopt;
+  }
+  return vm::plane3f{vertices.front(), normal / length};
+}
+
+/**
+ * Orients the given plane so that its normal points into the leaf with the given
+ * center. Since a leaf is convex, the center of its portal vertices is inside of the
+ * leaf. If that center is on the plane, e.g. because the leaf has only one portal, the
+ * leaf on the other side of the portal is used to orient the plane.
+ */
+std::optional<vm::plane3f> orientPlane(
+  const vm::plane3f& plane, const vm::vec3f& center, const vm::vec3f& otherCenter)
+{
+  if (const auto distance = plane.point_distance(center); std::abs(distance) > Epsilon)
+  {
+    return distance > 0.0f ? plane : plane.flip();
+  }
+  if (const auto distance = plane.point_distance(otherCenter);
+      std::abs(distance) > Epsilon)
+  {
+    return distance > 0.0f ? plane.flip() : plane;
+  }
+  return std::nullopt;
+}
+} // namespace
+
+PortalCuller::PortalCuller(const Model::PortalFile& portalFile)
+{
+  const auto& polygons = portalFile.portals();
+  const auto& portalLeafs = portalFile.portalLeafs();
+  assert(polygons.size() == portalLeafs.size());
+
+  const auto leafCount = portalFile.leafCount();
+  auto centers = std::vector<vm::vec3f>(leafCount, vm::vec3f::zero());
+  auto vertexCounts = std::vector<size_t>(leafCount, 0u);
+
+  m_portals.reserve(polygons.size());
+  for (size_t i = 0; i < polygons.size(); ++i)
+  {
+    // a portal that connects a leaf beyond the leaf count is invalid and ignored
+    if (portalLeafs[i][0] >= leafCount || portalLeafs[i][1] >= leafCount)
+    {
+      continue;
+    }
+
+    const auto& vertices = polygons[i].vertices();
+    m_portals.push_back(Portal{vertices, portalLeafs[i]});
+
+    for (const auto leafIndex : portalLeafs[i])
+    {
+      for (const auto& vertex : vertices)
+      {
+        centers[leafIndex] = centers[leafIndex] + vertex;
+      }
+      vertexCounts[leafIndex] += vertices.size();
+    }
+  }
+
+  for (size_t i = 0; i < leafCount; ++i)
+  {
+    if (vertexCounts[i] > 0u)
+    {
+      centers[i] = centers[i] / static_cast<float>(vertexCounts[i]);
+    }
+  }
+
+  m_leafs.resize(leafCount);
+  for (size_t i = 0; i < m_portals.size(); ++i)
+  {
+    const auto& portal = m_portals[i];
+    const auto plane = portalPlane(portal.vertices);
+
+    for (size_t side = 0; side < 2u; ++side)
+    {
+      const auto leafIndex = portal.leafs[side];
+      const auto otherLeafIndex = portal.leafs[1u - side];
+      m_leafs[leafIndex].portals.push_back(LeafPortal{
+        i,
+        plane ? orientPlane(*plane, centers[leafIndex], centers[otherLeafIndex])
+              : std::nullopt});
+    }
+  }
+
+  m_visibleLeafs.resize(leafCount, false);
+}
+
+void PortalCuller::update(
+  const vm::vec3f& position, const vm::mat4x4f& viewProjectionMatrix)
+{
+  std::fill(m_visibleLeafs.begin(), m_visibleLeafs.end(), false);
+  m_valid = false;
+
+  const auto fullRect = Rect{vm::vec2f{-1, -1}, vm::vec2f{1, 1}};
+
+  auto queue = std::vector<std::pair<size_t, Rect>>{};
+  for (size_t i = 0; i < m_leafs.size(); ++i)
+  {
+    if (containsPoint(m_leafs[i], position))
+    {
+      queue.emplace_back(i, fullRect);
+    }
+  }
+
+  if (queue.empty())
+  {
+    return;
+  }
+
+  // the rectangles through which each leaf has been entered so far
+  auto visitedRects = std::vector<std::optional<Rect>>(m_leafs.size());
+
+  // guards against pathological inputs, all leafs are visible if this is exceeded
+  auto remainingSteps = 16u * m_leafs.size();
+
+  while (!queue.empty())
+  {
+    if (remainingSteps-- == 0u)
+    {
+      return;
+    }
+
+    const auto [leafIndex, rect] = queue.back();
+    queue.pop_back();
+
+    auto& visitedRect = visitedRects[leafIndex];
+    if (
+      visitedRect && visitedRect->min.x() <= rect.min.x()
+      && visitedRect->min.y() <= rect.min.y() && visitedRect->max.x() >= rect.max.x()
+      && visitedRect->max.y() >= rect.max.y())
+    {
+      continue;
+    }
+
+    visitedRect = visitedRect ? Rect{vm::min(visitedRect->min, rect.min),
+                                     vm::max(visitedRect->max, rect.max)}
+                              : rect;
+    m_visibleLeafs[leafIndex] = true;
+
+    for (const auto& leafPortal : m_leafs[leafIndex].portals)
+    {
+      // a portal can only be looked through from the inside of the leaf
+      if (leafPortal.plane && leafPortal.plane->point_distance(position) < -Epsilon)
+      {
+        continue;
+      }
+
+      const auto& portal = m_portals[leafPortal.portalIndex];
+      if (const auto portalRect = projectPortal(portal, viewProjectionMatrix))
+      {
+        const auto clippedRect =
+          Rect{vm::max(rect.min, portalRect->min), vm::min(rect.max, portalRect->max)};
+        if (
+          clippedRect.min.x() <= clippedRect.max.x()
+          && clippedRect.min.y() <= clippedRect.max.y())
+        {
+          const auto otherLeafIndex =
+            portal.leafs[0] == leafIndex ? portal.leafs[1] : portal.leafs[0];
+          queue.emplace_back(otherLeafIndex, clippedRect);
+        }
+      }
+    }
+  }
+
+  m_valid = true;
+}
+
+bool PortalCuller::isVisible(const vm::bbox3f& bounds) const
+{
+  if (!m_valid)
+  {
+    return true;
+  }
+
+  for (size_t i = 0; i < m_leafs.size(); ++i)
+  {
+    if (m_visibleLeafs[i] && intersectsBounds(m_leafs[i], bounds))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PortalCuller::isLeafVisible(const size_t leafIndex) const
+{
+  return !m_valid || (leafIndex < m_visibleLeafs.size() && m_visibleLeafs[leafIndex]);
+}
+
+bool PortalCuller::containsPoint(const Leaf& leaf, const vm::vec3f& point) const
+{
+  return !leaf.portals.empty()
+         && std::all_of(
+           leaf.portals.begin(), leaf.portals.end(), [&](const auto& leafPortal) {
+             return !leafPortal.plane
+                    || leafPortal.plane->point_distance(point) >= -Epsilon;
+           });
+}
+
+bool PortalCuller::intersectsBounds(const Leaf& leaf, const vm::bbox3f& bounds) const
+{
+  return std::all_of(
+    leaf.portals.begin(), leaf.portals.end(), [&](const auto& leafPortal) {
+      if (!leafPortal.plane)
+      {
+        return true;
+      }
+
+      // the corner of the bounds that is farthest along the plane normal
+      const auto& normal = leafPortal.plane->normal;
+      const auto corner = vm::vec3f{
+        normal.x() > 0.0f ? bounds.max.x() : bounds.min.x(),
+        normal.y() > 0.0f ? bounds.max.y() : bounds.min.y(),
+        normal.z() > 0.0f ? bounds.max.z() : bounds.min.z()};
+      return leafPortal.plane->point_distance(corner) >= -Epsilon;
+    });
+}
+
+std::optional<PortalCuller::Rect> PortalCuller::projectPortal(
+  const Portal& portal, const vm::mat4x4f& viewProjectionMatrix) const
+{
+  auto min = vm::vec2f::fill(std::numeric_limits<float>::max());
+  auto max = vm::vec2f::fill(std::numeric_limits<float>::lowest());
+  auto anyNear = false;
+  auto allBehind = true;
+
+  for (const auto& vertex : portal.vertices)
+  {
+    const auto clip = viewProjectionMatrix * vm::to_homogeneous_coords(vertex);
+    if (clip.w() > 0.0f)
+    {
+      allBehind = false;
+    }
+    if (clip.w() <= 0.0f || clip.z() < -clip.w())
+    {
+      anyNear = true;
+      continue;
+    }
+
+    const auto ndc = vm::vec2f{clip.x() / clip.w(), clip.y() / clip.w()};
+    min = vm::min(min, ndc);
+    max = vm::max(max, ndc);
+  }
+
+  if (allBehind)
+  {
+    // the portal is behind the camera
+    return std::nullopt;
+  }
+  if (anyNear)
+  {
+    // the portal intersects the near plane, so its projection is unbounded
+    return Rect{vm::vec2f{-1, -1}, vm::vec2f{1, 1}};
+  }
+  return Rect{min, max};
+}
+} // namespace Renderer
+} // namespace TrenchBroom
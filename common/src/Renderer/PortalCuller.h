@@ -0,0 +1,112 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vecmath/forward.h>
+#include <vecmath/plane.h>
+#include <vecmath/vec.h>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+class PortalFile;
+}
+
+namespace Renderer
+{
+/**
+ * Determines the leafs of a compiled map that are visible from the camera by flood
+ * filling from the camera's leaf through the portals of a portal file.
+ *
+ * Portal files do not contain the solid faces that bound a leaf, so a leaf is
+ * approximated by the intersection of the half spaces of its portals. This region
+ * contains the leaf, which keeps the culling conservative.
+ *
+ * While flood filling, the screen space bounding rectangle of each portal is intersected
+ * with the rectangle through which its leaf was entered, so that only leafs that can be
+ * seen through a sequence of portals within the view frustum are visible.
+ */
+class PortalCuller
+{
+private:
+  struct Portal
+  {
+    std::vector<vm::vec3f> vertices;
+    std::array<size_t, 2> leafs;
+  };
+
+  struct LeafPortal
+  {
+    size_t portalIndex;
+    // the portal's plane with its normal pointing into the leaf, if it can be determined
+    std::optional<vm::plane3f> plane;
+  };
+
+  struct Leaf
+  {
+    std::vector<LeafPortal> portals;
+  };
+
+  struct Rect
+  {
+    vm::vec2f min;
+    vm::vec2f max;
+  };
+
+  std::vector<Portal> m_portals;
+  std::vector<Leaf> m_leafs;
+
+  bool m_valid = false;
+  std::vector<bool> m_visibleLeafs;
+
+public:
+  explicit PortalCuller(const Model::PortalFile& portalFile);
+
+  /**
+   * Computes the leafs visible from the given position. If the position is not inside
+   * any leaf, e.g. because it is in solid space or outside of the map, all leafs are
+   * considered visible.
+   */
+  void update(const vm::vec3f& position, const vm::mat4x4f& viewProjectionMatrix);
+
+  /**
+   * Indicates whether the given bounding box intersects a visible leaf.
+   */
+  bool isVisible(const vm::bbox3f& bounds) const;
+
+  /**
+   * Indicates whether the given leaf is visible.
+   */
+  bool isLeafVisible(size_t leafIndex) const;
+
+private:
+  bool containsPoint(const Leaf& leaf, const vm::vec3f& point) const;
+  bool intersectsBounds(const Leaf& leaf, const vm::bbox3f& bounds) const;
+  std::optional<Rect> projectPortal(
+    const Portal& portal, const vm::mat4x4f& viewProjectionMatrix) const;
+};
+} // namespace Renderer
+} // namespace TrenchBroom
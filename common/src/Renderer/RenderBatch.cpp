@@ -103,6 +103,13 @@ void RenderBatch::addOneShot(IndexedRenderable* renderable)
   m_oneshots.push_back(renderable);
 }
 
+void RenderBatch::addTransient(DirectRenderable* renderable)
+{
+  doAdd(renderable);
+  m_transientRenderables.push_back(renderable);
+  m_oneshots.push_back(renderable);
+}
+
 void RenderBatch::render(RenderContext& renderContext)
 {
   prepareRenderables();
@@ -125,6 +132,13 @@ void RenderBatch::prepareRenderables()
   {
     renderable->prepareVerticesAndIndices(m_vboManager);
   }
+
+  m_vboManager.beginTransientAllocations();
+  for (auto* renderable : m_transientRenderables)
+  {
+    renderable->prepareVertices(m_vboManager);
+  }
+  m_vboManager.endTransientAllocations();
 }
 
 void RenderBatch::renderRenderables(RenderContext& renderContext)
@@ -44,6 +44,7 @@ private:
 
   DirectRenderableList m_directRenderables;
   IndexedRenderableList m_indexedRenderables;
+  DirectRenderableList m_transientRenderables;
 
   RenderableList m_batch;
   RenderableList m_oneshots;
@@ -64,6 +65,13 @@ public:
   void addOneShot(DirectRenderable* renderable);
   void addOneShot(IndexedRenderable* renderable);
 
+  /**
+   * Same as `addOneShot()`, but the vertices of the given renderable are streamed into
+   * transient VBOs that are only valid for the current frame. The renderable must own
+   * all of its vertex arrays.
+   */
+  void addTransient(DirectRenderable* renderable);
+
   void render(RenderContext& renderContext);
 
 private:
@@ -396,9 +396,9 @@ void RenderService::renderFilledCircle(
 
 void RenderService::flush()
 {
-  m_renderBatch.addOneShot(m_primitiveRenderer.release());
-  m_renderBatch.addOneShot(m_pointHandleRenderer.release());
-  m_renderBatch.addOneShot(m_textRenderer.release());
+  m_renderBatch.addTransient(m_primitiveRenderer.release());
+  m_renderBatch.addTransient(m_pointHandleRenderer.release());
+  m_renderBatch.addTransient(m_textRenderer.release());
 }
 } // namespace Renderer
 } // namespace TrenchBroom
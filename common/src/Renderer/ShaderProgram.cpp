@@ -30,13 +30,64 @@
 #include <vecmath/mat.h>
 #include <vecmath/vec.h>
 
+#include <cstring>
+#include <deque>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 namespace TrenchBroom::Renderer
 {
 
+namespace
+{
+
+struct UniformRegistry
+{
+  std::deque<std::string> names;
+  std::unordered_map<std::string, size_t> indices;
+};
+
+UniformRegistry& uniformRegistry()
+{
+  static auto registry = UniformRegistry{};
+  return registry;
+}
+
+size_t internUniform(const std::string& name)
+{
+  auto& registry = uniformRegistry();
+  const auto [it, inserted] = registry.indices.emplace(name, registry.names.size());
+  if (inserted)
+  {
+    registry.names.push_back(name);
+  }
+  return it->second;
+}
+
+} // namespace
+
+Uniform::Uniform(const char* name)
+  : m_index{internUniform(name)}
+{
+}
+
+Uniform::Uniform(const std::string& name)
+  : m_index{internUniform(name)}
+{
+}
+
+size_t Uniform::index() const
+{
+  return m_index;
+}
+
+const std::string& Uniform::name() const
+{
+  return uniformRegistry().names[m_index];
+}
+
 ShaderProgram::ShaderProgram(std::string name, const GLuint programId)
   : m_name{std::move(name)}
   , m_programId{programId}
@@ -47,6 +98,8 @@ ShaderProgram::ShaderProgram(std::string name, const GLuint programId)
 ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept
   : m_name{std::move(other.m_name)}
   , m_programId{std::exchange(other.m_programId, 0)}
+  , m_uniforms{std::move(other.m_uniforms)}
+  , m_attributeCache{std::move(other.m_attributeCache)}
 {
 }
 
@@ -54,6 +107,8 @@ ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept
 {
   m_name = std::move(other.m_name);
   m_programId = std::exchange(other.m_programId, 0);
+  m_uniforms = std::move(other.m_uniforms);
+  m_attributeCache = std::move(other.m_attributeCache);
   return *this;
 }
 
@@ -106,6 +161,10 @@ Result<void> ShaderProgram::link()
       "Could not link shader program '" + m_name + "': " + getInfoLog(m_programId)};
   }
 
+  // linking resets all locations and values
+  m_uniforms.clear();
+  m_attributeCache.clear();
+
   return kdl::void_success;
 }
 
@@ -126,73 +185,97 @@ void ShaderProgram::deactivate(ShaderManager& shaderManager)
   shaderManager.setCurrentProgram(nullptr);
 }
 
-void ShaderProgram::set(const std::string& name, const bool value)
+template <typename T, typename U>
+void ShaderProgram::setUniform(const Uniform& uniform, const T& value, const U& upload)
 {
-  return set(name, int(value));
+  static_assert(std::is_trivially_copyable_v<T>);
+  static_assert(sizeof(T) <= sizeof(UniformState::value));
+
+  assert(checkActive());
+
+  const auto location = findUniformLocation(uniform);
+  auto& state = m_uniforms[uniform.index()];
+  if (
+    state.size != sizeof(T)
+    || std::memcmp(state.value.data(), &value, sizeof(T)) != 0)
+  {
+    glAssert(upload(location, value));
+    std::memcpy(state.value.data(), &value, sizeof(T));
+    state.size = sizeof(T);
+  }
 }
 
-void ShaderProgram::set(const std::string& name, const int value)
+void ShaderProgram::set(const Uniform& uniform, const bool value)
 {
-  assert(checkActive());
-  glAssert(glUniform1i(findUniformLocation(name), value));
+  return set(uniform, int(value));
 }
 
-void ShaderProgram::set(const std::string& name, const size_t value)
+void ShaderProgram::set(const Uniform& uniform, const int value)
 {
-  assert(checkActive());
-  glAssert(glUniform1i(findUniformLocation(name), int(value)));
+  setUniform(uniform, value, [](const auto location, const auto& v) {
+    glUniform1i(location, v);
+  });
 }
 
-void ShaderProgram::set(const std::string& name, const float value)
+void ShaderProgram::set(const Uniform& uniform, const size_t value)
 {
-  assert(checkActive());
-  glAssert(glUniform1f(findUniformLocation(name), value));
+  return set(uniform, int(value));
 }
 
-void ShaderProgram::set(const std::string& name, const double value)
+void ShaderProgram::set(const Uniform& uniform, const float value)
 {
-  assert(checkActive());
-  glAssert(glUniform1d(findUniformLocation(name), value));
+  setUniform(uniform, value, [](const auto location, const auto& v) {
+    glUniform1f(location, v);
+  });
 }
 
-void ShaderProgram::set(const std::string& name, const vm::vec2f& value)
+void ShaderProgram::set(const Uniform& uniform, const double value)
 {
-  assert(checkActive());
-  glAssert(glUniform2f(findUniformLocation(name), value.x(), value.y()));
+  setUniform(uniform, value, [](const auto location, const auto& v) {
+    glUniform1d(location, v);
+  });
 }
 
-void ShaderProgram::set(const std::string& name, const vm::vec3f& value)
+void ShaderProgram::set(const Uniform& uniform, const vm::vec2f& value)
 {
-  assert(checkActive());
-  glAssert(glUniform3f(findUniformLocation(name), value.x(), value.y(), value.z()));
+  setUniform(uniform, value, [](const auto location, const auto& v) {
+    glUniform2f(location, v.x(), v.y());
+  });
 }
 
-void ShaderProgram::set(const std::string& name, const vm::vec4f& value)
+void ShaderProgram::set(const Uniform& uniform, const vm::vec3f& value)
 {
-  assert(checkActive());
-  glAssert(
-    glUniform4f(findUniformLocation(name), value.x(), value.y(), value.z(), value.w()));
+  setUniform(uniform, value, [](const auto location, const auto& v) {
+    glUniform3f(location, v.x(), v.y(), v.z());
+  });
 }
 
-void ShaderProgram::set(const std::string& name, const vm::mat2x2f& value)
+void ShaderProgram::set(const Uniform& uniform, const vm::vec4f& value)
 {
-  assert(checkActive());
-  glAssert(glUniformMatrix2fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  setUniform(uniform, value, [](const auto location, const auto& v) {
+    glUniform4f(location, v.x(), v.y(), v.z(), v.w());
+  });
 }
 
-void ShaderProgram::set(const std::string& name, const vm::mat3x3f& value)
+void ShaderProgram::set(const Uniform& uniform, const vm::mat2x2f& value)
 {
-  assert(checkActive());
-  glAssert(glUniformMatrix3fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  setUniform(uniform, value, [](const auto location, const auto& v) {
+    glUniformMatrix2fv(location, 1, false, reinterpret_cast<const float*>(v.v));
+  });
 }
 
-void ShaderProgram::set(const std::string& name, const vm::mat4x4f& value)
+void ShaderProgram::set(const Uniform& uniform, const vm::mat3x3f& value)
 {
-  assert(checkActive());
-  glAssert(glUniformMatrix4fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  setUniform(uniform, value, [](const auto location, const auto& v) {
+    glUniformMatrix3fv(location, 1, false, reinterpret_cast<const float*>(v.v));
+  });
+}
+
+void ShaderProgram::set(const Uniform& uniform, const vm::mat4x4f& value)
+{
+  setUniform(uniform, value, [](const auto location, const auto& v) {
+    glUniformMatrix4fv(location, 1, false, reinterpret_cast<const float*>(v.v));
+  });
 }
 
 GLint ShaderProgram::findAttributeLocation(const std::string& name) const
@@ -212,21 +295,24 @@ GLint ShaderProgram::findAttributeLocation(const std::string& name) const
   return it->second;
 }
 
-GLint ShaderProgram::findUniformLocation(const std::string& name) const
+GLint ShaderProgram::findUniformLocation(const Uniform& uniform) const
 {
-  auto it = m_variableCache.find(name);
-  if (it == std::end(m_variableCache))
+  if (uniform.index() >= m_uniforms.size())
+  {
+    m_uniforms.resize(uniform.index() + 1);
+  }
+
+  auto& state = m_uniforms[uniform.index()];
+  if (!state.location)
   {
     auto index = GLint(0);
-    glAssert(index = glGetUniformLocation(m_programId, name.c_str()));
-    ensure(index != -1, "Attribute location found in shader program");
+    glAssert(index = glGetUniformLocation(m_programId, uniform.name().c_str()));
+    ensure(index != -1, "Uniform location found in shader program");
 
-    auto inserted = false;
-    std::tie(it, inserted) = m_variableCache.emplace(name, index);
-    assert(inserted);
+    state.location = index;
   }
 
-  return it->second;
+  return *state.location;
 }
 
 bool ShaderProgram::checkActive() const
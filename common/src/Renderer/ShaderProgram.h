@@ -25,8 +25,11 @@
 
 #include <vecmath/forward.h>
 
+#include <array>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom::Renderer
 {
@@ -34,17 +37,46 @@ namespace TrenchBroom::Renderer
 class ShaderManager;
 class Shader;
 
+/**
+ * A handle for the name of a uniform variable. The name is interned when the handle is
+ * created, so renderers that keep their handles around can set uniforms without hashing
+ * the name on every call.
+ */
+class Uniform
+{
+private:
+  size_t m_index;
+
+public:
+  Uniform(const char* name);
+  Uniform(const std::string& name);
+
+  size_t index() const;
+  const std::string& name() const;
+};
+
 class ShaderProgram
 {
 private:
-  using UniformVariableCache = std::unordered_map<std::string, GLint>;
+  /**
+   * The location of a uniform variable and the value that was last uploaded to it, which
+   * is kept to skip redundant uploads. Uniform values are part of the program object and
+   * survive switching programs.
+   */
+  struct UniformState
+  {
+    std::optional<GLint> location;
+    size_t size = 0;
+    std::array<unsigned char, sizeof(float) * 16> value;
+  };
+
   using AttributeLocationCache = std::unordered_map<std::string, GLint>;
 
   std::string m_name;
 
   GLuint m_programId;
 
-  mutable UniformVariableCache m_variableCache;
+  mutable std::vector<UniformState> m_uniforms;
   mutable AttributeLocationCache m_attributeCache;
 
 public:
@@ -63,22 +95,25 @@ public:
   void activate(ShaderManager& shaderManager);
   void deactivate(ShaderManager& shaderManager);
 
-  void set(const std::string& name, bool value);
-  void set(const std::string& name, int value);
-  void set(const std::string& name, size_t value);
-  void set(const std::string& name, float value);
-  void set(const std::string& name, double value);
-  void set(const std::string& name, const vm::vec2f& value);
-  void set(const std::string& name, const vm::vec3f& value);
-  void set(const std::string& name, const vm::vec4f& value);
-  void set(const std::string& name, const vm::mat2x2f& value);
-  void set(const std::string& name, const vm::mat3x3f& value);
-  void set(const std::string& name, const vm::mat4x4f& value);
+  void set(const Uniform& uniform, bool value);
+  void set(const Uniform& uniform, int value);
+  void set(const Uniform& uniform, size_t value);
+  void set(const Uniform& uniform, float value);
+  void set(const Uniform& uniform, double value);
+  void set(const Uniform& uniform, const vm::vec2f& value);
+  void set(const Uniform& uniform, const vm::vec3f& value);
+  void set(const Uniform& uniform, const vm::vec4f& value);
+  void set(const Uniform& uniform, const vm::mat2x2f& value);
+  void set(const Uniform& uniform, const vm::mat3x3f& value);
+  void set(const Uniform& uniform, const vm::mat4x4f& value);
 
   GLint findAttributeLocation(const std::string& name) const;
 
 private:
-  GLint findUniformLocation(const std::string& name) const;
+  template <typename T, typename U>
+  void setUniform(const Uniform& uniform, const T& value, const U& upload);
+
+  GLint findUniformLocation(const Uniform& uniform) const;
   bool checkActive() const;
 };
 
@@ -42,7 +42,9 @@ namespace TrenchBroom
 namespace Renderer
 {
 SpikeGuideRenderer::SpikeGuideRenderer()
-  : m_valid(false)
+  : m_spikeVertexCount(0)
+  , m_pointVertexCount(0)
+  , m_valid(false)
 {
 }
 
@@ -80,8 +82,9 @@ void SpikeGuideRenderer::clear()
 {
   m_spikeVertices.clear();
   m_pointVertices.clear();
-  m_spikeArray = VertexArray();
-  m_pointArray = VertexArray();
+  m_vertexArray = VertexArray();
+  m_spikeVertexCount = 0;
+  m_pointVertexCount = 0;
   m_valid = true;
 }
 
@@ -89,18 +92,25 @@ void SpikeGuideRenderer::doPrepareVertices(VboManager& vboManager)
 {
   if (!m_valid)
     validate();
-  m_pointArray.prepare(vboManager);
-  m_spikeArray.prepare(vboManager);
+  m_vertexArray.prepare(vboManager);
 }
 
 void SpikeGuideRenderer::doRender(RenderContext& renderContext)
 {
   ActiveShader shader(renderContext.shaderManager(), Shaders::VaryingPCShader);
-  m_spikeArray.render(PrimType::Lines);
+  if (m_vertexArray.setup())
+  {
+    m_vertexArray.render(PrimType::Lines, 0, static_cast<GLsizei>(m_spikeVertexCount));
+
+    glAssert(glPointSize(3.0f));
+    m_vertexArray.render(
+      PrimType::Points,
+      static_cast<GLint>(m_spikeVertexCount),
+      static_cast<GLsizei>(m_pointVertexCount));
+    glAssert(glPointSize(1.0f));
 
-  glAssert(glPointSize(3.0f));
-  m_pointArray.render(PrimType::Points);
-  glAssert(glPointSize(1.0f));
+    m_vertexArray.cleanup();
+  }
 }
 
 void SpikeGuideRenderer::addPoint(const vm::vec3& position)
@@ -120,8 +130,16 @@ void SpikeGuideRenderer::addSpike(
 
 void SpikeGuideRenderer::validate()
 {
-  m_pointArray = VertexArray::move(std::move(m_pointVertices));
-  m_spikeArray = VertexArray::move(std::move(m_spikeVertices));
+  m_spikeVertexCount = m_spikeVertices.size();
+  m_pointVertexCount = m_pointVertices.size();
+
+  // the points are rendered from the end of the array
+  auto vertices = std::move(m_spikeVertices);
+  vertices.insert(vertices.end(), m_pointVertices.begin(), m_pointVertices.end());
+  m_spikeVertices.clear();
+  m_pointVertices.clear();
+
+  m_vertexArray = VertexArray::move(std::move(vertices));
   m_valid = true;
 }
 } // namespace Renderer
@@ -45,19 +45,24 @@ class MapDocument;
 
 namespace Renderer
 {
+/**
+ * Renders spikes and the points where they hit a brush. The spikes and points share a
+ * single vertex array, so adding this renderer to a batch with
+ * RenderBatch::addTransient() streams all of them into one transient buffer.
+ */
 class SpikeGuideRenderer : public DirectRenderable
 {
 private:
   Color m_color;
 
-  using SpikeVertex = GLVertexTypes::P3C4::Vertex;
-  using PointVertex = GLVertexTypes::P3C4::Vertex;
+  using Vertex = GLVertexTypes::P3C4::Vertex;
 
-  std::vector<SpikeVertex> m_spikeVertices;
-  std::vector<PointVertex> m_pointVertices;
+  std::vector<Vertex> m_spikeVertices;
+  std::vector<Vertex> m_pointVertices;
 
-  VertexArray m_spikeArray;
-  VertexArray m_pointArray;
+  VertexArray m_vertexArray;
+  size_t m_spikeVertexCount;
+  size_t m_pointVertexCount;
 
   bool m_valid;
 
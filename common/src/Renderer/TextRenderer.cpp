@@ -35,6 +35,10 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/vec.h>
 
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -44,25 +48,17 @@ const float TextRenderer::DefaultMinZoomFactor = 0.5f;
 const vm::vec2f TextRenderer::DefaultInset = vm::vec2f(4.0f, 4.0f);
 const size_t TextRenderer::RectCornerSegments = 3;
 const float TextRenderer::RectCornerRadius = 3.0f;
+const float TextRenderer::DensityCellSize = 8.0f;
 
 TextRenderer::Entry::Entry(
-  std::vector<vm::vec2f>& i_vertices,
-  const vm::vec2f& i_size,
+  std::shared_ptr<const GlyphRun> i_glyphRun,
   const vm::vec3f& i_offset,
   const Color& i_textColor,
   const Color& i_backgroundColor)
-  : size(i_size)
+  : glyphRun(std::move(i_glyphRun))
   , offset(i_offset)
   , textColor(i_textColor)
   , backgroundColor(i_backgroundColor)
-{
-  using std::swap;
-  swap(vertices, i_vertices);
-}
-
-TextRenderer::EntryCollection::EntryCollection()
-  : textVertexCount(0)
-  , rectVertexCount(0)
 {
 }
 
@@ -106,62 +102,47 @@ void TextRenderer::renderString(
   const TextAnchor& position,
   const bool onTop)
 {
-
   const Camera& camera = renderContext.camera();
   const float distance = camera.perpendicularDistanceTo(position.position(camera));
   if (distance <= 0.0f)
     return;
 
-  if (!isVisible(renderContext, string, position, distance, onTop))
-    return;
+  // cull by distance and zoom before looking at the string at all
+  if (!onTop)
+  {
+    if (renderContext.render3D() && distance > m_maxViewDistance)
+      return;
+    if (renderContext.render2D() && camera.zoom() < m_minZoomFactor)
+      return;
+  }
 
   FontManager& fontManager = renderContext.fontManager();
   TextureFont& font = fontManager.font(m_fontDescriptor);
 
-  std::vector<vm::vec2f> vertices = font.quads(string, true);
-  const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-  const vm::vec2f size = font.measure(string);
-  const vm::vec3f offset = position.offset(camera, size);
+  auto glyphRun = font.glyphRun(string);
+  if (!isVisible(renderContext, glyphRun->size, position))
+    return;
 
-  if (onTop)
-    addEntry(
-      m_entriesOnTop,
-      Entry(
-        vertices,
-        size,
-        offset,
-        Color(textColor, alphaFactor * textColor.a()),
-        Color(backgroundColor, alphaFactor * backgroundColor.a())));
-  else
-    addEntry(
-      m_entries,
-      Entry(
-        vertices,
-        size,
-        offset,
-        Color(textColor, alphaFactor * textColor.a()),
-        Color(backgroundColor, alphaFactor * backgroundColor.a())));
+  const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
+  const vm::vec3f offset = position.offset(camera, glyphRun->size);
+
+  auto& collection = onTop ? m_entriesOnTop : m_entries;
+  collection.entries.emplace_back(
+    std::move(glyphRun),
+    offset,
+    Color(textColor, alphaFactor * textColor.a()),
+    Color(backgroundColor, alphaFactor * backgroundColor.a()));
 }
 
 bool TextRenderer::isVisible(
   RenderContext& renderContext,
-  const AttrString& string,
-  const TextAnchor& position,
-  const float distance,
-  const bool onTop) const
+  const vm::vec2f& stringSize,
+  const TextAnchor& position) const
 {
-  if (!onTop)
-  {
-    if (renderContext.render3D() && distance > m_maxViewDistance)
-      return false;
-    if (renderContext.render2D() && renderContext.camera().zoom() < m_minZoomFactor)
-      return false;
-  }
-
   const Camera& camera = renderContext.camera();
   const Camera::Viewport& viewport = camera.viewport();
 
-  const vm::vec2f size = stringSize(renderContext, string);
+  const vm::vec2f size = round(stringSize);
   const vm::vec2f offset = vm::vec2f(position.offset(camera, size)) - m_inset;
   const vm::vec2f actualSize = size + 2.0f * m_inset;
 
@@ -191,19 +172,44 @@ float TextRenderer::computeAlphaFactor(
   }
 }
 
-void TextRenderer::addEntry(EntryCollection& collection, const Entry& entry)
+TextRenderer::EntryList TextRenderer::cullDenseEntries(EntryList entries) const
 {
-  collection.entries.push_back(entry);
-  collection.textVertexCount += entry.vertices.size();
-  collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
-}
+  // Labels whose centers fall into the same small screen cell overlap almost entirely,
+  // so only the one closest to the camera is kept.
+  const auto cellKey = [](const Entry& entry) {
+    const auto center = entry.offset.xy() + entry.glyphRun->size / 2.0f;
+    const auto x = static_cast<std::int32_t>(std::floor(center.x() / DensityCellSize));
+    const auto y = static_cast<std::int32_t>(std::floor(center.y() / DensityCellSize));
+    return (std::uint64_t(std::uint32_t(x)) << 32) | std::uint64_t(std::uint32_t(y));
+  };
+
+  auto closestEntryInCell = std::unordered_map<std::uint64_t, size_t>{};
+  closestEntryInCell.reserve(entries.size());
+
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    const auto [it, inserted] = closestEntryInCell.emplace(cellKey(entries[i]), i);
+    if (!inserted && entries[i].offset.z() < entries[it->second].offset.z())
+    {
+      it->second = i;
+    }
+  }
 
-vm::vec2f TextRenderer::stringSize(
-  RenderContext& renderContext, const AttrString& string) const
-{
-  FontManager& fontManager = renderContext.fontManager();
-  TextureFont& font = fontManager.font(m_fontDescriptor);
-  return round(font.measure(string));
+  if (closestEntryInCell.size() == entries.size())
+  {
+    return entries;
+  }
+
+  auto result = EntryList{};
+  result.reserve(closestEntryInCell.size());
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    if (closestEntryInCell[cellKey(entries[i])] == i)
+    {
+      result.push_back(std::move(entries[i]));
+    }
+  }
+  return result;
 }
 
 void TextRenderer::doPrepareVertices(VboManager& vboManager)
@@ -215,11 +221,24 @@ void TextRenderer::doPrepareVertices(VboManager& vboManager)
 void TextRenderer::prepare(
   EntryCollection& collection, const bool onTop, VboManager& vboManager)
 {
+  // labels that are always on top must never be hidden
+  if (!onTop)
+  {
+    collection.entries = cullDenseEntries(std::move(collection.entries));
+  }
+
+  size_t textVertexCount = 0;
+  for (const Entry& entry : collection.entries)
+  {
+    textVertexCount += entry.glyphRun->vertices.size() / 2;
+  }
+
   std::vector<TextVertex> textVertices;
-  textVertices.reserve(collection.textVertexCount);
+  textVertices.reserve(textVertexCount);
 
   std::vector<RectVertex> rectVertices;
-  rectVertices.reserve(collection.rectVertexCount);
+  rectVertices.reserve(
+    collection.entries.size() * roundedRect2DVertexCount(RectCornerSegments));
 
   for (const Entry& entry : collection.entries)
   {
@@ -239,8 +258,8 @@ void TextRenderer::addEntry(
   std::vector<TextVertex>& textVertices,
   std::vector<RectVertex>& rectVertices)
 {
-  const std::vector<vm::vec2f>& stringVertices = entry.vertices;
-  const vm::vec2f& stringSize = entry.size;
+  const std::vector<vm::vec2f>& stringVertices = entry.glyphRun->vertices;
+  const vm::vec2f& stringSize = entry.glyphRun->size;
 
   const vm::vec3f& offset = entry.offset;
 
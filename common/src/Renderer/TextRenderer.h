@@ -28,6 +28,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom
@@ -35,6 +36,7 @@ namespace TrenchBroom
 namespace Renderer
 {
 class AttrString;
+struct GlyphRun;
 class RenderContext;
 class TextAnchor;
 
@@ -46,18 +48,17 @@ private:
   static const vm::vec2f DefaultInset;
   static const size_t RectCornerSegments;
   static const float RectCornerRadius;
+  static const float DensityCellSize;
 
   struct Entry
   {
-    std::vector<vm::vec2f> vertices;
-    vm::vec2f size;
+    std::shared_ptr<const GlyphRun> glyphRun;
     vm::vec3f offset;
     Color textColor;
     Color backgroundColor;
 
     Entry(
-      std::vector<vm::vec2f>& i_vertices,
-      const vm::vec2f& i_size,
+      std::shared_ptr<const GlyphRun> i_glyphRun,
       const vm::vec3f& i_offset,
       const Color& i_textColor,
       const Color& i_backgroundColor);
@@ -68,13 +69,9 @@ private:
   struct EntryCollection
   {
     EntryList entries;
-    size_t textVertexCount;
-    size_t rectVertexCount;
 
     VertexArray textArray;
     VertexArray rectArray;
-
-    EntryCollection();
   };
 
   using TextVertex = GLVertexTypes::P3T2C4::Vertex;
@@ -119,15 +116,12 @@ private:
 
   bool isVisible(
     RenderContext& renderContext,
-    const AttrString& string,
-    const TextAnchor& position,
-    float distance,
-    bool onTop) const;
+    const vm::vec2f& stringSize,
+    const TextAnchor& position) const;
   float computeAlphaFactor(
     const RenderContext& renderContext, float distance, bool onTop) const;
-  void addEntry(EntryCollection& collection, const Entry& entry);
 
-  vm::vec2f stringSize(RenderContext& renderContext, const AttrString& string) const;
+  EntryList cullDenseEntries(EntryList entries) const;
 
 private:
   void doPrepareVertices(VboManager& vboManager) override;
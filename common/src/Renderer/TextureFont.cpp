@@ -29,11 +29,14 @@
 #include <vecmath/vec.h>
 
 #include <string>
+#include <utility>
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
+const size_t TextureFont::MaxCachedGlyphRuns = 4096;
+
 TextureFont::TextureFont(
   std::unique_ptr<FontTexture> texture,
   const std::vector<FontGlyph>& glyphs,
@@ -251,6 +254,28 @@ vm::vec2f TextureFont::measure(const std::string& string) const
   return result;
 }
 
+std::shared_ptr<const GlyphRun> TextureFont::glyphRun(const AttrString& string)
+{
+  if (const auto it = m_glyphRunCacheIndex.find(string);
+      it != m_glyphRunCacheIndex.end())
+  {
+    m_glyphRunCache.splice(m_glyphRunCache.begin(), m_glyphRunCache, it->second);
+    return it->second->second;
+  }
+
+  if (m_glyphRunCache.size() >= MaxCachedGlyphRuns)
+  {
+    m_glyphRunCacheIndex.erase(m_glyphRunCache.back().first);
+    m_glyphRunCache.pop_back();
+  }
+
+  auto run =
+    std::make_shared<const GlyphRun>(GlyphRun{quads(string, true), measure(string)});
+  m_glyphRunCache.emplace_front(string, run);
+  m_glyphRunCacheIndex.emplace(string, m_glyphRunCache.begin());
+  return run;
+}
+
 void TextureFont::activate()
 {
   m_texture->activate();
@@ -19,26 +19,42 @@
 
 #pragma once
 
+#include "AttrString.h"
 #include "Macros.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <list>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
-class AttrString;
 class FontGlyph;
 class FontTexture;
 
+/**
+ * The laid out quads of a string along with its size. The vertices alternate between
+ * positions and texture coordinates and are relative to the bottom left corner of the
+ * string.
+ */
+struct GlyphRun
+{
+  std::vector<vm::vec2f> vertices;
+  vm::vec2f size;
+};
+
 class TextureFont
 {
 private:
+  static const size_t MaxCachedGlyphRuns;
+
   std::unique_ptr<FontTexture> m_texture;
   std::vector<FontGlyph> m_glyphs;
   int m_lineHeight;
@@ -46,6 +62,12 @@ private:
   unsigned char m_firstChar;
   unsigned char m_charCount;
 
+  using GlyphRunCacheEntry = std::pair<AttrString, std::shared_ptr<const GlyphRun>>;
+
+  // the cached glyph runs, most recently used first
+  std::list<GlyphRunCacheEntry> m_glyphRunCache;
+  std::map<AttrString, std::list<GlyphRunCacheEntry>::iterator> m_glyphRunCacheIndex;
+
 public:
   TextureFont(
     std::unique_ptr<FontTexture> texture,
@@ -69,6 +91,14 @@ public:
     const vm::vec2f& offset = vm::vec2f::zero()) const;
   vm::vec2f measure(const std::string& string) const;
 
+  /**
+   * Returns the clockwise quads and the size of the given string. The result is cached,
+   * so laying out the same string again is cheap. If the cache is full, the least
+   * recently used run is evicted. The returned run remains valid even if it is later
+   * evicted from the cache.
+   */
+  std::shared_ptr<const GlyphRun> glyphRun(const AttrString& string);
+
   void activate();
   void deactivate();
 };
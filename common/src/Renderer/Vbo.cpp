@@ -27,32 +27,27 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
-Vbo::Vbo(GLenum type, const size_t capacity, const GLenum usage)
+Vbo::Vbo(
+  const GLenum type,
+  const GLuint bufferId,
+  const size_t offset,
+  const size_t capacity,
+  const bool dedicated,
+  AllocationTracker::Block* block)
   : m_type(type)
+  , m_bufferId(bufferId)
+  , m_offset(offset)
   , m_capacity(capacity)
+  , m_dedicated(dedicated)
+  , m_block(block)
 {
   assert(m_type == GL_ELEMENT_ARRAY_BUFFER || m_type == GL_ARRAY_BUFFER);
-
-  glAssert(glGenBuffers(1, &m_bufferId));
-  glAssert(glBindBuffer(m_type, m_bufferId));
-  glAssert(glBufferData(m_type, static_cast<GLsizeiptr>(m_capacity), nullptr, usage));
-}
-
-void Vbo::free()
-{
   assert(m_bufferId != 0);
-  glAssert(glDeleteBuffers(1, &m_bufferId));
-  m_bufferId = 0;
-}
-
-Vbo::~Vbo()
-{
-  assert(m_bufferId == 0);
 }
 
 size_t Vbo::offset() const
 {
-  return 0;
+  return m_offset;
 }
 
 size_t Vbo::capacity() const
@@ -63,13 +58,13 @@ size_t Vbo::capacity() const
 void Vbo::bind()
 {
   assert(m_bufferId != 0);
-  glAssert(glBindBuffer(m_type, m_bufferId));
+  glBindBufferCached(m_type, m_bufferId);
 }
 
 void Vbo::unbind()
 {
   assert(m_bufferId != 0);
-  glAssert(glBindBuffer(m_type, 0));
+  glBindBufferCached(m_type, 0);
 }
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "Renderer/AllocationTracker.h"
 #include "Renderer/VboManager.h"
 
 #include <cassert>
@@ -30,7 +31,8 @@ namespace TrenchBroom
 namespace Renderer
 {
 /**
- * Wrapper around an OpenGL buffer
+ * A block of an OpenGL buffer. The buffer is owned by the VboManager, and it may be
+ * shared with other VBOs, so all addresses are relative to offset().
  */
 class Vbo
 {
@@ -41,26 +43,31 @@ private:
    * e.g. GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
    */
   GLenum m_type;
-  size_t m_capacity;
   GLuint m_bufferId;
+  size_t m_offset;
+  size_t m_capacity;
 
   /**
-   * Immediately creates and binds to a buffer of the given type and capacity.
-   * The contents are initially unspecified.
+   * Whether the buffer was created for this VBO alone.
    */
-  Vbo(GLenum type, size_t capacity, GLenum usage);
-  ~Vbo();
+  bool m_dedicated;
 
   /**
-   * Deletes the underlying OpenGL buffer with glDeleteBuffers.
-   * Must be called before the destructor.
-   * Calling any other methods after free() is disallowed.
+   * If this VBO is a block of a pooled arena, the tracker block of its allocation.
    */
-  void free();
+  AllocationTracker::Block* m_block;
+
+  Vbo(
+    GLenum type,
+    GLuint bufferId,
+    size_t offset,
+    size_t capacity,
+    bool dedicated,
+    AllocationTracker::Block* block);
 
 public:
   /**
-   * Deprecated, always returns 0.
+   * The byte offset of this VBO within its OpenGL buffer.
    */
   size_t offset() const;
   size_t capacity() const;
@@ -99,13 +106,41 @@ public:
     static_assert(std::is_standard_layout<T>::value);
 
     const GLvoid* ptr = static_cast<const GLvoid*>(array);
-    const GLintptr offset = static_cast<GLintptr>(address);
+    const GLintptr offset = static_cast<GLintptr>(m_offset + address);
     const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
-    glAssert(glBindBuffer(m_type, m_bufferId));
+    glBindBufferCached(m_type, m_bufferId);
     glAssert(glBufferSubData(m_type, offset, sizei, ptr));
 
     return size;
   }
+
+  /**
+   * Reads the contents of the VBO block into a C array. This waits for the GPU to finish
+   * all pending operations on the buffer, so it should be used sparingly.
+   *
+   * @tparam T        element type
+   * @param address   byte offset from the start of the block to read at
+   * @param array     array to read into
+   * @param count     number of elements to read
+   * @return          number of bytes read
+   */
+  template <typename T>
+  size_t readArray(const size_t address, T* array, const size_t count)
+  {
+    const size_t size = count * sizeof(T);
+    assert(address + size <= m_capacity);
+
+    static_assert(std::is_trivially_copyable<T>::value);
+    static_assert(std::is_standard_layout<T>::value);
+
+    GLvoid* ptr = static_cast<GLvoid*>(array);
+    const GLintptr offset = static_cast<GLintptr>(m_offset + address);
+    const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
+    glBindBufferCached(m_type, m_bufferId);
+    glAssert(glGetBufferSubData(m_type, offset, sizei, ptr));
+
+    return size;
+  }
 };
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/VboHolder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+
+// DirtyRangeTracker
+
+DirtyRangeTracker::DirtyRangeTracker(const size_t initial_capacity)
+  : m_dirtyPos(0)
+  , m_dirtySize(0)
+  , m_capacity(initial_capacity)
+{
+}
+
+DirtyRangeTracker::DirtyRangeTracker()
+  : m_dirtyPos(0)
+  , m_dirtySize(0)
+  , m_capacity(0)
+{
+}
+
+void DirtyRangeTracker::expand(const size_t newcap)
+{
+  if (newcap <= m_capacity)
+  {
+    throw std::invalid_argument("new capacity must be greater");
+  }
+
+  const size_t oldcap = m_capacity;
+  m_capacity = newcap;
+  markDirty(oldcap, newcap - oldcap);
+}
+
+size_t DirtyRangeTracker::capacity() const
+{
+  return m_capacity;
+}
+
+void DirtyRangeTracker::markDirty(const size_t pos, const size_t size)
+{
+  // bounds check
+  if (pos + size > m_capacity)
+  {
+    throw std::invalid_argument("markDirty provided range out of bounds");
+  }
+
+  const size_t newPos = std::min(pos, m_dirtyPos);
+  const size_t newEnd = std::max(pos + size, m_dirtyPos + m_dirtySize);
+
+  m_dirtyPos = newPos;
+  m_dirtySize = newEnd - newPos;
+}
+
+bool DirtyRangeTracker::clean() const
+{
+  return m_dirtySize == 0;
+}
+
+// VboHolder
+
+namespace
+{
+std::atomic<size_t> totalVboHolderMemorySize{0};
+} // namespace
+
+size_t vboHolderMemorySize()
+{
+  return totalVboHolderMemorySize;
+}
+
+void updateVboHolderMemorySize(const size_t oldSize, const size_t newSize)
+{
+  totalVboHolderMemorySize += newSize;
+  totalVboHolderMemorySize -= oldSize;
+}
+
+} // namespace Renderer
+} // namespace TrenchBroom
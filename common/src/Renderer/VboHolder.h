@@ -0,0 +1,472 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Renderer/GL.h"
+#include "Renderer/Vbo.h"
+#include "Renderer/VboManager.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+struct DirtyRangeTracker
+{
+  size_t m_dirtyPos;
+  size_t m_dirtySize;
+  size_t m_capacity;
+
+  /**
+   * New trackers are initially clean.
+   */
+  explicit DirtyRangeTracker(size_t initial_capacity);
+  DirtyRangeTracker();
+
+  /**
+   * Expanding marks the new range as dirty.
+   */
+  void expand(size_t newcap);
+  size_t capacity() const;
+  void markDirty(size_t pos, size_t size);
+  bool clean() const;
+};
+
+/**
+ * Determines whether a VboHolder keeps a CPU side copy of its elements.
+ */
+enum class VboSnapshotPolicy
+{
+  /**
+   * A copy of all elements is kept for the lifetime of the holder. Dirty ranges are
+   * uploaded from it.
+   */
+  Retain,
+  /**
+   * Only the elements written since the last upload are kept. Growing the VBO reads its
+   * previous contents back from the GPU.
+   */
+  Discard
+};
+
+/**
+ * Returns the number of bytes of element data that all VboHolders currently keep in CPU
+ * memory, i.e., their snapshots and the writes that have not been uploaded yet.
+ */
+size_t vboHolderMemorySize();
+
+/**
+ * Used by VboHolder to keep the value returned by vboHolderMemorySize() up to date.
+ */
+void updateVboHolderMemorySize(size_t oldSize, size_t newSize);
+
+/**
+ * Elements that have been written to a VboHolder, but not uploaded yet.
+ */
+template <typename T>
+struct VboWrite
+{
+  size_t pos;
+  std::vector<T> elements;
+};
+
+/**
+ * Merges the given writes that overlap or are adjacent, so that each contiguous range can
+ * be uploaded at once. Where writes overlap, later ones take precedence. Adjacent writes
+ * are only merged while the merged write has at most maxMergedCount elements, which
+ * bounds the memory needed to merge them. The returned writes are sorted by position
+ * and do not overlap.
+ */
+template <typename T>
+std::vector<VboWrite<T>> mergeVboWrites(
+  std::vector<VboWrite<T>> writes, const size_t maxMergedCount)
+{
+  auto order = std::vector<size_t>(writes.size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::stable_sort(order.begin(), order.end(), [&](const auto lhs, const auto rhs) {
+    return writes[lhs].pos < writes[rhs].pos;
+  });
+
+  auto result = std::vector<VboWrite<T>>{};
+  for (size_t i = 0; i < order.size();)
+  {
+    const auto begin = writes[order[i]].pos;
+    auto end = begin + writes[order[i]].elements.size();
+    auto j = i + 1u;
+    while (j < order.size())
+    {
+      const auto& write = writes[order[j]];
+      const auto writeEnd = write.pos + write.elements.size();
+      if (write.pos > end || (write.pos == end && writeEnd - begin > maxMergedCount))
+      {
+        break;
+      }
+      end = std::max(end, writeEnd);
+      ++j;
+    }
+
+    if (j == i + 1u)
+    {
+      result.push_back(std::move(writes[order[i]]));
+    }
+    else
+    {
+      // apply the writes in the order in which they were made
+      std::sort(order.begin() + std::ptrdiff_t(i), order.begin() + std::ptrdiff_t(j));
+
+      auto elements = std::vector<T>(end - begin);
+      for (auto k = i; k < j; ++k)
+      {
+        auto& write = writes[order[k]];
+        std::copy(
+          write.elements.begin(),
+          write.elements.end(),
+          elements.begin() + std::ptrdiff_t(write.pos - begin));
+        write.elements = std::vector<T>{};
+      }
+      result.push_back(VboWrite<T>{begin, std::move(elements)});
+    }
+    i = j;
+  }
+
+  return result;
+}
+
+/**
+ * Wrapper around a std::vector<T> and VboBlock.
+ *
+ * Non-copyable; meant to be held in a std::shared_ptr.
+ * Able to be resized, and handles copying edits made on the CPU side to the VBO.
+ *
+ * Depending on the snapshot policy, edits are made either in a local std::vector that
+ * mirrors the entire VBO or in staging buffers that are released once they have been
+ * uploaded. The latter halves the memory used by large holders at the cost of a GPU
+ * readback whenever the VBO grows.
+ *
+ * With a snapshot, a single range is used to track the modified region which might
+ * upload much more than necessary. Without one, the writes are merged into contiguous
+ * ranges, and each range is uploaded separately.
+ */
+template <typename T>
+class VboHolder
+{
+private:
+  // the maximum number of elements that are merged, copied or zeroed in one buffer
+  static constexpr size_t MaxChunkCount = 16384;
+
+protected:
+  VboType m_type;
+  VboSnapshotPolicy m_snapshotPolicy;
+  std::vector<T> m_snapshot;
+  std::vector<VboWrite<T>> m_pendingWrites;
+  size_t m_size;
+  size_t m_memorySize;
+  DirtyRangeTracker m_dirtyRange;
+  VboManager* m_vboManager;
+  Vbo* m_vbo;
+
+private:
+  void freeBlock()
+  {
+    if (m_vbo != nullptr)
+    {
+      m_vboManager->destroyVbo(m_vbo);
+      m_vbo = nullptr;
+    }
+  }
+
+  void allocateBlock(VboManager& vboManager, const size_t elementCount)
+  {
+    if (m_vboManager != nullptr)
+    {
+      assert(m_vboManager == &vboManager);
+    }
+    else
+    {
+      m_vboManager = &vboManager;
+    }
+    assert(m_vbo == nullptr);
+
+    m_vbo = m_vboManager->allocateVbo(
+      m_type, elementCount * sizeof(T), VboUsage::DynamicDraw);
+    assert(m_vbo != nullptr);
+
+    m_dirtyRange = DirtyRangeTracker(elementCount);
+    assert(m_dirtyRange.clean());
+    assert((m_vbo->capacity() / sizeof(T)) == m_dirtyRange.capacity());
+  }
+
+  /**
+   * Allocates a new block and fills it with the contents of the current block, if any,
+   * and the pending writes. Elements that were never written are zeroed.
+   *
+   * The ranges that are not written are copied or zeroed in chunks, so apart from the
+   * pending writes, at most one chunk is kept in CPU memory.
+   */
+  void reallocateBlock(VboManager& vboManager)
+  {
+    auto* oldVbo = m_vbo;
+    const auto oldCount =
+      oldVbo ? std::min(m_size, oldVbo->capacity() / sizeof(T)) : size_t(0);
+
+    m_vbo = nullptr;
+    allocateBlock(vboManager, m_size);
+
+    auto buffer = std::vector<T>{};
+    auto pos = size_t(0);
+    for (auto& write : mergeVboWrites(std::move(m_pendingWrites), MaxChunkCount))
+    {
+      fillRange(oldVbo, oldCount, pos, write.pos, buffer);
+      m_vbo->writeElements(write.pos * sizeof(T), write.elements);
+      pos = write.pos + write.elements.size();
+      write.elements = std::vector<T>{};
+    }
+    fillRange(oldVbo, oldCount, pos, m_size, buffer);
+    m_pendingWrites.clear();
+
+    if (oldVbo != nullptr)
+    {
+      m_vboManager->destroyVbo(oldVbo);
+    }
+  }
+
+  /**
+   * Fills the given range of the current block with the contents of the old block, or
+   * with zeros beyond the old block's element count.
+   */
+  void fillRange(
+    Vbo* oldVbo,
+    const size_t oldCount,
+    size_t begin,
+    const size_t end,
+    std::vector<T>& buffer)
+  {
+    while (begin < end)
+    {
+      const auto count = std::min(end - begin, MaxChunkCount);
+      const auto oldCountInRange =
+        begin < oldCount ? std::min(count, oldCount - begin) : size_t(0);
+
+      buffer.resize(count);
+      if (oldCountInRange > 0u)
+      {
+        oldVbo->readArray(begin * sizeof(T), buffer.data(), oldCountInRange);
+      }
+      std::fill(
+        buffer.begin() + std::ptrdiff_t(oldCountInRange),
+        buffer.begin() + std::ptrdiff_t(count),
+        T{});
+
+      m_vbo->writeArray(begin * sizeof(T), buffer.data(), count);
+      begin += count;
+    }
+  }
+
+  void setMemorySize(const size_t memorySize)
+  {
+    updateVboHolderMemorySize(m_memorySize, memorySize);
+    m_memorySize = memorySize;
+  }
+
+public:
+  explicit VboHolder(
+    const VboType type,
+    const VboSnapshotPolicy snapshotPolicy = VboSnapshotPolicy::Retain)
+    : m_type(type)
+    , m_snapshotPolicy(snapshotPolicy)
+    , m_snapshot()
+    , m_pendingWrites()
+    , m_size(0)
+    , m_memorySize(0)
+    , m_dirtyRange(0)
+    , m_vboManager(nullptr)
+    , m_vbo(nullptr)
+  {
+  }
+
+  /**
+   * NOTE: This destructively moves the contents of `elements` into the Holder.
+   */
+  VboHolder(
+    const VboType type,
+    std::vector<T>& elements,
+    const VboSnapshotPolicy snapshotPolicy = VboSnapshotPolicy::Retain)
+    : m_type(type)
+    , m_snapshotPolicy(snapshotPolicy)
+    , m_snapshot()
+    , m_pendingWrites()
+    , m_size(elements.size())
+    , m_memorySize(0)
+    , m_dirtyRange(elements.size())
+    , m_vboManager(nullptr)
+    , m_vbo(nullptr)
+  {
+
+    const size_t elementsCount = elements.size();
+    m_dirtyRange.markDirty(0, elementsCount);
+
+    if (m_snapshotPolicy == VboSnapshotPolicy::Retain)
+    {
+      elements.swap(m_snapshot);
+      setMemorySize(m_snapshot.capacity() * sizeof(T));
+    }
+    else if (!elements.empty())
+    {
+      setMemorySize(elements.capacity() * sizeof(T));
+      m_pendingWrites.push_back(VboWrite<T>{0, std::move(elements)});
+      elements.clear();
+    }
+
+    // we allow zero elements.
+    if (!empty())
+    {
+      assert(!prepared());
+    }
+  }
+
+  VboHolder(const VboHolder& other) = delete;
+
+  virtual ~VboHolder()
+  {
+    updateVboHolderMemorySize(m_memorySize, 0);
+
+    // TODO: Revisit this revisiting OpenGL resource management. We should not store the
+    // VboManager, since it represents a safe time to delete the OpenGL buffer object.
+    freeBlock();
+  }
+
+  void resize(const size_t newSize)
+  {
+    if (m_snapshotPolicy == VboSnapshotPolicy::Retain)
+    {
+      m_snapshot.resize(newSize);
+      setMemorySize(m_snapshot.capacity() * sizeof(T));
+    }
+    m_size = newSize;
+    m_dirtyRange.expand(newSize);
+  }
+
+  T* getPointerToWriteElementsTo(
+    const size_t offsetWithinBlock, const size_t elementCount)
+  {
+    assert(offsetWithinBlock + elementCount <= m_size);
+
+    // mark dirty range
+    m_dirtyRange.markDirty(offsetWithinBlock, elementCount);
+
+    if (m_snapshotPolicy == VboSnapshotPolicy::Retain)
+    {
+      return m_snapshot.data() + offsetWithinBlock;
+    }
+
+    // the pointer remains valid when more writes are added because moving a vector does
+    // not move its elements
+    m_pendingWrites.push_back(
+      VboWrite<T>{offsetWithinBlock, std::vector<T>(elementCount)});
+    setMemorySize(m_memorySize + elementCount * sizeof(T));
+    return m_pendingWrites.back().elements.data();
+  }
+
+  bool prepared() const
+  {
+    // NOTE: this returns true if the capacity is 0
+    return m_dirtyRange.clean();
+  }
+
+  void prepare(VboManager& vboManager)
+  {
+    if (empty())
+    {
+      assert(prepared());
+      return;
+    }
+    if (prepared())
+    {
+      return;
+    }
+
+    // first ever upload or resize?
+    if (m_vbo == nullptr || m_dirtyRange.capacity() != (m_vbo->capacity() / sizeof(T)))
+    {
+      if (m_snapshotPolicy == VboSnapshotPolicy::Retain)
+      {
+        freeBlock();
+        allocateBlock(vboManager, m_snapshot.size());
+        m_vbo->writeElements(0, m_snapshot);
+      }
+      else
+      {
+        reallocateBlock(vboManager);
+        setMemorySize(0);
+      }
+      assert(prepared());
+      return;
+    }
+
+    // otherwise, it's an incremental update of the dirty ranges.
+
+    if (m_snapshotPolicy == VboSnapshotPolicy::Retain)
+    {
+      const size_t pos = m_dirtyRange.m_dirtyPos;
+      const size_t size = m_dirtyRange.m_dirtySize;
+
+      const size_t bytesFromStart = pos * sizeof(T);
+      m_vbo->writeArray(bytesFromStart, m_snapshot.data() + pos, size);
+    }
+    else
+    {
+      for (const auto& write : mergeVboWrites(std::move(m_pendingWrites), MaxChunkCount))
+      {
+        m_vbo->writeElements(write.pos * sizeof(T), write.elements);
+      }
+      m_pendingWrites.clear();
+      setMemorySize(0);
+    }
+
+    m_dirtyRange = DirtyRangeTracker(m_size);
+    assert(prepared());
+  }
+
+  bool empty() const { return m_size == 0; }
+
+  size_t size() const { return m_size; }
+
+  /**
+   * Returns the number of bytes of element data that this holder keeps in CPU memory.
+   */
+  size_t memorySize() const { return m_memorySize; }
+
+  /**
+   * Returns the CPU side copy of the elements. It is empty unless the snapshot policy is
+   * VboSnapshotPolicy::Retain.
+   */
+  const std::vector<T>& snapshot() const { return m_snapshot; }
+
+  void bindBlock() { m_vbo->bind(); }
+
+  void unbindBlock() { m_vbo->unbind(); }
+};
+} // namespace Renderer
+} // namespace TrenchBroom
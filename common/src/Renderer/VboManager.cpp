@@ -24,6 +24,7 @@
 #include "Vbo.h"
 
 #include <algorithm> // for std::max
+#include <cassert>
 
 namespace TrenchBroom
 {
@@ -56,19 +57,71 @@ static GLenum usageToOpenGL(const VboUsage usage)
   }
 }
 
+namespace
+{
+/**
+ * Blocks are aligned to this many bytes within a shared buffer.
+ */
+constexpr size_t BlockAlignment = 16u;
+
+/**
+ * Static VBOs larger than this get a dedicated buffer instead of a pooled block.
+ */
+constexpr size_t MaxPooledCapacity = 1024u * 1024u;
+constexpr size_t ArenaCapacity = 4u * MaxPooledCapacity;
+
+constexpr size_t InitialStreamCapacity = 1024u * 1024u;
+constexpr size_t MaxStreamCapacity = 64u * 1024u * 1024u;
+
+size_t typeIndex(const VboType type)
+{
+  return type == VboType::ArrayBuffer ? 0u : 1u;
+}
+
+size_t alignedCapacity(const size_t capacity)
+{
+  return (capacity + BlockAlignment - 1u) / BlockAlignment * BlockAlignment;
+}
+
+void orphanBuffer(const VboType type, const GLuint bufferId, const size_t capacity)
+{
+  glBindBufferCached(typeToOpenGL(type), bufferId);
+  glAssert(glBufferData(
+    typeToOpenGL(type), static_cast<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW));
+}
+} // namespace
+
 // VboManager
 
+VboManager::Arena::Arena(const GLuint i_bufferId, const size_t i_capacity)
+  : bufferId{i_bufferId}
+  , tracker{i_capacity}
+{
+}
+
 VboManager::VboManager(ShaderManager* shaderManager)
   : m_peakVboCount(0u)
   , m_currentVboCount(0u)
   , m_currentVboSize(0u)
   , m_shaderManager(shaderManager)
+  , m_transientAllocations(false)
+  , m_createdBufferCount(0u)
+  , m_streamedSize(0u)
+  , m_lastFrameCreatedBufferCount(0u)
+  , m_lastFrameStreamedSize(0u)
 {
 }
 
+// The pooled and streaming buffers are released together with the OpenGL context, which
+// may no longer be current at this point.
+VboManager::~VboManager() = default;
+
 Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage usage)
 {
-  auto* result = new Vbo(typeToOpenGL(type), capacity, usageToOpenGL(usage));
+  auto* result = usage == VboUsage::DynamicDraw || capacity > MaxPooledCapacity
+                   ? allocateDedicatedVbo(type, capacity, usage)
+                 : m_transientAllocations ? allocateTransientVbo(type, capacity)
+                                          : allocatePooledVbo(type, capacity);
 
   m_currentVboSize += capacity;
   m_currentVboCount++;
@@ -82,10 +135,89 @@ void VboManager::destroyVbo(Vbo* vbo)
   m_currentVboSize -= vbo->capacity();
   m_currentVboCount--;
 
-  vbo->free();
+  if (vbo->m_dedicated)
+  {
+    glAssert(glDeleteBuffers(1, &vbo->m_bufferId));
+    glResetStateCache();
+  }
+  else if (vbo->m_block)
+  {
+    const auto type = vbo->m_type == GL_ARRAY_BUFFER ? VboType::ArrayBuffer
+                                                     : VboType::ElementArrayBuffer;
+    for (auto& arena : m_arenas[typeIndex(type)])
+    {
+      if (arena->bufferId == vbo->m_bufferId)
+      {
+        arena->tracker.free(vbo->m_block);
+        break;
+      }
+    }
+  }
+  // transient blocks are reclaimed when the streaming buffer is reset
+
   delete vbo;
 }
 
+void VboManager::beginFrame()
+{
+  assert(!m_transientAllocations);
+
+  for (size_t i = 0u; i < 2u; ++i)
+  {
+    const auto type = i == 0u ? VboType::ArrayBuffer : VboType::ElementArrayBuffer;
+
+    auto& stream = m_streamBuffers[i];
+    if (stream.requested > stream.capacity && stream.capacity < MaxStreamCapacity)
+    {
+      // the last frame overflowed into the pool, so grow the buffer to fit
+      while (stream.capacity < stream.requested && stream.capacity < MaxStreamCapacity)
+      {
+        stream.capacity *= 2u;
+      }
+      orphanBuffer(type, stream.bufferId, stream.capacity);
+    }
+    else if (stream.head > 0u)
+    {
+      orphanBuffer(type, stream.bufferId, stream.capacity);
+    }
+    stream.head = 0u;
+    stream.requested = 0u;
+
+    // keep the first arena around, but release the others once they become empty
+    auto& arenas = m_arenas[i];
+    for (auto it = arenas.begin(); it != arenas.end();)
+    {
+      if (it != arenas.begin() && !(*it)->tracker.hasAllocations())
+      {
+        glAssert(glDeleteBuffers(1, &(*it)->bufferId));
+        glResetStateCache();
+        it = arenas.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  m_lastFrameCreatedBufferCount = m_createdBufferCount;
+  m_lastFrameStreamedSize = m_streamedSize;
+  m_createdBufferCount = 0u;
+  m_streamedSize = 0u;
+}
+
+void VboManager::beginTransientAllocations()
+{
+  assert(!m_transientAllocations);
+  m_transientAllocations = true;
+}
+
+void VboManager::endTransientAllocations()
+{
+  assert(m_transientAllocations);
+  m_transientAllocations = false;
+}
+
 size_t VboManager::peakVboCount() const
 {
   return m_peakVboCount;
@@ -101,9 +233,87 @@ size_t VboManager::currentVboSize() const
   return m_currentVboSize;
 }
 
+size_t VboManager::lastFrameCreatedBufferCount() const
+{
+  return m_lastFrameCreatedBufferCount;
+}
+
+size_t VboManager::lastFrameStreamedSize() const
+{
+  return m_lastFrameStreamedSize;
+}
+
 ShaderManager& VboManager::shaderManager()
 {
   return *m_shaderManager;
 }
+
+Vbo* VboManager::allocateDedicatedVbo(
+  const VboType type, const size_t capacity, const VboUsage usage)
+{
+  const auto bufferId = createBuffer(type, capacity, usageToOpenGL(usage));
+  return new Vbo{typeToOpenGL(type), bufferId, 0u, capacity, true, nullptr};
+}
+
+Vbo* VboManager::allocatePooledVbo(const VboType type, const size_t capacity)
+{
+  const auto blockCapacity = alignedCapacity(capacity);
+
+  auto& arenas = m_arenas[typeIndex(type)];
+  for (auto& arena : arenas)
+  {
+    if (auto* block = arena->tracker.allocate(blockCapacity))
+    {
+      return new Vbo{
+        typeToOpenGL(type), arena->bufferId, block->pos, capacity, false, block};
+    }
+  }
+
+  const auto bufferId = createBuffer(type, ArenaCapacity, GL_STATIC_DRAW);
+  auto& arena = arenas.emplace_back(std::make_unique<Arena>(bufferId, ArenaCapacity));
+
+  auto* block = arena->tracker.allocate(blockCapacity);
+  assert(block != nullptr);
+  return new Vbo{typeToOpenGL(type), bufferId, block->pos, capacity, false, block};
+}
+
+Vbo* VboManager::allocateTransientVbo(const VboType type, const size_t capacity)
+{
+  const auto blockCapacity = alignedCapacity(capacity);
+
+  auto& stream = m_streamBuffers[typeIndex(type)];
+  stream.requested += blockCapacity;
+
+  if (stream.bufferId == 0u)
+  {
+    stream.capacity = InitialStreamCapacity;
+    stream.bufferId = createBuffer(type, stream.capacity, GL_STREAM_DRAW);
+  }
+
+  if (stream.head + blockCapacity > stream.capacity)
+  {
+    // the buffer cannot be orphaned before the end of the frame because the blocks
+    // handed out so far have not been rendered yet
+    return allocatePooledVbo(type, capacity);
+  }
+
+  const auto offset = stream.head;
+  stream.head += blockCapacity;
+  m_streamedSize += capacity;
+
+  return new Vbo{typeToOpenGL(type), stream.bufferId, offset, capacity, false, nullptr};
+}
+
+GLuint VboManager::createBuffer(const VboType type, const size_t capacity, GLenum usage)
+{
+  auto bufferId = GLuint(0);
+  glAssert(glGenBuffers(1, &bufferId));
+  glBindBufferCached(typeToOpenGL(type), bufferId);
+  glAssert(glBufferData(
+    typeToOpenGL(type), static_cast<GLsizeiptr>(capacity), nullptr, usage));
+
+  ++m_createdBufferCount;
+  return bufferId;
+}
 } // namespace Renderer
 } // namespace TrenchBroom
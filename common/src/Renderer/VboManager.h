@@ -19,9 +19,12 @@
 
 #pragma once
 
+#include "Renderer/AllocationTracker.h"
 #include "Renderer/GL.h"
 
 #include <cstddef> // for size_t
+#include <memory>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -42,28 +45,93 @@ enum class VboUsage
   DynamicDraw
 };
 
+/**
+ * Hands out VBOs to vertex and index arrays.
+ *
+ * Most VBOs are blocks of a few large shared OpenGL buffers: small static VBOs are
+ * sub-allocated from a pool of arenas using an AllocationTracker, and VBOs allocated
+ * between beginTransientAllocations() and endTransientAllocations() are sub-allocated
+ * from a per-type streaming ring buffer that is reset at the start of each frame.
+ * Dynamic and very large VBOs get a dedicated OpenGL buffer.
+ */
 class VboManager
 {
 private:
+  struct Arena
+  {
+    GLuint bufferId;
+    AllocationTracker tracker;
+
+    Arena(GLuint i_bufferId, size_t i_capacity);
+  };
+
+  struct StreamBuffer
+  {
+    GLuint bufferId = 0;
+    size_t capacity = 0;
+    size_t head = 0;
+    size_t requested = 0;
+  };
+
   size_t m_peakVboCount;
   size_t m_currentVboCount;
   size_t m_currentVboSize;
   ShaderManager* m_shaderManager;
 
+  std::vector<std::unique_ptr<Arena>> m_arenas[2];
+  StreamBuffer m_streamBuffers[2];
+  bool m_transientAllocations;
+
+  size_t m_createdBufferCount;
+  size_t m_streamedSize;
+  size_t m_lastFrameCreatedBufferCount;
+  size_t m_lastFrameStreamedSize;
+
 public:
   explicit VboManager(ShaderManager* shaderManager);
+  ~VboManager();
+
   /**
-   * Immediately creates and binds to an OpenGL buffer of the given type and capacity.
-   * The contents are initially unspecified. See Vbo class.
+   * Returns a VBO of the given type and capacity. The contents are initially
+   * unspecified, and the VBO may be a block of a larger OpenGL buffer, so callers must
+   * respect Vbo::offset(). See Vbo class.
    */
   Vbo* allocateVbo(VboType type, size_t capacity, VboUsage usage = VboUsage::StaticDraw);
   void destroyVbo(Vbo* vbo);
 
+  /**
+   * Starts a new frame. Orphans the streaming ring buffers so that transient VBOs of the
+   * previous frame can still be read by the GPU while new data is being uploaded, and
+   * releases empty pool arenas.
+   */
+  void beginFrame();
+
+  /**
+   * Static VBOs allocated between these calls are served from the streaming ring buffer
+   * and must be destroyed before the next call to beginFrame().
+   */
+  void beginTransientAllocations();
+  void endTransientAllocations();
+
   size_t peakVboCount() const;
   size_t currentVboCount() const;
   size_t currentVboSize() const;
 
+  /**
+   * The number of OpenGL buffers created and the number of bytes streamed during the
+   * previous frame.
+   */
+  size_t lastFrameCreatedBufferCount() const;
+  size_t lastFrameStreamedSize() const;
+
   ShaderManager& shaderManager();
+
+private:
+  Vbo* allocateDedicatedVbo(VboType type, size_t capacity, VboUsage usage);
+  Vbo* allocatePooledVbo(VboType type, size_t capacity);
+  Vbo* allocateTransientVbo(VboType type, size_t capacity);
+
+  GLuint createBuffer(VboType type, size_t capacity, GLenum usage);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
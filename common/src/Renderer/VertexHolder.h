@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Ensure.h"
+#include "Renderer/ShaderManager.h"
+#include "Renderer/Vbo.h"
+#include "Renderer/VboHolder.h"
+#include "Renderer/VboManager.h"
+
+#include <memory>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+class VertexArrayInterface
+{
+public:
+  virtual ~VertexArrayInterface() = 0;
+  virtual bool setupVertices() = 0;
+  virtual void prepareVertices(VboManager& vboManager) = 0;
+  virtual void cleanupVertices() = 0;
+};
+
+template <typename V>
+class VertexHolder : public VboHolder<V>, public VertexArrayInterface
+{
+public:
+  explicit VertexHolder(VboSnapshotPolicy snapshotPolicy = VboSnapshotPolicy::Retain)
+    : VboHolder<V>(VboType::ArrayBuffer, snapshotPolicy)
+  {
+  }
+
+  /**
+   * NOTE: This destructively moves the contents of `elements` into the Holder.
+   */
+  explicit VertexHolder(std::vector<V>& elements)
+    : VboHolder<V>(VboType::ArrayBuffer, elements)
+  {
+  }
+
+  bool setupVertices() override
+  {
+    ensure(VboHolder<V>::m_vbo != nullptr, "block is null");
+    VboHolder<V>::m_vbo->bind();
+    V::Type::setup(
+      this->m_vboManager->shaderManager().currentProgram(),
+      VboHolder<V>::m_vbo->offset());
+    return true;
+  }
+
+  void prepareVertices(VboManager& vboManager) override
+  {
+    VboHolder<V>::prepare(vboManager);
+  }
+
+  void cleanupVertices() override
+  {
+    V::Type::cleanup(this->m_vboManager->shaderManager().currentProgram());
+    VboHolder<V>::m_vbo->unbind();
+  }
+
+  static std::shared_ptr<VertexHolder<V>> swap(std::vector<V>& elements)
+  {
+    return std::make_shared<VertexHolder<V>>(elements);
+  }
+};
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -0,0 +1,145 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BackgroundAssetLoader.h"
+
+#include <QString>
+
+#include "IO/SimpleParserStatus.h"
+#include "Model/Game.h"
+
+#include <chrono>
+#include <exception>
+
+namespace TrenchBroom
+{
+namespace View
+{
+namespace
+{
+template <typename T>
+std::optional<T> take(std::future<T>& future, const bool wait)
+{
+  if (!future.valid())
+  {
+    return std::nullopt;
+  }
+  if (!wait && future.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+  {
+    return std::nullopt;
+  }
+  return future.get();
+}
+
+template <typename T, typename F>
+void setValue(std::promise<T>& promise, const F& f)
+{
+  try
+  {
+    promise.set_value(f());
+  }
+  catch (...)
+  {
+    promise.set_exception(std::current_exception());
+  }
+}
+} // namespace
+
+void BackgroundAssetLoader::BufferingLogger::flush(Logger& logger)
+{
+  auto messages = std::vector<Message>{};
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    messages = std::move(m_messages);
+    m_messages.clear();
+  }
+
+  for (const auto& message : messages)
+  {
+    logger.log(message.level, message.str);
+  }
+}
+
+void BackgroundAssetLoader::BufferingLogger::doLog(
+  const LogLevel level, const std::string& message)
+{
+  const auto lock = std::lock_guard{m_mutex};
+  m_messages.push_back({level, message});
+}
+
+void BackgroundAssetLoader::BufferingLogger::doLog(
+  const LogLevel level, const QString& message)
+{
+  doLog(level, message.toStdString());
+}
+
+BackgroundAssetLoader::BackgroundAssetLoader(
+  std::shared_ptr<Model::Game> game, std::filesystem::path entityDefinitionPath)
+{
+  auto entityDefinitions = std::promise<EntityDefinitionResult>{};
+  auto textureCollections = std::promise<std::vector<Assets::TextureCollection>>{};
+  m_entityDefinitions = entityDefinitions.get_future();
+  m_textureCollections = textureCollections.get_future();
+
+  m_worker = std::async(
+    std::launch::async,
+    [this,
+     game = std::move(game),
+     path = std::move(entityDefinitionPath),
+     entityDefinitions = std::move(entityDefinitions),
+     textureCollections = std::move(textureCollections)]() mutable {
+      setValue(entityDefinitions, [&]() {
+        auto status = IO::SimpleParserStatus{m_logger};
+        return game->loadEntityDefinitions(status, path);
+      });
+      setValue(
+        textureCollections, [&]() { return game->loadTextureCollections(m_logger); });
+    });
+}
+
+BackgroundAssetLoader::~BackgroundAssetLoader()
+{
+  // the worker refers to the logger, so it must finish before it is destroyed
+  m_worker.wait();
+}
+
+void BackgroundAssetLoader::flushLog(Logger& logger)
+{
+  m_logger.flush(logger);
+}
+
+std::optional<BackgroundAssetLoader::EntityDefinitionResult> BackgroundAssetLoader::
+  takeEntityDefinitions(const bool wait)
+{
+  return take(m_entityDefinitions, wait);
+}
+
+std::optional<std::vector<Assets::TextureCollection>> BackgroundAssetLoader::
+  takeTextureCollections(const bool wait)
+{
+  return take(m_textureCollections, wait);
+}
+
+bool BackgroundAssetLoader::done() const
+{
+  return !m_entityDefinitions.valid() && !m_textureCollections.valid();
+}
+
+} // namespace View
+} // namespace TrenchBroom
@@ -0,0 +1,126 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Assets/EntityDefinition.h"
+#include "Assets/TextureCollection.h"
+#include "Error.h"
+#include "Logger.h"
+#include "Result.h"
+
+#include <kdl/result.h>
+
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+class Game;
+}
+
+namespace View
+{
+
+/**
+ * Loads the entity definitions and texture collections of a document on a worker thread.
+ *
+ * The game's file system is not thread safe, so the worker loads the entity definitions
+ * and then the texture collections one after the other. Each becomes available as soon
+ * as it is loaded.
+ *
+ * The loaded assets are taken by the thread that owns the document, which is also
+ * responsible for binding them to the map. Messages logged by the worker thread are
+ * buffered until they are flushed to the document's logger.
+ *
+ * The game's file system must not be used by any other thread while assets are being
+ * loaded, which includes loading entity models. The destructor waits for the worker
+ * thread to finish.
+ */
+class BackgroundAssetLoader
+{
+public:
+  using EntityDefinitionResult =
+    Result<std::vector<std::unique_ptr<Assets::EntityDefinition>>>;
+
+private:
+  class BufferingLogger : public Logger
+  {
+  private:
+    struct Message
+    {
+      LogLevel level;
+      std::string str;
+    };
+
+    std::mutex m_mutex;
+    std::vector<Message> m_messages;
+
+  public:
+    void flush(Logger& logger);
+
+  private:
+    void doLog(LogLevel level, const std::string& message) override;
+    void doLog(LogLevel level, const QString& message) override;
+  };
+
+  BufferingLogger m_logger;
+  std::future<EntityDefinitionResult> m_entityDefinitions;
+  std::future<std::vector<Assets::TextureCollection>> m_textureCollections;
+  std::future<void> m_worker;
+
+public:
+  BackgroundAssetLoader(
+    std::shared_ptr<Model::Game> game, std::filesystem::path entityDefinitionPath);
+  ~BackgroundAssetLoader();
+
+  /**
+   * Forwards the messages that were logged by the worker thread so far to the given
+   * logger.
+   */
+  void flushLog(Logger& logger);
+
+  /**
+   * Returns the loaded entity definitions if they are available and have not been taken
+   * yet. If wait is true, blocks until the entity definitions are loaded.
+   */
+  std::optional<EntityDefinitionResult> takeEntityDefinitions(bool wait);
+
+  /**
+   * Returns the loaded texture collections if they are available and have not been taken
+   * yet. If wait is true, blocks until the texture collections are loaded.
+   */
+  std::optional<std::vector<Assets::TextureCollection>> takeTextureCollections(
+    bool wait);
+
+  /**
+   * Indicates whether all loaded assets have been taken.
+   */
+  bool done() const;
+};
+
+} // namespace View
+} // namespace TrenchBroom
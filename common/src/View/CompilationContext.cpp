@@ -39,6 +39,11 @@ CompilationContext::CompilationContext(
 {
 }
 
+CompilationContext CompilationContext::withOutput(TextOutputAdapter output) const
+{
+  return CompilationContext{m_document, *m_variables, std::move(output), m_test};
+}
+
 std::shared_ptr<MapDocument> CompilationContext::document() const
 {
   return kdl::mem_lock(m_document);
@@ -45,6 +45,11 @@ public:
     TextOutputAdapter output,
     bool test);
 
+  /**
+   * Returns a copy of this context that writes to the given output instead.
+   */
+  CompilationContext withOutput(TextOutputAdapter output) const;
+
   std::shared_ptr<MapDocument> document() const;
   bool test() const;
 
@@ -25,10 +25,12 @@
 #include <QLabel>
 #include <QMessageBox>
 #include <QPushButton>
+#include <QTabWidget>
 #include <QTextEdit>
 
 #include "Ensure.h"
 #include "Model/CompilationProfile.h"
+#include "Model/CompilationTask.h"
 #include "Model/Game.h"
 #include "Model/GameFactory.h"
 #include "View/CompilationContext.h"
@@ -39,13 +41,38 @@
 #include "View/MapFrame.h"
 #include "View/QtUtils.h"
 #include "View/Splitter.h"
+#include "View/TextOutputAdapter.h"
 #include "View/TitledPanel.h"
 #include "View/ViewConstants.h"
 
+#include <kdl/overload.h>
+
+#include <filesystem>
+
 namespace TrenchBroom
 {
 namespace View
 {
+namespace
+{
+QString taskTitle(const size_t taskIndex, const Model::CompilationTask& task)
+{
+  const auto title = std::visit(
+    kdl::overload(
+      [](const Model::CompilationExportMap&) { return std::string{"Export Map"}; },
+      [](const Model::CompilationCopyFiles&) { return std::string{"Copy Files"}; },
+      [](const Model::CompilationRenameFile&) { return std::string{"Rename File"}; },
+      [](const Model::CompilationDeleteFiles&) { return std::string{"Delete Files"}; },
+      [](const Model::CompilationRunTool& runTool) {
+        const auto toolName = std::filesystem::path{runTool.toolSpec}.filename().string();
+        return toolName.empty() ? std::string{"Run Tool"} : toolName;
+      }),
+    task);
+  const auto taskNumber = Model::taskNumberForIndex(taskIndex);
+  return QString::fromStdString(std::to_string(taskNumber) + ". " + title);
+}
+} // namespace
+
 CompilationDialog::CompilationDialog(MapFrame* mapFrame)
   : QDialog{mapFrame}
   , m_mapFrame{mapFrame}
@@ -73,15 +100,21 @@ void CompilationDialog::createGui()
   m_output->setReadOnly(true);
   m_output->setFont(Fonts::fixedWidthFont());
 
+  // profiles that run several tasks at once get an additional tab for each task
+  m_outputTabs = new QTabWidget{};
+  m_outputTabs->setTabBarAutoHide(true);
+  m_outputTabs->setDocumentMode(true);
+  m_outputTabs->addTab(m_output, "Output");
+
   auto* outputLayout = new QVBoxLayout{};
   outputLayout->setContentsMargins(0, 0, 0, 0);
   outputLayout->setSpacing(0);
-  outputLayout->addWidget(m_output);
+  outputLayout->addWidget(m_outputTabs);
   outputPanel->getPanel()->setLayout(outputLayout);
 
   auto* splitter = new Splitter{Qt::Vertical};
   splitter->addWidget(m_profileManager);
-  splitter->addWidget(m_output);
+  splitter->addWidget(m_outputTabs);
   splitter->setSizes({2, 1});
 
   auto* buttonBox = new QDialogButtonBox{};
@@ -180,17 +213,42 @@ void CompilationDialog::startCompilation(const bool test)
     ensure(profile != nullptr, "profile is null");
     ensure(!profile->tasks.empty(), "profile has no tasks");
 
+    removeTaskOutputs();
+
+    auto makeTaskOutput = CompilationRunner::TaskOutputFactory{};
+    if (profile->jobCount > 1)
+    {
+      makeTaskOutput = [&](const size_t taskIndex, const Model::CompilationTask& task) {
+        auto* taskOutput = new QTextEdit{};
+        taskOutput->setReadOnly(true);
+        taskOutput->setFont(Fonts::fixedWidthFont());
+        m_outputTabs->addTab(taskOutput, taskTitle(taskIndex, task));
+        return TextOutputAdapter{taskOutput};
+      };
+    }
+
     if (test)
     {
-      m_run.test(*profile, m_mapFrame->document(), m_output);
+      m_run.test(*profile, m_mapFrame->document(), m_output, makeTaskOutput);
     }
     else
     {
-      m_run.run(*profile, m_mapFrame->document(), m_output);
+      m_run.run(*profile, m_mapFrame->document(), m_output, makeTaskOutput);
     }
   }
 }
 
+void CompilationDialog::removeTaskOutputs()
+{
+  while (m_outputTabs->count() > 1)
+  {
+    auto* taskOutput = m_outputTabs->widget(1);
+    m_outputTabs->removeTab(1);
+    delete taskOutput;
+  }
+  m_outputTabs->setCurrentWidget(m_output);
+}
+
 void CompilationDialog::stopCompilation()
 {
   if (m_run.running())
@@ -25,6 +25,7 @@
 
 class QLabel;
 class QPushButton;
+class QTabWidget;
 class QTextEdit;
 
 namespace TrenchBroom
@@ -46,6 +47,7 @@ private:
   QPushButton* m_stopCompileButton{nullptr};
   QPushButton* m_closeButton{nullptr};
   QLabel* m_currentRunLabel{nullptr};
+  QTabWidget* m_outputTabs{nullptr};
   QTextEdit* m_output{nullptr};
   CompilationRun m_run;
 
@@ -59,6 +61,7 @@ private:
 
   void updateCompileButtons();
   void startCompilation(bool test);
+  void removeTaskOutputs();
   void stopCompilation();
   void closeEvent(QCloseEvent* event) override;
 private slots:
@@ -23,6 +23,7 @@
 #include <QFormLayout>
 #include <QLineEdit>
 #include <QMenu>
+#include <QSpinBox>
 #include <QStackedWidget>
 #include <QToolButton>
 
@@ -81,6 +82,12 @@ QWidget* CompilationProfileEditor::createEditorPage(QWidget* parent)
   m_workDirTxt->setToolTip(R"(A working directory for the compilation profile.
 Variables are allowed.)");
 
+  m_jobCountSpinBox = new QSpinBox{};
+  m_jobCountSpinBox->setRange(1, 64);
+  m_jobCountSpinBox->setToolTip(
+    R"(The maximum number of tasks to run at the same time.
+A task only runs once all tasks it depends on have finished.)");
+
   auto* upperLayout = new QFormLayout{};
   upperLayout->setContentsMargins(
     LayoutConstants::MediumHMargin,
@@ -92,6 +99,7 @@ Variables are allowed.)");
   upperLayout->setFieldGrowthPolicy(QFormLayout::ExpandingFieldsGrow);
   upperLayout->addRow("Name", m_nameTxt);
   upperLayout->addRow("Working Directory", m_workDirTxt);
+  upperLayout->addRow("Parallel Jobs", m_jobCountSpinBox);
   upperPanel->setLayout(upperLayout);
 
   m_taskList = new CompilationTaskListBox{m_document, containerPanel};
@@ -122,6 +130,11 @@ Variables are allowed.)");
     &QLineEdit::textChanged,
     this,
     &CompilationProfileEditor::workDirChanged);
+  connect(
+    m_jobCountSpinBox,
+    QOverload<int>::of(&QSpinBox::valueChanged),
+    this,
+    &CompilationProfileEditor::jobCountChanged);
   connect(
     m_taskList,
     &ControlListBox::itemSelectionChanged,
@@ -192,6 +205,17 @@ void CompilationProfileEditor::workDirChanged(const QString& text)
   }
 }
 
+void CompilationProfileEditor::jobCountChanged(const int jobCount)
+{
+  ensure(m_profile != nullptr, "profile is null");
+  const auto newJobCount = static_cast<size_t>(jobCount);
+  if (m_profile->jobCount != newJobCount)
+  {
+    m_profile->jobCount = newJobCount;
+    emit profileChanged();
+  }
+}
+
 void CompilationProfileEditor::addTask()
 {
   auto menu = QMenu{};
@@ -241,6 +265,10 @@ void CompilationProfileEditor::addTask()
     {
       m_profile->tasks.insert(
         std::next(m_profile->tasks.begin(), index + 1), std::move(*task));
+      m_profile->tasks = Model::remapDependencies(
+        std::move(m_profile->tasks), [&](const size_t i) -> std::optional<size_t> {
+          return i <= size_t(index) ? i : i + 1;
+        });
       m_taskList->reloadTasks();
       m_taskList->setCurrentRow(index + 1);
     }
@@ -258,6 +286,14 @@ void CompilationProfileEditor::removeTask(const int index)
   assert(index >= 0);
 
   m_profile->tasks = kdl::vec_erase_at(std::move(m_profile->tasks), size_t(index));
+  m_profile->tasks = Model::remapDependencies(
+    std::move(m_profile->tasks), [&](const size_t i) -> std::optional<size_t> {
+      if (i == size_t(index))
+      {
+        return std::nullopt;
+      }
+      return i < size_t(index) ? i : i - 1;
+    });
   m_taskList->reloadTasks();
 
   if (!m_profile->tasks.empty())
@@ -272,6 +308,10 @@ void CompilationProfileEditor::duplicateTask(const int index)
   auto task = m_profile->tasks[size_t(index)];
   m_profile->tasks.insert(
     std::next(m_profile->tasks.begin(), index + 1), std::move(task));
+  m_profile->tasks = Model::remapDependencies(
+    std::move(m_profile->tasks), [&](const size_t i) -> std::optional<size_t> {
+      return i <= size_t(index) ? i : i + 1;
+    });
   m_taskList->reloadTasks();
   m_taskList->setCurrentRow(index + 1);
   emit profileChanged();
@@ -288,6 +328,10 @@ void CompilationProfileEditor::moveTaskUp(const int index)
 
   auto it = std::next(m_profile->tasks.begin(), index);
   std::iter_swap(it, std::prev(it));
+  m_profile->tasks = Model::remapDependencies(
+    std::move(m_profile->tasks), [&](const size_t i) -> std::optional<size_t> {
+      return i == size_t(index) ? i - 1 : i == size_t(index - 1) ? i + 1 : i;
+    });
   m_taskList->reloadTasks();
   m_taskList->setCurrentRow(index - 1);
   emit profileChanged();
@@ -304,6 +348,10 @@ void CompilationProfileEditor::moveTaskDown(const int index)
 
   auto it = std::next(m_profile->tasks.begin(), index);
   std::iter_swap(it, std::next(it));
+  m_profile->tasks = Model::remapDependencies(
+    std::move(m_profile->tasks), [&](const size_t i) -> std::optional<size_t> {
+      return i == size_t(index) ? i + 1 : i == size_t(index + 1) ? i - 1 : i;
+    });
   m_taskList->reloadTasks();
   m_taskList->setCurrentRow(index + 1);
   emit profileChanged();
@@ -334,6 +382,10 @@ void CompilationProfileEditor::refresh()
     {
       m_workDirTxt->setText(QString::fromStdString(m_profile->workDirSpec));
     }
+    if (static_cast<size_t>(m_jobCountSpinBox->value()) != m_profile->jobCount)
+    {
+      m_jobCountSpinBox->setValue(static_cast<int>(m_profile->jobCount));
+    }
   }
   m_addTaskButton->setEnabled(m_profile);
   m_removeTaskButton->setEnabled(m_profile && m_taskList->currentRow() >= 0);
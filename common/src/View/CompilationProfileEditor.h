@@ -25,6 +25,7 @@
 
 class QAbstractButton;
 class QLineEdit;
+class QSpinBox;
 class QStackedWidget;
 
 namespace TrenchBroom
@@ -52,6 +53,7 @@ private:
   QStackedWidget* m_stackedWidget{nullptr};
   QLineEdit* m_nameTxt{nullptr};
   MultiCompletionLineEdit* m_workDirTxt{nullptr};
+  QSpinBox* m_jobCountSpinBox{nullptr};
   CompilationTaskListBox* m_taskList{nullptr};
   QAbstractButton* m_addTaskButton{nullptr};
   QAbstractButton* m_removeTaskButton{nullptr};
@@ -68,6 +70,7 @@ private:
 private slots:
   void nameChanged(const QString& text);
   void workDirChanged(const QString& text);
+  void jobCountChanged(int jobCount);
 
   void addTask();
   void removeTask();
@@ -87,7 +90,7 @@ private:
   void refresh();
 signals:
   /**
-   * Emitted when the profile name/working directory change, or tasks are
+   * Emitted when the profile name/working directory/job count change, or tasks are
    * added/removed/reordered.
    */
   void profileChanged();
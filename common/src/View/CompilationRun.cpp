@@ -51,17 +51,19 @@ bool CompilationRun::running() const
 void CompilationRun::run(
   const Model::CompilationProfile& profile,
   std::shared_ptr<MapDocument> document,
-  QTextEdit* currentOutput)
+  QTextEdit* currentOutput,
+  const CompilationRunner::TaskOutputFactory& makeTaskOutput)
 {
-  run(profile, std::move(document), currentOutput, false);
+  run(profile, std::move(document), currentOutput, makeTaskOutput, false);
 }
 
 void CompilationRun::test(
   const Model::CompilationProfile& profile,
   std::shared_ptr<MapDocument> document,
-  QTextEdit* currentOutput)
+  QTextEdit* currentOutput,
+  const CompilationRunner::TaskOutputFactory& makeTaskOutput)
 {
-  run(profile, std::move(document), currentOutput, true);
+  run(profile, std::move(document), currentOutput, makeTaskOutput, true);
 }
 
 void CompilationRun::terminate()
@@ -81,6 +83,7 @@ void CompilationRun::run(
   const Model::CompilationProfile& profile,
   std::shared_ptr<MapDocument> document,
   QTextEdit* currentOutput,
+  const CompilationRunner::TaskOutputFactory& makeTaskOutput,
   const bool test)
 {
   ensure(!profile.tasks.empty(), "profile has no tasks");
@@ -94,7 +97,8 @@ void CompilationRun::run(
 
   auto compilationContext =
     CompilationContext{document, variables, TextOutputAdapter{currentOutput}, test};
-  m_currentRun = new CompilationRunner{std::move(compilationContext), profile, this};
+  m_currentRun = new CompilationRunner{
+    std::move(compilationContext), profile, makeTaskOutput, this};
   connect(
     m_currentRun,
     &CompilationRunner::compilationStarted,
@@ -21,6 +21,8 @@
 
 #include <QObject>
 
+#include "View/CompilationRunner.h"
+
 #include <memory>
 #include <string>
 
@@ -38,7 +40,6 @@ struct CompilationProfile;
 
 namespace TrenchBroom::View
 {
-class CompilationRunner;
 class MapDocument;
 
 class CompilationRun : public QObject
@@ -54,11 +55,13 @@ public:
   void run(
     const Model::CompilationProfile& profile,
     std::shared_ptr<MapDocument> document,
-    QTextEdit* currentOutput);
+    QTextEdit* currentOutput,
+    const CompilationRunner::TaskOutputFactory& makeTaskOutput = {});
   void test(
     const Model::CompilationProfile& profile,
     std::shared_ptr<MapDocument> document,
-    QTextEdit* currentOutput);
+    QTextEdit* currentOutput,
+    const CompilationRunner::TaskOutputFactory& makeTaskOutput = {});
   void terminate();
 
 private:
@@ -67,6 +70,7 @@ private:
     const Model::CompilationProfile& profile,
     std::shared_ptr<MapDocument> document,
     QTextEdit* currentOutput,
+    const CompilationRunner::TaskOutputFactory& makeTaskOutput,
     bool test);
 
 private:
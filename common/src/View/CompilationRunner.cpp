@@ -44,6 +44,7 @@
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <string>
 
@@ -406,61 +407,88 @@ void CompilationRunToolTaskRunner::processReadyReadStandardOutput()
   }
 }
 
+namespace
+{
+std::unique_ptr<CompilationTaskRunner> createTaskRunner(
+  CompilationContext& context, const Model::CompilationTask& task)
+{
+  return std::visit(
+    kdl::overload(
+      [&](const Model::CompilationExportMap& exportMap)
+        -> std::unique_ptr<CompilationTaskRunner> {
+        return std::make_unique<CompilationExportMapTaskRunner>(context, exportMap);
+      },
+      [&](const Model::CompilationCopyFiles& copyFiles)
+        -> std::unique_ptr<CompilationTaskRunner> {
+        return std::make_unique<CompilationCopyFilesTaskRunner>(context, copyFiles);
+      },
+      [&](const Model::CompilationRenameFile& renameFile)
+        -> std::unique_ptr<CompilationTaskRunner> {
+        return std::make_unique<CompilationRenameFileTaskRunner>(context, renameFile);
+      },
+      [&](const Model::CompilationDeleteFiles& deleteFiles)
+        -> std::unique_ptr<CompilationTaskRunner> {
+        return std::make_unique<CompilationDeleteFilesTaskRunner>(context, deleteFiles);
+      },
+      [&](const Model::CompilationRunTool& runTool)
+        -> std::unique_ptr<CompilationTaskRunner> {
+        return std::make_unique<CompilationRunToolTaskRunner>(context, runTool);
+      }),
+    task);
+}
+} // namespace
+
 CompilationRunner::CompilationRunner(
   CompilationContext context, const Model::CompilationProfile& profile, QObject* parent)
+  : CompilationRunner{std::move(context), profile, TaskOutputFactory{}, parent}
+{
+}
+
+CompilationRunner::CompilationRunner(
+  CompilationContext context,
+  const Model::CompilationProfile& profile,
+  const TaskOutputFactory& makeTaskOutput,
+  QObject* parent)
   : QObject{parent}
   , m_context{std::move(context)}
-  , m_taskRunners{createTaskRunners(m_context, profile)}
-  , m_currentTask{std::end(m_taskRunners)}
+  , m_tasks{createTasks(m_context, profile, makeTaskOutput)}
+  , m_jobCount{std::max(profile.jobCount, size_t(1))}
 {
 }
 
 CompilationRunner::~CompilationRunner() = default;
 
-CompilationRunner::TaskRunnerList CompilationRunner::createTaskRunners(
-  CompilationContext& context, const Model::CompilationProfile& profile)
+std::vector<CompilationRunner::Task> CompilationRunner::createTasks(
+  CompilationContext& context,
+  const Model::CompilationProfile& profile,
+  const TaskOutputFactory& makeTaskOutput)
 {
-  auto result = TaskRunnerList{};
-  for (const auto& task : profile.tasks)
+  const auto dependencies = Model::resolveDependencies(profile.tasks);
+
+  // maps the indices of the enabled profile tasks to the indices of the runner's tasks
+  auto taskIndices = std::vector<size_t>(profile.tasks.size(), 0);
+
+  auto result = std::vector<Task>{};
+  for (size_t i = 0; i < profile.tasks.size(); ++i)
   {
-    std::visit(
-      kdl::overload(
-        [&](const Model::CompilationExportMap& exportMap) {
-          if (exportMap.enabled)
-          {
-            result.push_back(
-              std::make_unique<CompilationExportMapTaskRunner>(context, exportMap));
-          }
-        },
-        [&](const Model::CompilationCopyFiles& copyFiles) {
-          if (copyFiles.enabled)
-          {
-            result.push_back(
-              std::make_unique<CompilationCopyFilesTaskRunner>(context, copyFiles));
-          }
-        },
-        [&](const Model::CompilationRenameFile& renameFile) {
-          if (renameFile.enabled)
-          {
-            result.push_back(
-              std::make_unique<CompilationRenameFileTaskRunner>(context, renameFile));
-          }
-        },
-        [&](const Model::CompilationDeleteFiles& deleteFiles) {
-          if (deleteFiles.enabled)
-          {
-            result.push_back(
-              std::make_unique<CompilationDeleteFilesTaskRunner>(context, deleteFiles));
-          }
-        },
-        [&](const Model::CompilationRunTool& runTool) {
-          if (runTool.enabled)
-          {
-            result.push_back(
-              std::make_unique<CompilationRunToolTaskRunner>(context, runTool));
-          }
-        }),
-      task);
+    const auto& task = profile.tasks[i];
+    if (Model::isEnabled(task))
+    {
+      auto taskContext = std::unique_ptr<CompilationContext>{};
+      if (makeTaskOutput)
+      {
+        taskContext = std::make_unique<CompilationContext>(
+          context.withOutput(makeTaskOutput(i, task)));
+      }
+
+      auto runner = createTaskRunner(taskContext ? *taskContext : context, task);
+      auto taskDependencies = kdl::vec_transform(
+        dependencies[i], [&](const auto dependency) { return taskIndices[dependency]; });
+
+      taskIndices[i] = result.size();
+      result.push_back(
+        Task{std::move(taskContext), std::move(runner), std::move(taskDependencies)});
+    }
   }
   return result;
 }
@@ -469,12 +497,17 @@ void CompilationRunner::execute()
 {
   assert(!running());
 
-  m_currentTask = std::begin(m_taskRunners);
-  if (m_currentTask == std::end(m_taskRunners))
+  if (m_tasks.empty())
   {
     return;
   }
-  bindEvents(*m_currentTask->get());
+
+  for (auto& task : m_tasks)
+  {
+    task.state = TaskState::Pending;
+  }
+  m_running = true;
+  m_elapsedTimer.start();
 
   emit compilationStarted();
 
@@ -488,60 +521,140 @@ void CompilationRunner::execute()
   {
     m_context << "#### Using working directory '" << workDir << "'\n";
   }
-  m_currentTask->get()->execute();
+
+  startReadyTasks();
 }
 
 void CompilationRunner::terminate()
 {
   assert(running());
-  unbindEvents(*m_currentTask->get());
-  m_currentTask->get()->terminate();
-  m_currentTask = std::end(m_taskRunners);
-
-  emit compilationEnded();
+  terminateRunningTasks();
+  endCompilation("terminated");
 }
 
 bool CompilationRunner::running() const
 {
-  return m_currentTask != std::end(m_taskRunners);
+  return m_running;
 }
 
-void CompilationRunner::bindEvents(CompilationTaskRunner& runner) const
+void CompilationRunner::startReadyTasks()
 {
-  connect(&runner, &CompilationTaskRunner::error, this, &CompilationRunner::taskError);
-  connect(&runner, &CompilationTaskRunner::end, this, &CompilationRunner::taskEnd);
+  // Tasks that don't run an external tool finish while they are being started, which
+  // starts the next tasks. Any tasks that become ready this way are picked up by the
+  // outermost call.
+  if (m_startingTasks)
+  {
+    return;
+  }
+
+  m_startingTasks = true;
+
+  auto startedTask = true;
+  while (running() && startedTask)
+  {
+    startedTask = false;
+    for (size_t i = 0; i < m_tasks.size() && running(); ++i)
+    {
+      if (runningTaskCount() >= m_jobCount)
+      {
+        break;
+      }
+
+      if (canStart(m_tasks[i]))
+      {
+        m_tasks[i].state = TaskState::Running;
+        bindEvents(i);
+        m_tasks[i].runner->execute();
+        startedTask = true;
+      }
+    }
+  }
+
+  m_startingTasks = false;
+
+  if (
+    running() && std::all_of(m_tasks.begin(), m_tasks.end(), [](const auto& task) {
+      return task.state == TaskState::Finished;
+    }))
+  {
+    endCompilation("finished");
+  }
+}
+
+bool CompilationRunner::canStart(const Task& task) const
+{
+  return task.state == TaskState::Pending
+         && std::all_of(
+           task.dependencies.begin(), task.dependencies.end(), [&](const auto i) {
+             return m_tasks[i].state == TaskState::Finished;
+           });
 }
 
-void CompilationRunner::unbindEvents(CompilationTaskRunner& runner) const
+size_t CompilationRunner::runningTaskCount() const
 {
-  runner.disconnect(this);
+  return size_t(std::count_if(m_tasks.begin(), m_tasks.end(), [](const auto& task) {
+    return task.state == TaskState::Running;
+  }));
 }
 
-void CompilationRunner::taskError()
+void CompilationRunner::terminateRunningTasks()
+{
+  for (size_t i = 0; i < m_tasks.size(); ++i)
+  {
+    if (m_tasks[i].state == TaskState::Running)
+    {
+      unbindEvents(i);
+      m_tasks[i].runner->terminate();
+      m_tasks[i].state = TaskState::Pending;
+    }
+  }
+}
+
+void CompilationRunner::endCompilation(const QString& status)
+{
+  m_running = false;
+
+  const auto elapsedSeconds = double(m_elapsedTimer.elapsed()) / 1000.0;
+  m_context << "#### Compilation " << status << " after "
+            << QString::number(elapsedSeconds, 'f', 2) << "s\n";
+
+  emit compilationEnded();
+}
+
+void CompilationRunner::bindEvents(const size_t taskIndex)
+{
+  auto& runner = *m_tasks[taskIndex].runner;
+  connect(&runner, &CompilationTaskRunner::error, this, [this, taskIndex]() {
+    taskError(taskIndex);
+  });
+  connect(&runner, &CompilationTaskRunner::end, this, [this, taskIndex]() {
+    taskEnd(taskIndex);
+  });
+}
+
+void CompilationRunner::unbindEvents(const size_t taskIndex)
+{
+  m_tasks[taskIndex].runner->disconnect(this);
+}
+
+void CompilationRunner::taskError(const size_t taskIndex)
 {
   if (running())
   {
-    unbindEvents(*m_currentTask->get());
-    m_currentTask = std::end(m_taskRunners);
-    emit compilationEnded();
+    unbindEvents(taskIndex);
+    m_tasks[taskIndex].state = TaskState::Pending;
+    terminateRunningTasks();
+    endCompilation("failed");
   }
 }
 
-void CompilationRunner::taskEnd()
+void CompilationRunner::taskEnd(const size_t taskIndex)
 {
   if (running())
   {
-    unbindEvents(*m_currentTask->get());
-    ++m_currentTask;
-    if (m_currentTask != std::end(m_taskRunners))
-    {
-      bindEvents(*m_currentTask->get());
-      m_currentTask->get()->execute();
-    }
-    else
-    {
-      emit compilationEnded();
-    }
+    unbindEvents(taskIndex);
+    m_tasks[taskIndex].state = TaskState::Finished;
+    startReadyTasks();
   }
 }
 
@@ -19,13 +19,16 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QProcess> // for QProcess::ProcessError
 
 #include "Macros.h"
 #include "Model/CompilationTask.h"
 #include "View/CompilationContext.h"
+#include "View/TextOutputAdapter.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -169,26 +172,67 @@ private slots:
   deleteCopyAndMove(CompilationRunToolTaskRunner);
 };
 
+/**
+ * Runs the enabled tasks of a compilation profile. A task is started once all of its
+ * dependencies have finished, and at most as many tasks as the profile's job count are
+ * run at the same time. If any task fails, all running tasks are terminated.
+ */
 class CompilationRunner : public QObject
 {
   Q_OBJECT
+public:
+  /**
+   * Creates the output for the task at the given index of the compilation profile.
+   */
+  using TaskOutputFactory = std::function<TextOutputAdapter(
+    size_t taskIndex, const Model::CompilationTask& task)>;
+
 private:
-  using TaskRunnerList = std::vector<std::unique_ptr<CompilationTaskRunner>>;
+  enum class TaskState
+  {
+    Pending,
+    Running,
+    Finished
+  };
+
+  struct Task
+  {
+    // null if the task writes to the runner's output
+    std::unique_ptr<CompilationContext> context;
+    std::unique_ptr<CompilationTaskRunner> runner;
+    std::vector<size_t> dependencies;
+    TaskState state = TaskState::Pending;
+  };
 
   CompilationContext m_context;
-  TaskRunnerList m_taskRunners;
-  TaskRunnerList::iterator m_currentTask;
+  std::vector<Task> m_tasks;
+  size_t m_jobCount;
+  bool m_running{false};
+  bool m_startingTasks{false};
+  QElapsedTimer m_elapsedTimer;
 
 public:
   CompilationRunner(
     CompilationContext context,
     const Model::CompilationProfile& profile,
     QObject* parent = nullptr);
+
+  /**
+   * Creates a runner where each task writes to the output returned by the given factory
+   * instead of the output of the given context.
+   */
+  CompilationRunner(
+    CompilationContext context,
+    const Model::CompilationProfile& profile,
+    const TaskOutputFactory& makeTaskOutput,
+    QObject* parent = nullptr);
   ~CompilationRunner() override;
 
 private:
-  static TaskRunnerList createTaskRunners(
-    CompilationContext& context, const Model::CompilationProfile& profile);
+  static std::vector<Task> createTasks(
+    CompilationContext& context,
+    const Model::CompilationProfile& profile,
+    const TaskOutputFactory& makeTaskOutput);
 
 public:
   void execute();
@@ -196,11 +240,17 @@ public:
   bool running() const;
 
 private:
-  void bindEvents(CompilationTaskRunner& runner) const;
-  void unbindEvents(CompilationTaskRunner& runner) const;
-private slots:
-  void taskError();
-  void taskEnd();
+  void startReadyTasks();
+  bool canStart(const Task& task) const;
+  size_t runningTaskCount() const;
+  void terminateRunningTasks();
+  void endCompilation(const QString& status);
+
+  void bindEvents(size_t taskIndex);
+  void unbindEvents(size_t taskIndex);
+
+  void taskError(size_t taskIndex);
+  void taskEnd(size_t taskIndex);
 signals:
   void compilationStarted();
   void compilationEnded();
@@ -43,9 +43,58 @@
 
 #include <kdl/memory_utils.h>
 #include <kdl/overload.h>
+#include <kdl/string_utils.h>
+#include <kdl/vector_utils.h>
 
 namespace TrenchBroom::View
 {
+namespace
+{
+// Dependencies are shown as task numbers. An empty string means that the task depends on
+// the previous task, and "none" means that it has no dependencies.
+
+Model::CompilationTaskDependencies parseDependencies(
+  const std::string& str, const size_t taskIndex)
+{
+  if (kdl::str_trim(str).empty())
+  {
+    return std::nullopt;
+  }
+
+  auto result = std::vector<size_t>{};
+  for (const auto& part : kdl::str_split(str, ", "))
+  {
+    const auto number = kdl::str_to_size(part);
+    if (const auto index = number ? Model::taskIndexForNumber(*number) : std::nullopt)
+    {
+      // tasks can only depend on earlier tasks
+      if (*index < taskIndex)
+      {
+        result.push_back(*index);
+      }
+    }
+  }
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+}
+
+std::string formatDependencies(const Model::CompilationTaskDependencies& dependencies)
+{
+  if (!dependencies)
+  {
+    return "";
+  }
+  if (dependencies->empty())
+  {
+    return "none";
+  }
+  return kdl::str_join(
+    kdl::vec_transform(
+      *dependencies,
+      [](const auto i) { return std::to_string(Model::taskNumberForIndex(i)); }),
+    ", ");
+}
+} // namespace
+
 // CompilationTaskEditorBase
 
 CompilationTaskEditorBase::CompilationTaskEditorBase(
@@ -63,7 +112,8 @@ CompilationTaskEditorBase::CompilationTaskEditorBase(
   // request customContextMenuRequested() to be emitted
   setContextMenuPolicy(Qt::CustomContextMenu);
 
-  auto* panel = new TitledPanel{m_title};
+  const auto taskNumber = Model::taskNumberForIndex(taskIndex());
+  auto* panel = new TitledPanel{QString::number(taskNumber) + ". " + m_title};
 
   auto* layout = new QVBoxLayout{};
   layout->setContentsMargins(0, 0, 0, 0);
@@ -105,9 +155,48 @@ void CompilationTaskEditorBase::addMainLayout(QLayout* layout)
   m_taskLayout->addLayout(layout, 1);
 }
 
+void CompilationTaskEditorBase::addDependenciesEditor(QFormLayout* formLayout)
+{
+  m_dependenciesEditor = new QLineEdit{};
+  m_dependenciesEditor->setPlaceholderText(tr("previous task"));
+  m_dependenciesEditor->setToolTip(
+    tr(R"(The numbers of the tasks that must have finished before this task can run.
+Enter 'none' if this task does not depend on any other task.)"));
+  formLayout->addRow("Depends On", m_dependenciesEditor);
+
+  connect(
+    m_dependenciesEditor,
+    &QLineEdit::textChanged,
+    this,
+    &CompilationTaskEditorBase::dependenciesChanged);
+}
+
 void CompilationTaskEditorBase::updateItem()
 {
   std::visit([&](const auto& t) { m_enabledCheckbox->setChecked(t.enabled); }, m_task);
+
+  if (m_dependenciesEditor)
+  {
+    // don't replace what the user is typing if it means the same
+    const auto& dependencies = Model::dependencies(m_task);
+    const auto text = m_dependenciesEditor->text().toStdString();
+    if (parseDependencies(text, taskIndex()) != dependencies)
+    {
+      m_dependenciesEditor->setText(
+        QString::fromStdString(formatDependencies(dependencies)));
+    }
+  }
+}
+
+size_t CompilationTaskEditorBase::taskIndex() const
+{
+  return static_cast<size_t>(&m_task - m_profile.tasks.data());
+}
+
+void CompilationTaskEditorBase::dependenciesChanged(const QString& text)
+{
+  auto dependencies = parseDependencies(text.toStdString(), taskIndex());
+  std::visit([&](auto& t) { t.dependencies = std::move(dependencies); }, m_task);
 }
 
 void CompilationTaskEditorBase::updateCompleter(QCompleter* completer)
@@ -155,6 +244,8 @@ Variables are allowed.)");
   setupCompleter(m_targetEditor);
   formLayout->addRow("File Path", m_targetEditor);
 
+  addDependenciesEditor(formLayout);
+
   connect(
     m_targetEditor,
     &QLineEdit::textChanged,
@@ -223,6 +314,8 @@ Variables are allowed.)");
   setupCompleter(m_targetEditor);
   formLayout->addRow("Target Directory Path", m_targetEditor);
 
+  addDependenciesEditor(formLayout);
+
   connect(
     m_sourceEditor,
     &QLineEdit::textChanged,
@@ -308,6 +401,8 @@ Variables are allowed.)");
   setupCompleter(m_targetEditor);
   formLayout->addRow("Target File Path", m_targetEditor);
 
+  addDependenciesEditor(formLayout);
+
   connect(
     m_sourceEditor,
     &QLineEdit::textChanged,
@@ -382,6 +477,8 @@ Variables are allowed.)");
   setupCompleter(m_targetEditor);
   formLayout->addRow("File Path", m_targetEditor);
 
+  addDependenciesEditor(formLayout);
+
   connect(
     m_targetEditor,
     &QLineEdit::textChanged,
@@ -467,6 +564,8 @@ Variables are allowed.)");
     tr("Stop compilation if the tool returns a nonzero error code"));
   formLayout->addRow("", m_treatNonZeroResultCodeAsError);
 
+  addDependenciesEditor(formLayout);
+
   connect(
     m_toolEditor,
     &QLineEdit::textChanged,
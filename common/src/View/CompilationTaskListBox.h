@@ -27,6 +27,7 @@
 
 class QCheckBox;
 class QCompleter;
+class QFormLayout;
 class QHBoxLayout;
 class QLayout;
 class QLineEdit;
@@ -52,6 +53,7 @@ protected:
   Model::CompilationProfile& m_profile;
   Model::CompilationTask& m_task;
   QCheckBox* m_enabledCheckbox = nullptr;
+  QLineEdit* m_dependenciesEditor = nullptr;
   QHBoxLayout* m_taskLayout = nullptr;
 
   std::vector<QCompleter*> m_completers;
@@ -67,12 +69,16 @@ protected:
 protected:
   void setupCompleter(MultiCompletionLineEdit* lineEdit);
   void addMainLayout(QLayout* layout);
+  void addDependenciesEditor(QFormLayout* formLayout);
 
 protected:
   void updateItem() override;
 
 private:
+  size_t taskIndex() const;
   void updateCompleter(QCompleter* completer);
+private slots:
+  void dependenciesChanged(const QString& text);
 };
 
 class CompilationExportMapTaskEditor : public CompilationTaskEditorBase
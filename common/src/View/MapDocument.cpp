@@ -88,6 +88,7 @@
 #include "Uuid.h"
 #include "View/Actions.h"
 #include "View/AddRemoveNodesCommand.h"
+#include "View/BackgroundAssetLoader.h"
 #include "View/BrushVertexCommands.h"
 #include "View/CurrentGroupCommand.h"
 #include "View/Grid.h"
@@ -113,6 +114,7 @@
 #include <kdl/parallel.h>
 #include <kdl/result.h>
 #include <kdl/result_fold.h>
+#include <kdl/set_temp.h>
 #include <kdl/string_format.h>
 #include <kdl/vector_set.h>
 #include <kdl/vector_utils.h>
@@ -206,6 +208,52 @@ std::vector<Model::GroupNode*> collectGroupsOrContainers(
   return kdl::vec_sort_and_remove_duplicates(std::move(result));
 }
 
+Model::GroupNode* findGroupOrContainingGroup(Model::Node* node)
+{
+  if (auto* groupNode = dynamic_cast<Model::GroupNode*>(node))
+  {
+    return groupNode;
+  }
+  return Model::findContainingGroup(node);
+}
+
+/**
+ * Records the addition of the given nodes in the innermost groups containing their
+ * parents. Must be called after the nodes were added.
+ */
+void addPendingAdditions(const std::map<Model::Node*, std::vector<Model::Node*>>& nodes)
+{
+  for (const auto& [parent, children] : nodes)
+  {
+    if (auto* groupNode = findGroupOrContainingGroup(parent))
+    {
+      groupNode->addPendingChanges(
+        kdl::vec_transform(children, [parent = parent](auto* child) {
+          return Model::PendingChange{Model::NodeAddition{parent, child}};
+        }));
+    }
+  }
+}
+
+/**
+ * Records the removal of the given nodes in the innermost groups containing their
+ * parents.
+ */
+void addPendingRemovals(const std::map<Model::Node*, std::vector<Model::Node*>>& nodes)
+{
+  for (const auto& [parent, children] : nodes)
+  {
+    if (auto* groupNode = findGroupOrContainingGroup(parent))
+    {
+      groupNode->addPendingChanges(
+        kdl::vec_transform(children, [parent = parent](auto* child) {
+          return Model::PendingChange{
+            Model::NodeRemoval{parent, child, Model::getLinkId(*child)}};
+        }));
+    }
+  }
+}
+
 /**
  * Applies the given lambda to a copy of the contents of each of the given nodes and
  * returns a vector of pairs of the original node and the modified contents.
@@ -369,6 +417,13 @@ bool applyAndSwap(
 }
 } // namespace
 
+struct MapDocument::PendingChangesSnapshot
+{
+  std::vector<
+    std::pair<Model::GroupNode*, std::optional<std::vector<Model::PendingChange>>>>
+    groupNodes;
+};
+
 const vm::bbox3 MapDocument::DefaultWorldBounds(-32768.0, 32768.0);
 const std::string MapDocument::DefaultDocumentName("unnamed.map");
 
@@ -381,6 +436,8 @@ MapDocument::MapDocument()
   , m_textureManager(std::make_unique<Assets::TextureManager>(
       pref(Preferences::TextureMagFilter), pref(Preferences::TextureMinFilter), logger()))
   , m_tagManager(std::make_unique<Model::TagManager>())
+  , m_loadAssetsInBackground(false)
+  , m_bindingLoadedAssets(false)
   , m_editorContext(std::make_unique<Model::EditorContext>())
   , m_grid(std::make_unique<Grid>(4))
   , m_path(DefaultDocumentName)
@@ -1560,7 +1617,7 @@ std::vector<Model::Node*> MapDocument::addNodes(
     return {};
   }
 
-  setHasPendingChanges(collectGroupsOrContainers(kdl::map_keys(nodes)), true);
+  addPendingAdditions(nodes);
 
   const auto addedNodes = kdl::vec_flatten(kdl::map_values(nodes));
   ensureVisible(addedNodes);
@@ -1586,7 +1643,7 @@ void MapDocument::removeNodes(const std::vector<Model::Node*>& nodes)
   auto transaction = Transaction{*this};
   while (!removableNodes.empty())
   {
-    setHasPendingChanges(collectGroupsOrContainers(kdl::map_keys(removableNodes)), true);
+    addPendingRemovals(removableNodes);
 
     closeRemovedGroups(removableNodes);
     executeAndStore(AddRemoveNodesCommand::remove(removableNodes));
@@ -1711,13 +1768,13 @@ bool MapDocument::reparentNodes(
     return false;
   }
 
-  setHasPendingChanges(changedLinkedGroups, true);
+  addPendingRemovals(nodesToRemove);
+  addPendingAdditions(nodesToAdd);
 
   auto removableNodes = collectRemovableParents(nodesToRemove);
   while (!removableNodes.empty())
   {
-    setHasPendingChanges(
-      collectContainingGroups(kdl::vec_flatten(kdl::map_values(removableNodes))), true);
+    addPendingRemovals(removableNodes);
 
     closeRemovedGroups(removableNodes);
     executeAndStore(AddRemoveNodesCommand::remove(removableNodes));
@@ -2329,6 +2386,40 @@ void MapDocument::setHasPendingChanges(
   }
 }
 
+void MapDocument::setHasPendingChanges(
+  const std::vector<Model::GroupNode*>& groupNodes,
+  const std::vector<Model::Node*>& changedNodes)
+{
+  // attribute every changed node to the innermost of the given groups containing it
+  auto changedNodesByGroup =
+    std::unordered_map<Model::GroupNode*, std::vector<Model::Node*>>{};
+  for (auto* groupNode : groupNodes)
+  {
+    changedNodesByGroup[groupNode] = {};
+  }
+
+  for (auto* changedNode : changedNodes)
+  {
+    for (auto* ancestor = changedNode->parent(); ancestor; ancestor = ancestor->parent())
+    {
+      auto* groupNode = dynamic_cast<Model::GroupNode*>(ancestor);
+      if (const auto it = changedNodesByGroup.find(groupNode);
+          it != changedNodesByGroup.end())
+      {
+        it->second.push_back(changedNode);
+        break;
+      }
+    }
+  }
+
+  for (auto& [groupNode, nodes] : changedNodesByGroup)
+  {
+    groupNode->addPendingChanges(kdl::vec_transform(nodes, [](auto* node) {
+      return Model::PendingChange{Model::NodeContentsChange{node}};
+    }));
+  }
+}
+
 static std::vector<Model::GroupNode*> collectGroupsWithPendingChanges(Model::Node& node)
 {
   auto result = std::vector<Model::GroupNode*>{};
@@ -2364,9 +2455,10 @@ bool MapDocument::updateLinkedGroups()
     if (const auto allChangedLinkedGroups = collectGroupsWithPendingChanges(*m_world);
         !allChangedLinkedGroups.empty())
     {
+      // the command records the changed nodes of the groups, so create it first
+      auto command = std::make_unique<UpdateLinkedGroupsCommand>(allChangedLinkedGroups);
       setHasPendingChanges(allChangedLinkedGroups, false);
 
-      auto command = std::make_unique<UpdateLinkedGroupsCommand>(allChangedLinkedGroups);
       const auto result = executeAndStore(std::move(command));
       return result->success();
     }
@@ -2813,6 +2905,9 @@ bool MapDocument::swapNodeContents(
     return false;
   }
 
+  const auto changedNodes =
+    kdl::vec_transform(nodesToSwap, [](const auto& p) { return p.first; });
+
   auto transaction = Transaction{*this};
   const auto result = executeAndStore(
     std::make_unique<SwapNodeContentsCommand>(commandName, std::move(nodesToSwap)));
@@ -2823,7 +2918,7 @@ bool MapDocument::swapNodeContents(
     return false;
   }
 
-  setHasPendingChanges(changedLinkedGroups, true);
+  setHasPendingChanges(changedLinkedGroups, changedNodes);
   return transaction.commit();
 }
 
@@ -3794,8 +3889,9 @@ MapDocument::MoveVerticesResult MapDocument::moveVertices(
       kdl::str_plural(vertexPositions.size(), "Move Brush Vertex", "Move Brush Vertices");
     auto transaction = Transaction{*this, commandName};
 
-    const auto changedLinkedGroups = collectContainingGroups(
-      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+    const auto changedNodes =
+      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; });
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = executeAndStore(std::make_unique<BrushVertexCommand>(
       commandName,
@@ -3809,7 +3905,7 @@ MapDocument::MoveVerticesResult MapDocument::moveVertices(
       return MoveVerticesResult{false, false};
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    setHasPendingChanges(changedLinkedGroups, changedNodes);
 
     if (!transaction.commit())
     {
@@ -3873,8 +3969,9 @@ bool MapDocument::moveEdges(
       kdl::str_plural(edgePositions.size(), "Move Brush Edge", "Move Brush Edges");
     auto transaction = Transaction{*this, commandName};
 
-    const auto changedLinkedGroups = collectContainingGroups(
-      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+    const auto changedNodes =
+      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; });
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = executeAndStore(std::make_unique<BrushEdgeCommand>(
       commandName,
@@ -3888,7 +3985,7 @@ bool MapDocument::moveEdges(
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    setHasPendingChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -3939,8 +4036,9 @@ bool MapDocument::moveFaces(
       kdl::str_plural(facePositions.size(), "Move Brush Face", "Move Brush Faces");
     auto transaction = Transaction{*this, commandName};
 
-    auto changedLinkedGroups = collectContainingGroups(
-      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+    const auto changedNodes =
+      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; });
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = executeAndStore(std::make_unique<BrushFaceCommand>(
       commandName,
@@ -3954,7 +4052,7 @@ bool MapDocument::moveFaces(
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    setHasPendingChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -3986,8 +4084,9 @@ bool MapDocument::addVertex(const vm::vec3& vertexPosition)
     const auto commandName = "Add Brush Vertex";
     auto transaction = Transaction{*this, commandName};
 
-    const auto changedLinkedGroups = collectContainingGroups(
-      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+    const auto changedNodes =
+      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; });
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = executeAndStore(std::make_unique<BrushVertexCommand>(
       commandName,
@@ -4001,7 +4100,7 @@ bool MapDocument::addVertex(const vm::vec3& vertexPosition)
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    setHasPendingChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -4041,8 +4140,9 @@ bool MapDocument::removeVertices(
   {
     auto transaction = Transaction{*this, commandName};
 
-    auto changedLinkedGroups = collectContainingGroups(
-      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+    const auto changedNodes =
+      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; });
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = executeAndStore(std::make_unique<BrushVertexCommand>(
       commandName,
@@ -4056,7 +4156,7 @@ bool MapDocument::removeVertices(
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    setHasPendingChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -4178,6 +4278,8 @@ void MapDocument::startTransaction(std::string name, const TransactionScope scop
   debug("Starting transaction '" + name + "'");
   doStartTransaction(std::move(name), scope);
   m_repeatStack->startTransaction();
+  m_nodeChangeCoalescer.beginScope(scope == TransactionScope::Oneshot);
+  savePendingChanges();
 }
 
 void MapDocument::rollbackTransaction()
@@ -4185,6 +4287,7 @@ void MapDocument::rollbackTransaction()
   debug("Rolling back transaction");
   doRollbackTransaction();
   m_repeatStack->rollbackTransaction();
+  restorePendingChanges();
 }
 
 bool MapDocument::commitTransaction()
@@ -4194,11 +4297,14 @@ bool MapDocument::commitTransaction()
   if (!updateLinkedGroups())
   {
     rollbackTransaction();
+    m_nodeChangeCoalescer.endScope();
     return false;
   }
 
+  m_nodeChangeCoalescer.endScope();
   doCommitTransaction();
   m_repeatStack->commitTransaction();
+  m_pendingChangesSnapshots.pop_back();
   return true;
 }
 
@@ -4207,8 +4313,47 @@ void MapDocument::cancelTransaction()
   debug("Cancelling transaction");
   doRollbackTransaction();
   m_repeatStack->rollbackTransaction();
+  restorePendingChanges();
+  m_nodeChangeCoalescer.endScope();
   doCommitTransaction();
   m_repeatStack->commitTransaction();
+  m_pendingChangesSnapshots.pop_back();
+}
+
+void MapDocument::savePendingChanges()
+{
+  auto snapshot = PendingChangesSnapshot{};
+  if (m_world)
+  {
+    for (auto* groupNode : Model::collectGroups({m_world.get()}))
+    {
+      if (groupNode->hasPendingChanges())
+      {
+        snapshot.groupNodes.emplace_back(groupNode, groupNode->pendingChanges());
+      }
+    }
+  }
+  m_pendingChangesSnapshots.push_back(std::move(snapshot));
+}
+
+void MapDocument::restorePendingChanges()
+{
+  assert(!m_pendingChangesSnapshots.empty());
+
+  if (m_world)
+  {
+    for (auto* groupNode : Model::collectGroups({m_world.get()}))
+    {
+      groupNode->setHasPendingChanges(false);
+    }
+  }
+
+  // the rollback has restored every group that existed when the transaction started
+  for (const auto& [groupNode, pendingChanges] :
+       m_pendingChangesSnapshots.back().groupNodes)
+  {
+    groupNode->setPendingChanges(pendingChanges);
+  }
 }
 
 std::unique_ptr<CommandResult> MapDocument::execute(std::unique_ptr<Command>&& command)
@@ -4325,9 +4470,11 @@ void MapDocument::setEntityDefinitions(
 
 void MapDocument::reloadTextureCollections()
 {
+  finishLoadingAssets();
+
   const auto nodes = std::vector<Model::Node*>{m_world.get()};
   NotifyBeforeAndAfter notifyNodes(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+    nodesWillChangeImmediatelyNotifier, nodesDidChangeImmediatelyNotifier, nodes);
   NotifyBeforeAndAfter notifyTextureCollections(
     textureCollectionsWillChangeNotifier, textureCollectionsDidChangeNotifier);
 
@@ -4339,17 +4486,68 @@ void MapDocument::reloadTextureCollections()
 
 void MapDocument::reloadEntityDefinitions()
 {
+  finishLoadingAssets();
+
   const auto nodes = std::vector<Model::Node*>{m_world.get()};
   NotifyBeforeAndAfter notifyNodes(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+    nodesWillChangeImmediatelyNotifier, nodesDidChangeImmediatelyNotifier, nodes);
   NotifyBeforeAndAfter notifyEntityDefinitions(
     entityDefinitionsWillChangeNotifier, entityDefinitionsDidChangeNotifier);
 
   info("Reloading entity definitions");
 }
 
+namespace
+{
+/**
+ * The maximum number of entity models to load per call to processLoadedAssets.
+ */
+constexpr auto EntityModelBatchSize = size_t(8);
+} // namespace
+
+void MapDocument::setLoadAssetsInBackground(const bool loadAssetsInBackground)
+{
+  m_loadAssetsInBackground = loadAssetsInBackground;
+}
+
+bool MapDocument::isLoadingAssets() const
+{
+  return m_backgroundAssetLoader != nullptr || !m_pendingEntityModels.empty();
+}
+
+void MapDocument::processLoadedAssets()
+{
+  if (m_backgroundAssetLoader)
+  {
+    bindLoadedAssets(false);
+  }
+  else if (!m_pendingEntityModels.empty())
+  {
+    loadEntityModelBatch(EntityModelBatchSize);
+  }
+}
+
+void MapDocument::finishLoadingAssets()
+{
+  if (m_backgroundAssetLoader)
+  {
+    bindLoadedAssets(true);
+  }
+  if (!m_pendingEntityModels.empty())
+  {
+    m_pendingEntityModels.clear();
+    bindEntityModels();
+  }
+}
+
 void MapDocument::loadAssets()
 {
+  if (m_loadAssetsInBackground)
+  {
+    startLoadingAssets();
+    return;
+  }
+
   loadEntityDefinitions();
   setEntityDefinitions();
   loadEntityModels();
@@ -4359,11 +4557,141 @@ void MapDocument::loadAssets()
 
 void MapDocument::unloadAssets()
 {
+  // discard assets which are still loading, but wait for the workers to finish since
+  // they use the game
+  m_backgroundAssetLoader.reset();
+  m_pendingEntityModels.clear();
+
   unloadEntityDefinitions();
   unloadEntityModels();
   unloadTextures();
 }
 
+void MapDocument::startLoadingAssets()
+{
+  // the game file system must not change while the worker reads from it, and entity
+  // models are not loaded until the worker is done since they are read from it as well
+  reloadWads();
+  m_entityModelManager->setLoader(nullptr);
+
+  const auto path =
+    m_game->findEntityDefinitionFile(entityDefinitionFile(), externalSearchPaths());
+  m_backgroundAssetLoader = std::make_unique<BackgroundAssetLoader>(m_game, path);
+  info("Loading assets in the background");
+}
+
+void MapDocument::bindLoadedAssets(const bool wait)
+{
+  assert(m_backgroundAssetLoader);
+
+  // the notifications below would otherwise make this document reload its assets
+  const auto bindingLoadedAssets = kdl::set_temp{m_bindingLoadedAssets};
+  auto& loader = *m_backgroundAssetLoader;
+
+  if (auto definitions = loader.takeEntityDefinitions(wait))
+  {
+    loader.flushLog(logger());
+
+    const auto nodes = std::vector<Model::Node*>{m_world.get()};
+    NotifyBeforeAndAfter notifyNodes(
+      nodesWillChangeImmediatelyNotifier, nodesDidChangeImmediatelyNotifier, nodes);
+    NotifyBeforeAndAfter notifyEntityDefinitions(
+      entityDefinitionsWillChangeNotifier, entityDefinitionsDidChangeNotifier);
+
+    const auto spec = entityDefinitionFile();
+    const auto path = m_game->findEntityDefinitionFile(spec, externalSearchPaths());
+    std::move(*definitions)
+      .transform([&](auto entityDefinitions) {
+        m_entityDefinitionManager->setDefinitions(std::move(entityDefinitions));
+        info("Loaded entity definition file " + path.filename().string());
+        createEntityDefinitionActions();
+      })
+      .transform_error([&](auto e) {
+        error() << "Could not load " << (spec.builtin() ? "builtin" : "external")
+                << " entity definition file '" << spec.path() << "': " << e.msg;
+      });
+    setEntityDefinitions();
+  }
+
+  if (auto textureCollections = loader.takeTextureCollections(wait))
+  {
+    loader.flushLog(logger());
+
+    const auto nodes = std::vector<Model::Node*>{m_world.get()};
+    NotifyBeforeAndAfter notifyNodes(
+      nodesWillChangeImmediatelyNotifier, nodesDidChangeImmediatelyNotifier, nodes);
+    NotifyBeforeAndAfter notifyTextureCollections(
+      textureCollectionsWillChangeNotifier, textureCollectionsDidChangeNotifier);
+
+    m_textureManager->setTextureCollections(std::move(*textureCollections));
+    setTextures();
+  }
+
+  loader.flushLog(logger());
+  if (loader.done())
+  {
+    m_backgroundAssetLoader.reset();
+
+    // the game file system is no longer in use, so entity models can be loaded in batches
+    m_entityModelManager->setLoader(m_game.get());
+    queueEntityModels();
+    if (m_pendingEntityModels.empty())
+    {
+      bindEntityModels();
+    }
+  }
+}
+
+void MapDocument::queueEntityModels()
+{
+  auto modelSpecs = std::vector<Assets::ModelSpecification>{};
+
+  m_world->accept(kdl::overload(
+    [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
+    [](auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [](auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
+    [&](Model::EntityNode* entityNode) {
+      auto modelSpec = Assets::safeGetModelSpecification(
+        logger(), entityNode->entity().classname(), [&]() {
+          return entityNode->entity().modelSpecification();
+        });
+      if (!m_entityModelManager->isModelLoaded(modelSpec.path))
+      {
+        modelSpecs.push_back(std::move(modelSpec));
+      }
+    },
+    [](Model::BrushNode*) {},
+    [](Model::PatchNode*) {}));
+
+  m_pendingEntityModels = kdl::vec_sort_and_remove_duplicates(std::move(modelSpecs));
+}
+
+void MapDocument::loadEntityModelBatch(const size_t maxModelCount)
+{
+  for (size_t i = 0; i < maxModelCount && !m_pendingEntityModels.empty(); ++i)
+  {
+    // loads the model and the requested frame
+    m_entityModelManager->frame(m_pendingEntityModels.back());
+    m_pendingEntityModels.pop_back();
+  }
+
+  if (m_pendingEntityModels.empty())
+  {
+    bindEntityModels();
+  }
+}
+
+void MapDocument::bindEntityModels()
+{
+  const auto nodes = std::vector<Model::Node*>{m_world.get()};
+  NotifyBeforeAndAfter notifyNodes(
+    nodesWillChangeImmediatelyNotifier, nodesDidChangeImmediatelyNotifier, nodes);
+
+  // the models were loaded already, except for those left over by finishLoadingAssets
+  setEntityModels();
+  info("Finished loading assets");
+}
+
 void MapDocument::loadEntityDefinitions()
 {
   const auto spec = entityDefinitionFile();
@@ -4410,23 +4738,29 @@ void MapDocument::unloadEntityModels()
 
 void MapDocument::reloadTextures()
 {
+  finishLoadingAssets();
   unloadTextures();
   m_game->reloadShaders().transform_error(
     [&](auto e) { error() << "Failed to reload shaders: " << e.msg; });
   loadTextures();
 }
 
+void MapDocument::reloadWads()
+{
+  if (const auto* wadStr = m_world->entity().property(Model::EntityPropertyKeys::Wad))
+  {
+    const auto wadPaths = kdl::vec_transform(
+      kdl::str_split(*wadStr, ";"),
+      [](const auto& str) { return std::filesystem::path{str}; });
+    m_game->reloadWads(path(), wadPaths, logger());
+  }
+}
+
 void MapDocument::loadTextures()
 {
   try
   {
-    if (const auto* wadStr = m_world->entity().property(Model::EntityPropertyKeys::Wad))
-    {
-      const auto wadPaths = kdl::vec_transform(
-        kdl::str_split(*wadStr, ";"),
-        [](const auto& str) { return std::filesystem::path{str}; });
-      m_game->reloadWads(path(), wadPaths, logger());
-    }
+    reloadWads();
     m_game->loadTextureCollections(*m_textureManager);
   }
   catch (const Exception& e)
@@ -4577,6 +4911,7 @@ void MapDocument::unsetEntityDefinitions(const std::vector<Model::Node*>& nodes)
 
 void MapDocument::reloadEntityDefinitionsInternal()
 {
+  finishLoadingAssets();
   unloadEntityDefinitions();
   clearEntityModels();
   loadEntityDefinitions();
@@ -4856,11 +5191,42 @@ static auto makeClearNodeTagsVisitor()
     [](Model::PatchNode* patch) { patch->clearTags(); });
 }
 
+static void initializeTagsInParallel(
+  const std::vector<Model::Node*>& nodes, Model::TagManager& tagManager)
+{
+  // the nodes are tagged independently of each other, and the tag matchers are safe to
+  // use from multiple threads
+  kdl::parallel_for(
+    nodes.size(), [&](const size_t i) { nodes[i]->initializeTags(tagManager); });
+}
+
 void MapDocument::initializeAllNodeTags(MapDocument* document)
 {
   assert(document == this);
   unused(document);
-  m_world->accept(makeInitializeNodeTagsVisitor(*m_tagManager));
+
+  auto nodes = std::vector<Model::Node*>{};
+  m_world->accept(kdl::overload(
+    [&](auto&& thisLambda, Model::WorldNode* world) {
+      nodes.push_back(world);
+      world->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, Model::LayerNode* layer) {
+      nodes.push_back(layer);
+      layer->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, Model::GroupNode* group) {
+      nodes.push_back(group);
+      group->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, Model::EntityNode* entity) {
+      nodes.push_back(entity);
+      entity->visitChildren(thisLambda);
+    },
+    [&](Model::BrushNode* brush) { nodes.push_back(brush); },
+    [&](Model::PatchNode* patch) { nodes.push_back(patch); }));
+
+  initializeTagsInParallel(nodes, *m_tagManager);
 }
 
 void MapDocument::initializeNodeTags(const std::vector<Model::Node*>& nodes)
@@ -4892,6 +5258,7 @@ void MapDocument::updateFaceTags(const std::vector<Model::BrushFaceHandle>& face
 
 void MapDocument::updateAllFaceTags()
 {
+  auto nodes = std::vector<Model::Node*>{};
   m_world->accept(kdl::overload(
     [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
     [](auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
@@ -4899,8 +5266,10 @@ void MapDocument::updateAllFaceTags()
     [](auto&& thisLambda, Model::EntityNode* entity) {
       entity->visitChildren(thisLambda);
     },
-    [&](Model::BrushNode* brush) { brush->initializeTags(*m_tagManager); },
+    [&](Model::BrushNode* brush) { nodes.push_back(brush); },
     [](Model::PatchNode*) {}));
+
+  initializeTagsInParallel(nodes, *m_tagManager);
 }
 
 bool MapDocument::persistent() const
@@ -4951,6 +5320,11 @@ void MapDocument::clearModificationCount()
 
 void MapDocument::connectObservers()
 {
+  m_notifierConnection += nodesWillChangeImmediatelyNotifier.connect(
+    &m_nodeChangeCoalescer, &NotificationCoalescer<Model::Node*>::notifyBefore);
+  m_notifierConnection += nodesDidChangeImmediatelyNotifier.connect(
+    &m_nodeChangeCoalescer, &NotificationCoalescer<Model::Node*>::notifyAfter);
+
   m_notifierConnection += textureCollectionsWillChangeNotifier.connect(
     this, &MapDocument::textureCollectionsWillChange);
   m_notifierConnection += textureCollectionsDidChangeNotifier.connect(
@@ -4989,7 +5363,7 @@ void MapDocument::connectObservers()
   m_notifierConnection +=
     nodesWillBeRemovedNotifier.connect(this, &MapDocument::clearNodeTags);
   m_notifierConnection +=
-    nodesDidChangeNotifier.connect(this, &MapDocument::updateNodeTags);
+    nodesDidChangeImmediatelyNotifier.connect(this, &MapDocument::updateNodeTags);
   m_notifierConnection +=
     brushFacesDidChangeNotifier.connect(this, &MapDocument::updateFaceTags);
   m_notifierConnection +=
@@ -5000,30 +5374,45 @@ void MapDocument::connectObservers()
 
 void MapDocument::textureCollectionsWillChange()
 {
-  unsetTextures();
+  if (!m_bindingLoadedAssets)
+  {
+    finishLoadingAssets();
+    unsetTextures();
+  }
 }
 
 void MapDocument::textureCollectionsDidChange()
 {
-  loadTextures();
-  setTextures();
+  if (!m_bindingLoadedAssets)
+  {
+    loadTextures();
+    setTextures();
+  }
 }
 
 void MapDocument::entityDefinitionsWillChange()
 {
-  unloadEntityDefinitions();
-  clearEntityModels();
+  if (!m_bindingLoadedAssets)
+  {
+    finishLoadingAssets();
+    unloadEntityDefinitions();
+    clearEntityModels();
+  }
 }
 
 void MapDocument::entityDefinitionsDidChange()
 {
-  loadEntityDefinitions();
-  setEntityDefinitions();
-  setEntityModels();
+  if (!m_bindingLoadedAssets)
+  {
+    loadEntityDefinitions();
+    setEntityDefinitions();
+    setEntityModels();
+  }
 }
 
 void MapDocument::modsWillChange()
 {
+  finishLoadingAssets();
   unsetEntityModels();
   unsetEntityDefinitions();
   clearEntityModels();
@@ -5040,6 +5429,8 @@ void MapDocument::preferenceDidChange(const std::filesystem::path& path)
 {
   if (isGamePathPreference(path))
   {
+    finishLoadingAssets();
+
     const Model::GameFactory& gameFactory = Model::GameFactory::instance();
     const std::filesystem::path newGamePath = gameFactory.gamePath(m_game->gameName());
     m_game->setGamePath(newGamePath, logger());
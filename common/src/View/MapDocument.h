@@ -54,6 +54,7 @@ class EntityDefinition;
 class EntityDefinitionFileSpec;
 class EntityDefinitionManager;
 class EntityModelManager;
+struct ModelSpecification;
 class Texture;
 class TextureManager;
 } // namespace TrenchBroom::Assets
@@ -82,6 +83,7 @@ enum class WrapStyle;
 namespace TrenchBroom::View
 {
 class Action;
+class BackgroundAssetLoader;
 class Command;
 class CommandResult;
 class Grid;
@@ -124,6 +126,11 @@ protected:
   std::unique_ptr<Assets::TextureManager> m_textureManager;
   std::unique_ptr<Model::TagManager> m_tagManager;
 
+  bool m_loadAssetsInBackground;
+  std::unique_ptr<BackgroundAssetLoader> m_backgroundAssetLoader;
+  bool m_bindingLoadedAssets;
+  std::vector<Assets::ModelSpecification> m_pendingEntityModels;
+
   std::unique_ptr<Model::EditorContext> m_editorContext;
   std::unique_ptr<Grid> m_grid;
 
@@ -155,6 +162,14 @@ protected:
    */
   std::unique_ptr<RepeatStack> m_repeatStack;
 
+  /*
+   * The pending changes of the linked groups at the start of every running transaction.
+   * They are restored when a transaction is rolled back, because the recorded changes
+   * refer to nodes which the rollback may have deleted or restored.
+   */
+  struct PendingChangesSnapshot;
+  std::vector<PendingChangesSnapshot> m_pendingChangesSnapshots;
+
 public: // notification
   Notifier<Command&> commandDoNotifier;
   Notifier<Command&> commandDoneNotifier;
@@ -182,8 +197,17 @@ public: // notification
   Notifier<const std::vector<Model::Node*>&> nodesWereAddedNotifier;
   Notifier<const std::vector<Model::Node*>&> nodesWillBeRemovedNotifier;
   Notifier<const std::vector<Model::Node*>&> nodesWereRemovedNotifier;
+
+  /*
+   * Within a transaction that cannot be observed by the user, these notifications are
+   * coalesced: Observers are notified once of every changed node before it first
+   * changes, and once of all changed nodes when the transaction is committed. Observers
+   * which must track every individual change must use the immediate notifiers below.
+   */
   Notifier<const std::vector<Model::Node*>&> nodesWillChangeNotifier;
   Notifier<const std::vector<Model::Node*>&> nodesDidChangeNotifier;
+  Notifier<const std::vector<Model::Node*>&> nodesWillChangeImmediatelyNotifier;
+  Notifier<const std::vector<Model::Node*>&> nodesDidChangeImmediatelyNotifier;
 
   Notifier<const std::vector<Model::Node*>&> nodeVisibilityDidChangeNotifier;
   Notifier<const std::vector<Model::Node*>&> nodeLockingDidChangeNotifier;
@@ -210,6 +234,10 @@ public: // notification
   Notifier<> portalFileWasLoadedNotifier;
   Notifier<> portalFileWasUnloadedNotifier;
 
+protected:
+  NotificationCoalescer<Model::Node*> m_nodeChangeCoalescer{
+    nodesWillChangeNotifier, nodesDidChangeNotifier};
+
 private:
   NotifierConnection m_notifierConnection;
 
@@ -500,9 +528,15 @@ public:
 protected:
   void setHasPendingChanges(
     const std::vector<Model::GroupNode*>& groupNodes, bool hasPendingChanges);
+  void setHasPendingChanges(
+    const std::vector<Model::GroupNode*>& groupNodes,
+    const std::vector<Model::Node*>& changedNodes);
   bool updateLinkedGroups();
 
 private:
+  void savePendingChanges();
+  void restorePendingChanges();
+
   void separateSelectedLinkedGroups(bool relinkGroups);
 
 public: // layer management
@@ -708,10 +742,37 @@ public: // asset management
   void reloadTextureCollections();
   void reloadEntityDefinitions();
 
+  /**
+   * Controls whether creating or loading a document loads its entity definitions, entity
+   * models and textures in the background. If enabled, the document can be used as soon
+   * as its world is loaded, and the owner of the document must call processLoadedAssets
+   * periodically while isLoadingAssets returns true. Disabled by default.
+   */
+  void setLoadAssetsInBackground(bool loadAssetsInBackground);
+  bool isLoadingAssets() const;
+
+  /**
+   * Binds the entity definitions and texture collections that have finished loading in
+   * the background. Once the entity definitions are bound, each call loads a batch of
+   * entity models.
+   */
+  void processLoadedAssets();
+
+  /**
+   * Waits until all assets have been loaded and binds them.
+   */
+  void finishLoadingAssets();
+
 private:
   void loadAssets();
   void unloadAssets();
 
+  void startLoadingAssets();
+  void bindLoadedAssets(bool wait);
+  void queueEntityModels();
+  void loadEntityModelBatch(size_t maxModelCount);
+  void bindEntityModels();
+
   void loadEntityDefinitions();
   void unloadEntityDefinitions();
 
@@ -720,6 +781,7 @@ private:
 
 protected:
   void reloadTextures();
+  void reloadWads();
   void loadTextures();
   void unloadTextures();
 
@@ -269,14 +269,16 @@ void MapDocumentCommandFacade::performAddNodes(
 {
   const auto parents = collectNodesAndAncestors(kdl::map_keys(nodes));
   NotifyBeforeAndAfter notifyParents(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+    nodesWillChangeImmediatelyNotifier, nodesDidChangeImmediatelyNotifier, parents);
 
   std::vector<Model::Node*> addedNodes;
-  for (const auto& [parent, children] : nodes)
-  {
-    parent->addChildren(children);
-    addedNodes = kdl::vec_concat(std::move(addedNodes), children);
-  }
+  m_world->batchNodeTreeUpdates([&]() {
+    for (const auto& [parent, children] : nodes)
+    {
+      parent->addChildren(children);
+      addedNodes = kdl::vec_concat(std::move(addedNodes), children);
+    }
+  });
 
   setEntityDefinitions(addedNodes);
   setEntityModels(addedNodes);
@@ -289,21 +291,26 @@ void MapDocumentCommandFacade::performAddNodes(
 void MapDocumentCommandFacade::performRemoveNodes(
   const std::map<Model::Node*, std::vector<Model::Node*>>& nodes)
 {
+  // nodes which are about to be removed must not be reported as changed later
+  m_nodeChangeCoalescer.flush();
+
   const auto parents = collectNodesAndAncestors(kdl::map_keys(nodes));
   NotifyBeforeAndAfter notifyParents(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+    nodesWillChangeImmediatelyNotifier, nodesDidChangeImmediatelyNotifier, parents);
 
   const auto allChildren = kdl::vec_flatten(kdl::map_values(nodes));
   NotifyBeforeAndAfter notifyChildren(
     nodesWillBeRemovedNotifier, nodesWereRemovedNotifier, allChildren);
 
-  for (const auto& [parent, children] : nodes)
-  {
-    unsetEntityModels(children);
-    unsetEntityDefinitions(children);
-    unsetTextures(children);
-    parent->removeChildren(std::begin(children), std::end(children));
-  }
+  m_world->batchNodeTreeUpdates([&]() {
+    for (const auto& [parent, children] : nodes)
+    {
+      unsetEntityModels(children);
+      unsetEntityDefinitions(children);
+      unsetTextures(children);
+      parent->removeChildren(std::begin(children), std::end(children));
+    }
+  });
 
   invalidateSelectionBounds();
 }
@@ -329,9 +336,12 @@ MapDocumentCommandFacade::performReplaceChildren(
     return {};
   }
 
+  // nodes which are about to be removed must not be reported as changed later
+  m_nodeChangeCoalescer.flush();
+
   const auto parents = collectNodesAndAncestors(kdl::map_keys(nodes));
   NotifyBeforeAndAfter notifyParents(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+    nodesWillChangeImmediatelyNotifier, nodesDidChangeImmediatelyNotifier, parents);
 
   const std::vector<Model::Node*> allOldChildren = collectOldChildren(nodes);
   NotifyBeforeAndAfter notifyChildren(
@@ -341,16 +351,18 @@ MapDocumentCommandFacade::performReplaceChildren(
     std::vector<std::pair<Model::Node*, std::vector<std::unique_ptr<Model::Node>>>>{};
   auto allNewChildren = std::vector<Model::Node*>{};
 
-  for (auto& [parent, newChildren] : nodes)
-  {
-    allNewChildren = kdl::vec_concat(
-      std::move(allNewChildren),
-      kdl::vec_transform(newChildren, [](auto& child) { return child.get(); }));
+  m_world->batchNodeTreeUpdates([&]() {
+    for (auto& [parent, newChildren] : nodes)
+    {
+      allNewChildren = kdl::vec_concat(
+        std::move(allNewChildren),
+        kdl::vec_transform(newChildren, [](auto& child) { return child.get(); }));
 
-    auto oldChildren = parent->replaceChildren(std::move(newChildren));
+      auto oldChildren = parent->replaceChildren(std::move(newChildren));
 
-    result.emplace_back(parent, std::move(oldChildren));
-  }
+      result.emplace_back(parent, std::move(oldChildren));
+    }
+  });
 
   unsetEntityModels(allOldChildren);
   unsetEntityDefinitions(allOldChildren);
@@ -410,12 +422,11 @@ void MapDocumentCommandFacade::performSwapNodeContents(
   const auto parents = collectAncestors(nodes);
   const auto descendants = collectDescendants(nodes);
 
+  // notify observers once of every affected node
+  const auto changedNodes =
+    kdl::vec_sort_and_remove_duplicates(kdl::vec_concat(nodes, parents, descendants));
   NotifyBeforeAndAfter notifyNodes(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
-  NotifyBeforeAndAfter notifyParents(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-  NotifyBeforeAndAfter notifyDescendants(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, descendants);
+    nodesWillChangeImmediatelyNotifier, nodesDidChangeImmediatelyNotifier, changedNodes);
 
   const auto [notifyWadsChange, notifyEntityDefinitionsChange, notifyModsChange] =
     notifySpecialWorldProperties(*game(), nodesToSwap);
@@ -430,37 +441,39 @@ void MapDocumentCommandFacade::performSwapNodeContents(
   NotifyBeforeAndAfter notifyMods(
     notifyModsChange, modsWillChangeNotifier, modsDidChangeNotifier);
 
-  for (auto& pair : nodesToSwap)
-  {
-    auto* node = pair.first;
-    auto& contents = pair.second.get();
-
-    pair.second = node->accept(kdl::overload(
-      [&](Model::WorldNode* worldNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          worldNode->setEntity(std::get<Model::Entity>(std::move(contents))));
-      },
-      [&](Model::LayerNode* layerNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          layerNode->setLayer(std::get<Model::Layer>(std::move(contents))));
-      },
-      [&](Model::GroupNode* groupNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          groupNode->setGroup(std::get<Model::Group>(std::move(contents))));
-      },
-      [&](Model::EntityNode* entityNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          entityNode->setEntity(std::get<Model::Entity>(std::move(contents))));
-      },
-      [&](Model::BrushNode* brushNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          brushNode->setBrush(std::get<Model::Brush>(std::move(contents))));
-      },
-      [&](Model::PatchNode* patchNode) -> Model::NodeContents {
-        return Model::NodeContents(
-          patchNode->setPatch(std::get<Model::BezierPatch>(std::move(contents))));
-      }));
-  }
+  m_world->batchNodeTreeUpdates([&]() {
+    for (auto& pair : nodesToSwap)
+    {
+      auto* node = pair.first;
+      auto& contents = pair.second.get();
+
+      pair.second = node->accept(kdl::overload(
+        [&](Model::WorldNode* worldNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            worldNode->setEntity(std::get<Model::Entity>(std::move(contents))));
+        },
+        [&](Model::LayerNode* layerNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            layerNode->setLayer(std::get<Model::Layer>(std::move(contents))));
+        },
+        [&](Model::GroupNode* groupNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            groupNode->setGroup(std::get<Model::Group>(std::move(contents))));
+        },
+        [&](Model::EntityNode* entityNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            entityNode->setEntity(std::get<Model::Entity>(std::move(contents))));
+        },
+        [&](Model::BrushNode* brushNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            brushNode->setBrush(std::get<Model::Brush>(std::move(contents))));
+        },
+        [&](Model::PatchNode* patchNode) -> Model::NodeContents {
+          return Model::NodeContents(
+            patchNode->setPatch(std::get<Model::BezierPatch>(std::move(contents))));
+        }));
+    }
+  });
 
   if (!notifyEntityDefinitionsChange && !notifyModsChange)
   {
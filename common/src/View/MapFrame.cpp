@@ -118,6 +118,7 @@ MapFrame::MapFrame(FrameManager* frameManager, std::shared_ptr<MapDocument> docu
   , m_lastInputTime(std::chrono::system_clock::now())
   , m_autosaver(std::make_unique<Autosaver>(m_document))
   , m_autosaveTimer(nullptr)
+  , m_assetLoadingTimer(nullptr)
   , m_toolBar(nullptr)
   , m_hSplitter(nullptr)
   , m_vSplitter(nullptr)
@@ -161,6 +162,10 @@ MapFrame::MapFrame(FrameManager* frameManager, std::shared_ptr<MapDocument> docu
   m_autosaveTimer = new QTimer(this);
   m_autosaveTimer->start(1000);
 
+  // keep the map responsive while its assets are loading
+  m_document->setLoadAssetsInBackground(true);
+  m_assetLoadingTimer = new QTimer(this);
+
   connectObservers();
   bindEvents();
 
@@ -765,7 +770,12 @@ static QString describeSelection(const MapDocument* document)
 
 void MapFrame::updateStatusBar()
 {
-  m_statusBarLabel->setText(QString(describeSelection(m_document.get())));
+  auto text = QString(describeSelection(m_document.get()));
+  if (m_document->isLoadingAssets())
+  {
+    text += tr("   |   Loading assets...");
+  }
+  m_statusBarLabel->setText(text);
 }
 
 void MapFrame::updateStatusBarDelayed()
@@ -840,6 +850,12 @@ void MapFrame::documentDidChange(View::MapDocument*)
   updateActionState();
   updateUndoRedoActions();
   updateRecentDocumentsMenu();
+
+  if (m_document->isLoadingAssets())
+  {
+    m_assetLoadingTimer->start(50);
+    updateStatusBar();
+  }
 }
 
 void MapFrame::documentModificationStateDidChange()
@@ -947,6 +963,8 @@ void MapFrame::portalFileDidChange()
 void MapFrame::bindEvents()
 {
   connect(m_autosaveTimer, &QTimer::timeout, this, &MapFrame::triggerAutosave);
+  connect(
+    m_assetLoadingTimer, &QTimer::timeout, this, &MapFrame::processLoadedAssets);
   connect(qApp, &QApplication::focusChanged, this, &MapFrame::focusChange);
   connect(
     m_gridChoice,
@@ -2543,6 +2561,16 @@ void MapFrame::triggerAutosave()
   }
 }
 
+void MapFrame::processLoadedAssets()
+{
+  m_document->processLoadedAssets();
+  if (!m_document->isLoadingAssets())
+  {
+    m_assetLoadingTimer->stop();
+  }
+  updateStatusBar();
+}
+
 // DebugPaletteWindow
 
 DebugPaletteWindow::DebugPaletteWindow(QWidget* parent)
@@ -89,6 +89,7 @@ private:
   std::chrono::time_point<std::chrono::system_clock> m_lastInputTime;
   std::unique_ptr<Autosaver> m_autosaver;
   QTimer* m_autosaveTimer;
+  QTimer* m_assetLoadingTimer;
 
   QToolBar* m_toolBar;
 
@@ -423,6 +424,7 @@ public: // event filter (suppress autosave for user input events)
 
 private:
   void triggerAutosave();
+  void processLoadedAssets();
 };
 
 class DebugPaletteWindow : public QDialog
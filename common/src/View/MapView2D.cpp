@@ -409,7 +409,8 @@ Renderer::Camera& MapView2D::doGetCamera()
 void MapView2D::doRenderGrid(Renderer::RenderContext&, Renderer::RenderBatch& renderBatch)
 {
   auto document = kdl::mem_lock(m_document);
-  renderBatch.addOneShot(new Renderer::GridRenderer(*m_camera, document->worldBounds()));
+  renderBatch.addTransient(
+    new Renderer::GridRenderer(*m_camera, document->worldBounds()));
 }
 
 void MapView2D::doRenderMap(
@@ -577,7 +577,7 @@ void MapView3D::doRenderMap(
       new Renderer::BoundsGuideRenderer(m_document);
     guideRenderer->setColor(pref(Preferences::SelectionBoundsColor));
     guideRenderer->setBounds(bounds);
-    renderBatch.addOneShot(guideRenderer);
+    renderBatch.addTransient(guideRenderer);
   }
 }
 
@@ -20,6 +20,7 @@
 
 #include "ObjExportDialog.h"
 
+#include <QCheckBox>
 #include <QDialogButtonBox>
 #include <QFileDialog>
 #include <QLabel>
@@ -52,6 +53,7 @@ ObjExportDialog::ObjExportDialog(MapFrame* mapFrame)
   , m_browseExportPathButton{nullptr}
   , m_relativeToGamePathRadioButton{nullptr}
   , m_relativeToExportPathRadioButton{nullptr}
+  , m_streamingCheckBox{nullptr}
   , m_exportButton{nullptr}
   , m_closeButton{nullptr}
 {
@@ -109,6 +111,15 @@ void ObjExportDialog::createGui()
 
   formLayout->addRow(texturePathLayout);
 
+  formLayout->addSection(
+    tr("Output"),
+    tr("Writing objects while they are exported uses less memory for large maps."));
+
+  m_streamingCheckBox = new QCheckBox{};
+  m_streamingCheckBox->setText(tr("Write objects while exporting"));
+
+  formLayout->addRow(m_streamingCheckBox);
+
   auto* innerLayout = new QVBoxLayout{};
   innerLayout->setContentsMargins(0, 0, 0, 0);
   innerLayout->setSpacing(0);
@@ -151,6 +162,7 @@ void ObjExportDialog::createGui()
     options.mtlPathMode = m_relativeToGamePathRadioButton->isChecked()
                             ? IO::ObjMtlPathMode::RelativeToGamePath
                             : IO::ObjMtlPathMode::RelativeToExportPath;
+    options.streaming = m_streamingCheckBox->isChecked();
     m_mapFrame->exportDocument(options);
     close();
   });
@@ -22,6 +22,7 @@
 
 #include <QDialog>
 
+class QCheckBox;
 class QLineEdit;
 class QPushButton;
 class QRadioButton;
@@ -42,6 +43,7 @@ private:
   QPushButton* m_browseExportPathButton;
   QRadioButton* m_relativeToGamePathRadioButton;
   QRadioButton* m_relativeToExportPathRadioButton;
+  QCheckBox* m_streamingCheckBox;
   QPushButton* m_exportButton;
   QPushButton* m_closeButton;
 
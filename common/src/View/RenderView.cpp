@@ -21,6 +21,7 @@
 
 #include "PreferenceManager.h"
 #include "Preferences.h"
+#include "Renderer/BrushRendererArrays.h"
 #include "Renderer/GLVertexType.h"
 #include "Renderer/PrimType.h"
 #include "Renderer/Transformation.h"
@@ -113,7 +114,12 @@ RenderView::RenderView(GLContextManager& contextManager, QWidget* parent)
       + " Max time between frames: " + std::to_string(maxFrameTime) + "ms. "
       + std::to_string(m_glContext->vboManager().currentVboCount()) + " current VBOs ("
       + std::to_string(m_glContext->vboManager().peakVboCount()) + " peak) totalling "
-      + std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB";
+      + std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB ("
+      + std::to_string(Renderer::vboHolderMemorySize() / 1024u) + " KiB in CPU memory), "
+      + std::to_string(m_glContext->vboManager().lastFrameCreatedBufferCount())
+      + " buffers created and "
+      + std::to_string(m_glContext->vboManager().lastFrameStreamedSize() / 1024u)
+      + " KiB streamed last frame";
   });
 
   fpsCounter->start(1000);
@@ -190,6 +196,9 @@ void RenderView::paintGL()
   if (TrenchBroom::View::isReportingCrash())
     return;
 
+  // Qt may have changed the bindings since the last frame
+  glResetStateCache();
+  m_glContext->vboManager().beginFrame();
   render();
 
   // Update stats
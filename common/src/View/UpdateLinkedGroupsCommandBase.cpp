@@ -84,19 +84,26 @@ bool UpdateLinkedGroupsCommandBase::collateWith(UndoableCommand& command)
 {
   assert(&command != this);
 
+  auto* updateLinkedGroupsCommandBase =
+    dynamic_cast<UpdateLinkedGroupsCommandBase*>(&command);
   if (
-    auto* updateLinkedGroupsCommand = dynamic_cast<UpdateLinkedGroupsCommand*>(&command))
+    updateLinkedGroupsCommandBase
+    && !m_updateLinkedGroupsHelper.canCollateWith(
+      updateLinkedGroupsCommandBase->m_updateLinkedGroupsHelper))
+  {
+    return false;
+  }
+
+  if (dynamic_cast<UpdateLinkedGroupsCommand*>(&command))
   {
     m_updateLinkedGroupsHelper.collateWith(
-      updateLinkedGroupsCommand->m_updateLinkedGroupsHelper);
+      updateLinkedGroupsCommandBase->m_updateLinkedGroupsHelper);
     return true;
   }
 
   if (UndoableCommand::collateWith(command))
   {
-    if (
-      auto* updateLinkedGroupsCommandBase =
-        dynamic_cast<UpdateLinkedGroupsCommandBase*>(&command))
+    if (updateLinkedGroupsCommandBase)
     {
       m_updateLinkedGroupsHelper.collateWith(
         updateLinkedGroupsCommandBase->m_updateLinkedGroupsHelper);
@@ -27,15 +27,19 @@
 #include "Model/WorldNode.h"
 #include "View/MapDocumentCommandFacade.h"
 
+#include <kdl/map_utils.h>
 #include <kdl/overload.h>
 #include <kdl/result.h>
 #include <kdl/result_fold.h>
 #include <kdl/vector_utils.h>
+#include <kdl/zip_iterator.h>
 
 #include <algorithm>
 #include <cassert>
 #include <map>
+#include <optional>
 #include <unordered_set>
+#include <utility>
 
 namespace TrenchBroom::View
 {
@@ -64,10 +68,20 @@ bool checkLinkedGroupsToUpdate(const std::vector<Model::GroupNode*>& changedLink
 UpdateLinkedGroupsHelper::UpdateLinkedGroupsHelper(
   ChangedLinkedGroups changedLinkedGroups)
   : m_state{kdl::vec_sort(std::move(changedLinkedGroups), compareByAncestry)}
+  , m_pendingChanges{kdl::vec_transform(
+      std::get<ChangedLinkedGroups>(m_state), [](const auto* groupNode) {
+        return Model::collectPendingChanges(*groupNode);
+      })}
 {
 }
 
-UpdateLinkedGroupsHelper::~UpdateLinkedGroupsHelper() = default;
+UpdateLinkedGroupsHelper::~UpdateLinkedGroupsHelper()
+{
+  if (auto* linkedNodeUpdates = std::get_if<LinkedNodeUpdates>(&m_state))
+  {
+    kdl::map_clear_and_delete(linkedNodeUpdates->nodesToAdd);
+  }
+}
 
 Result<void> UpdateLinkedGroupsHelper::applyLinkedGroupUpdates(
   MapDocumentCommandFacade& document)
@@ -81,38 +95,78 @@ void UpdateLinkedGroupsHelper::undoLinkedGroupUpdates(MapDocumentCommandFacade&
   doApplyOrUndoLinkedGroupUpdates(document);
 }
 
+bool UpdateLinkedGroupsHelper::canCollateWith(const UpdateLinkedGroupsHelper& other) const
+{
+  // added and removed nodes cannot be collated because the other helper might add or
+  // remove the same nodes
+  const auto hasAddedOrRemovedNodes = [](const auto& helper) {
+    const auto* linkedNodeUpdates = std::get_if<LinkedNodeUpdates>(&helper.m_state);
+    return linkedNodeUpdates
+           && (!linkedNodeUpdates->nodesToAdd.empty()
+               || !linkedNodeUpdates->nodesToRemove.empty());
+  };
+
+  return !hasUpdates() || !other.hasUpdates()
+         || (m_state.index() == other.m_state.index() && !hasAddedOrRemovedNodes(*this)
+             && !hasAddedOrRemovedNodes(other));
+}
+
 void UpdateLinkedGroupsHelper::collateWith(UpdateLinkedGroupsHelper& other)
 {
+  assert(canCollateWith(other));
+
+  if (!other.hasUpdates())
+  {
+    return;
+  }
+
+  if (!hasUpdates())
+  {
+    m_state = std::exchange(other.m_state, ChangedLinkedGroups{});
+    return;
+  }
+
   // Both helpers have already applied their changes at this point, so in both helpers,
-  // m_linkedGroups contains pairs p where
-  // - p.first is the group node to update
-  // - p.second is a vector containing the group node's original children
+  // m_state contains pairs p where
+  // - p.first is the node to update
+  // - p.second is the node's original children or contents
   //
-  // Let p_o be an update from the other helper. If p_o is an update for a linked group
-  // node that was updated by this helper, then there is a pair p_t in this helper such
-  // that p_t.first == p_o.first. In this case, we want to keep the old children of the
-  // linked group node stored in this helper and discard those in the other helper. If p_o
-  // is not an update for a linked group node that was updated by this helper, then we
-  // will add p_o to our updates and remove it from the other helper's updates to prevent
-  // the replaced node to be deleted with the other helper.
-
-  auto& myLinkedGroupUpdates = std::get<LinkedGroupUpdates>(m_state);
-  auto& theirLinkedGroupUpdates = std::get<LinkedGroupUpdates>(other.m_state);
-
-  for (auto& [theirGroupNodeToUpdate, theirOldChildren] : theirLinkedGroupUpdates)
-  {
-    const auto myIt = std::find_if(
-      std::begin(myLinkedGroupUpdates),
-      std::end(myLinkedGroupUpdates),
-      [theirGroupNodeToUpdate = theirGroupNodeToUpdate](const auto& p) {
-        return p.first == theirGroupNodeToUpdate;
-      });
-    if (myIt == std::end(myLinkedGroupUpdates))
+  // Let p_o be an update from the other helper. If p_o is an update for a node that was
+  // updated by this helper, then there is a pair p_t in this helper such that
+  // p_t.first == p_o.first. In this case, we want to keep the original children or
+  // contents of the node stored in this helper and discard those in the other helper. If
+  // p_o is not an update for a node that was updated by this helper, then we will add p_o
+  // to our updates and remove it from the other helper's updates to prevent the replaced
+  // node to be deleted with the other helper.
+
+  const auto collate = [](auto& myUpdates, auto& theirUpdates) {
+    for (auto& [theirNodeToUpdate, theirOldState] : theirUpdates)
     {
-      myLinkedGroupUpdates.emplace_back(
-        theirGroupNodeToUpdate, std::move(theirOldChildren));
+      const auto myIt = std::find_if(
+        std::begin(myUpdates),
+        std::end(myUpdates),
+        [theirNodeToUpdate = theirNodeToUpdate](const auto& p) {
+          return p.first == theirNodeToUpdate;
+        });
+      if (myIt == std::end(myUpdates))
+      {
+        myUpdates.emplace_back(theirNodeToUpdate, std::move(theirOldState));
+      }
     }
-  }
+  };
+
+  std::visit(
+    kdl::overload(
+      [](ChangedLinkedGroups&) {},
+      [&](LinkedGroupUpdates& myLinkedGroupUpdates) {
+        collate(myLinkedGroupUpdates, std::get<LinkedGroupUpdates>(other.m_state));
+      },
+      [&](LinkedNodeUpdates& myLinkedNodeUpdates) {
+        collate(
+          myLinkedNodeUpdates.nodesToUpdate,
+          std::get<LinkedNodeUpdates>(other.m_state).nodesToUpdate);
+      }),
+    m_state);
 }
 
 Result<void> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(
@@ -121,50 +175,162 @@ Result<void> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(
   return std::visit(
     kdl::overload(
       [&](const ChangedLinkedGroups& changedLinkedGroups) {
-        return computeLinkedGroupUpdates(changedLinkedGroups, document)
+        return computeLinkedGroupUpdates(changedLinkedGroups, m_pendingChanges, document)
           .transform([&](auto&& linkedGroupUpdates) {
             m_state = std::forward<decltype(linkedGroupUpdates)>(linkedGroupUpdates);
           });
       },
-      [](const LinkedGroupUpdates&) -> Result<void> { return kdl::void_success; }),
+      [](const LinkedGroupUpdates&) -> Result<void> { return kdl::void_success; },
+      [](const LinkedNodeUpdates&) -> Result<void> { return kdl::void_success; }),
     m_state);
 }
 
-Result<UpdateLinkedGroupsHelper::LinkedGroupUpdates> UpdateLinkedGroupsHelper::
+namespace
+{
+
+/**
+ * Replays the recorded changes of each changed linked group. Returns nothing if the
+ * changes of any group cannot be propagated this way.
+ */
+Result<std::optional<Model::UpdateLinkedNodesResult>> computeLinkedNodeUpdates(
+  const std::vector<Model::GroupNode*>& changedLinkedGroups,
+  const std::vector<std::optional<std::vector<Model::PendingChange>>>& pendingChanges,
+  MapDocumentCommandFacade& document)
+{
+  if (std::any_of(
+        std::begin(pendingChanges), std::end(pendingChanges), [](const auto& changes) {
+          return !changes.has_value();
+        }))
+  {
+    return std::nullopt;
+  }
+
+  const auto& worldBounds = document.worldBounds();
+  return kdl::fold_results(
+           kdl::vec_transform(
+             kdl::make_zip_range(changedLinkedGroups, pendingChanges),
+             [&](const auto& groupAndPendingChanges) {
+               const auto& [groupNode, changes] = groupAndPendingChanges;
+               const auto groupNodesToUpdate = kdl::vec_erase(
+                 Model::collectGroupsWithLinkId(
+                   {document.world()}, groupNode->group().linkId()),
+                 groupNode);
+
+               return Model::updateLinkedNodes(
+                 *groupNode, *changes, groupNodesToUpdate, worldBounds);
+             }))
+    .transform(
+      [](auto nestedUpdateLists) -> std::optional<Model::UpdateLinkedNodesResult> {
+        auto result = Model::mergeLinkedNodeUpdates(std::move(nestedUpdateLists));
+        if (!result)
+        {
+          return std::nullopt;
+        }
+
+        // the updates of different link sets must not affect the same nodes
+        const auto removedNodes = kdl::vec_transform(
+          result->nodesToRemove, [](const auto& p) { return p.second; });
+        const auto updatedNodes = kdl::vec_transform(
+          result->nodesToUpdate, [](const auto& p) { return p.first; });
+        const auto affectedNodes =
+          kdl::vec_sort(kdl::vec_concat(removedNodes, updatedNodes));
+        if (
+          std::adjacent_find(std::begin(affectedNodes), std::end(affectedNodes))
+          != std::end(affectedNodes))
+        {
+          return std::nullopt;
+        }
+
+        return result;
+      });
+}
+
+} // namespace
+
+Result<UpdateLinkedGroupsHelper::State> UpdateLinkedGroupsHelper::
   computeLinkedGroupUpdates(
-    const ChangedLinkedGroups& changedLinkedGroups, MapDocumentCommandFacade& document)
+    const ChangedLinkedGroups& changedLinkedGroups,
+    const std::vector<PendingChanges>& pendingChanges,
+    MapDocumentCommandFacade& document)
 {
   if (!checkLinkedGroupsToUpdate(changedLinkedGroups))
   {
     return Error{"Cannot update multiple members of the same link set"};
   }
 
-  const auto& worldBounds = document.worldBounds();
-  return kdl::fold_results(kdl::vec_transform(
-                             changedLinkedGroups,
-                             [&](const auto* groupNode) {
-                               const auto groupNodesToUpdate = kdl::vec_erase(
-                                 Model::collectGroupsWithLinkId(
-                                   {document.world()}, groupNode->group().linkId()),
-                                 groupNode);
-
-                               return Model::updateLinkedGroups(
-                                 *groupNode, groupNodesToUpdate, worldBounds);
-                             }))
-    .and_then([&](auto nestedUpdateLists) -> Result<LinkedGroupUpdates> {
-      return kdl::vec_flatten(std::move(nestedUpdateLists));
+  return computeLinkedNodeUpdates(changedLinkedGroups, pendingChanges, document)
+    .and_then([&](auto linkedNodeUpdates) -> Result<State> {
+      if (linkedNodeUpdates)
+      {
+        auto state = LinkedNodeUpdates{};
+        for (auto& [parent, node] : linkedNodeUpdates->nodesToRemove)
+        {
+          state.nodesToRemove[parent].push_back(node);
+        }
+        for (auto& [parent, node] : linkedNodeUpdates->nodesToAdd)
+        {
+          state.nodesToAdd[parent].push_back(node.release());
+        }
+        state.nodesToUpdate = std::move(linkedNodeUpdates->nodesToUpdate);
+        return State{std::move(state)};
+      }
+
+      const auto& worldBounds = document.worldBounds();
+      return kdl::fold_results(kdl::vec_transform(
+                                 changedLinkedGroups,
+                                 [&](const auto* groupNode) {
+                                   const auto groupNodesToUpdate = kdl::vec_erase(
+                                     Model::collectGroupsWithLinkId(
+                                       {document.world()}, groupNode->group().linkId()),
+                                     groupNode);
+
+                                   return Model::updateLinkedGroups(
+                                     *groupNode, groupNodesToUpdate, worldBounds);
+                                 }))
+        .and_then([&](auto nestedUpdateLists) -> Result<State> {
+          return State{kdl::vec_flatten(std::move(nestedUpdateLists))};
+        });
     });
 }
 
+bool UpdateLinkedGroupsHelper::hasUpdates() const
+{
+  return std::visit(
+    kdl::overload(
+      [](const ChangedLinkedGroups&) { return false; },
+      [](const LinkedGroupUpdates& updates) { return !updates.empty(); },
+      [](const LinkedNodeUpdates& updates) {
+        return !updates.nodesToAdd.empty() || !updates.nodesToRemove.empty()
+               || !updates.nodesToUpdate.empty();
+      }),
+    m_state);
+}
+
 void UpdateLinkedGroupsHelper::doApplyOrUndoLinkedGroupUpdates(
   MapDocumentCommandFacade& document)
 {
   std::visit(
     kdl::overload(
-      [](const ChangedLinkedGroups&) {},
-      [&](LinkedGroupUpdates&& linkedGroupUpdates) {
+      [](ChangedLinkedGroups&) {},
+      [&](LinkedGroupUpdates& linkedGroupUpdates) {
         m_state = document.performReplaceChildren(std::move(linkedGroupUpdates));
+      },
+      [&](LinkedNodeUpdates& linkedNodeUpdates) {
+        // removing before adding and swapping the nodes to add and remove afterwards
+        // makes this symmetric, so doing it again undoes the update
+        if (!linkedNodeUpdates.nodesToRemove.empty())
+        {
+          document.performRemoveNodes(linkedNodeUpdates.nodesToRemove);
+        }
+        if (!linkedNodeUpdates.nodesToAdd.empty())
+        {
+          document.performAddNodes(linkedNodeUpdates.nodesToAdd);
+        }
+        document.performSwapNodeContents(linkedNodeUpdates.nodesToUpdate);
+
+        using std::swap;
+        swap(linkedNodeUpdates.nodesToAdd, linkedNodeUpdates.nodesToRemove);
       }),
-    std::move(m_state));
+    m_state);
 }
 } // namespace TrenchBroom::View
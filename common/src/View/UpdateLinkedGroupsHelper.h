@@ -19,19 +19,17 @@
 
 #pragma once
 
+#include "Model/GroupNode.h"
+#include "Model/NodeContents.h"
 #include "Result.h"
 
+#include <map>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <variant>
 #include <vector>
 
-namespace TrenchBroom::Model
-{
-class GroupNode;
-class Node;
-} // namespace TrenchBroom::Model
-
 namespace TrenchBroom::View
 {
 class MapDocumentCommandFacade;
@@ -49,10 +47,18 @@ bool checkLinkedGroupsToUpdate(const std::vector<Model::GroupNode*>& changedLink
  *
  * The class is initialized with a vector of group nodes whose changes should be
  * propagated to the members of their respective link sets. When applyLinkedGroupUpdates
- * is first called, a replacement node is created for each linked group that needs to be
- * updated, and these linked groups are replaced with their replacements. Calling
- * applyLinkedGroupUpdates replaces the replacement nodes with their original
- * corresponding groups again, effectively undoing the change.
+ * is first called, the linked groups that need to be updated are updated in one of two
+ * ways:
+ *
+ * - If all changes to the changed groups were recorded and they can be replayed in all
+ *   linked groups, then only the nodes corresponding to the changed nodes are updated by
+ *   swapping their contents, and the nodes corresponding to added and removed nodes are
+ *   added and removed.
+ * - Otherwise, a replacement node is created for each linked group that needs to be
+ *   updated, and these linked groups are replaced with their replacements.
+ *
+ * Calling undoLinkedGroupUpdates swaps the original contents or children back and
+ * reverts the added and removed nodes, effectively undoing the change.
  */
 class UpdateLinkedGroupsHelper
 {
@@ -60,7 +66,27 @@ private:
   using ChangedLinkedGroups = std::vector<Model::GroupNode*>;
   using LinkedGroupUpdates =
     std::vector<std::pair<Model::Node*, std::vector<std::unique_ptr<Model::Node>>>>;
-  std::variant<ChangedLinkedGroups, LinkedGroupUpdates> m_state;
+
+  struct LinkedNodeUpdates
+  {
+    /**
+     * The nodes to add, which are owned by this helper.
+     */
+    std::map<Model::Node*, std::vector<Model::Node*>> nodesToAdd;
+    std::map<Model::Node*, std::vector<Model::Node*>> nodesToRemove;
+    std::vector<std::pair<Model::Node*, Model::NodeContents>> nodesToUpdate;
+  };
+
+  using State = std::variant<ChangedLinkedGroups, LinkedGroupUpdates, LinkedNodeUpdates>;
+  using PendingChanges = std::optional<std::vector<Model::PendingChange>>;
+
+  State m_state;
+
+  /**
+   * For each changed linked group, the pending changes at the time this helper was
+   * created, or std::nullopt if they were not recorded.
+   */
+  std::vector<PendingChanges> m_pendingChanges;
 
 public:
   explicit UpdateLinkedGroupsHelper(ChangedLinkedGroups changedLinkedGroups);
@@ -68,12 +94,18 @@ public:
 
   Result<void> applyLinkedGroupUpdates(MapDocumentCommandFacade& document);
   void undoLinkedGroupUpdates(MapDocumentCommandFacade& document);
+
+  bool canCollateWith(const UpdateLinkedGroupsHelper& other) const;
   void collateWith(UpdateLinkedGroupsHelper& other);
 
 private:
   Result<void> computeLinkedGroupUpdates(MapDocumentCommandFacade& document);
-  static Result<LinkedGroupUpdates> computeLinkedGroupUpdates(
-    const ChangedLinkedGroups& changedLinkedGroups, MapDocumentCommandFacade& document);
+  static Result<State> computeLinkedGroupUpdates(
+    const ChangedLinkedGroups& changedLinkedGroups,
+    const std::vector<PendingChanges>& pendingChanges,
+    MapDocumentCommandFacade& document);
+
+  bool hasUpdates() const;
 
   void doApplyOrUndoLinkedGroupUpdates(MapDocumentCommandFacade& document);
 };
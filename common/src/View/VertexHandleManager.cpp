@@ -25,16 +25,68 @@
 #include "Preferences.h"
 #include "View/Grid.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/distance.h>
 #include <vecmath/intersection.h>
 #include <vecmath/plane.h>
 #include <vecmath/ray.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace TrenchBroom
 {
 namespace View
 {
+namespace
+{
+bool intersectsRay(const vm::ray3& pickRay, const vm::bbox3& bounds)
+{
+  // Test against the bounding sphere of the box. This is conservative, but unlike
+  // intersecting the box itself, it is robust against rounding errors when the box is
+  // flat or when the ray hits it exactly on an edge.
+  const auto radius = vm::length(bounds.size()) / FloatType(2) + FloatType(0.001);
+  return vm::squared_distance(pickRay, bounds.center()).distance <= radius * radius;
+}
+} // namespace
+
+std::function<bool(const vm::bbox3&)> makePickPointHandlePredicate(
+  const vm::ray3& pickRay, const Renderer::Camera& camera, const FloatType handleRadius)
+{
+  return [pickRay, &camera, handleRadius](const vm::bbox3& bounds) {
+    const auto center = bounds.center();
+    const auto extent = vm::length(bounds.size()) / FloatType(2);
+    const auto offset = extent * vm::vec3{camera.direction()};
+
+    const auto scaling = std::max(
+      std::abs(camera.perspectiveScalingFactor(vm::vec3f{center - offset})),
+      std::abs(camera.perspectiveScalingFactor(vm::vec3f{center + offset})));
+
+    // allow for rounding errors since the scaling factor is computed with floats
+    const auto maxDistance =
+      (FloatType(2) * handleRadius * static_cast<FloatType>(scaling) + extent)
+      * FloatType(1.01);
+    return vm::squared_distance(pickRay, center).distance <= maxDistance * maxDistance;
+  };
+}
+
+vm::bbox3 handleBounds(const vm::vec3& handle)
+{
+  return vm::bbox3{handle, handle};
+}
+
+vm::bbox3 handleBounds(const vm::segment3& handle)
+{
+  return vm::bbox3{
+    vm::min(handle.start(), handle.end()), vm::max(handle.start(), handle.end())};
+}
+
+vm::bbox3 handleBounds(const vm::polygon3& handle)
+{
+  return vm::bbox3::merge_all(std::begin(handle), std::end(handle));
+}
+
 VertexHandleManagerBase::~VertexHandleManagerBase() {}
 
 const Model::HitType::Type VertexHandleManager::HandleHitType =
@@ -45,17 +97,19 @@ void VertexHandleManager::pick(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    const auto distance = camera.pickPointHandle(
-      pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-    if (!vm::is_nan(distance))
-    {
-      const auto hitPoint = vm::point_at_distance(pickRay, distance);
-      const auto error = vm::squared_distance(pickRay, position).distance;
-      pickResult.addHit(Model::Hit(HandleHitType, distance, hitPoint, position, error));
-    }
-  }
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandleIf(
+    makePickPointHandlePredicate(pickRay, camera, handleRadius),
+    [&](const vm::vec3& position, const HandleInfo&) {
+      const auto distance = camera.pickPointHandle(pickRay, position, handleRadius);
+      if (!vm::is_nan(distance))
+      {
+        const auto hitPoint = vm::point_at_distance(pickRay, distance);
+        const auto error = vm::squared_distance(pickRay, position).distance;
+        pickResult.addHit(
+          Model::Hit(HandleHitType, distance, hitPoint, position, error));
+      }
+    });
 }
 
 void VertexHandleManager::addHandles(const Model::BrushNode* brushNode)
@@ -96,24 +150,27 @@ void EdgeHandleManager::pickGridHandle(
   const Grid& grid,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    const FloatType edgeDist = camera.pickLineSegmentHandle(
-      pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-    if (!vm::is_nan(edgeDist))
-    {
-      const vm::vec3 pointHandle =
-        grid.snap(vm::point_at_distance(pickRay, edgeDist), position);
-      const FloatType pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-      if (!vm::is_nan(pointDist))
+  // both the closest point of an edge and its snapped point lie on the edge
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandleIf(
+    makePickPointHandlePredicate(pickRay, camera, handleRadius),
+    [&](const vm::segment3& position, const HandleInfo&) {
+      const FloatType edgeDist =
+        camera.pickLineSegmentHandle(pickRay, position, handleRadius);
+      if (!vm::is_nan(edgeDist))
       {
-        const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
-        pickResult.addHit(
-          Model::Hit(HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
+        const vm::vec3 pointHandle =
+          grid.snap(vm::point_at_distance(pickRay, edgeDist), position);
+        const FloatType pointDist =
+          camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+        if (!vm::is_nan(pointDist))
+        {
+          const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
+          pickResult.addHit(Model::Hit(
+            HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
+        }
       }
-    }
-  }
+    });
 }
 
 void EdgeHandleManager::pickCenterHandle(
@@ -121,18 +178,20 @@ void EdgeHandleManager::pickCenterHandle(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    const vm::vec3 pointHandle = position.center();
-
-    const FloatType pointDist = camera.pickPointHandle(
-      pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-    if (!vm::is_nan(pointDist))
-    {
-      const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
-      pickResult.addHit(Model::Hit(HandleHitType, pointDist, hitPoint, position));
-    }
-  }
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandleIf(
+    makePickPointHandlePredicate(pickRay, camera, handleRadius),
+    [&](const vm::segment3& position, const HandleInfo&) {
+      const vm::vec3 pointHandle = position.center();
+
+      const FloatType pointDist =
+        camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+      if (!vm::is_nan(pointDist))
+      {
+        const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
+        pickResult.addHit(Model::Hit(HandleHitType, pointDist, hitPoint, position));
+      }
+    });
 }
 
 void EdgeHandleManager::addHandles(const Model::BrushNode* brushNode)
@@ -174,30 +233,34 @@ void FaceHandleManager::pickGridHandle(
   const Grid& grid,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    const auto [valid, plane] = vm::from_points(std::begin(position), std::end(position));
-    if (!valid)
-    {
-      continue;
-    }
-
-    const auto distance =
-      vm::intersect_ray_polygon(pickRay, plane, std::begin(position), std::end(position));
-    if (!vm::is_nan(distance))
-    {
-      const auto pointHandle = grid.snap(vm::point_at_distance(pickRay, distance), plane);
-
-      const auto pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-      if (!vm::is_nan(pointDist))
+  // the snapped point may lie outside of the face, but the ray must hit the face
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandleIf(
+    [&](const vm::bbox3& bounds) { return intersectsRay(pickRay, bounds); },
+    [&](const vm::polygon3& position, const HandleInfo&) {
+      const auto [valid, plane] =
+        vm::from_points(std::begin(position), std::end(position));
+      if (!valid)
       {
-        const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
-        pickResult.addHit(
-          Model::Hit(HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
+        return;
       }
-    }
-  }
+
+      const auto distance = vm::intersect_ray_polygon(
+        pickRay, plane, std::begin(position), std::end(position));
+      if (!vm::is_nan(distance))
+      {
+        const auto pointHandle =
+          grid.snap(vm::point_at_distance(pickRay, distance), plane);
+
+        const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+        if (!vm::is_nan(pointDist))
+        {
+          const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
+          pickResult.addHit(Model::Hit(
+            HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
+        }
+      }
+    });
 }
 
 void FaceHandleManager::pickCenterHandle(
@@ -205,18 +268,19 @@ void FaceHandleManager::pickCenterHandle(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    const auto pointHandle = position.center();
-
-    const auto pointDist = camera.pickPointHandle(
-      pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
-    if (!vm::is_nan(pointDist))
-    {
-      const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
-      pickResult.addHit(Model::Hit(HandleHitType, pointDist, hitPoint, position));
-    }
-  }
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandleIf(
+    makePickPointHandlePredicate(pickRay, camera, handleRadius),
+    [&](const vm::polygon3& position, const HandleInfo&) {
+      const auto pointHandle = position.center();
+
+      const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+      if (!vm::is_nan(pointDist))
+      {
+        const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
+        pickResult.addHit(Model::Hit(HandleHitType, pointDist, hitPoint, position));
+      }
+    });
 }
 
 void FaceHandleManager::addHandles(const Model::BrushNode* brushNode)
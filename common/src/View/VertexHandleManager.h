@@ -25,11 +25,15 @@
 #include "Model/HitType.h"
 #include "Model/PickResult.h"
 #include "Renderer/Camera.h"
+#include "aabb_tree.h"
 
 #include <kdl/vector_set.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/polygon.h>
 #include <vecmath/segment.h>
 
+#include <functional>
 #include <iterator>
 #include <map>
 #include <vector>
@@ -45,6 +49,26 @@ namespace View
 {
 class Grid;
 
+/**
+ * Returns the bounds of the given handle.
+ */
+vm::bbox3 handleBounds(const vm::vec3& handle);
+vm::bbox3 handleBounds(const vm::segment3& handle);
+vm::bbox3 handleBounds(const vm::polygon3& handle);
+
+/**
+ * Returns a predicate that determines whether a box may contain a point that would be hit
+ * by Camera::pickPointHandle for the given ray.
+ *
+ * The pick radius of a point handle depends on the perspective scaling factor at its
+ * position, which is affine in the position, so its maximum within the bounding sphere of
+ * a box is attained at one of the two points of the sphere along the view direction.
+ *
+ * The returned predicate refers to the given camera, which must outlive it.
+ */
+std::function<bool(const vm::bbox3&)> makePickPointHandlePredicate(
+  const vm::ray3& pickRay, const Renderer::Camera& camera, FloatType handleRadius);
+
 class VertexHandleManagerBase
 {
 public:
@@ -178,6 +202,12 @@ protected:
    */
   HandleMap m_handles;
 
+  /**
+   * Spatial index of the entries of m_handles by the bounds of their handles. Since the
+   * entries of a std::map are never moved, they can be referenced by pointer.
+   */
+  aabb_tree<FloatType, HandleEntry*> m_handleTree;
+
   /**
    * The total number of selected handles, not counting duplicates.
    */
@@ -324,8 +354,15 @@ public:
    */
   void add(const Handle& handle)
   {
-    m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo
-                             // means its default constructor is called
+    // unknown value gets value constructed, which for HandleInfo means its default
+    // constructor is called
+    auto [it, inserted] = m_handles.try_emplace(handle);
+    it->second.inc();
+
+    if (inserted)
+    {
+      m_handleTree.insert(handleBounds(handle), &*it);
+    }
   }
 
   /**
@@ -346,6 +383,7 @@ public:
       if (info.count == 0)
       {
         deselect(info);
+        m_handleTree.remove(&*it);
         m_handles.erase(it);
       }
       return true;
@@ -359,6 +397,7 @@ public:
    */
   void clear()
   {
+    m_handleTree.clear();
     m_handles.clear();
     m_selectedHandleCount = 0;
   }
@@ -466,15 +505,41 @@ private:
   void forEachCloseHandle(const H& otherHandle, F fun)
   {
     static const auto epsilon = 0.001 * 0.001;
-    for (auto& [handle, info] : m_handles)
+    const auto bounds = handleBounds(otherHandle).expand(0.001);
+    forEachHandleIf(
+      [&](const vm::bbox3& handleBounds) { return bounds.intersects(handleBounds); },
+      [&](const H& handle, HandleInfo& info) {
+        if (compare(otherHandle, handle, epsilon) == 0)
+        {
+          fun(info);
+        }
+      });
+  }
+
+protected:
+  /**
+   * Calls the given function for every handle whose bounds satisfy the given predicate.
+   *
+   * The predicate is also applied to the bounds of groups of handles, so it must return
+   * true for any box that contains the bounds of a matching handle.
+   *
+   * @tparam P the type of the predicate, a unary function that maps a vm::bbox3 to bool
+   * @tparam F the type of the function to call with each handle and its info
+   * @param predicate the predicate to apply
+   * @param fun the function to call
+   */
+  template <typename P, typename F>
+  void forEachHandleIf(const P& predicate, F fun) const
+  {
+    auto entries = std::vector<HandleEntry*>{};
+    m_handleTree.find_if(predicate, std::back_inserter(entries));
+    for (auto* entry : entries)
     {
-      if (compare(otherHandle, handle, epsilon) == 0)
-      {
-        fun(info);
-      }
+      fun(entry->first, entry->second);
     }
   }
 
+private:
   void select(HandleInfo& info)
   {
     if (info.select())
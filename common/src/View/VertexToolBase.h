@@ -518,10 +518,11 @@ private: // Observers and state management
     auto document = kdl::mem_lock(m_document);
     m_notifierConnection += document->selectionDidChangeNotifier.connect(
       this, &VertexToolBase::selectionDidChange);
-    m_notifierConnection +=
-      document->nodesWillChangeNotifier.connect(this, &VertexToolBase::nodesWillChange);
-    m_notifierConnection +=
-      document->nodesDidChangeNotifier.connect(this, &VertexToolBase::nodesDidChange);
+    // handles must be updated for every individual change
+    m_notifierConnection += document->nodesWillChangeImmediatelyNotifier.connect(
+      this, &VertexToolBase::nodesWillChange);
+    m_notifierConnection += document->nodesDidChangeImmediatelyNotifier.connect(
+      this, &VertexToolBase::nodesDidChange);
     m_notifierConnection +=
       document->commandDoNotifier.connect(this, &VertexToolBase::commandDo);
     m_notifierConnection +=
@@ -161,6 +161,16 @@ QWidget* ViewPreferencePane::createViewPreferences()
   m_enableMsaa = new QCheckBox{};
   m_enableMsaa->setToolTip("Enable multisampling");
 
+  m_occlusionCulling = new QCheckBox{};
+  m_occlusionCulling->setToolTip(
+    "Skip rendering parts of the map that are hidden behind large brush faces in the 3D "
+    "editing view.");
+
+  m_portalFileCulling = new QCheckBox{};
+  m_portalFileCulling->setToolTip(
+    "Skip rendering parts of the map that cannot be seen from the camera's leaf in the "
+    "3D editing view. Requires a loaded portal file.");
+
   m_textureBrowserIconSizeCombo = new QComboBox{};
   m_textureBrowserIconSizeCombo->addItem("25%");
   m_textureBrowserIconSizeCombo->addItem("50%");
@@ -197,6 +207,8 @@ QWidget* ViewPreferencePane::createViewPreferences()
   layout->addRow("Show axes", m_showAxes);
   layout->addRow("Texture mode", m_textureModeCombo);
   layout->addRow("Enable multisampling", m_enableMsaa);
+  layout->addRow("Occlusion culling", m_occlusionCulling);
+  layout->addRow("Portal file culling", m_portalFileCulling);
 
   layout->addSection("Texture Browser");
   layout->addRow("Icon size", m_textureBrowserIconSizeCombo);
@@ -238,6 +250,16 @@ void ViewPreferencePane::bindEvents()
     m_showAxes, &QCheckBox::stateChanged, this, &ViewPreferencePane::showAxesChanged);
   connect(
     m_enableMsaa, &QCheckBox::stateChanged, this, &ViewPreferencePane::enableMsaaChanged);
+  connect(
+    m_occlusionCulling,
+    &QCheckBox::stateChanged,
+    this,
+    &ViewPreferencePane::occlusionCullingChanged);
+  connect(
+    m_portalFileCulling,
+    &QCheckBox::stateChanged,
+    this,
+    &ViewPreferencePane::portalFileCullingChanged);
   connect(
     m_themeCombo,
     QOverload<int>::of(&QComboBox::activated),
@@ -275,6 +297,8 @@ void ViewPreferencePane::doResetToDefaults()
   prefs.resetToDefault(Preferences::CameraFov);
   prefs.resetToDefault(Preferences::ShowAxes);
   prefs.resetToDefault(Preferences::EnableMSAA);
+  prefs.resetToDefault(Preferences::OcclusionCulling);
+  prefs.resetToDefault(Preferences::PortalFileCulling);
   prefs.resetToDefault(Preferences::TextureMinFilter);
   prefs.resetToDefault(Preferences::TextureMagFilter);
   prefs.resetToDefault(Preferences::Theme);
@@ -296,6 +320,8 @@ void ViewPreferencePane::doUpdateControls()
 
   m_showAxes->setChecked(pref(Preferences::ShowAxes));
   m_enableMsaa->setChecked(pref(Preferences::EnableMSAA));
+  m_occlusionCulling->setChecked(pref(Preferences::OcclusionCulling));
+  m_portalFileCulling->setChecked(pref(Preferences::PortalFileCulling));
   m_themeCombo->setCurrentIndex(findThemeIndex(pref(Preferences::Theme)));
 
   const auto textureBrowserIconSize = pref(Preferences::TextureBrowserIconSize);
@@ -409,6 +435,20 @@ void ViewPreferencePane::enableMsaaChanged(const int state)
   prefs.set(Preferences::EnableMSAA, value);
 }
 
+void ViewPreferencePane::occlusionCullingChanged(const int state)
+{
+  const auto value = state == Qt::Checked;
+  auto& prefs = PreferenceManager::instance();
+  prefs.set(Preferences::OcclusionCulling, value);
+}
+
+void ViewPreferencePane::portalFileCullingChanged(const int state)
+{
+  const auto value = state == Qt::Checked;
+  auto& prefs = PreferenceManager::instance();
+  prefs.set(Preferences::PortalFileCulling, value);
+}
+
 void ViewPreferencePane::textureModeChanged(const int value)
 {
   const auto index = static_cast<size_t>(value);
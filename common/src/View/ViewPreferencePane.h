@@ -40,6 +40,8 @@ private:
   QCheckBox* m_showAxes = nullptr;
   QComboBox* m_textureModeCombo = nullptr;
   QCheckBox* m_enableMsaa = nullptr;
+  QCheckBox* m_occlusionCulling = nullptr;
+  QCheckBox* m_portalFileCulling = nullptr;
   QComboBox* m_themeCombo = nullptr;
   QComboBox* m_textureBrowserIconSizeCombo = nullptr;
   QComboBox* m_rendererFontSizeCombo = nullptr;
@@ -68,6 +70,8 @@ private slots:
   void fovChanged(int value);
   void showAxesChanged(int state);
   void enableMsaaChanged(int state);
+  void occlusionCullingChanged(int state);
+  void portalFileCullingChanged(int state);
   void textureModeChanged(int index);
   void themeChanged(int index);
   void textureBrowserIconSizeChanged(int index);
@@ -0,0 +1,583 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Exceptions.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/intersection.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom
+{
+
+/**
+ * A dynamic bounding volume hierarchy that allows for quick ray intersection and
+ * containment queries.
+ *
+ * Every data item is stored in a leaf whose bounds are the exact bounds of the item, so
+ * unlike the octree, the placement of an item does not depend on its size or position
+ * relative to a grid. Inner nodes bound their two children. New leaves are inserted next
+ * to the sibling that minimizes the increase in surface area of the tree, and the tree
+ * is rebalanced with local rotations on the way back up to the root.
+ *
+ * Updating an item whose new bounds remain within the bounds of its parent only refits
+ * the ancestors of its leaf, otherwise the leaf is removed and inserted again.
+ *
+ * The interface matches that of octree so that both can be used interchangeably.
+ *
+ * @tparam T the floating point type
+ * @tparam U the node data to store in the leaves, must be hashable
+ */
+template <typename T, typename U>
+class aabb_tree
+{
+private:
+  using box_type = vm::bbox<T, 3>;
+
+  static constexpr auto null_index = std::numeric_limits<size_t>::max();
+
+  struct node
+  {
+    box_type bounds;
+    size_t parent = null_index;
+    size_t child1 = null_index;
+    size_t child2 = null_index;
+    int height = 0;
+    std::optional<U> data;
+
+    bool is_leaf() const { return child1 == null_index; }
+  };
+
+  std::vector<node> m_nodes;
+  std::vector<size_t> m_free_nodes;
+  size_t m_root = null_index;
+  std::unordered_map<U, size_t> m_leaf_for_data;
+
+public:
+  aabb_tree() = default;
+
+  /**
+   * Indicates whether a node with the given data exists in this tree.
+   *
+   * @param data the data to find
+   * @return true if a node with the given data exists and false otherwise
+   */
+  bool contains(const U& data) const { return m_leaf_for_data.count(data) > 0; }
+
+  /**
+   * Inserts the given data with the given bounds into this tree.
+   *
+   * @param bounds the bounds of the data
+   * @param data the data to insert
+   *
+   * @throws NodeTreeException if the given data is already contained in this tree or if
+   * the given bounds are invalid
+   */
+  void insert(const box_type& bounds, U data)
+  {
+    check(bounds);
+
+    if (contains(data))
+    {
+      throw NodeTreeException("Data already in tree");
+    }
+
+    const auto leaf = allocate_node();
+    m_nodes[leaf].bounds = bounds;
+    m_nodes[leaf].data = data;
+    m_leaf_for_data.emplace(std::move(data), leaf);
+
+    insert_leaf(leaf);
+  }
+
+  /**
+   * Removes the node with the given data from this tree.
+   *
+   * @param data the data to remove
+   * @return true if a node with the given data was removed, and false otherwise
+   */
+  bool remove(const U& data)
+  {
+    const auto i_leaf = m_leaf_for_data.find(data);
+    if (i_leaf == m_leaf_for_data.end())
+    {
+      return false;
+    }
+
+    const auto leaf = i_leaf->second;
+    m_leaf_for_data.erase(i_leaf);
+
+    remove_leaf(leaf);
+    free_node(leaf);
+    return true;
+  }
+
+  /**
+   * Updates the node with the given data with the given new bounds.
+   *
+   * @param new_bounds the new bounds of the node
+   * @param data the node data of the node to update
+   *
+   * @throws NodeTreeException if no node with the given data can be found in this tree
+   */
+  void update(const box_type& new_bounds, const U& data)
+  {
+    check(new_bounds);
+
+    const auto i_leaf = m_leaf_for_data.find(data);
+    if (i_leaf == m_leaf_for_data.end())
+    {
+      throw NodeTreeException("node not found");
+    }
+
+    const auto leaf = i_leaf->second;
+    if (m_nodes[leaf].bounds == new_bounds)
+    {
+      return;
+    }
+
+    const auto parent = m_nodes[leaf].parent;
+    if (parent != null_index && m_nodes[parent].bounds.contains(new_bounds))
+    {
+      m_nodes[leaf].bounds = new_bounds;
+      refit(parent);
+    }
+    else
+    {
+      remove_leaf(leaf);
+      m_nodes[leaf].bounds = new_bounds;
+      insert_leaf(leaf);
+    }
+  }
+
+  /**
+   * Clears this node tree.
+   */
+  void clear()
+  {
+    m_nodes.clear();
+    m_free_nodes.clear();
+    m_leaf_for_data.clear();
+    m_root = null_index;
+  }
+
+  /**
+   * Indicates whether this tree is empty.
+   *
+   * @return true if this tree is empty and false otherwise
+   */
+  bool empty() const { return m_root == null_index; }
+
+  /**
+   * Returns the height of this tree. An empty tree and a tree with only one node have a
+   * height of 0.
+   */
+  size_t height() const { return empty() ? 0u : size_t(m_nodes[m_root].height); }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given ray
+   * and returns a list of those items.
+   *
+   * @param ray the ray to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_intersectors(const vm::ray<T, 3>& ray) const
+  {
+    auto result = std::vector<U>{};
+    find_intersectors(ray, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given ray
+   * and appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param ray the ray to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const vm::ray<T, 3>& ray, O out) const
+  {
+    visit_leaves_if(
+      [&](const auto& bounds) {
+        return bounds.contains(ray.origin)
+               || !vm::is_nan(vm::intersect_ray_bbox(ray, bounds));
+      },
+      out);
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given bbox
+   * and returns a list of those items.
+   *
+   * @param bbox the bbox to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_intersectors(const box_type& bbox) const
+  {
+    auto result = std::vector<U>{};
+    find_intersectors(bbox, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given bbox
+   * and appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param bbox the bbox to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const box_type& bbox, O out) const
+  {
+    visit_leaves_if([&](const auto& bounds) { return bbox.intersects(bounds); }, out);
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box contains the given point and
+   * returns a list of those items.
+   *
+   * @param point the point to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_containers(const vm::vec<T, 3>& point) const
+  {
+    auto result = std::vector<U>{};
+    find_containers(point, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box contains the given point and
+   * appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param point the point to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_containers(const vm::vec<T, 3>& point, O out) const
+  {
+    visit_leaves_if([&](const auto& bounds) { return bounds.contains(point); }, out);
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box satisfies the given predicate
+   * and appends it to the given output iterator.
+   *
+   * The predicate is also applied to the bounds of inner nodes to decide whether their
+   * subtrees must be visited, so it must return true for every box that contains a box
+   * which satisfies it.
+   *
+   * @tparam P the predicate type, a unary function that maps a box to bool
+   * @tparam O the output iterator type
+   * @param predicate the predicate to apply
+   * @param out the output iterator to append to
+   */
+  template <typename P, typename O>
+  void find_if(const P& predicate, O out) const
+  {
+    visit_leaves_if(predicate, out);
+  }
+
+private:
+  void check(const box_type& bounds) const
+  {
+    if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max))
+    {
+      throw NodeTreeException("Cannot add node to tree with invalid bounds");
+    }
+  }
+
+  template <typename Predicate, typename O>
+  void visit_leaves_if(const Predicate& predicate, O out) const
+  {
+    if (empty())
+    {
+      return;
+    }
+
+    auto stack = std::vector<size_t>{m_root};
+    while (!stack.empty())
+    {
+      const auto& current = m_nodes[stack.back()];
+      stack.pop_back();
+
+      if (predicate(current.bounds))
+      {
+        if (current.is_leaf())
+        {
+          *out++ = *current.data;
+        }
+        else
+        {
+          stack.push_back(current.child1);
+          stack.push_back(current.child2);
+        }
+      }
+    }
+  }
+
+  static T area(const box_type& bounds)
+  {
+    const auto size = bounds.size();
+    return size.x() * size.y() + size.y() * size.z() + size.z() * size.x();
+  }
+
+  size_t allocate_node()
+  {
+    if (!m_free_nodes.empty())
+    {
+      const auto index = m_free_nodes.back();
+      m_free_nodes.pop_back();
+      m_nodes[index] = node{};
+      return index;
+    }
+
+    m_nodes.emplace_back();
+    return m_nodes.size() - 1u;
+  }
+
+  void free_node(const size_t index)
+  {
+    m_nodes[index].data = std::nullopt;
+    m_free_nodes.push_back(index);
+  }
+
+  /**
+   * Finds the node that a leaf with the given bounds should become the sibling of.
+   * Starting at the root, descends into the child with the lower cost until creating a
+   * new parent for the current node is cheaper than descending. The cost of a node is the
+   * increase in surface area of the tree when the new leaf is inserted there.
+   */
+  size_t find_best_sibling(const box_type& bounds) const
+  {
+    auto index = m_root;
+    while (!m_nodes[index].is_leaf())
+    {
+      const auto& current = m_nodes[index];
+      const auto current_area = area(current.bounds);
+      const auto combined_area = area(vm::merge(current.bounds, bounds));
+
+      // the cost of creating a new parent for the current node and the new leaf
+      const auto cost = T(2) * combined_area;
+
+      // the minimum cost of pushing the new leaf further down the tree
+      const auto inheritance_cost = T(2) * (combined_area - current_area);
+
+      const auto child_cost = [&](const size_t child_index) {
+        const auto& child = m_nodes[child_index];
+        const auto merged_area = area(vm::merge(child.bounds, bounds));
+        return child.is_leaf() ? merged_area + inheritance_cost
+                               : merged_area - area(child.bounds) + inheritance_cost;
+      };
+
+      const auto cost1 = child_cost(current.child1);
+      const auto cost2 = child_cost(current.child2);
+
+      if (cost < cost1 && cost < cost2)
+      {
+        break;
+      }
+
+      index = cost1 < cost2 ? current.child1 : current.child2;
+    }
+
+    return index;
+  }
+
+  void insert_leaf(const size_t leaf)
+  {
+    if (m_root == null_index)
+    {
+      m_root = leaf;
+      m_nodes[leaf].parent = null_index;
+      return;
+    }
+
+    const auto sibling = find_best_sibling(m_nodes[leaf].bounds);
+    const auto old_parent = m_nodes[sibling].parent;
+
+    const auto new_parent = allocate_node();
+    m_nodes[new_parent].parent = old_parent;
+    m_nodes[new_parent].bounds = vm::merge(m_nodes[sibling].bounds, m_nodes[leaf].bounds);
+    m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+    m_nodes[new_parent].child1 = sibling;
+    m_nodes[new_parent].child2 = leaf;
+
+    if (old_parent == null_index)
+    {
+      m_root = new_parent;
+    }
+    else if (m_nodes[old_parent].child1 == sibling)
+    {
+      m_nodes[old_parent].child1 = new_parent;
+    }
+    else
+    {
+      m_nodes[old_parent].child2 = new_parent;
+    }
+
+    m_nodes[sibling].parent = new_parent;
+    m_nodes[leaf].parent = new_parent;
+
+    refit(old_parent);
+  }
+
+  void remove_leaf(const size_t leaf)
+  {
+    if (leaf == m_root)
+    {
+      m_root = null_index;
+      return;
+    }
+
+    const auto parent = m_nodes[leaf].parent;
+    const auto grand_parent = m_nodes[parent].parent;
+    const auto sibling =
+      m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grand_parent == null_index)
+    {
+      m_root = sibling;
+      m_nodes[sibling].parent = null_index;
+    }
+    else
+    {
+      if (m_nodes[grand_parent].child1 == parent)
+      {
+        m_nodes[grand_parent].child1 = sibling;
+      }
+      else
+      {
+        m_nodes[grand_parent].child2 = sibling;
+      }
+      m_nodes[sibling].parent = grand_parent;
+    }
+
+    free_node(parent);
+    m_nodes[leaf].parent = null_index;
+
+    refit(grand_parent);
+  }
+
+  /**
+   * Recomputes the bounds and heights of the given node and all of its ancestors,
+   * rebalancing the tree along the way.
+   */
+  void refit(size_t index)
+  {
+    while (index != null_index)
+    {
+      index = balance(index);
+
+      auto& current = m_nodes[index];
+      const auto& child1 = m_nodes[current.child1];
+      const auto& child2 = m_nodes[current.child2];
+      current.bounds = vm::merge(child1.bounds, child2.bounds);
+      current.height = 1 + std::max(child1.height, child2.height);
+
+      index = current.parent;
+    }
+  }
+
+  /**
+   * If the subtrees of the given inner node differ in height by more than 1, the taller
+   * child is rotated up to replace the given node. Returns the index of the node that is
+   * now at the position of the given node.
+   */
+  size_t balance(const size_t a)
+  {
+    assert(!m_nodes[a].is_leaf());
+
+    const auto b = m_nodes[a].child1;
+    const auto c = m_nodes[a].child2;
+    const auto difference = m_nodes[c].height - m_nodes[b].height;
+
+    if (difference > 1)
+    {
+      rotate_up(a, c);
+      return c;
+    }
+    if (difference < -1)
+    {
+      rotate_up(a, b);
+      return b;
+    }
+    return a;
+  }
+
+  /**
+   * Rotates the given child of the given node up so that it replaces the given node. The
+   * given node takes the place of the taller grandchild, and the shorter grandchild takes
+   * the place of the child.
+   */
+  void rotate_up(const size_t a, const size_t child)
+  {
+    const auto other = m_nodes[a].child1 == child ? m_nodes[a].child2 : m_nodes[a].child1;
+    const auto f = m_nodes[child].child1;
+    const auto g = m_nodes[child].child2;
+
+    // child replaces a
+    m_nodes[child].child1 = a;
+    m_nodes[child].parent = m_nodes[a].parent;
+    m_nodes[a].parent = child;
+
+    if (m_nodes[child].parent == null_index)
+    {
+      m_root = child;
+    }
+    else if (m_nodes[m_nodes[child].parent].child1 == a)
+    {
+      m_nodes[m_nodes[child].parent].child1 = child;
+    }
+    else
+    {
+      m_nodes[m_nodes[child].parent].child2 = child;
+    }
+
+    // the taller grandchild stays below child, the shorter one moves below a
+    const auto [taller, shorter] =
+      m_nodes[f].height > m_nodes[g].height ? std::pair{f, g} : std::pair{g, f};
+
+    m_nodes[child].child2 = taller;
+    m_nodes[a].child1 = other;
+    m_nodes[a].child2 = shorter;
+    m_nodes[shorter].parent = a;
+
+    m_nodes[a].bounds = vm::merge(m_nodes[other].bounds, m_nodes[shorter].bounds);
+    m_nodes[a].height = 1 + std::max(m_nodes[other].height, m_nodes[shorter].height);
+  }
+};
+
+} // namespace TrenchBroom
@@ -103,6 +103,126 @@ static Renderer::IndexRangeMapBuilder<EntityModelVertex::Type> makeDummyBuilder(
   return builder;
 }
 
+static Renderer::IndexRangeMapBuilder<EntityModelVertex::Type> makeGridBuilder(
+  const size_t cellCount)
+{
+  auto size = Renderer::IndexRangeMap::Size{};
+  size.inc(Renderer::PrimType::Triangles, 2 * cellCount * cellCount);
+
+  auto builder = Renderer::IndexRangeMapBuilder<EntityModelVertex::Type>{
+    6 * cellCount * cellCount, size};
+
+  const auto vertex = [](const size_t x, const size_t y) {
+    return EntityModelVertex{vm::vec3f{float(x), float(y), 0} * 8.0f, vm::vec2f{0, 0}};
+  };
+
+  for (size_t x = 0; x < cellCount; ++x)
+  {
+    for (size_t y = 0; y < cellCount; ++y)
+    {
+      builder.addTriangle(vertex(x, y), vertex(x + 1, y), vertex(x + 1, y + 1));
+      builder.addTriangle(vertex(x, y), vertex(x + 1, y + 1), vertex(x, y + 1));
+    }
+  }
+
+  return builder;
+}
+
+static Renderer::IndexRangeMapBuilder<EntityModelVertex::Type> makeStripGridBuilder(
+  const size_t cellCount)
+{
+  auto builder = Renderer::IndexRangeMapBuilder<EntityModelVertex::Type>{};
+
+  const auto vertex = [](const size_t x, const size_t y) {
+    return EntityModelVertex{vm::vec3f{float(x), float(y), 0} * 8.0f, vm::vec2f{0, 0}};
+  };
+
+  for (size_t y = 0; y < cellCount; ++y)
+  {
+    auto strip = std::vector<EntityModelVertex>{};
+    for (size_t x = 0; x <= cellCount; ++x)
+    {
+      strip.push_back(vertex(x, y));
+      strip.push_back(vertex(x, y + 1));
+    }
+    builder.addTriangleStrip(strip);
+  }
+
+  return builder;
+}
+
+TEST_CASE("EntityModelTest.decimateMesh")
+{
+  const auto builder = makeGridBuilder(32);
+  const auto bounds = vm::bbox3f{vm::vec3f::zero(), vm::vec3f{256, 256, 0}};
+
+  const auto vertices = decimateMesh(builder.vertices(), builder.indices(), 8);
+  CHECK(!vertices.empty());
+  CHECK(vertices.size() % 3 == 0);
+  CHECK(vertices.size() < builder.vertices().size() / 4);
+
+  for (const auto& vertex : vertices)
+  {
+    CHECK(bounds.contains(Renderer::getVertexComponent<0>(vertex)));
+  }
+
+  // a single cell collapses every triangle
+  CHECK(decimateMesh(builder.vertices(), builder.indices(), 1).empty());
+}
+
+TEST_CASE("EntityModelTest.levelsOfDetail")
+{
+  auto model = EntityModel{"test", PitchType::Normal, Orientation::Oriented};
+  model.addFrame();
+  model.addFrame();
+  auto& frame0 = model.loadFrame(0, "dense", vm::bbox3f{0, 256});
+  auto& frame1 = model.loadFrame(1, "sparse", vm::bbox3f{0, 8});
+
+  auto& surface = model.addSurface("surface");
+
+  auto textures = std::vector<Texture>{};
+  textures.push_back(makeDummyTexture("skin"));
+  surface.setSkins(std::move(textures));
+
+  auto denseBuilder = makeGridBuilder(32);
+  surface.addIndexedMesh(frame0, denseBuilder.vertices(), denseBuilder.indices());
+
+  auto sparseBuilder = makeDummyBuilder();
+  surface.addIndexedMesh(frame1, sparseBuilder.vertices(), sparseBuilder.indices());
+
+  CHECK(model.lodCount(0) == EntityModelLodCount);
+  CHECK(model.lodCount(1) == 1u);
+  CHECK(model.lodCount(2) == 0u);
+
+  for (size_t lodIndex = 0; lodIndex < EntityModelLodCount; ++lodIndex)
+  {
+    CHECK(model.buildRenderer(0, 0, lodIndex) != nullptr);
+    CHECK(model.buildRenderer(0, 1, lodIndex) != nullptr);
+  }
+
+  CHECK(model.buildImpostorRenderer(0, 0) != nullptr);
+  CHECK(model.buildImpostorRenderer(0, 2) == nullptr);
+}
+
+TEST_CASE("EntityModelTest.levelsOfDetailOfTriangleStrips")
+{
+  auto model = EntityModel{"test", PitchType::Normal, Orientation::Oriented};
+  model.addFrame();
+  auto& frame = model.loadFrame(0, "strips", vm::bbox3f{0, 256});
+
+  auto& surface = model.addSurface("surface");
+
+  auto textures = std::vector<Texture>{};
+  textures.push_back(makeDummyTexture("skin"));
+  surface.setSkins(std::move(textures));
+
+  // the simplified meshes have fewer triangles, but more vertices than the strips
+  auto builder = makeStripGridBuilder(32);
+  surface.addIndexedMesh(frame, builder.vertices(), builder.indices());
+
+  CHECK(model.lodCount(0) == EntityModelLodCount);
+}
+
 TEST_CASE("EntityModelTest.buildRenderer.defaultSkinIndex")
 {
   // Ensure that when rendering a model with multiple surfaces
@@ -24,6 +24,7 @@
 #include "Model/CompilationTask.h"
 
 #include <string>
+#include <tuple>
 
 #include "Catch2.h"
 
@@ -460,5 +461,84 @@ TEST_CASE("CompilationConfigParserTest.parseUnescapedBackslashes")
        }},
     }});
 }
+
+TEST_CASE("CompilationConfigParserTest.parseJobsAndDependencies")
+{
+  const auto config = R"(
+{
+  'version': 1,
+  'profiles': [{
+    'name': 'A profile',
+    'workdir': '',
+    'jobs': 2,
+    'tasks': [
+    {
+      'type': 'export',
+      'target': 'the target'
+    },
+    {
+      'type': 'tool',
+      'tool': 'light.exe',
+      'parameters': 'this and that',
+      'dependencies': [0]
+    },
+    {
+      'type': 'tool',
+      'tool': 'vis.exe',
+      'parameters': 'this and that',
+      'dependencies': [0]
+    },
+    {
+      'type': 'delete',
+      'target': 'some other target',
+      'dependencies': [2, 1, 2]
+    }]
+  }]
+})";
+
+  auto parser = CompilationConfigParser{config};
+  CHECK(
+    parser.parse()
+    == Model::CompilationConfig{{
+      {"A profile",
+       "",
+       {
+         Model::CompilationExportMap{true, "the target"},
+         Model::CompilationRunTool{true, "light.exe", "this and that", false, {{0}}},
+         Model::CompilationRunTool{true, "vis.exe", "this and that", false, {{0}}},
+         Model::CompilationDeleteFiles{true, "some other target", {{1, 2}}},
+       },
+       2},
+    }});
+}
+
+TEST_CASE("CompilationConfigParserTest.parseInvalidJobsAndDependencies")
+{
+  using T = std::tuple<std::string, std::string>;
+
+  // clang-format off
+  const auto
+  [tasks,                                               jobs] = GENERATE(values<T>({
+  {R"([{'type': 'export', 'target': 'x', 'dependencies': [0]}])",     "1"},
+  {R"([{'type': 'export', 'target': 'x', 'dependencies': [1]},
+       {'type': 'export', 'target': 'y'}])",                           "1"},
+  {R"([{'type': 'export', 'target': 'x'},
+       {'type': 'export', 'target': 'y', 'dependencies': [-1]}])",     "1"},
+  {R"([{'type': 'export', 'target': 'x'},
+       {'type': 'export', 'target': 'y', 'dependencies': 0}])",        "1"},
+  {R"([{'type': 'export', 'target': 'x'}])",                          "0"},
+  {R"([{'type': 'export', 'target': 'x'}])",                          "1.5"},
+  }));
+  // clang-format on
+
+  CAPTURE(tasks, jobs);
+
+  const auto config = "{ 'version': 1, 'profiles': [{ 'name': 'A profile', "
+                      "'workdir': '', 'jobs': "
+                      + jobs + ", 'tasks': " + tasks + " }] }";
+
+  auto parser = CompilationConfigParser{config};
+  CHECK_THROWS_AS(parser.parse(), ParserException);
+}
 } // namespace IO
 } // namespace TrenchBroom
@@ -0,0 +1,188 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/EntityDefinitionCache.h"
+#include "IO/EntityDefinitionClassInfo.h"
+#include "IO/FgdParser.h"
+#include "IO/RecordingParserStatus.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
+#include "Logger.h"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+const auto HostFgd = std::string{R"(
+@include "base.fgd"
+@PointClass base(Targetname) = info_null : "Nothing" []
+)"};
+
+const auto BaseFgd = std::string{R"(
+@baseclass = Targetname [ targetname(target_source) : "Name" ]
+)"};
+
+std::vector<EntityDefinitionClassInfo> parse(
+  EntityDefinitionCache& cache,
+  const std::filesystem::path& path,
+  const std::string& contents,
+  ParserStatus& status)
+{
+  auto parser = FgdParser{contents, Color{1.0f, 1.0f, 1.0f, 1.0f}, path};
+  auto recordingStatus = RecordingParserStatus{status};
+  auto classInfos = parser.parseResolvedClassInfos(recordingStatus);
+  cache.insert(
+    path, contents, parser.includedFiles(), classInfos, recordingStatus.messages());
+  return classInfos;
+}
+
+std::vector<EntityDefinitionClassInfo> parse(
+  EntityDefinitionCache& cache,
+  const std::filesystem::path& path,
+  const std::string& contents)
+{
+  auto status = TestParserStatus{};
+  return parse(cache, path, contents, status);
+}
+
+std::optional<std::vector<EntityDefinitionClassInfo>> find(
+  EntityDefinitionCache& cache,
+  const std::filesystem::path& path,
+  const std::string& contents)
+{
+  auto status = TestParserStatus{};
+  return cache.find(path, contents, status);
+}
+} // namespace
+
+TEST_CASE("EntityDefinitionCacheTest.find")
+{
+  auto env = TestEnvironment{[](auto& e) {
+    e.createFile("host.fgd", HostFgd);
+    e.createFile("base.fgd", BaseFgd);
+  }};
+
+  const auto hostPath = env.dir() / "host.fgd";
+  auto cache = EntityDefinitionCache{};
+
+  CHECK(find(cache, hostPath, HostFgd) == std::nullopt);
+
+  const auto classInfos = parse(cache, hostPath, HostFgd);
+  REQUIRE(classInfos.size() == 1u);
+
+  SECTION("Returns the cached class infos if no file has changed")
+  {
+    CHECK(find(cache, hostPath, HostFgd) == classInfos);
+  }
+
+  SECTION("Ignores the entry if the host file has changed")
+  {
+    CHECK(find(cache, hostPath, HostFgd + "\n// comment") == std::nullopt);
+  }
+
+  SECTION("Ignores the entry if the host file has the same size but other contents")
+  {
+    auto changed = HostFgd;
+    changed.back() = ' ';
+    REQUIRE(changed.size() == HostFgd.size());
+    CHECK(find(cache, hostPath, changed) == std::nullopt);
+  }
+
+  SECTION("Ignores the entry if an included file has changed")
+  {
+    env.createFile("base.fgd", BaseFgd + "\n// comment");
+    CHECK(find(cache, hostPath, HostFgd) == std::nullopt);
+  }
+
+  SECTION("Ignores the entry if an included file was deleted")
+  {
+    std::filesystem::remove(env.dir() / "base.fgd");
+    CHECK(find(cache, hostPath, HostFgd) == std::nullopt);
+  }
+
+  SECTION("Clearing removes all entries")
+  {
+    cache.clear();
+    CHECK(find(cache, hostPath, HostFgd) == std::nullopt);
+  }
+}
+
+TEST_CASE("EntityDefinitionCacheTest.findWithMissingInclude")
+{
+  auto env = TestEnvironment{[](auto& e) { e.createFile("host.fgd", HostFgd); }};
+
+  const auto hostPath = env.dir() / "host.fgd";
+  auto cache = EntityDefinitionCache{};
+  parse(cache, hostPath, HostFgd);
+
+  CHECK(find(cache, hostPath, HostFgd) != std::nullopt);
+
+  env.createFile("base.fgd", BaseFgd);
+  CHECK(find(cache, hostPath, HostFgd) == std::nullopt);
+}
+
+TEST_CASE("EntityDefinitionCacheTest.replayMessages")
+{
+  auto env = TestEnvironment{[](auto& e) { e.createFile("host.fgd", HostFgd); }};
+
+  const auto hostPath = env.dir() / "host.fgd";
+  auto cache = EntityDefinitionCache{};
+
+  auto parseStatus = TestParserStatus{};
+  parse(cache, hostPath, HostFgd, parseStatus);
+  REQUIRE(parseStatus.countStatus(LogLevel::Error) > 0u);
+
+  auto findStatus = TestParserStatus{};
+  REQUIRE(cache.find(hostPath, HostFgd, findStatus) != std::nullopt);
+  CHECK(findStatus.messages(LogLevel::Error) == parseStatus.messages(LogLevel::Error));
+  CHECK(findStatus.messages(LogLevel::Warn) == parseStatus.messages(LogLevel::Warn));
+}
+
+TEST_CASE("EntityDefinitionCacheTest.evictLeastRecentlyUsed")
+{
+  auto env = TestEnvironment{[](auto& e) { e.createFile("base.fgd", BaseFgd); }};
+
+  const auto pathAt = [&](const size_t i) {
+    return env.dir() / ("host" + std::to_string(i) + ".fgd");
+  };
+
+  auto cache = EntityDefinitionCache{};
+  for (size_t i = 0; i < EntityDefinitionCache::MaxEntries; ++i)
+  {
+    parse(cache, pathAt(i), HostFgd);
+  }
+  REQUIRE(cache.size() == EntityDefinitionCache::MaxEntries);
+
+  // use the first entry so that the second one is the least recently used
+  REQUIRE(find(cache, pathAt(0), HostFgd) != std::nullopt);
+
+  parse(cache, pathAt(EntityDefinitionCache::MaxEntries), HostFgd);
+  CHECK(cache.size() == EntityDefinitionCache::MaxEntries);
+  CHECK(find(cache, pathAt(0), HostFgd) != std::nullopt);
+  CHECK(find(cache, pathAt(1), HostFgd) == std::nullopt);
+  CHECK(find(cache, pathAt(EntityDefinitionCache::MaxEntries), HostFgd) != std::nullopt);
+}
+} // namespace TrenchBroom::IO
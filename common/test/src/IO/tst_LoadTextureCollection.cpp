@@ -218,4 +218,47 @@ TEST_CASE("loadTextureCollection")
   }
 }
 
+TEST_CASE("loadTextureCollections")
+{
+  auto fs = VirtualFileSystem{};
+  fs.mount("", std::make_unique<DiskFileSystem>(std::filesystem::current_path()));
+
+  const auto wadPath =
+    std::filesystem::current_path() / "fixture/test/IO/Wad/cr8_czg.wad";
+  fs.mount("textures" / wadPath.filename(), openFS<WadFileSystem>(wadPath));
+
+  auto logger = NullLogger{};
+
+  SECTION("missing texture root")
+  {
+    const auto textureConfig = Model::TextureConfig{
+      "missing",
+      {".D"},
+      "fixture/test/palette.lmp",
+      "wad",
+      "",
+      {},
+    };
+
+    CHECK(loadTextureCollections(fs, textureConfig, logger).empty());
+  }
+
+  SECTION("loading all collections")
+  {
+    const auto textureConfig = Model::TextureConfig{
+      "textures",
+      {".D"},
+      "fixture/test/palette.lmp",
+      "wad",
+      "",
+      {},
+    };
+
+    const auto textureCollections = loadTextureCollections(fs, textureConfig, logger);
+    REQUIRE(textureCollections.size() == 1u);
+    CHECK(textureCollections.front().path() == "textures/cr8_czg.wad");
+    CHECK(textureCollections.front().textures().size() == 21u);
+  }
+}
+
 } // namespace TrenchBroom::IO
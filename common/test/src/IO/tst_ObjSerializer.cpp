@@ -28,18 +28,26 @@
 #include "Model/BrushBuilder.h"
 #include "Model/BrushNode.h"
 #include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/Layer.h"
 #include "Model/LayerNode.h"
 #include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
 
 #include <kdl/result.h>
 #include <kdl/result_io.h>
+#include <kdl/string_utils.h>
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -448,5 +456,288 @@ map_Kd {}
 
   CHECK(mtlStream.str() == expectedMtl);
 }
+
+TEST_CASE("ObjSerializer.writeStreaming")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto map = Model::WorldNode{{}, {}, Model::MapFormat::Quake3};
+
+  auto builder = Model::BrushBuilder{map.mapFormat(), worldBounds};
+  auto* brushNode1 = new Model::BrushNode{
+    builder.createCuboid(vm::bbox3{{0, 0, 0}, {32, 32, 32}}, "texture1").value()};
+  auto* brushNode2 = new Model::BrushNode{
+    builder.createCuboid(vm::bbox3{{0, 0, 0}, {32, 32, 32}}, "texture2").value()};
+  map.defaultLayer()->addChild(brushNode1);
+  map.defaultLayer()->addChild(brushNode2);
+
+  auto objStream = std::ostringstream{};
+  auto mtlStream = std::ostringstream{};
+  const auto mtlFilename = "some_file_name.mtl";
+  auto objOptions =
+    ObjExportOptions{"/some/export/path.obj", ObjMtlPathMode::RelativeToGamePath};
+  objOptions.streaming = true;
+
+  auto writer = NodeWriter{
+    map, std::make_unique<ObjSerializer>(objStream, mtlStream, mtlFilename, objOptions)};
+  writer.writeMap();
+
+  CHECK(objStream.str() == R"(mtllib some_file_name.mtl
+
+v 0 0 -32
+v 0 0 -0
+v 0 32 -0
+v 0 32 -32
+v 32 32 -0
+v 32 0 -0
+v 32 0 -32
+v 32 32 -32
+vt 32 -0
+vt 0 -0
+vt 0 32
+vt 32 32
+vn -1 0 -0
+vn 0 0 1
+vn 0 -1 -0
+vn 0 1 -0
+vn 0 0 -1
+vn 1 0 -0
+o entity0_brush0
+usemtl texture1
+f  1/1/1  2/2/1  3/3/1  4/4/1
+usemtl texture1
+f  5/4/2  3/3/2  2/2/2  6/1/2
+usemtl texture1
+f  6/1/3  2/2/3  1/3/3  7/4/3
+usemtl texture1
+f  8/4/4  4/3/4  3/2/4  5/1/4
+usemtl texture1
+f  7/1/5  1/2/5  4/3/5  8/4/5
+usemtl texture1
+f  8/4/6  5/3/6  6/2/6  7/1/6
+
+v 0 0 -32
+v 0 0 -0
+v 0 32 -0
+v 0 32 -32
+v 32 32 -0
+v 32 0 -0
+v 32 0 -32
+v 32 32 -32
+vt 32 -0
+vt 0 -0
+vt 0 32
+vt 32 32
+vn -1 0 -0
+vn 0 0 1
+vn 0 -1 -0
+vn 0 1 -0
+vn 0 0 -1
+vn 1 0 -0
+o entity0_brush1
+usemtl texture2
+f  9/5/7  10/6/7  11/7/7  12/8/7
+usemtl texture2
+f  13/8/8  11/7/8  10/6/8  14/5/8
+usemtl texture2
+f  14/5/9  10/6/9  9/7/9  15/8/9
+usemtl texture2
+f  16/8/10  12/7/10  11/6/10  13/5/10
+usemtl texture2
+f  15/5/11  9/6/11  12/7/11  16/8/11
+usemtl texture2
+f  16/8/12  13/7/12  14/6/12  15/5/12
+
+)");
+
+  CHECK(mtlStream.str() == R"(newmtl texture1
+
+newmtl texture2
+
+)");
+}
+
+TEST_CASE("ObjSerializer.writeWithPrecisionAndWithoutDeduplication")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto map = Model::WorldNode{{}, {}, Model::MapFormat::Quake3};
+
+  auto builder = Model::BrushBuilder{map.mapFormat(), worldBounds};
+  auto* brushNode = new Model::BrushNode{
+    builder.createCuboid(vm::bbox3{{0, 0, 0}, {1.0 / 3.0, 32, 32}}, "some_texture")
+      .value()};
+  map.defaultLayer()->addChild(brushNode);
+
+  auto objStream = std::ostringstream{};
+  auto mtlStream = std::ostringstream{};
+  const auto mtlFilename = "some_file_name.mtl";
+  auto objOptions =
+    ObjExportOptions{"/some/export/path.obj", ObjMtlPathMode::RelativeToGamePath};
+  objOptions.precision = 3;
+  objOptions.deduplicate = false;
+
+  auto writer = NodeWriter{
+    map, std::make_unique<ObjSerializer>(objStream, mtlStream, mtlFilename, objOptions)};
+  writer.writeMap();
+
+  const auto obj = objStream.str();
+  CHECK_THAT(obj, Catch::Contains("\nv 0.333 32 -32\n"));
+
+  // every face has its own vertices and texture coordinates
+  auto vertexCount = size_t(0);
+  auto texCoordsCount = size_t(0);
+  auto line = std::string{};
+  auto objLines = std::istringstream{obj};
+  while (std::getline(objLines, line))
+  {
+    vertexCount += line.rfind("v ", 0) == 0 ? 1u : 0u;
+    texCoordsCount += line.rfind("vt ", 0) == 0 ? 1u : 0u;
+  }
+  CHECK(vertexCount == 24u);
+  CHECK(texCoordsCount == 24u);
+}
+
+namespace
+{
+/**
+ * Returns the object, material and face lines of the given OBJ file with every face
+ * index replaced by the vertex data it refers to.
+ */
+std::vector<std::string> resolveObjFaces(const std::string& obj)
+{
+  auto vertices = std::vector<std::string>{};
+  auto texCoords = std::vector<std::string>{};
+  auto normals = std::vector<std::string>{};
+  auto result = std::vector<std::string>{};
+
+  auto line = std::string{};
+  auto lines = std::istringstream{obj};
+  while (std::getline(lines, line))
+  {
+    if (line.rfind("v ", 0) == 0)
+    {
+      vertices.push_back(line.substr(2));
+    }
+    else if (line.rfind("vt ", 0) == 0)
+    {
+      texCoords.push_back(line.substr(3));
+    }
+    else if (line.rfind("vn ", 0) == 0)
+    {
+      normals.push_back(line.substr(3));
+    }
+    else if (line.rfind("o ", 0) == 0 || line.rfind("usemtl ", 0) == 0)
+    {
+      result.push_back(line);
+    }
+    else if (line.rfind("f ", 0) == 0)
+    {
+      auto face = std::string{"f"};
+      for (const auto& vertex : kdl::str_split(line.substr(2), " "))
+      {
+        const auto indices = kdl::str_split(vertex, "/");
+        REQUIRE(indices.size() == 3u);
+        face += " (" + vertices.at(std::stoul(indices[0]) - 1u) + ")/("
+                + texCoords.at(std::stoul(indices[1]) - 1u) + ")/("
+                + normals.at(std::stoul(indices[2]) - 1u) + ")";
+      }
+      result.push_back(face);
+    }
+  }
+
+  return result;
+}
+
+std::string exportObj(
+  const Model::WorldNode& map, const bool streaming, std::ostream& mtlStream)
+{
+  auto objStream = std::ostringstream{};
+  auto objOptions =
+    ObjExportOptions{"/some/export/path.obj", ObjMtlPathMode::RelativeToGamePath};
+  objOptions.streaming = streaming;
+
+  auto writer = NodeWriter{
+    map,
+    std::make_unique<ObjSerializer>(
+      objStream, mtlStream, "some_file_name.mtl", objOptions)};
+  writer.setExporting(true);
+  writer.writeMap();
+
+  return objStream.str();
+}
+} // namespace
+
+TEST_CASE("ObjSerializer.writeStreamingMatchesBuffered")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto map = Model::WorldNode{{}, {}, Model::MapFormat::Quake3};
+  auto builder = Model::BrushBuilder{map.mapFormat(), worldBounds};
+
+  auto brushIndex = size_t(0);
+  const auto createBrushNode = [&](const std::string& textureName) {
+    const auto x = FloatType(brushIndex % 64u) * 16.0;
+    const auto y = FloatType(brushIndex / 64u) * 16.0;
+    ++brushIndex;
+    return new Model::BrushNode{
+      builder.createCuboid(vm::bbox3{{x, y, 0}, {x + 8, y + 8, 8}}, textureName)
+        .value()};
+  };
+
+  // the group and the entity precede the default layer's brushes, but the brushes are
+  // written first
+  auto* groupNode = new Model::GroupNode{Model::Group{"group"}};
+  groupNode->addChild(createBrushNode("group_texture"));
+  groupNode->addChild(createBrushNode("group_texture"));
+  map.defaultLayer()->addChild(groupNode);
+
+  auto* entityNode =
+    new Model::EntityNode{Model::Entity{{}, {{"classname", "func_door"}}}};
+  entityNode->addChild(createBrushNode("entity_texture"));
+  map.defaultLayer()->addChild(entityNode);
+
+  // more than one chunk of brushes
+  const auto defaultLayerBrushCount = size_t(1100);
+  for (size_t i = 0; i < defaultLayerBrushCount; ++i)
+  {
+    map.defaultLayer()->addChild(createBrushNode("texture" + std::to_string(i % 7u)));
+  }
+
+  auto* customLayerNode = new Model::LayerNode{Model::Layer{"custom"}};
+  customLayerNode->addChild(createBrushNode("custom_texture"));
+  auto* customEntityNode =
+    new Model::EntityNode{Model::Entity{{}, {{"classname", "func_wall"}}}};
+  customEntityNode->addChild(createBrushNode("custom_entity_texture"));
+  customLayerNode->addChild(customEntityNode);
+  map.addChild(customLayerNode);
+
+  auto omittedLayer = Model::Layer{"omitted"};
+  omittedLayer.setOmitFromExport(true);
+  auto* omittedLayerNode = new Model::LayerNode{std::move(omittedLayer)};
+  omittedLayerNode->addChild(createBrushNode("omitted_texture"));
+  omittedLayerNode->addChild(createBrushNode("omitted_texture"));
+  map.addChild(omittedLayerNode);
+
+  auto bufferedMtlStream = std::ostringstream{};
+  const auto bufferedObj = exportObj(map, false, bufferedMtlStream);
+
+  auto streamedMtlStream = std::ostringstream{};
+  const auto streamedObj = exportObj(map, true, streamedMtlStream);
+
+  const auto bufferedFaces = resolveObjFaces(bufferedObj);
+  const auto streamedFaces = resolveObjFaces(streamedObj);
+
+  const auto objectCount = size_t(std::count_if(
+    streamedFaces.begin(), streamedFaces.end(), [](const auto& line) {
+      return line.rfind("o ", 0) == 0;
+    }));
+  CHECK(objectCount == 2u + 1u + defaultLayerBrushCount + 1u + 1u);
+  CHECK(streamedFaces == bufferedFaces);
+
+  CHECK_THAT(streamedObj, !Catch::Contains("omitted_texture"));
+  CHECK_THAT(streamedMtlStream.str(), !Catch::Contains("omitted_texture"));
+  CHECK_THAT(streamedMtlStream.str(), Catch::Contains("newmtl custom_entity_texture"));
+}
 } // namespace IO
 } // namespace TrenchBroom
@@ -22,6 +22,7 @@
 #include "Assets/EntityDefinition.h"
 #include "Assets/EntityDefinitionFileSpec.h"
 #include "Assets/EntityModel.h"
+#include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
 #include "Error.h"
 #include "Exceptions.h"
@@ -201,18 +202,27 @@ void TestGame::doWriteBrushFacesToStream(
   writer.writeBrushFaces(faces);
 }
 
+namespace
+{
+const auto TestTextureConfig = Model::TextureConfig{
+  "textures",
+  {".D"},
+  "fixture/test/palette.lmp",
+  "wad",
+  "",
+  {},
+};
+} // namespace
+
 void TestGame::doLoadTextureCollections(Assets::TextureManager& textureManager) const
 {
-  const Model::TextureConfig textureConfig{
-    "textures",
-    {".D"},
-    "fixture/test/palette.lmp",
-    "wad",
-    "",
-    {},
-  };
+  textureManager.reload(*m_fs, TestTextureConfig);
+}
 
-  textureManager.reload(*m_fs, textureConfig);
+std::vector<Assets::TextureCollection> TestGame::doLoadTextureCollections(
+  Logger& logger) const
+{
+  return IO::loadTextureCollections(*m_fs, TestTextureConfig, logger);
 }
 
 const std::optional<std::string>& TestGame::doGetWadProperty() const
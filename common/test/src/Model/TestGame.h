@@ -108,6 +108,8 @@ private:
     std::ostream& stream) const override;
 
   void doLoadTextureCollections(Assets::TextureManager& textureManager) const override;
+  std::vector<Assets::TextureCollection> doLoadTextureCollections(
+    Logger& logger) const override;
 
   const std::optional<std::string>& doGetWadProperty() const override;
   void doReloadWads(
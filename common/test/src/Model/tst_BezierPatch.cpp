@@ -60,6 +60,30 @@ TEST_CASE("BezierPatch.evaluate")
   CHECK(patch.evaluate(subdiv) == expectedGrid);
 }
 
+TEST_CASE("BezierPatch.evaluateWithDifferentSubdivisions")
+{
+  // clang-format off
+  const auto patch = BezierPatch{3, 5, {
+    {0, 0, 0}, {1, 0, 1}, {2, 0, 0}, {3, 0, 1}, {4, 0, 0},
+    {0, 1, 1}, {1, 1, 2}, {2, 1, 1}, {3, 1, 2}, {4, 1, 1},
+    {0, 2, 0}, {1, 2, 1}, {2, 2, 0}, {3, 2, 1}, {4, 2, 0}}, ""};
+  // clang-format on
+
+  const auto grid = patch.evaluate(1, 2);
+  REQUIRE(grid.size() == 3u * 9u);
+
+  // the grid points at even columns are shared with a uniform subdivision
+  const auto uniformGrid = patch.evaluate(1);
+  REQUIRE(uniformGrid.size() == 3u * 5u);
+  for (size_t row = 0u; row < 3u; ++row)
+  {
+    for (size_t col = 0u; col < 5u; ++col)
+    {
+      CHECK(grid[row * 9u + col * 2u] == uniformGrid[row * 5u + col]);
+    }
+  }
+}
+
 TEST_CASE("BezierPatch.transform")
 {
   // clang-format off
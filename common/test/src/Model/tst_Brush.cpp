@@ -30,6 +30,7 @@
 #include "Model/BrushGeometry.h"
 #include "Model/BrushNode.h"
 #include "Model/Entity.h"
+#include "Model/ExactBrushGeometry.h"
 #include "Model/Polyhedron.h"
 #include "TestUtils.h"
 
@@ -123,6 +124,114 @@ TEST_CASE("BrushTest.constructBrushWithRedundantFaces")
           .is_error());
 }
 
+TEST_CASE("BrushTest.constructBrushWithExactGeometry")
+{
+  const vm::bbox3 worldBounds(4096.0);
+
+  // a cube with length 16 at the origin
+  auto faces = std::vector<BrushFace>{
+    // left
+    createParaxial(
+      vm::vec3(0.0, 0.0, 0.0), vm::vec3(0.0, 1.0, 0.0), vm::vec3(0.0, 0.0, 1.0)),
+    // right
+    createParaxial(
+      vm::vec3(16.0, 0.0, 0.0), vm::vec3(16.0, 0.0, 1.0), vm::vec3(16.0, 1.0, 0.0)),
+    // front
+    createParaxial(
+      vm::vec3(0.0, 0.0, 0.0), vm::vec3(0.0, 0.0, 1.0), vm::vec3(1.0, 0.0, 0.0)),
+    // back
+    createParaxial(
+      vm::vec3(0.0, 16.0, 0.0), vm::vec3(1.0, 16.0, 0.0), vm::vec3(0.0, 16.0, 1.0)),
+    // top
+    createParaxial(
+      vm::vec3(0.0, 0.0, 16.0), vm::vec3(0.0, 1.0, 16.0), vm::vec3(1.0, 0.0, 16.0)),
+    // bottom
+    createParaxial(
+      vm::vec3(0.0, 0.0, 0.0), vm::vec3(1.0, 0.0, 0.0), vm::vec3(0.0, 1.0, 0.0)),
+  };
+
+  SECTION("Axis-aligned brush with off-grid faces")
+  {
+    faces.push_back(createParaxial(
+      vm::vec3(0.0, 0.0, 8.5), vm::vec3(0.0, 1.0, 8.5), vm::vec3(1.0, 0.0, 8.5)));
+
+    const auto brush = Brush::create(worldBounds, faces).value();
+    CHECK(brush.faceCount() == 6u);
+    CHECK(brush.bounds() == vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(16, 16, 8.5)));
+    CHECK(brush.fullySpecified());
+  }
+
+  SECTION("Integer wedge")
+  {
+    // replace the right and top faces with a sloped face, leaving few enough faces for
+    // the brush geometry to be built from the integer planes
+    faces.erase(faces.begin() + 4);
+    faces.erase(faces.begin() + 1);
+    faces.push_back(createParaxial(
+      vm::vec3(16.0, 0.0, 0.0), vm::vec3(0.0, 0.0, 16.0), vm::vec3(16.0, 1.0, 0.0)));
+
+    auto sortedFaces = faces;
+    BrushFace::sortFaces(sortedFaces);
+    CHECK(createExactBrushGeometry(sortedFaces, worldBounds) != nullptr);
+
+    const auto brush = Brush::create(worldBounds, faces).value();
+    CHECK(brush.faceCount() == 5u);
+    CHECK_THAT(
+      brush.vertexPositions(),
+      Catch::UnorderedEquals(std::vector<vm::vec3>{
+        vm::vec3(0, 0, 0),
+        vm::vec3(16, 0, 0),
+        vm::vec3(0, 0, 16),
+        vm::vec3(0, 16, 0),
+        vm::vec3(16, 16, 0),
+        vm::vec3(0, 16, 16),
+      }));
+    CHECK(brush.findFace(vm::normalize(vm::vec3(1, 0, 1))));
+    CHECK(brush.fullySpecified());
+  }
+
+  SECTION("Integer wedge with redundant faces")
+  {
+    faces.push_back(createParaxial(
+      vm::vec3(16.0, 0.0, 0.0), vm::vec3(0.0, 0.0, 16.0), vm::vec3(16.0, 1.0, 0.0)));
+
+    const auto brush = Brush::create(worldBounds, faces).value();
+    CHECK(brush.faceCount() == 5u);
+    CHECK_THAT(
+      brush.vertexPositions(),
+      Catch::UnorderedEquals(std::vector<vm::vec3>{
+        vm::vec3(0, 0, 0),
+        vm::vec3(16, 0, 0),
+        vm::vec3(0, 0, 16),
+        vm::vec3(0, 16, 0),
+        vm::vec3(16, 16, 0),
+        vm::vec3(0, 16, 16),
+      }));
+    CHECK(brush.findFace(vm::normalize(vm::vec3(1, 0, 1))));
+    CHECK_FALSE(brush.findFace(vm::vec3::pos_x()));
+    CHECK_FALSE(brush.findFace(vm::vec3::pos_z()));
+    CHECK(brush.fullySpecified());
+  }
+
+  SECTION("Integer faces with non-integer vertices")
+  {
+    faces.push_back(createParaxial(
+      vm::vec3(0.0, 0.0, 1.0), vm::vec3(0.0, 1.0, 1.0), vm::vec3(3.0, 0.0, -1.0)));
+
+    const auto brush = Brush::create(worldBounds, faces).value();
+    CHECK(brush.faceCount() == 5u);
+    CHECK(brush.hasVertex(vm::vec3(1.5, 0, 0)));
+    CHECK(brush.hasVertex(vm::vec3(0, 16, 1)));
+    CHECK(brush.fullySpecified());
+  }
+
+  SECTION("Unbounded brush")
+  {
+    faces.pop_back();
+    CHECK(Brush::create(worldBounds, faces).is_error());
+  }
+}
+
 TEST_CASE("BrushTest.clip")
 {
   const vm::bbox3 worldBounds(4096.0);
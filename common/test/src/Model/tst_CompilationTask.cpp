@@ -0,0 +1,132 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/CompilationTask.h"
+
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Model
+{
+namespace
+{
+CompilationTask makeTask(const bool enabled, CompilationTaskDependencies dependencies)
+{
+  return CompilationDeleteFiles{enabled, "", std::move(dependencies)};
+}
+} // namespace
+
+TEST_CASE("CompilationTask.resolveDependencies")
+{
+  using T = std::vector<CompilationTask>;
+  using R = std::vector<std::vector<size_t>>;
+
+  // clang-format off
+  const auto [tasks, expectedDependencies] = GENERATE(values<std::tuple<T, R>>({
+  // tasks without declared dependencies run one after another
+  {T{makeTask(true, std::nullopt),
+     makeTask(true, std::nullopt),
+     makeTask(true, std::nullopt)},                        R{{}, {0}, {1}}},
+  // declared dependencies
+  {T{makeTask(true, std::nullopt),
+     makeTask(true, std::vector<size_t>{}),
+     makeTask(true, std::vector<size_t>{0, 1})},           R{{}, {}, {0, 1}}},
+  // dependencies on disabled tasks are replaced by their dependencies
+  {T{makeTask(true, std::nullopt),
+     makeTask(false, std::nullopt),
+     makeTask(true, std::nullopt)},                        R{{}, {0}, {0}}},
+  {T{makeTask(true, std::nullopt),
+     makeTask(true, std::vector<size_t>{}),
+     makeTask(false, std::vector<size_t>{0, 1}),
+     makeTask(true, std::vector<size_t>{0, 2})},           R{{}, {}, {0, 1}, {0, 1}}},
+  }));
+  // clang-format on
+
+  CAPTURE(tasks);
+
+  CHECK(resolveDependencies(tasks) == expectedDependencies);
+}
+
+TEST_CASE("CompilationTask.remapDependencies")
+{
+  const auto tasks = std::vector<CompilationTask>{
+    makeTask(true, std::nullopt),
+    makeTask(true, std::vector<size_t>{}),
+    makeTask(true, std::vector<size_t>{0}),
+    makeTask(true, std::vector<size_t>{0, 2}),
+  };
+
+  SECTION("Removing a task")
+  {
+    auto removed = tasks;
+    removed.erase(removed.begin());
+
+    CHECK(
+      remapDependencies(
+        removed,
+        [](const size_t i) -> std::optional<size_t> {
+          return i == 0 ? std::nullopt : std::optional{i - 1};
+        })
+      == std::vector<CompilationTask>{
+        makeTask(true, std::vector<size_t>{}),
+        makeTask(true, std::vector<size_t>{}),
+        makeTask(true, std::vector<size_t>{1}),
+      });
+  }
+
+  SECTION("Swapping tasks")
+  {
+    auto swapped = tasks;
+    std::swap(swapped[2], swapped[3]);
+
+    // task 3 depended on task 2, which is now after it
+    CHECK(
+      remapDependencies(
+        swapped,
+        [](const size_t i) -> std::optional<size_t> {
+          return i == 2 ? 3 : i == 3 ? 2 : i;
+        })
+      == std::vector<CompilationTask>{
+        makeTask(true, std::nullopt),
+        makeTask(true, std::vector<size_t>{}),
+        makeTask(true, std::vector<size_t>{0}),
+        makeTask(true, std::vector<size_t>{0}),
+      });
+  }
+}
+
+TEST_CASE("CompilationTask.taskNumbers")
+{
+  CHECK(taskNumberForIndex(0) == 1u);
+  CHECK(taskNumberForIndex(4) == 5u);
+
+  CHECK(taskIndexForNumber(0) == std::nullopt);
+  CHECK(taskIndexForNumber(1) == 0u);
+  CHECK(taskIndexForNumber(5) == 4u);
+
+  CHECK(taskIndexForNumber(taskNumberForIndex(7)) == 7u);
+}
+} // namespace Model
+} // namespace TrenchBroom
@@ -24,6 +24,7 @@
 #include <kdl/vector_utils.h>
 
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Catch2.h"
@@ -223,5 +224,99 @@ TEST_CASE("EntityNodeIndexTest.allValuesForKeys")
     index.allValuesForKeys(EntityNodeIndexQuery::exact("test")),
     Catch::UnorderedEquals(std::vector<std::string>{"somevalue", "somevalue2"}));
 }
+
+TEST_CASE("EntityNodeIndexTest.allValuesForNumberedKeys")
+{
+  EntityNodeIndex index;
+
+  EntityNode* entity1 = new EntityNode({}, {{"target1", "a"}, {"target2", "b"}});
+
+  EntityNode* entity2 =
+    new EntityNode({}, {{"target", "c"}, {"targetname", "d"}, {"other", "e"}});
+
+  index.addEntityNode(entity1);
+  index.addEntityNode(entity2);
+
+  CHECK_THAT(
+    index.allValuesForKeys(EntityNodeIndexQuery::numbered("target")),
+    Catch::UnorderedEquals(std::vector<std::string>{"a", "b", "c"}));
+  CHECK_THAT(
+    index.allValuesForKeys(EntityNodeIndexQuery::prefix("target")),
+    Catch::UnorderedEquals(std::vector<std::string>{"a", "b", "c", "d"}));
+  CHECK(index.allValuesForKeys(EntityNodeIndexQuery::prefix("xyz")).empty());
+
+  delete entity1;
+  delete entity2;
+}
+
+TEST_CASE("EntityNodeIndexTest.findValueWithWildcards")
+{
+  EntityNodeIndex index;
+
+  EntityNode* entity1 = new EntityNode({}, {{"test", "some*"}});
+  EntityNode* entity2 = new EntityNode({}, {{"test", "somevalue"}});
+
+  index.addEntityNode(entity1);
+  index.addEntityNode(entity2);
+
+  CHECK(findExactExact(index, "test", "some*") == std::vector<EntityNodeBase*>{entity1});
+  CHECK(findExactExact(index, "test", "some").empty());
+
+  delete entity1;
+  delete entity2;
+}
+
+TEST_CASE("EntityNodeIndexTest.removeDuplicateValue")
+{
+  EntityNodeIndex index;
+
+  EntityNode* entity1 = new EntityNode({}, {{"target", "x"}, {"killtarget", "x"}});
+
+  index.addEntityNode(entity1);
+  index.removeProperty(entity1, "killtarget", "x");
+
+  CHECK(findExactExact(index, "target", "x") == std::vector<EntityNodeBase*>{entity1});
+  CHECK_THAT(index.allKeys(), Catch::Equals(std::vector<std::string>{"target"}));
+
+  index.removeEntityNode(entity1);
+  CHECK(findExactExact(index, "target", "x").empty());
+  CHECK(index.allKeys().empty());
+
+  delete entity1;
+}
+
+TEST_CASE("EntityNodeIndexTest.concurrentPrefixQueries")
+{
+  EntityNodeIndex index;
+
+  auto entities = std::vector<EntityNode*>{};
+  for (size_t i = 0; i < 100; ++i)
+  {
+    const auto num = std::to_string(i);
+    entities.push_back(new EntityNode({}, {{"target" + num, "value" + num}}));
+    index.addEntityNode(entities.back());
+  }
+
+  // the sorted key list is invalid now and will be rebuilt by the concurrent queries
+  auto results = std::vector<std::vector<EntityNodeBase*>>(4);
+  auto threads = std::vector<std::thread>{};
+  for (auto& result : results)
+  {
+    threads.emplace_back([&]() {
+      result = index.findEntityNodes(EntityNodeIndexQuery::numbered("target"), "value1");
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (const auto& result : results)
+  {
+    CHECK(result == std::vector<EntityNodeBase*>{entities[1]});
+  }
+
+  kdl::vec_clear_and_delete(entities);
+}
 } // namespace Model
 } // namespace TrenchBroom
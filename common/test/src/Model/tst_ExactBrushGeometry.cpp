@@ -0,0 +1,201 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/ExactBrushGeometry.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/bbox_io.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+const auto worldBounds = vm::bbox3{8192.0};
+
+std::vector<BrushFace> sortedFaces(std::vector<BrushFace> faces)
+{
+  BrushFace::sortFaces(faces);
+  return faces;
+}
+
+std::unique_ptr<BrushGeometry> createClippedBrushGeometry(
+  const std::vector<BrushFace>& faces)
+{
+  auto geometry = std::make_unique<BrushGeometry>(worldBounds);
+  for (size_t i = 0u; i < faces.size(); ++i)
+  {
+    const auto result = geometry->clip(faces[i].boundary());
+    if (result.success())
+    {
+      result.face()->setPayload(i);
+    }
+  }
+
+  geometry->correctVertexPositions();
+  REQUIRE(geometry->healEdges());
+  return geometry;
+}
+
+std::vector<std::optional<size_t>> facePayloads(const BrushGeometry& geometry)
+{
+  auto result = std::vector<std::optional<size_t>>{};
+  for (const auto* face : geometry.faces())
+  {
+    result.push_back(face->payload());
+  }
+  return result;
+}
+
+std::vector<std::vector<vm::vec3>> faceVertexPositions(const BrushGeometry& geometry)
+{
+  auto result = std::vector<std::vector<vm::vec3>>{};
+  for (const auto* face : geometry.faces())
+  {
+    result.push_back(face->vertexPositions());
+  }
+  return result;
+}
+
+std::vector<BrushFace> cuboidFaces(const vm::bbox3& bounds)
+{
+  auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+  return builder.createCuboid(bounds, "texture").value().faces();
+}
+
+} // namespace
+
+TEST_CASE("ExactBrushGeometryTest.axisAlignedBrushes")
+{
+  using T = std::vector<BrushFace>;
+
+  // clang-format off
+  const auto faces = GENERATE(
+    cuboidFaces(vm::bbox3{64.0}),
+    cuboidFaces(vm::bbox3{{-8.5, 16.0, 0.25}, {32.0, 17.0, 1024.0}}),
+    // a redundant face
+    kdl::vec_concat(T{cuboidFaces(vm::bbox3{64.0})[0]}, cuboidFaces(vm::bbox3{64.0})),
+    // a face that is tighter than a preceding face with the same direction
+    kdl::vec_concat(cuboidFaces(vm::bbox3{64.0}), cuboidFaces(vm::bbox3{32.0})),
+    kdl::vec_concat(cuboidFaces(vm::bbox3{32.0}), cuboidFaces(vm::bbox3{64.0})));
+  // clang-format on
+
+  CAPTURE(faces.size());
+
+  const auto sorted = sortedFaces(faces);
+  const auto exact = createExactBrushGeometry(sorted, worldBounds);
+  REQUIRE(exact != nullptr);
+
+  const auto clipped = createClippedBrushGeometry(sorted);
+  CHECK(exact->bounds() == clipped->bounds());
+  CHECK(exact->vertexPositions() == clipped->vertexPositions());
+  CHECK(facePayloads(*exact) == facePayloads(*clipped));
+  CHECK(faceVertexPositions(*exact) == faceVertexPositions(*clipped));
+}
+
+TEST_CASE("ExactBrushGeometryTest.integerBrushes")
+{
+  // clang-format off
+  const auto points = GENERATE(
+    // wedge
+    std::vector<vm::vec3>{
+      {-64, -64, -64}, {64, -64, -64}, {-64, 64, -64}, {64, 64, -64},
+      {-64, -64, 64}, {-64, 64, 64}},
+    // parallelepiped
+    std::vector<vm::vec3>{
+      {0, 0, 0}, {64, 0, 0}, {0, 64, 0}, {64, 64, 0},
+      {32, 0, 64}, {96, 0, 64}, {32, 64, 64}, {96, 64, 64}},
+    // tetrahedron
+    std::vector<vm::vec3>{{0, 0, 0}, {64, 0, 0}, {0, 64, 0}, {0, 0, 64}});
+  // clang-format on
+
+  auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+  const auto sorted = sortedFaces(builder.createBrush(points, "texture").value().faces());
+
+  const auto exact = createExactBrushGeometry(sorted, worldBounds);
+  REQUIRE(exact != nullptr);
+
+  const auto clipped = createClippedBrushGeometry(sorted);
+  CHECK(exact->bounds() == clipped->bounds());
+  CHECK_THAT(
+    exact->vertexPositions(), Catch::UnorderedEquals(clipped->vertexPositions()));
+  CHECK_THAT(facePayloads(*exact), Catch::UnorderedEquals(facePayloads(*clipped)));
+}
+
+TEST_CASE("ExactBrushGeometryTest.ineligibleBrushes")
+{
+  auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  SECTION("Non-integer face points")
+  {
+    const auto points =
+      std::vector<vm::vec3>{{0, 0, 0}, {64.5, 0, 0}, {0, 64, 0}, {0, 0, 64}};
+    const auto faces =
+      sortedFaces(builder.createBrush(points, "texture").value().faces());
+    CHECK(createExactBrushGeometry(faces, worldBounds) == nullptr);
+  }
+
+  SECTION("Integer brush with too many faces")
+  {
+    const auto points = std::vector<vm::vec3>{
+      {-32, -64, -16},
+      {32, -64, -16},
+      {64, -32, -16},
+      {64, 32, -16},
+      {32, 64, -16},
+      {-32, 64, -16},
+      {-64, 32, -16},
+      {-64, -32, -16},
+      {-32, -64, 16},
+      {32, -64, 16},
+      {64, -32, 16},
+      {64, 32, 16},
+      {32, 64, 16},
+      {-32, 64, 16},
+      {-64, 32, 16},
+      {-64, -32, 16}};
+    const auto faces =
+      sortedFaces(builder.createBrush(points, "texture").value().faces());
+    CHECK(createExactBrushGeometry(faces, worldBounds) == nullptr);
+  }
+
+  SECTION("Axis-aligned brush exceeding the world bounds")
+  {
+    const auto faces = sortedFaces(cuboidFaces(vm::bbox3{64.0}));
+    CHECK(createExactBrushGeometry(faces, vm::bbox3{32.0}) == nullptr);
+  }
+}
+
+} // namespace TrenchBroom::Model
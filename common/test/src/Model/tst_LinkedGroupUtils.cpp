@@ -40,7 +40,9 @@
 #include <vecmath/mat_ext.h>
 
 #include <numeric>
+#include <optional>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
 #include "CatchUtils/Matchers.h"
@@ -341,6 +343,315 @@ TEST_CASE("GroupNode.updateLinkedGroupsExceedsWorldBounds")
     });
 }
 
+namespace
+{
+std::vector<Node*> changedNodes(const std::vector<PendingChange>& changes)
+{
+  return kdl::vec_transform(changes, [](const auto& change) -> Node* {
+    return std::visit(
+      kdl::overload(
+        [](const NodeContentsChange& c) { return c.node; },
+        [](const NodeAddition& c) { return c.node; },
+        [](const NodeRemoval& c) { return c.node; }),
+      change);
+  });
+}
+} // namespace
+
+TEST_CASE("GroupNode.updateLinkedNodes")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto groupNode = GroupNode{Group{"name"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* otherEntityNode = new EntityNode{Entity{}};
+  groupNode.addChildren({entityNode, otherEntityNode});
+
+  auto groupNodeClone = std::unique_ptr<GroupNode>{
+    static_cast<GroupNode*>(groupNode.cloneRecursively(worldBounds, SetLinkId::keep))};
+  transformNode(*groupNodeClone, vm::translation_matrix(vm::vec3{0, 2, 0}), worldBounds);
+
+  auto* entityNodeClone = static_cast<EntityNode*>(groupNodeClone->children().front());
+  auto* otherEntityNodeClone = groupNodeClone->children().back();
+  REQUIRE(entityNodeClone->entity().origin() == vm::vec3{0, 2, 0});
+
+  SECTION("Target group list contains only source group")
+  {
+    updateLinkedNodes(
+      groupNode, {NodeContentsChange{entityNode}}, {&groupNode}, worldBounds)
+      .transform([&](const auto& r) {
+        REQUIRE(r.has_value());
+        CHECK(r->nodesToRemove.empty());
+        CHECK(r->nodesToAdd.empty());
+        CHECK(r->nodesToUpdate.empty());
+      })
+      .transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Update a changed node")
+  {
+    transformNode(*entityNode, vm::translation_matrix(vm::vec3{0, 0, 3}), worldBounds);
+
+    auto entity = entityNode->entity();
+    entity.setProtectedProperties({"some_key"});
+    entityNode->setEntity(std::move(entity));
+
+    auto entityClone = entityNodeClone->entity();
+    entityClone.addOrUpdateProperty({}, "some_key", "some_value");
+    entityNodeClone->setEntity(std::move(entityClone));
+
+    // the same node changed twice is updated once
+    const auto changes = std::vector<PendingChange>{
+      NodeContentsChange{entityNode}, NodeContentsChange{entityNode}};
+
+    updateLinkedNodes(groupNode, changes, {groupNodeClone.get()}, worldBounds)
+      .transform([&](const auto& r) {
+        REQUIRE(r.has_value());
+        CHECK(r->nodesToRemove.empty());
+        CHECK(r->nodesToAdd.empty());
+        REQUIRE(r->nodesToUpdate.size() == 1u);
+
+        const auto& [nodeToUpdate, newContents] = r->nodesToUpdate.front();
+        CHECK(nodeToUpdate == entityNodeClone);
+
+        const auto& newEntity = std::get<Entity>(newContents.get());
+        CHECK(newEntity.origin() == vm::vec3{0, 2, 3});
+        CHECK(newEntity.protectedProperties().empty());
+        CHECK(
+          newEntity.properties()
+          == std::vector<EntityProperty>{
+            {"origin", "0 2 3"}, {"some_key", "some_value"}});
+      })
+      .transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Add a node")
+  {
+    auto* newEntityNode = new EntityNode{Entity{}};
+    groupNode.addChild(newEntityNode);
+    transformNode(*newEntityNode, vm::translation_matrix(vm::vec3{0, 0, 3}), worldBounds);
+
+    // changes to the added node are already accounted for by cloning it
+    const auto changes = std::vector<PendingChange>{
+      NodeAddition{&groupNode, newEntityNode}, NodeContentsChange{newEntityNode}};
+
+    updateLinkedNodes(groupNode, changes, {groupNodeClone.get()}, worldBounds)
+      .transform([&](const auto& r) {
+        REQUIRE(r.has_value());
+        CHECK(r->nodesToRemove.empty());
+        CHECK(r->nodesToUpdate.empty());
+        REQUIRE(r->nodesToAdd.size() == 1u);
+
+        const auto& [parent, nodeToAdd] = r->nodesToAdd.front();
+        CHECK(parent == groupNodeClone.get());
+
+        const auto* entityNodeToAdd = dynamic_cast<const EntityNode*>(nodeToAdd.get());
+        REQUIRE(entityNodeToAdd != nullptr);
+        CHECK(entityNodeToAdd->entity().origin() == vm::vec3{0, 2, 3});
+        CHECK(entityNodeToAdd->entity().linkId() == newEntityNode->entity().linkId());
+      })
+      .transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Remove a node")
+  {
+    const auto changes = std::vector<PendingChange>{
+      NodeRemoval{&groupNode, otherEntityNode, getLinkId(*otherEntityNode)}};
+    groupNode.removeChild(otherEntityNode);
+    auto removedEntityNode = std::unique_ptr<Node>{otherEntityNode};
+
+    updateLinkedNodes(groupNode, changes, {groupNodeClone.get()}, worldBounds)
+      .transform([&](const auto& r) {
+        REQUIRE(r.has_value());
+        CHECK(r->nodesToAdd.empty());
+        CHECK(r->nodesToUpdate.empty());
+        CHECK(
+          r->nodesToRemove
+          == std::vector<std::pair<Node*, Node*>>{
+            {groupNodeClone.get(), otherEntityNodeClone}});
+      })
+      .transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Changes that cannot be replayed")
+  {
+    SECTION("Removed node is missing in target group")
+    {
+      const auto changes = std::vector<PendingChange>{
+        NodeRemoval{&groupNode, otherEntityNode, getLinkId(*otherEntityNode)}};
+      groupNodeClone->removeChild(otherEntityNodeClone);
+      auto removedEntityNodeClone = std::unique_ptr<Node>{otherEntityNodeClone};
+
+      updateLinkedNodes(groupNode, changes, {groupNodeClone.get()}, worldBounds)
+        .transform([&](const auto& r) { CHECK_FALSE(r.has_value()); })
+        .transform_error([](const auto&) { FAIL(); });
+    }
+
+    SECTION("Added node already exists in target group")
+    {
+      auto* newEntityNode = new EntityNode{Entity{}};
+      groupNode.addChild(newEntityNode);
+      groupNodeClone->addChild(
+        newEntityNode->cloneRecursively(worldBounds, SetLinkId::keep));
+
+      const auto changes =
+        std::vector<PendingChange>{NodeAddition{&groupNode, newEntityNode}};
+
+      updateLinkedNodes(groupNode, changes, {groupNodeClone.get()}, worldBounds)
+        .transform([&](const auto& r) { CHECK_FALSE(r.has_value()); })
+        .transform_error([](const auto&) { FAIL(); });
+    }
+
+    SECTION("Changed node is not a descendant of the source group")
+    {
+      auto entityNodeOutsideGroup = EntityNode{Entity{}};
+
+      const auto changes =
+        std::vector<PendingChange>{NodeContentsChange{&entityNodeOutsideGroup}};
+
+      updateLinkedNodes(groupNode, changes, {groupNodeClone.get()}, worldBounds)
+        .transform([&](const auto& r) { CHECK_FALSE(r.has_value()); })
+        .transform_error([](const auto&) { FAIL(); });
+    }
+  }
+
+  SECTION("Updating a linked node would exceed world bounds")
+  {
+    transformNode(
+      *entityNode, vm::translation_matrix(vm::vec3{0, 8192 - 8, 0}), worldBounds);
+
+    updateLinkedNodes(
+      groupNode, {NodeContentsChange{entityNode}}, {groupNodeClone.get()}, worldBounds)
+      .transform([](const auto&) { FAIL(); })
+      .transform_error([](auto e) {
+        CHECK(e == Error{"Updating a linked node would exceed world bounds"});
+      });
+  }
+}
+
+TEST_CASE("GroupNode.addPendingChanges")
+{
+  auto groupNode = GroupNode{Group{"name"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushEntityNode = new EntityNode{Entity{}};
+  auto brushBuilder = BrushBuilder{MapFormat::Quake3, vm::bbox3{8192.0}};
+  auto* brushNode = new BrushNode{brushBuilder.createCube(64.0, "texture").value()};
+
+  groupNode.addChildren({entityNode, brushEntityNode});
+  brushEntityNode->addChild(brushNode);
+
+  REQUIRE_FALSE(groupNode.hasPendingChanges());
+  REQUIRE(groupNode.pendingChanges().has_value());
+  REQUIRE(groupNode.pendingChanges()->empty());
+
+  SECTION("Records changes in order")
+  {
+    groupNode.addPendingChanges({NodeContentsChange{entityNode}});
+    groupNode.addPendingChanges({NodeContentsChange{brushNode}});
+    CHECK(groupNode.hasPendingChanges());
+    CHECK(
+      changedNodes(*groupNode.pendingChanges())
+      == std::vector<Node*>{entityNode, brushNode});
+  }
+
+  SECTION("Removing a node discards the changes to it and its descendants")
+  {
+    groupNode.addPendingChanges({
+      NodeContentsChange{entityNode},
+      NodeContentsChange{brushNode},
+      NodeContentsChange{brushEntityNode},
+    });
+    groupNode.addPendingChanges(
+      {NodeRemoval{&groupNode, brushEntityNode, getLinkId(*brushEntityNode)}});
+    CHECK(
+      changedNodes(*groupNode.pendingChanges())
+      == std::vector<Node*>{entityNode, brushEntityNode});
+  }
+
+  SECTION("Adding and removing a node cancel out")
+  {
+    auto* newEntityNode = new EntityNode{Entity{}};
+    groupNode.addChild(newEntityNode);
+
+    groupNode.addPendingChanges({NodeAddition{&groupNode, newEntityNode}});
+    groupNode.addPendingChanges({NodeContentsChange{newEntityNode}});
+    groupNode.addPendingChanges(
+      {NodeRemoval{&groupNode, newEntityNode, getLinkId(*newEntityNode)}});
+    CHECK(groupNode.hasPendingChanges());
+    REQUIRE(groupNode.pendingChanges().has_value());
+    CHECK(groupNode.pendingChanges()->empty());
+  }
+
+  SECTION("Unrecorded changes")
+  {
+    groupNode.addPendingChanges({NodeContentsChange{entityNode}});
+    groupNode.setHasPendingChanges(true);
+    CHECK_FALSE(groupNode.pendingChanges().has_value());
+
+    groupNode.addPendingChanges({NodeContentsChange{entityNode}});
+    CHECK_FALSE(groupNode.pendingChanges().has_value());
+
+    groupNode.setHasPendingChanges(false);
+    CHECK_FALSE(groupNode.hasPendingChanges());
+    REQUIRE(groupNode.pendingChanges().has_value());
+    CHECK(groupNode.pendingChanges()->empty());
+  }
+}
+
+TEST_CASE("GroupNode.collectPendingChanges")
+{
+  auto outerGroupNode = GroupNode{Group{"outer"}};
+  auto* innerGroupNode = new GroupNode{Group{"inner"}};
+  auto* outerEntityNode = new EntityNode{Entity{}};
+  auto* innerEntityNode = new EntityNode{Entity{}};
+
+  outerGroupNode.addChildren({innerGroupNode, outerEntityNode});
+  innerGroupNode->addChild(innerEntityNode);
+
+  CHECK_FALSE(collectPendingChanges(outerGroupNode).has_value());
+
+  outerGroupNode.addPendingChanges({NodeContentsChange{outerEntityNode}});
+  innerGroupNode->addPendingChanges({NodeContentsChange{innerEntityNode}});
+  CHECK(outerGroupNode.hasPendingChanges());
+
+  const auto changes = collectPendingChanges(outerGroupNode);
+  REQUIRE(changes.has_value());
+  CHECK(changedNodes(*changes) == std::vector<Node*>{outerEntityNode, innerEntityNode});
+
+  SECTION("Nested additions and removals are not collected")
+  {
+    auto* newEntityNode = new EntityNode{Entity{}};
+    innerGroupNode->addChild(newEntityNode);
+    innerGroupNode->addPendingChanges({NodeAddition{innerGroupNode, newEntityNode}});
+
+    CHECK_FALSE(collectPendingChanges(outerGroupNode).has_value());
+  }
+
+  SECTION("Changes of added nested groups are not collected")
+  {
+    auto* newGroupNode = new GroupNode{Group{"new"}};
+    auto* newEntityNode = new EntityNode{Entity{}};
+    outerGroupNode.addChild(newGroupNode);
+    outerGroupNode.addPendingChanges({NodeAddition{&outerGroupNode, newGroupNode}});
+
+    newGroupNode->addChild(newEntityNode);
+    newGroupNode->addPendingChanges({NodeAddition{newGroupNode, newEntityNode}});
+
+    const auto changesWithAddition = collectPendingChanges(outerGroupNode);
+    REQUIRE(changesWithAddition.has_value());
+    CHECK(
+      changedNodes(*changesWithAddition)
+      == std::vector<Node*>{outerEntityNode, newGroupNode, innerEntityNode});
+  }
+
+  SECTION("Unrecorded nested changes are not collected")
+  {
+    innerGroupNode->setHasPendingChanges(true);
+
+    CHECK_FALSE(collectPendingChanges(outerGroupNode).has_value());
+  }
+}
+
 static void setGroupName(GroupNode& groupNode, const std::string& name)
 {
   auto group = groupNode.group();
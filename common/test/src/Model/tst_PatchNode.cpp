@@ -31,6 +31,10 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace vm
@@ -167,6 +171,108 @@ TEST_CASE("PatchNode.makePatchGrid")
     == kdl::vec_transform(expectedPoints, [](const auto& p) { return vm::approx{p}; }));
 }
 
+TEST_CASE("PatchNode.computeSubdivisionsPerSurface")
+{
+  using P = BezierPatch::Point;
+  using T = std::tuple<size_t, size_t, std::vector<P>, SubdivisionsPerSurface>;
+
+  // clang-format off
+  const auto
+  [r, c, controlPoints, expectedSubdivisions] = GENERATE(values<T>({
+  {3, 3, // flat surface
+    {P{0.0, 2.0, 0.0, 0.0, 0.0}, P{1.0, 2.0, 0.0, 0.5, 0.0}, P{2.0, 2.0, 0.0, 1.0, 0.0},
+     P{0.0, 1.0, 0.0, 0.0, 0.5}, P{1.0, 1.0, 0.0, 0.5, 0.5}, P{2.0, 1.0, 0.0, 1.0, 0.5},
+     P{0.0, 0.0, 0.0, 0.0, 1.0}, P{1.0, 0.0, 0.0, 0.5, 1.0}, P{2.0, 0.0, 0.0, 1.0, 1.0}},
+    {0u, 0u}},
+  {3, 3, // flat surface with curved texture coordinates
+    {P{0.0, 2.0, 0.0, 0.0, 0.0}, P{1.0, 2.0, 0.0, 0.25, 0.0}, P{2.0, 2.0, 0.0, 1.0, 0.0},
+     P{0.0, 1.0, 0.0, 0.0, 0.5}, P{1.0, 1.0, 0.0, 0.25, 0.5}, P{2.0, 1.0, 0.0, 1.0, 0.5},
+     P{0.0, 0.0, 0.0, 0.0, 1.0}, P{1.0, 0.0, 0.0, 0.25, 1.0}, P{2.0, 0.0, 0.0, 1.0, 1.0}},
+    {0u, 3u}},
+  {3, 3, // slightly curved along the columns
+    {P{0.0, 2.0, 0.0, 0.0, 0.0}, P{1.0, 2.0, 0.0, 0.5, 0.0}, P{2.0, 2.0, 0.0, 1.0, 0.0},
+     P{0.0, 1.0, 1.0, 0.0, 0.5}, P{1.0, 1.0, 1.0, 0.5, 0.5}, P{2.0, 1.0, 1.0, 1.0, 0.5},
+     P{0.0, 0.0, 0.0, 0.0, 1.0}, P{1.0, 0.0, 0.0, 0.5, 1.0}, P{2.0, 0.0, 0.0, 1.0, 1.0}},
+    {2u, 0u}},
+  {3, 3, // strongly curved along the rows
+    {P{0.0, 2.0, 0.0, 0.0, 0.0}, P{1.0, 2.0, 64.0, 0.5, 0.0}, P{2.0, 2.0, 0.0, 1.0, 0.0},
+     P{0.0, 1.0, 0.0, 0.0, 0.5}, P{1.0, 1.0, 64.0, 0.5, 0.5}, P{2.0, 1.0, 0.0, 1.0, 0.5},
+     P{0.0, 0.0, 0.0, 0.0, 1.0}, P{1.0, 0.0, 64.0, 0.5, 1.0}, P{2.0, 0.0, 0.0, 1.0, 1.0}},
+    {0u, MaxSubdivisionsPerSurface}},
+  }));
+  // clang-format on
+
+  CAPTURE(r, c, controlPoints);
+  const auto patch = BezierPatch{r, c, controlPoints, "texture"};
+  CHECK(computeSubdivisionsPerSurface(patch) == expectedSubdivisions);
+
+  const auto grid = makePatchGrid(patch, expectedSubdivisions);
+  CHECK(grid.pointRowCount == (size_t(1) << expectedSubdivisions.first) + 1u);
+  CHECK(grid.pointColumnCount == (size_t(1) << expectedSubdivisions.second) + 1u);
+}
+
+TEST_CASE("PatchNode.makeAdaptivePatchGrid")
+{
+  using P = BezierPatch::Point;
+
+  // Two patches which share the curve from (0, 0, 0) to (2, 0, 0). The first patch is
+  // more curved along it than the second, so it subdivides its surface more often in
+  // that direction. The second patch traverses the curve in the opposite direction.
+
+  // clang-format off
+  const auto patch1 = BezierPatch{3, 3, {
+    P{0, 0, 0, 0.0, 0.0}, P{1, 0, 0.5, 0.5, 0.0}, P{2, 0, 0, 1.0, 0.0},
+    P{0, 1, 0, 0.0, 0.5}, P{1, 1, 8.0, 0.5, 0.5}, P{2, 1, 0, 1.0, 0.5},
+    P{0, 2, 0, 0.0, 1.0}, P{1, 2, 0.0, 0.5, 1.0}, P{2, 2, 0, 1.0, 1.0}}, "texture"};
+
+  const auto patch2 = BezierPatch{3, 3, {
+    P{2, 0, 0.0, 0.0, 0.0}, P{2, -1, 0, 0.0, 0.5}, P{2, -2, 0, 0.0, 1.0},
+    P{1, 0, 0.5, 0.5, 0.0}, P{1, -1, 2, 0.5, 0.5}, P{1, -2, 0, 0.5, 1.0},
+    P{0, 0, 0.0, 1.0, 0.0}, P{0, -1, 0, 1.0, 0.5}, P{0, -2, 0, 1.0, 1.0}}, "texture"};
+  // clang-format on
+
+  REQUIRE(computeSubdivisionsPerSurface(patch1).second == 3u);
+  REQUIRE(computeSubdivisionsPerSurface(patch2).first == 2u);
+
+  const auto grid1 = makeAdaptivePatchGrid(patch1);
+  const auto grid2 = makeAdaptivePatchGrid(patch2);
+
+  const auto distinctPositions = [](std::vector<vm::vec3> positions) {
+    positions.erase(
+      std::unique(std::begin(positions), std::end(positions)), std::end(positions));
+    return positions;
+  };
+
+  auto edge1 = std::vector<vm::vec3>{};
+  for (size_t col = 0u; col < grid1.pointColumnCount; ++col)
+  {
+    edge1.push_back(grid1.point(0u, col).position);
+  }
+
+  auto edge2 = std::vector<vm::vec3>{};
+  for (size_t row = grid2.pointRowCount; row > 0u; --row)
+  {
+    edge2.push_back(grid2.point(row - 1u, 0u).position);
+  }
+
+  CHECK(edge1.size() == 9u);
+  CHECK(edge2.size() == 5u);
+  CHECK(
+    distinctPositions(edge1)
+    == std::vector<vm::vec3>{{0, 0, 0}, {1, 0, 0.25}, {2, 0, 0}});
+  CHECK(distinctPositions(edge1) == distinctPositions(edge2));
+
+  // the interior of the patch is not affected
+  const auto uniformGrid1 = makePatchGrid(patch1, computeSubdivisionsPerSurface(patch1));
+  for (size_t row = 1u; row + 1u < grid1.pointRowCount; ++row)
+  {
+    for (size_t col = 1u; col + 1u < grid1.pointColumnCount; ++col)
+    {
+      CHECK(grid1.point(row, col) == uniformGrid1.point(row, col));
+    }
+  }
+}
+
 TEST_CASE("PatchNode.pickFlatPatch")
 {
   using P = BezierPatch::Point;
@@ -21,10 +21,13 @@
 #include "IO/DiskIO.h"
 #include "Model/PortalFile.h"
 
+#include <kdl/result.h>
+
 #include <vecmath/polygon.h>
 
 #include <filesystem>
 #include <memory>
+#include <sstream>
 
 #include "Catch2.h"
 
@@ -40,6 +43,16 @@ TEST_CASE("PortalFileTest.parseInvalidPRT1")
         }).is_error());
 }
 
+TEST_CASE("PortalFileTest.parseInvalidLeafIndex")
+{
+  auto stream = std::istringstream{R"(PRT1
+2
+1
+4 0 2 (0 0 0) (0 100 0) (0 100 100) (0 0 100)
+)"};
+  CHECK(Model::loadPortalFile(stream).is_error());
+}
+
 static const std::vector<vm::polygon3f> ExpectedPortals{
   {{-96, -32, 80}, {-96, 160, 80}, {0, 160, 80}, {0, -32, 80}},
   {{208, -64, 80}, {64, -64, 80}, {64, 160, 80}, {208, 160, 80}},
@@ -64,12 +77,11 @@ static const std::vector<vm::polygon3f> ExpectedPortals{
 TEST_CASE("PortalFileTest.parsePRT1")
 {
   const auto path = "fixture/test/Model/PortalFile/portaltest_prt1.prt";
-  CHECK(
-    IO::Disk::withInputStream(
-      path, [](auto& stream) { return Model::loadPortalFile(stream); })
-      .value()
-      .portals()
-    == ExpectedPortals);
+  const auto portalFile = IO::Disk::withInputStream(path, [](auto& stream) {
+                            return Model::loadPortalFile(stream);
+                          }).value();
+  CHECK(portalFile.portals() == ExpectedPortals);
+  CHECK(portalFile.leafCount() == 6u);
 }
 
 TEST_CASE("PortalFileTest.parsePRT1Q3")
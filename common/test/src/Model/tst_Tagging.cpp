@@ -20,15 +20,20 @@
 #include "Error.h"
 #include "Exceptions.h"
 #include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
 #include "Model/LayerNode.h"
 #include "Model/MapFormat.h"
 #include "Model/Tag.h"
 #include "Model/TagManager.h"
+#include "Model/TagMatcher.h"
 #include "Model/WorldNode.h"
 
 #include <kdl/result.h>
 
+#include <string>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
@@ -67,5 +72,67 @@ TEST_CASE("TaggingTest.testTagBrush")
   CHECK_FALSE(brushNode->hasTag(tag1));
   CHECK_FALSE(brushNode->hasTag(tag2));
 }
+
+TEST_CASE("TaggingTest.nameMatchCache")
+{
+  auto matchedNames = std::vector<std::string>{};
+  const auto match = [&](const std::string_view name) {
+    matchedNames.emplace_back(name);
+    return name.front() == 'a';
+  };
+
+  auto cache = NameMatchCache{};
+  CHECK(cache.matches("abc", match));
+  CHECK_FALSE(cache.matches("xyz", match));
+  CHECK(cache.matches("abc", match));
+  CHECK_FALSE(cache.matches("xyz", match));
+  CHECK(matchedNames == std::vector<std::string>{"abc", "xyz"});
+
+  // copies start with an empty cache
+  const auto copy = NameMatchCache{cache};
+  CHECK(copy.matches("abc", match));
+  CHECK(matchedNames == std::vector<std::string>{"abc", "xyz", "abc"});
+}
+
+TEST_CASE("TaggingTest.textureNameTagMatcher")
+{
+  const vm::bbox3 worldBounds{4096.0};
+  WorldNode world{{}, {}, MapFormat::Standard};
+
+  BrushBuilder builder{MapFormat::Standard, worldBounds};
+  BrushNode* brushNode = new BrushNode(
+    builder.createCube(64.0, "left", "clip", "front", "back", "top", "e1u1/clip")
+      .value());
+  world.defaultLayer()->addChild(brushNode);
+
+  auto tagManager = TagManager{};
+  tagManager.registerSmartTags({
+    SmartTag{"clip", {}, std::make_unique<TextureNameTagMatcher>("clip")},
+  });
+  const auto& tag = tagManager.smartTag("clip");
+
+  const auto getTaggedTextureNames = [&]() {
+    auto result = std::vector<std::string>{};
+    for (const auto& face : brushNode->brush().faces())
+    {
+      if (face.hasTag(tag))
+      {
+        result.push_back(face.attributes().textureName());
+      }
+    }
+    return result;
+  };
+
+  brushNode->initializeTags(tagManager);
+  CHECK_THAT(
+    getTaggedTextureNames(),
+    Catch::UnorderedEquals(std::vector<std::string>{"clip", "e1u1/clip"}));
+
+  // the second pass uses the memoized results
+  brushNode->updateTags(tagManager);
+  CHECK_THAT(
+    getTaggedTextureNames(),
+    Catch::UnorderedEquals(std::vector<std::string>{"clip", "e1u1/clip"}));
+}
 } // namespace Model
 } // namespace TrenchBroom
@@ -24,6 +24,9 @@
 #include "Model/ParaxialTexCoordSystem.h"
 
 #include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <vector>
 
 #include "Catch2.h"
 
@@ -57,5 +60,35 @@ TEST_CASE("TexCoordSystemTest.testSnapshotTypeSafety")
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
+
+TEST_CASE("TexCoordSystemTest.getTexCoordProjection")
+{
+  auto attribs = BrushFaceAttributes{""};
+  attribs.setOffset({12.0f, -7.0f});
+  attribs.setScale({0.5f, 2.0f});
+
+  const auto textureSize = vm::vec2f{64.0f, 128.0f};
+  const auto points = std::vector<vm::vec3>{
+    {0.0, 0.0, 0.0}, {32.0, -16.0, 8.0}, {-128.0, 64.0, 256.0}, {1.5, 2.5, -3.5}};
+
+  const auto paraxial = ParaxialTexCoordSystem{vm::vec3::pos_z(), attribs};
+  const auto parallel = ParallelTexCoordSystem{
+    vm::vec3{0, 0, 0}, vm::vec3{64, 0, 0}, vm::vec3{0, 64, 16}, attribs};
+
+  for (const TexCoordSystem* texCoordSystem :
+       std::vector<const TexCoordSystem*>{&paraxial, &parallel})
+  {
+    const auto projection = texCoordSystem->getTexCoordProjection(attribs, textureSize);
+    const auto texCoords = projection(points);
+
+    REQUIRE(texCoords.size() == points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      const auto expected = texCoordSystem->getTexCoords(points[i], attribs, textureSize);
+      CHECK(projection(points[i]) == expected);
+      CHECK(texCoords[i] == expected);
+    }
+  }
+}
 } // namespace Model
 } // namespace TrenchBroom
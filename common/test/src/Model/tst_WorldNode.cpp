@@ -30,7 +30,7 @@
 #include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
 #include "TestUtils.h"
-#include "octree.h"
+#include "aabb_tree.h"
 
 #include <kdl/result.h>
 #include <kdl/result_io.h>
@@ -323,6 +323,105 @@ TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.batchNodeTreeUpdates")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+
+  const auto& nodeTree = worldNode.nodeTree();
+
+  SECTION("Added nodes are inserted when the batch is committed")
+  {
+    worldNode.batchNodeTreeUpdates([&]() {
+      worldNode.defaultLayer()->addChild(entityNode);
+      worldNode.defaultLayer()->addChild(groupNode);
+      groupNode->addChild(brushNode);
+
+      CHECK_FALSE(nodeTree.contains(entityNode));
+      CHECK_FALSE(nodeTree.contains(brushNode));
+    });
+
+    CHECK_FALSE(nodeTree.contains(groupNode));
+    CHECK(nodeTree.contains(entityNode));
+    CHECK(nodeTree.contains(brushNode));
+  }
+
+  SECTION("Nested batches are committed by the outermost batch")
+  {
+    worldNode.beginNodeTreeBatch();
+    worldNode.batchNodeTreeUpdates(
+      [&]() { worldNode.defaultLayer()->addChild(entityNode); });
+    CHECK_FALSE(nodeTree.contains(entityNode));
+
+    worldNode.commitNodeTreeBatch();
+    CHECK(nodeTree.contains(entityNode));
+  }
+
+  SECTION("Nodes added and removed within a batch are never inserted")
+  {
+    worldNode.defaultLayer()->addChild(groupNode);
+    worldNode.batchNodeTreeUpdates([&]() {
+      groupNode->addChild(brushNode);
+      groupNode->removeChild(brushNode);
+    });
+
+    CHECK_FALSE(nodeTree.contains(brushNode));
+  }
+
+  SECTION("Nodes removed and added again within a batch are updated")
+  {
+    worldNode.defaultLayer()->addChild(groupNode);
+    groupNode->addChild(brushNode);
+    REQUIRE(nodeTree.contains(brushNode));
+
+    worldNode.batchNodeTreeUpdates([&]() {
+      groupNode->removeChild(brushNode);
+      worldNode.defaultLayer()->addChild(brushNode);
+      transformNode(
+        *brushNode, vm::translation_matrix(vm::vec3{256, 0, 0}), worldBounds);
+    });
+
+    CHECK(nodeTree.contains(brushNode));
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3{256, 0, 0}),
+      Catch::UnorderedEquals(std::vector<Node*>{brushNode}));
+  }
+
+  SECTION("Nodes whose bounds change are updated when the batch is committed")
+  {
+    worldNode.defaultLayer()->addChild(brushNode);
+
+    worldNode.batchNodeTreeUpdates([&]() {
+      transformNode(
+        *brushNode, vm::translation_matrix(vm::vec3{256, 0, 0}), worldBounds);
+      transformNode(
+        *brushNode, vm::translation_matrix(vm::vec3{0, 256, 0}), worldBounds);
+
+      CHECK_THAT(
+        nodeTree.find_containers(vm::vec3::zero()),
+        Catch::UnorderedEquals(std::vector<Node*>{brushNode}));
+    });
+
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3{256, 256, 0}),
+      Catch::UnorderedEquals(std::vector<Node*>{brushNode}));
+  }
+
+  for (auto* node : std::vector<Node*>{groupNode, entityNode, brushNode})
+  {
+    if (!node->parent())
+    {
+      delete node;
+    }
+  }
+}
+
 TEST_CASE("WorldNodeTest.persistentIdOfDefaultLayer")
 {
   auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
@@ -0,0 +1,148 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+#include "Renderer/BrushRenderer.h"
+#include "Renderer/BrushRendererBrushCache.h"
+#include "Renderer/GLVertex.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+// more than the number of brushes that BrushRenderer validates in parallel
+constexpr auto BrushCount = size_t(300);
+
+std::vector<std::unique_ptr<Model::BrushNode>> makeBrushNodes(
+  const std::vector<std::unique_ptr<Assets::Texture>>& textures)
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  auto builder = Model::BrushBuilder{Model::MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<std::unique_ptr<Model::BrushNode>>{};
+  auto textureIndex = size_t(0);
+  for (size_t i = 0; i < BrushCount; ++i)
+  {
+    const auto min = vm::vec3{double(i % 16u) * 64.0, double(i / 16u) * 64.0, 0.0};
+    const auto max = min + vm::vec3{32.0, 48.0, double(16u + i % 7u * 8u)};
+    auto brush = builder.createCuboid(vm::bbox3{min, max}, "").value();
+    for (auto& face : brush.faces())
+    {
+      face.setTexture(textures[textureIndex++ % textures.size()].get());
+    }
+    result.push_back(std::make_unique<Model::BrushNode>(std::move(brush)));
+  }
+  return result;
+}
+
+void checkSameVertexCache(
+  const Model::BrushNode& brushNode, const Model::BrushNode& expectedBrushNode)
+{
+  const auto& cache = brushNode.brushRendererBrushCache();
+  const auto& expectedCache = expectedBrushNode.brushRendererBrushCache();
+
+  const auto& vertices = cache.cachedVertices();
+  const auto& expectedVertices = expectedCache.cachedVertices();
+  REQUIRE(vertices.size() == expectedVertices.size());
+  for (size_t i = 0; i < vertices.size(); ++i)
+  {
+    const auto& vertex = vertices[i];
+    const auto& expectedVertex = expectedVertices[i];
+    CHECK(getVertexComponent<0>(vertex) == getVertexComponent<0>(expectedVertex));
+    CHECK(getVertexComponent<1>(vertex) == getVertexComponent<1>(expectedVertex));
+    CHECK(getVertexComponent<2>(vertex) == getVertexComponent<2>(expectedVertex));
+  }
+
+  const auto& faces = cache.cachedFacesSortedByTexture();
+  const auto& expectedFaces = expectedCache.cachedFacesSortedByTexture();
+  REQUIRE(faces.size() == expectedFaces.size());
+  for (size_t i = 0; i < faces.size(); ++i)
+  {
+    CHECK(faces[i].texture == expectedFaces[i].texture);
+    CHECK(faces[i].vertexCount == expectedFaces[i].vertexCount);
+    CHECK(
+      faces[i].indexOfFirstVertexRelativeToBrush
+      == expectedFaces[i].indexOfFirstVertexRelativeToBrush);
+  }
+
+  const auto& edges = cache.cachedEdges();
+  const auto& expectedEdges = expectedCache.cachedEdges();
+  REQUIRE(edges.size() == expectedEdges.size());
+  for (size_t i = 0; i < edges.size(); ++i)
+  {
+    const auto& edge = edges[i];
+    const auto& expectedEdge = expectedEdges[i];
+    CHECK(edge.vertexIndex1RelativeToBrush == expectedEdge.vertexIndex1RelativeToBrush);
+    CHECK(edge.vertexIndex2RelativeToBrush == expectedEdge.vertexIndex2RelativeToBrush);
+  }
+}
+} // namespace
+
+TEST_CASE("BrushRendererTest.parallelValidation")
+{
+  auto textures = std::vector<std::unique_ptr<Assets::Texture>>{};
+  for (size_t i = 0; i < 5u; ++i)
+  {
+    textures.push_back(
+      std::make_unique<Assets::Texture>("texture " + std::to_string(i), 64, 64));
+  }
+
+  const auto parallelBrushNodes = makeBrushNodes(textures);
+  const auto serialBrushNodes = makeBrushNodes(textures);
+
+  auto parallelRenderer = BrushRenderer{};
+  auto serialRenderer = BrushRenderer{};
+  serialRenderer.setParallelValidation(false);
+
+  for (size_t i = 0; i < BrushCount; ++i)
+  {
+    parallelRenderer.addBrush(parallelBrushNodes[i].get());
+    serialRenderer.addBrush(serialBrushNodes[i].get());
+  }
+
+  parallelRenderer.validate();
+  serialRenderer.validate();
+  CHECK(parallelRenderer.valid());
+  CHECK(serialRenderer.valid());
+
+  for (size_t i = 0; i < BrushCount; ++i)
+  {
+    checkSameVertexCache(*parallelBrushNodes[i], *serialBrushNodes[i]);
+  }
+}
+
+} // namespace TrenchBroom::Renderer
@@ -0,0 +1,132 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/BrushRendererArrays.h"
+#include "Renderer/GLVertexType.h"
+#include "Renderer/VboHolder.h"
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+TEST_CASE("VboHolderTest.memorySize")
+{
+  const auto initialMemorySize = vboHolderMemorySize();
+
+  SECTION("Retaining a snapshot")
+  {
+    auto holder = IndexHolder{VboSnapshotPolicy::Retain};
+    CHECK(holder.memorySize() == 0u);
+
+    holder.resize(16);
+    CHECK(holder.size() == 16u);
+    CHECK(holder.memorySize() == 16u * sizeof(GLuint));
+    CHECK(vboHolderMemorySize() == initialMemorySize + 16u * sizeof(GLuint));
+
+    *holder.getPointerToWriteElementsTo(2, 1) = 7;
+    CHECK(holder.memorySize() == 16u * sizeof(GLuint));
+    CHECK_FALSE(holder.prepared());
+  }
+
+  SECTION("Discarding the snapshot")
+  {
+    auto holder = IndexHolder{VboSnapshotPolicy::Discard};
+    holder.resize(16);
+    CHECK(holder.size() == 16u);
+    CHECK(holder.memorySize() == 0u);
+    CHECK(vboHolderMemorySize() == initialMemorySize);
+
+    auto* dest = holder.getPointerToWriteElementsTo(2, 4);
+    std::fill(dest, dest + 4, 7u);
+    holder.zeroRange(8, 2);
+    CHECK(holder.memorySize() == 6u * sizeof(GLuint));
+    CHECK(vboHolderMemorySize() == initialMemorySize + 6u * sizeof(GLuint));
+    CHECK_FALSE(holder.prepared());
+  }
+
+  SECTION("Moving elements into a holder")
+  {
+    using Vertex = GLVertexTypes::P3::Vertex;
+    auto vertices = std::vector<Vertex>{
+      Vertex{vm::vec3f{0, 0, 0}}, Vertex{vm::vec3f{1, 0, 0}}, Vertex{vm::vec3f{0, 1, 0}}};
+
+    const auto holder = VertexHolder<Vertex>::swap(vertices);
+    CHECK(vertices.empty());
+    CHECK(holder->size() == 3u);
+    CHECK(holder->memorySize() == 3u * sizeof(Vertex));
+  }
+
+  CHECK(vboHolderMemorySize() == initialMemorySize);
+}
+TEST_CASE("VboHolderTest.mergeVboWrites")
+{
+  using Write = VboWrite<GLuint>;
+
+  const auto toPairs = [](const std::vector<Write>& writes) {
+    auto result = std::vector<std::pair<size_t, std::vector<GLuint>>>{};
+    for (const auto& write : writes)
+    {
+      result.emplace_back(write.pos, write.elements);
+    }
+    return result;
+  };
+
+  using T = std::vector<std::pair<size_t, std::vector<GLuint>>>;
+
+  SECTION("Disjoint writes are sorted, but not merged")
+  {
+    CHECK(
+      toPairs(mergeVboWrites(std::vector<Write>{{4, {3, 4}}, {0, {1, 2}}}, 16))
+      == T{{0, {1, 2}}, {4, {3, 4}}});
+  }
+
+  SECTION("Adjacent writes are merged")
+  {
+    CHECK(
+      toPairs(mergeVboWrites(std::vector<Write>{{2, {3, 4}}, {0, {1, 2}}, {4, {5}}}, 16))
+      == T{{0, {1, 2, 3, 4, 5}}});
+  }
+
+  SECTION("Adjacent writes are not merged beyond the maximum count")
+  {
+    CHECK(
+      toPairs(mergeVboWrites(std::vector<Write>{{0, {1, 2}}, {2, {3, 4}}, {4, {5}}}, 4))
+      == T{{0, {1, 2, 3, 4}}, {4, {5}}});
+  }
+
+  SECTION("Later writes take precedence where writes overlap")
+  {
+    CHECK(
+      toPairs(mergeVboWrites(std::vector<Write>{{1, {7, 7}}, {0, {1, 2, 3, 4}}}, 2))
+      == T{{0, {1, 2, 3, 4}}});
+    CHECK(
+      toPairs(mergeVboWrites(std::vector<Write>{{0, {1, 2, 3, 4}}, {1, {7, 7}}}, 2))
+      == T{{0, {1, 7, 7, 4}}});
+  }
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -0,0 +1,156 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "Renderer/EntityLinkRenderer.h"
+#include "Renderer/GLVertex.h"
+#include "View/MapDocument.h"
+#include "View/MapDocumentTest.h"
+
+#include <kdl/vector_utils.h>
+
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+using Link = std::pair<vm::vec3f, vm::vec3f>;
+
+std::vector<Link> getLinks(EntityLinkRenderer& renderer)
+{
+  const auto vertices = renderer.lineVertices();
+  REQUIRE(vertices.size() % 2u == 0u);
+
+  auto result = std::vector<Link>{};
+  for (size_t i = 0; i < vertices.size(); i += 2u)
+  {
+    result.emplace_back(
+      getVertexComponent<0>(vertices[i]), getVertexComponent<0>(vertices[i + 1u]));
+  }
+  return kdl::vec_sort(std::move(result));
+}
+
+/**
+ * Returns the links found by a renderer that builds its link graph from scratch.
+ */
+std::vector<Link> getAllLinks(std::weak_ptr<View::MapDocument> document)
+{
+  auto renderer = EntityLinkRenderer{std::move(document)};
+  return getLinks(renderer);
+}
+
+Model::EntityNode* createEntityNode(
+  const std::string& key, const std::string& value, const std::string& origin)
+{
+  return new Model::EntityNode{Model::Entity{
+    {}, {{"classname", "info_null"}, {key, value}, {"origin", origin}}}};
+}
+} // namespace
+
+TEST_CASE_METHOD(View::MapDocumentTest, "EntityLinkRendererTest.incrementalUpdates")
+{
+  const auto setPref =
+    TemporarilySetPref{Preferences::EntityLinkMode, Preferences::entityLinkModeAll()};
+
+  auto* sourceNode = createEntityNode(Model::EntityPropertyKeys::Target, "a", "0 0 0");
+  auto* targetNode =
+    createEntityNode(Model::EntityPropertyKeys::Targetname, "a", "64 0 0");
+  document->addNodes({{document->parentForNodes(), {sourceNode, targetNode}}});
+
+  auto renderer = EntityLinkRenderer{document};
+  REQUIRE(getLinks(renderer).size() == 1u);
+
+  SECTION("Changing a target updates the links pointing to it")
+  {
+    document->selectNodes({targetNode});
+    document->setProperty(Model::EntityPropertyKeys::Targetname, "b");
+    renderer.invalidateNodes({targetNode}, false);
+
+    CHECK(getLinks(renderer).empty());
+    CHECK(getLinks(renderer) == getAllLinks(document));
+  }
+
+  SECTION("Changing a source updates its links")
+  {
+    document->selectNodes({sourceNode});
+    document->setProperty("origin", "0 64 0");
+    renderer.invalidateNodes({sourceNode}, false);
+
+    CHECK(getLinks(renderer).size() == 1u);
+    CHECK(getLinks(renderer) == getAllLinks(document));
+  }
+
+  SECTION("Adding a target updates the links pointing to it")
+  {
+    auto* newTargetNode =
+      createEntityNode(Model::EntityPropertyKeys::Targetname, "a", "0 0 64");
+    document->addNodes({{document->parentForNodes(), {newTargetNode}}});
+    renderer.invalidateNodes({newTargetNode}, true);
+
+    CHECK(getLinks(renderer).size() == 2u);
+    CHECK(getLinks(renderer) == getAllLinks(document));
+  }
+
+  SECTION("Removing a target removes the links pointing to it")
+  {
+    document->removeNodes({targetNode});
+    renderer.removeNodes({targetNode});
+
+    CHECK(getLinks(renderer).empty());
+
+    // the removed target must be forgotten, even if a new node reuses its address
+    auto* newTargetNode =
+      createEntityNode(Model::EntityPropertyKeys::Targetname, "a", "0 0 64");
+    document->addNodes({{document->parentForNodes(), {newTargetNode}}});
+    renderer.invalidateNodes({newTargetNode}, true);
+
+    CHECK(getLinks(renderer).size() == 1u);
+    CHECK(getLinks(renderer) == getAllLinks(document));
+
+    document->selectNodes({newTargetNode});
+    document->setProperty(Model::EntityPropertyKeys::Targetname, "b");
+    renderer.invalidateNodes({newTargetNode}, false);
+
+    CHECK(getLinks(renderer).empty());
+  }
+
+  SECTION("Removing a source removes its links")
+  {
+    document->removeNodes({sourceNode});
+    renderer.removeNodes({sourceNode});
+
+    CHECK(getLinks(renderer).empty());
+    CHECK(getLinks(renderer) == getAllLinks(document));
+  }
+}
+
+} // namespace TrenchBroom::Renderer
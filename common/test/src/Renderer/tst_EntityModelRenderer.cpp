@@ -0,0 +1,62 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/EntityModelRenderer.h"
+#include "Renderer/TexturedIndexRangeRenderer.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+
+TEST_CASE("EntityModelRendererTest.selectEntityModelLod")
+{
+  auto full = TexturedIndexRangeRenderer{};
+  auto medium = TexturedIndexRangeRenderer{};
+  auto low = TexturedIndexRangeRenderer{};
+
+  SECTION("All levels of detail are available")
+  {
+    const auto lods = std::vector<TexturedRenderer*>{&full, &medium, &low};
+    CHECK(selectEntityModelLod(1000.0f, lods) == 0u);
+    CHECK(selectEntityModelLod(160.0f, lods) == 0u);
+    CHECK(selectEntityModelLod(100.0f, lods) == 1u);
+    CHECK(selectEntityModelLod(48.0f, lods) == 1u);
+    CHECK(selectEntityModelLod(10.0f, lods) == 2u);
+  }
+
+  SECTION("A missing level falls back to the next more detailed level")
+  {
+    const auto lods = std::vector<TexturedRenderer*>{&full, nullptr, &low};
+    CHECK(selectEntityModelLod(1000.0f, lods) == 0u);
+    CHECK(selectEntityModelLod(100.0f, lods) == 0u);
+    CHECK(selectEntityModelLod(10.0f, lods) == 2u);
+  }
+
+  SECTION("Only the full model is available")
+  {
+    const auto lods = std::vector<TexturedRenderer*>{&full};
+    CHECK(selectEntityModelLod(1000.0f, lods) == 0u);
+    CHECK(selectEntityModelLod(10.0f, lods) == 0u);
+  }
+}
+
+} // namespace TrenchBroom::Renderer
@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/GLVertexType.h"
+#include "Renderer/LinkRenderer.h"
+
+#include <kdl/vector_utils.h>
+
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+using Vertex = GLVertexTypes::P3::Vertex;
+
+std::vector<Vertex> makeVertices(const std::vector<float>& xs)
+{
+  return kdl::vec_transform(xs, [](const auto x) { return Vertex{vm::vec3f{x, 0, 0}}; });
+}
+
+std::vector<float> getXs(const LinkVertexArray<Vertex>& array)
+{
+  return kdl::vec_transform(
+    array.vertices(), [](const auto& v) { return getVertexComponent<0>(v).x(); });
+}
+
+using Ranges = std::vector<std::pair<size_t, size_t>>;
+} // namespace
+
+TEST_CASE("LinkVertexArrayTest.insert")
+{
+  auto array = LinkVertexArray<Vertex>{};
+  CHECK(array.ranges().empty());
+  CHECK(array.insert({}) == nullptr);
+
+  const auto* block1 = array.insert(makeVertices({1, 2}));
+  REQUIRE(block1 != nullptr);
+  CHECK(block1->size == 2u);
+
+  const auto* block2 = array.insert(makeVertices({3, 4, 5, 6}));
+  REQUIRE(block2 != nullptr);
+  CHECK(block2->size == 4u);
+
+  CHECK(array.ranges() == Ranges{{0, 6}});
+  CHECK(getXs(array) == std::vector<float>{1, 2, 3, 4, 5, 6});
+}
+
+TEST_CASE("LinkVertexArrayTest.remove")
+{
+  auto array = LinkVertexArray<Vertex>{};
+  auto* block1 = array.insert(makeVertices({1, 2}));
+  auto* block2 = array.insert(makeVertices({3, 4}));
+  auto* block3 = array.insert(makeVertices({5, 6}));
+  REQUIRE(array.ranges() == Ranges{{0, 6}});
+
+  SECTION("Removed blocks are not rendered")
+  {
+    array.remove(block2);
+    CHECK(array.ranges() == Ranges{{0, 2}, {4, 2}});
+    CHECK(getXs(array) == std::vector<float>{1, 2, 5, 6});
+
+    array.remove(block1);
+    array.remove(block3);
+    CHECK(array.ranges().empty());
+    CHECK(array.vertices().empty());
+  }
+
+  SECTION("Removing null does nothing")
+  {
+    array.remove(nullptr);
+    CHECK(array.ranges() == Ranges{{0, 6}});
+  }
+}
+
+TEST_CASE("LinkVertexArrayTest.update")
+{
+  auto array = LinkVertexArray<Vertex>{};
+  array.insert(makeVertices({1, 2}));
+  auto* block = array.insert(makeVertices({3, 4}));
+  array.insert(makeVertices({5, 6}));
+
+  SECTION("Replacing a block with one of the same size reuses its vertices")
+  {
+    array.remove(block);
+    block = array.insert(makeVertices({7, 8}));
+    CHECK(block->pos == 2u);
+    CHECK(array.ranges() == Ranges{{0, 6}});
+    CHECK(getXs(array) == std::vector<float>{1, 2, 7, 8, 5, 6});
+  }
+
+  SECTION("Replacing a block with a larger one grows the array")
+  {
+    array.remove(block);
+    block = array.insert(makeVertices({7, 8, 9, 10, 11, 12, 13}));
+    CHECK(array.ranges() == Ranges{{0, 2}, {4, 9}});
+    CHECK(getXs(array) == std::vector<float>{1, 2, 5, 6, 7, 8, 9, 10, 11, 12, 13});
+  }
+}
+
+} // namespace TrenchBroom::Renderer
@@ -0,0 +1,121 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/OcclusionCuller.h"
+#include "Renderer/PerspectiveCamera.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+vm::mat4x4f makeViewProjectionMatrix()
+{
+  // looks along the positive X axis
+  const auto camera = PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8192.0f,
+    Camera::Viewport{0, 0, 640, 480},
+    vm::vec3f::zero(),
+    vm::vec3f::pos_x(),
+    vm::vec3f::pos_z()};
+
+  return camera.projectionMatrix() * camera.viewMatrix();
+}
+
+OcclusionCuller makeCuller()
+{
+  auto culler = OcclusionCuller{128, 96};
+  culler.reset(makeViewProjectionMatrix());
+  return culler;
+}
+
+std::vector<vm::vec3f> makeWall(const float x, const float halfSize)
+{
+  return {
+    {x, -halfSize, -halfSize},
+    {x, -halfSize, halfSize},
+    {x, halfSize, halfSize},
+    {x, halfSize, -halfSize}};
+}
+} // namespace
+
+TEST_CASE("OcclusionCullerTest.frustum")
+{
+  const auto culler = makeCuller();
+
+  CHECK(culler.isVisible(vm::bbox3f{{200, -10, -10}, {220, 10, 10}}));
+  CHECK(culler.isVisible(vm::bbox3f{{-10, -10, -10}, {10, 10, 10}}));
+  CHECK_FALSE(culler.isVisible(vm::bbox3f{{-220, -10, -10}, {-200, 10, 10}}));
+  CHECK_FALSE(culler.isVisible(vm::bbox3f{{200, 1000, -10}, {220, 1020, 10}}));
+  CHECK_FALSE(culler.isVisible(vm::bbox3f{{9000, -10, -10}, {9020, 10, 10}}));
+}
+
+TEST_CASE("OcclusionCullerTest.occlusion")
+{
+  auto culler = makeCuller();
+  culler.addOccluder(makeWall(100, 50));
+
+  // behind the center of the wall
+  CHECK_FALSE(culler.isVisible(vm::bbox3f{{200, -10, -10}, {220, 10, 10}}));
+
+  // in front of the wall
+  CHECK(culler.isVisible(vm::bbox3f{{50, -10, -10}, {70, 10, 10}}));
+
+  // behind the wall, but next to it
+  CHECK(culler.isVisible(vm::bbox3f{{200, 150, -10}, {220, 170, 10}}));
+
+  // behind the wall and partially next to it
+  CHECK(culler.isVisible(vm::bbox3f{{200, 50, -10}, {220, 150, 10}}));
+
+  // intersects the wall
+  CHECK(culler.isVisible(vm::bbox3f{{90, -10, -10}, {110, 10, 10}}));
+
+  culler.reset(makeViewProjectionMatrix());
+  CHECK(culler.isVisible(vm::bbox3f{{200, -10, -10}, {220, 10, 10}}));
+}
+
+TEST_CASE("OcclusionCullerTest.conservativeCoverage")
+{
+  auto culler = makeCuller();
+  culler.addOccluder(makeWall(100, 50));
+
+  // the wall covers the center of the depth buffer, but not its corners
+  CHECK(culler.depth(64, 48) < 1.0f);
+  CHECK(culler.depth(0, 0) == 1.0f);
+  CHECK(culler.depth(127, 95) == 1.0f);
+
+  // a polygon that is clipped by the near plane still occludes
+  culler.addOccluder(
+    {{-100, -1000, -1000}, {500, -1000, 1000}, {500, 1000, 1000}, {-100, 1000, -1000}});
+  CHECK(culler.depth(0, 0) < 1.0f);
+  CHECK_FALSE(culler.isVisible(vm::bbox3f{{1000, -10, -10}, {1020, 10, 10}}));
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -0,0 +1,154 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "Model/PortalFile.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "Renderer/PortalCuller.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/polygon.h>
+#include <vecmath/vec.h>
+
+#include <array>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+vm::mat4x4f makeViewProjectionMatrix(
+  const vm::vec3f& position, const vm::vec3f& direction)
+{
+  const auto camera = PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8192.0f,
+    Camera::Viewport{0, 0, 640, 640},
+    position,
+    direction,
+    vm::vec3f::pos_z()};
+
+  return camera.projectionMatrix() * camera.viewMatrix();
+}
+
+Model::PortalFile loadPortalFile(const std::string& str)
+{
+  auto stream = std::istringstream{str};
+  return Model::loadPortalFile(stream).value();
+}
+} // namespace
+
+TEST_CASE("PortalCullerTest.floodFill")
+{
+  /*
+   * Four leafs in a row along the X axis:
+   * 3: x <= 0, 0: 0 <= x <= 100, 1: 100 <= x <= 200, 2: x >= 200
+   */
+  const auto portalFile = loadPortalFile(R"(PRT1
+4
+3
+4 3 0 (0 0 0) (0 100 0) (0 100 100) (0 0 100)
+4 0 1 (100 0 0) (100 100 0) (100 100 100) (100 0 100)
+4 1 2 (200 0 0) (200 100 0) (200 100 100) (200 0 100)
+)");
+
+  CHECK(
+    portalFile.portalLeafs()
+    == std::vector<std::array<size_t, 2>>{{3, 0}, {0, 1}, {1, 2}});
+
+  auto culler = PortalCuller{portalFile};
+  const auto position = vm::vec3f{50, 50, 50};
+
+  SECTION("Looking along the row")
+  {
+    culler.update(position, makeViewProjectionMatrix(position, vm::vec3f::pos_x()));
+
+    CHECK(culler.isLeafVisible(0));
+    CHECK(culler.isLeafVisible(1));
+    CHECK(culler.isLeafVisible(2));
+    CHECK_FALSE(culler.isLeafVisible(3));
+
+    CHECK(culler.isVisible(vm::bbox3f{{250, 40, 40}, {260, 60, 60}}));
+    CHECK_FALSE(culler.isVisible(vm::bbox3f{{-60, 40, 40}, {-50, 60, 60}}));
+    CHECK(culler.isVisible(vm::bbox3f{{-60, 40, 40}, {10, 60, 60}}));
+  }
+
+  SECTION("Looking the other way")
+  {
+    culler.update(position, makeViewProjectionMatrix(position, vm::vec3f::neg_x()));
+
+    CHECK(culler.isLeafVisible(0));
+    CHECK_FALSE(culler.isLeafVisible(1));
+    CHECK_FALSE(culler.isLeafVisible(2));
+    CHECK(culler.isLeafVisible(3));
+  }
+}
+
+TEST_CASE("PortalCullerTest.portalsNarrowTheView")
+{
+  /*
+   * Like above, but the portal between leafs 1 and 2 cannot be seen through the portal
+   * between leafs 0 and 1.
+   */
+  const auto portalFile = loadPortalFile(R"(PRT1
+4
+3
+4 3 0 (0 0 0) (0 100 0) (0 100 100) (0 0 100)
+4 0 1 (100 40 40) (100 60 40) (100 60 60) (100 40 60)
+4 1 2 (200 0 40) (200 10 40) (200 10 60) (200 0 60)
+)");
+
+  auto culler = PortalCuller{portalFile};
+  const auto position = vm::vec3f{50, 50, 50};
+  culler.update(position, makeViewProjectionMatrix(position, vm::vec3f::pos_x()));
+
+  CHECK(culler.isLeafVisible(0));
+  CHECK(culler.isLeafVisible(1));
+  CHECK_FALSE(culler.isLeafVisible(2));
+  CHECK_FALSE(culler.isVisible(vm::bbox3f{{250, 40, 40}, {260, 60, 60}}));
+}
+TEST_CASE("PortalCullerTest.invalidLeafIndex")
+{
+  // the second portal connects a leaf beyond the leaf count and is ignored
+  const auto portalFile = Model::PortalFile{
+    2,
+    {vm::polygon3f{{100, 0, 0}, {100, 100, 0}, {100, 100, 100}, {100, 0, 100}},
+     vm::polygon3f{{200, 0, 0}, {200, 100, 0}, {200, 100, 100}, {200, 0, 100}}},
+    {{0, 1}, {1, 1000}}};
+
+  auto culler = PortalCuller{portalFile};
+  const auto position = vm::vec3f{150, 50, 50};
+  culler.update(position, makeViewProjectionMatrix(position, vm::vec3f::neg_x()));
+
+  CHECK(culler.isLeafVisible(0));
+  CHECK(culler.isLeafVisible(1));
+  CHECK_FALSE(culler.isLeafVisible(1000));
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -0,0 +1,43 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/ShaderProgram.h"
+
+#include <string>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+TEST_CASE("UniformTest.internsNames")
+{
+  const auto brightness = Uniform{"Brightness"};
+  const auto alpha = Uniform{std::string{"Alpha"}};
+
+  CHECK(brightness.index() != alpha.index());
+  CHECK(Uniform{std::string{"Brightness"}}.index() == brightness.index());
+  CHECK(Uniform{"Alpha"}.index() == alpha.index());
+
+  CHECK(brightness.name() == "Brightness");
+  CHECK(alpha.name() == "Alpha");
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -75,5 +75,30 @@ TEST_CASE("VertexTest.memoryLayoutVertexList")
   REQUIRE(actual.size() == expected.size());
   REQUIRE(std::memcmp(expected.data(), actual.data(), sizeof(TestVertex) * 3) == 0);
 }
+
+TEST_CASE("VertexTest.compactNormals")
+{
+  using Vertex = GLVertexTypes::P3NBT2::Vertex;
+
+  const auto pos = vm::vec3f(1.0f, 2.0f, 3.0f);
+  const auto normal = quantizeNormal(vm::normalize(vm::vec3f(0.0f, -1.0f, 1.0f)));
+  const auto uv = vm::vec2f(4.0f, 5.0f);
+
+  CHECK(normal == vm::vec<GLbyte, 4>(0, -90, 90, 0));
+  CHECK(quantizeNormal(vm::vec3f::neg_z()) == vm::vec<GLbyte, 4>(0, 0, -127, 0));
+
+  const auto vertex = Vertex(pos, normal, uv);
+  const auto size = GLVertexTypes::P3NBT2::Size;
+  CHECK(size == 24u);
+  CHECK(size == sizeof(Vertex));
+  CHECK(getVertexComponent<1>(vertex) == normal);
+  CHECK(getVertexComponent<2>(vertex) == uv);
+
+  // the attribute offsets used to set up the vertex pointers must match the layout
+  const auto* base = reinterpret_cast<const char*>(&vertex);
+  CHECK(
+    reinterpret_cast<const char*>(&getVertexComponent<2>(vertex)) - base
+    == GLVertexAttributeTypes::P3::Size + GLVertexAttributeTypes::NB::Size);
+}
 } // namespace Renderer
 } // namespace TrenchBroom
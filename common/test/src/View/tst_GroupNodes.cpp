@@ -28,6 +28,7 @@
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/LinkedGroupUtils.h"
 #include "Model/ModelUtils.h"
 #include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
@@ -39,6 +40,7 @@
 
 #include <vecmath/mat_ext.h>
 
+#include <algorithm>
 #include <functional>
 #include <set>
 
@@ -748,6 +750,216 @@ TEST_CASE_METHOD(MapDocumentTest, "GroupNodesTest.newWithGroupOpen")
   CHECK(document->currentGroup() == nullptr);
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "GroupNodesTest.updateLinkedGroupsIncrementally")
+{
+  auto* brushNode = createBrushNode();
+  auto* entityNode = new Model::EntityNode{Model::Entity{}};
+  document->addNodes({{document->parentForNodes(), {brushNode, entityNode}}});
+  document->selectNodes({brushNode, entityNode});
+
+  auto* groupNode = document->groupSelection("test");
+  REQUIRE(groupNode != nullptr);
+
+  document->deselectAll();
+  document->selectNodes({groupNode});
+  auto* linkedGroupNode = document->createLinkedDuplicate();
+  REQUIRE(linkedGroupNode != nullptr);
+
+  document->deselectAll();
+  document->selectNodes({linkedGroupNode});
+  REQUIRE(document->translateObjects({0, 128, 0}));
+  document->deselectAll();
+
+  // the linked nodes are updated in place instead of being replaced
+  const auto linkedChildren = linkedGroupNode->children();
+  REQUIRE(linkedChildren.size() == 2u);
+
+  const auto findLinkedChild = [&](const auto& linkId) {
+    const auto it = std::find_if(
+      linkedChildren.begin(), linkedChildren.end(), [&](const auto* linkedChild) {
+        return Model::getLinkId(*linkedChild) == linkId;
+      });
+    REQUIRE(it != linkedChildren.end());
+    return *it;
+  };
+
+  auto* linkedBrushNode = findLinkedChild(brushNode->brush().linkId());
+  auto* linkedEntityNode =
+    static_cast<Model::EntityNode*>(findLinkedChild(entityNode->entity().linkId()));
+
+  document->openGroup(groupNode);
+
+  SECTION("Changing a node updates the corresponding node")
+  {
+    document->selectNodes({entityNode});
+    REQUIRE(document->translateObjects({16, 0, 0}));
+
+    CHECK(linkedGroupNode->children() == linkedChildren);
+    CHECK(linkedEntityNode->entity().origin() == vm::vec3{16, 128, 0});
+
+    document->undoCommand();
+    CHECK(linkedGroupNode->children() == linkedChildren);
+    CHECK(linkedEntityNode->entity().origin() == vm::vec3{0, 128, 0});
+
+    document->redoCommand();
+    CHECK(linkedGroupNode->children() == linkedChildren);
+    CHECK(linkedEntityNode->entity().origin() == vm::vec3{16, 128, 0});
+  }
+
+  SECTION("Adding a node adds a corresponding node")
+  {
+    auto* newBrushNode = createBrushNode();
+    document->addNodes({{groupNode, {newBrushNode}}});
+
+    REQUIRE(linkedGroupNode->childCount() == 3u);
+    CHECK(linkedGroupNode->children()[0] == linkedChildren[0]);
+    CHECK(linkedGroupNode->children()[1] == linkedChildren[1]);
+
+    const auto* newLinkedBrushNode =
+      dynamic_cast<const Model::BrushNode*>(linkedGroupNode->children()[2]);
+    REQUIRE(newLinkedBrushNode != nullptr);
+    CHECK(newLinkedBrushNode->brush().linkId() == newBrushNode->brush().linkId());
+    CHECK(
+      newLinkedBrushNode->logicalBounds()
+      == newBrushNode->logicalBounds().translate(vm::vec3{0, 128, 0}));
+
+    document->undoCommand();
+    CHECK(linkedGroupNode->children() == linkedChildren);
+
+    document->redoCommand();
+    REQUIRE(linkedGroupNode->childCount() == 3u);
+    CHECK(linkedGroupNode->children()[0] == linkedChildren[0]);
+    CHECK(linkedGroupNode->children()[1] == linkedChildren[1]);
+    CHECK(linkedGroupNode->children()[2] == newLinkedBrushNode);
+  }
+
+  SECTION("Removing a node removes the corresponding node")
+  {
+    document->removeNodes({brushNode});
+
+    CHECK(linkedGroupNode->children() == std::vector<Model::Node*>{linkedEntityNode});
+    CHECK(linkedBrushNode->parent() == nullptr);
+
+    document->undoCommand();
+    CHECK_THAT(linkedGroupNode->children(), Catch::UnorderedEquals(linkedChildren));
+
+    document->redoCommand();
+    CHECK(linkedGroupNode->children() == std::vector<Model::Node*>{linkedEntityNode});
+  }
+
+  SECTION("Reparenting a node moves the corresponding node")
+  {
+    document->selectNodes({brushNode});
+    auto* innerGroupNode = document->groupSelection("inner");
+    REQUIRE(innerGroupNode != nullptr);
+
+    REQUIRE(linkedGroupNode->childCount() == 2u);
+    CHECK(linkedGroupNode->children()[0] == linkedEntityNode);
+
+    const auto* linkedInnerGroupNode =
+      dynamic_cast<const Model::GroupNode*>(linkedGroupNode->children()[1]);
+    REQUIRE(linkedInnerGroupNode != nullptr);
+    CHECK(linkedInnerGroupNode->group().linkId() == innerGroupNode->group().linkId());
+    REQUIRE(linkedInnerGroupNode->childCount() == 1u);
+    CHECK(
+      Model::getLinkId(*linkedInnerGroupNode->children().front())
+      == brushNode->brush().linkId());
+
+    document->undoCommand();
+    CHECK_THAT(linkedGroupNode->children(), Catch::UnorderedEquals(linkedChildren));
+
+    document->redoCommand();
+    REQUIRE(linkedGroupNode->childCount() == 2u);
+    CHECK(linkedGroupNode->children()[0] == linkedEntityNode);
+    CHECK(linkedGroupNode->children()[1] == linkedInnerGroupNode);
+  }
+}
+
+TEST_CASE_METHOD(MapDocumentTest, "GroupNodesTest.discardRolledBackLinkedGroupChanges")
+{
+  auto* brushNode = createBrushNode();
+  auto* entityNode = new Model::EntityNode{Model::Entity{}};
+  document->addNodes({{document->parentForNodes(), {brushNode, entityNode}}});
+  document->selectNodes({brushNode, entityNode});
+
+  auto* groupNode = document->groupSelection("test");
+  REQUIRE(groupNode != nullptr);
+
+  document->deselectAll();
+  document->selectNodes({groupNode});
+  auto* linkedGroupNode = document->createLinkedDuplicate();
+  REQUIRE(linkedGroupNode != nullptr);
+
+  document->deselectAll();
+  document->selectNodes({linkedGroupNode});
+  REQUIRE(document->translateObjects({0, 128, 0}));
+  document->deselectAll();
+
+  const auto linkedChildren = linkedGroupNode->children();
+  REQUIRE(linkedChildren.size() == 2u);
+
+  const auto linkedEntityIt = std::find_if(
+    linkedChildren.begin(), linkedChildren.end(), [&](const auto* linkedChild) {
+      return Model::getLinkId(*linkedChild) == entityNode->entity().linkId();
+    });
+  REQUIRE(linkedEntityIt != linkedChildren.end());
+  auto* linkedEntityNode = static_cast<Model::EntityNode*>(*linkedEntityIt);
+
+  document->openGroup(groupNode);
+
+  const auto cancel = GENERATE(true, false);
+  CAPTURE(cancel);
+
+  auto transaction = Transaction{document};
+
+  SECTION("Adding a node")
+  {
+    document->addNodes({{groupNode, {createBrushNode()}}});
+    REQUIRE(groupNode->childCount() == 3u);
+  }
+
+  SECTION("Removing a node")
+  {
+    document->removeNodes({brushNode});
+    REQUIRE(groupNode->childCount() == 1u);
+  }
+
+  SECTION("Reparenting a node")
+  {
+    document->selectNodes({brushNode});
+    REQUIRE(document->groupSelection("inner") != nullptr);
+    document->deselectAll();
+  }
+
+  REQUIRE(groupNode->hasPendingChanges());
+
+  if (cancel)
+  {
+    transaction.cancel();
+  }
+  else
+  {
+    transaction.rollback();
+  }
+
+  CHECK(!groupNode->hasPendingChanges());
+  CHECK(groupNode->pendingChanges() != std::nullopt);
+  CHECK(groupNode->pendingChanges()->empty());
+  CHECK(groupNode->childCount() == 2u);
+
+  // the next change must only propagate the changed entity
+  document->selectNodes({entityNode});
+  REQUIRE(document->translateObjects({16, 0, 0}));
+
+  if (!cancel)
+  {
+    CHECK(transaction.commit());
+  }
+
+  CHECK(linkedGroupNode->children() == linkedChildren);
+  CHECK(linkedEntityNode->entity().origin() == vm::vec3{16, 128, 0});
+}
+
 // https://github.com/TrenchBroom/TrenchBroom/issues/3768
 TEST_CASE_METHOD(MapDocumentTest, "GroupNodesTest.operationsOnSeveralGroupsInLinkSet")
 {
@@ -0,0 +1,563 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FloatType.h"
+#include "Model/Hit.h"
+#include "Model/PickResult.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "Renderer/Camera.h"
+#include "Renderer/OrthographicCamera.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/Grid.h"
+#include "View/VertexHandleManager.h"
+
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/distance.h>
+#include <vecmath/intersection.h>
+#include <vecmath/plane.h>
+#include <vecmath/polygon.h>
+#include <vecmath/ray.h>
+#include <vecmath/segment.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace View
+{
+namespace
+{
+constexpr auto GridMin = -128;
+constexpr auto GridMax = 128;
+constexpr auto GridStep = 32;
+
+FloatType handleRadius()
+{
+  return static_cast<FloatType>(pref(Preferences::HandleRadius));
+}
+
+std::vector<vm::vec3> gridPoints()
+{
+  auto result = std::vector<vm::vec3>{};
+  for (auto x = GridMin; x <= GridMax; x += GridStep)
+  {
+    for (auto y = GridMin; y <= GridMax; y += GridStep)
+    {
+      for (auto z = GridMin; z <= GridMax; z += GridStep)
+      {
+        result.emplace_back(x, y, z);
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<vm::segment3> gridEdges()
+{
+  auto result = std::vector<vm::segment3>{};
+  for (const auto& point : gridPoints())
+  {
+    for (size_t i = 0; i < 3; ++i)
+    {
+      auto end = point;
+      end[i] += FloatType(GridStep);
+      if (end[i] <= FloatType(GridMax))
+      {
+        result.emplace_back(point, end);
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<vm::polygon3> gridFaces()
+{
+  auto result = std::vector<vm::polygon3>{};
+  for (const auto& point : gridPoints())
+  {
+    for (size_t i = 0; i < 3; ++i)
+    {
+      auto u = vm::vec3{};
+      auto v = vm::vec3{};
+      u[(i + 1) % 3] = FloatType(GridStep);
+      v[(i + 2) % 3] = FloatType(GridStep);
+      const auto corner = point + u + v;
+      if (
+        corner[(i + 1) % 3] <= FloatType(GridMax)
+        && corner[(i + 2) % 3] <= FloatType(GridMax))
+      {
+        result.push_back(vm::polygon3{point, point + u, corner, point + v});
+      }
+    }
+  }
+  return result;
+}
+
+std::unique_ptr<Renderer::Camera> createCamera(const bool perspective, const float zoom)
+{
+  const auto viewport = Renderer::Camera::Viewport{0, 0, 1024, 768};
+  const auto position = vm::vec3f{-640.0f, -320.0f, 480.0f};
+  const auto direction = vm::normalize(vm::vec3f{640.0f, 300.0f, -500.0f});
+  const auto up =
+    vm::normalize(vm::cross(vm::cross(direction, vm::vec3f::pos_z()), direction));
+
+  auto camera = std::unique_ptr<Renderer::Camera>{};
+  if (perspective)
+  {
+    camera = std::make_unique<Renderer::PerspectiveCamera>(
+      90.0f, 1.0f, 8192.0f, viewport, position, direction, up);
+  }
+  else
+  {
+    camera = std::make_unique<Renderer::OrthographicCamera>(
+      1.0f, 8192.0f, viewport, position, direction, up);
+  }
+  camera->setZoom(zoom);
+  return camera;
+}
+
+/**
+ * Returns pick rays that scan the viewport, and pick rays aimed at the given points and
+ * slightly offset so that they just hit or just miss a point handle there.
+ */
+std::vector<vm::ray3> pickRays(
+  const Renderer::Camera& camera, const std::vector<vm::vec3>& targets)
+{
+  auto result = std::vector<vm::ray3>{};
+  for (auto x = 0; x < 1024; x += 61)
+  {
+    for (auto y = 0; y < 768; y += 53)
+    {
+      result.emplace_back(camera.pickRay(float(x), float(y)));
+    }
+  }
+
+  for (const auto& target : targets)
+  {
+    const auto radius =
+      FloatType(2) * handleRadius()
+      * static_cast<FloatType>(camera.perspectiveScalingFactor(vm::vec3f{target}));
+    for (const auto factor : {0.0, 0.5, 0.99, 1.01, 1.5})
+    {
+      const auto offset = factor * radius * vm::vec3{camera.right()};
+      result.emplace_back(camera.pickRay(vm::vec3f{target + offset}));
+    }
+  }
+  return result;
+}
+
+std::vector<vm::vec3> sampleTargets(const std::vector<vm::vec3>& points)
+{
+  auto result = std::vector<vm::vec3>{};
+  for (size_t i = 0; i < points.size(); i += 31)
+  {
+    result.push_back(points[i]);
+  }
+  return result;
+}
+
+template <typename T>
+std::vector<std::tuple<FloatType, T>> hitTargets(const Model::PickResult& pickResult)
+{
+  auto result = std::vector<std::tuple<FloatType, T>>{};
+  for (const auto& hit : pickResult.all())
+  {
+    result.emplace_back(hit.distance(), hit.target<T>());
+  }
+  std::sort(std::begin(result), std::end(result));
+  return result;
+}
+
+template <typename T>
+std::vector<std::tuple<FloatType, T>> pickPointsBruteForce(
+  const vm::ray3& pickRay,
+  const Renderer::Camera& camera,
+  const std::vector<std::tuple<vm::vec3, T>>& points)
+{
+  auto result = std::vector<std::tuple<FloatType, T>>{};
+  for (const auto& [point, target] : points)
+  {
+    const auto distance = camera.pickPointHandle(pickRay, point, handleRadius());
+    if (!vm::is_nan(distance))
+    {
+      result.emplace_back(distance, target);
+    }
+  }
+  std::sort(std::begin(result), std::end(result));
+  return result;
+}
+
+template <typename H, typename F>
+std::vector<std::tuple<vm::vec3, H>> pointHandles(const std::vector<H>& handles, F f)
+{
+  auto result = std::vector<std::tuple<vm::vec3, H>>{};
+  for (const auto& handle : handles)
+  {
+    result.emplace_back(f(handle), handle);
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("VertexHandleManagerTest.makePickPointHandlePredicate")
+{
+  const auto perspective = GENERATE(true, false);
+  const auto zoom = GENERATE(0.5f, 1.0f, 2.0f);
+  CAPTURE(perspective, zoom);
+
+  const auto camera = createCamera(perspective, zoom);
+  const auto points = gridPoints();
+
+  auto hitCount = size_t(0);
+  for (const auto& pickRay : pickRays(*camera, sampleTargets(points)))
+  {
+    const auto predicate = makePickPointHandlePredicate(pickRay, *camera, handleRadius());
+    for (const auto& point : points)
+    {
+      if (!vm::is_nan(camera->pickPointHandle(pickRay, point, handleRadius())))
+      {
+        ++hitCount;
+        CAPTURE(pickRay, point);
+
+        // any box that contains a hit handle must satisfy the predicate
+        CHECK(predicate(handleBounds(point)));
+        for (const auto size : {1.0, 16.0, 256.0, 4096.0})
+        {
+          for (const auto& min : {
+                 point,
+                 point - vm::vec3{size, size, size},
+                 point - vm::vec3{size, 0, size / 2.0},
+                 point - vm::vec3{0, size / 3.0, 0}})
+          {
+            const auto bounds = vm::bbox3{min, min + vm::vec3{size, size, size}};
+            REQUIRE(bounds.contains(point));
+            CHECK(predicate(bounds));
+          }
+        }
+      }
+    }
+
+    // a box that is far away from the ray does not satisfy the predicate
+    const auto farPoint = vm::point_at_distance(pickRay, FloatType(512))
+                          + FloatType(512) * vm::vec3{camera->up()};
+    CHECK_FALSE(
+      predicate(vm::bbox3{farPoint - vm::vec3::one(), farPoint + vm::vec3::one()}));
+  }
+
+  CHECK(hitCount > 0u);
+}
+
+TEST_CASE("VertexHandleManagerTest.pick")
+{
+  const auto perspective = GENERATE(true, false);
+  const auto zoom = GENERATE(0.5f, 2.0f);
+  CAPTURE(perspective, zoom);
+
+  const auto camera = createCamera(perspective, zoom);
+  const auto points = gridPoints();
+  const auto targets = sampleTargets(points);
+
+  auto manager = VertexHandleManager{};
+  for (const auto& point : points)
+  {
+    manager.add(point);
+  }
+
+  SECTION("Hits match those of testing every handle")
+  {
+    const auto candidates = pointHandles(points, [](const auto& p) { return p; });
+
+    auto hitCount = size_t(0);
+    for (const auto& pickRay : pickRays(*camera, targets))
+    {
+      CAPTURE(pickRay);
+
+      auto pickResult = Model::PickResult{};
+      manager.pick(pickRay, *camera, pickResult);
+
+      const auto hits = hitTargets<vm::vec3>(pickResult);
+      CHECK(hits == pickPointsBruteForce(pickRay, *camera, candidates));
+      hitCount += hits.size();
+    }
+
+    CHECK(hitCount > 0u);
+  }
+
+  SECTION("Removed handles are not hit")
+  {
+    for (const auto& target : targets)
+    {
+      manager.remove(target);
+    }
+
+    const auto remaining = kdl::vec_erase_if(points, [&](const auto& p) {
+      return std::find(std::begin(targets), std::end(targets), p) != std::end(targets);
+    });
+    const auto candidates = pointHandles(remaining, [](const auto& p) { return p; });
+
+    for (const auto& pickRay : pickRays(*camera, targets))
+    {
+      CAPTURE(pickRay);
+
+      auto pickResult = Model::PickResult{};
+      manager.pick(pickRay, *camera, pickResult);
+      CHECK(
+        hitTargets<vm::vec3>(pickResult)
+        == pickPointsBruteForce(pickRay, *camera, candidates));
+    }
+  }
+
+  SECTION("Handles added twice are only hit once and remain after removing once")
+  {
+    const auto& target = targets.front();
+    manager.add(target);
+    manager.remove(target);
+
+    auto pickResult = Model::PickResult{};
+    manager.pick(vm::ray3{camera->pickRay(vm::vec3f{target})}, *camera, pickResult);
+
+    const auto hits = hitTargets<vm::vec3>(pickResult);
+    CHECK(
+      std::count_if(std::begin(hits), std::end(hits), [&](const auto& hit) {
+        return std::get<1>(hit) == target;
+      })
+      == 1);
+  }
+}
+
+TEST_CASE("VertexHandleManagerTest.selectCloseHandles")
+{
+  auto manager = VertexHandleManager{};
+  const auto points = gridPoints();
+  for (const auto& point : points)
+  {
+    manager.add(point);
+  }
+
+  const auto handle = vm::vec3{32, -64, 96};
+
+  manager.select(handle + vm::vec3{0.01, 0, 0});
+  CHECK(manager.selectedHandleCount() == 0u);
+
+  manager.select(handle + vm::vec3{0.0000001, 0, 0});
+  CHECK(manager.selectedHandles() == std::vector<vm::vec3>{handle});
+
+  manager.deselect(handle - vm::vec3{0, 0, 0.0000001});
+  CHECK(manager.selectedHandleCount() == 0u);
+
+  manager.remove(handle);
+  manager.select(handle);
+  CHECK(manager.selectedHandleCount() == 0u);
+  CHECK(manager.totalHandleCount() == points.size() - 1u);
+}
+
+TEST_CASE("EdgeHandleManagerTest.pick")
+{
+  const auto perspective = GENERATE(true, false);
+  const auto zoom = GENERATE(0.5f, 2.0f);
+  CAPTURE(perspective, zoom);
+
+  const auto camera = createCamera(perspective, zoom);
+  const auto edges = gridEdges();
+
+  auto manager = EdgeHandleManager{};
+  for (const auto& edge : edges)
+  {
+    manager.add(edge);
+  }
+
+  auto targets = std::vector<vm::vec3>{};
+  for (size_t i = 0; i < edges.size(); i += 31)
+  {
+    targets.push_back(edges[i].center());
+  }
+
+  SECTION("pickCenterHandle")
+  {
+    const auto candidates =
+      pointHandles(edges, [](const auto& edge) { return edge.center(); });
+
+    auto hitCount = size_t(0);
+    for (const auto& pickRay : pickRays(*camera, targets))
+    {
+      CAPTURE(pickRay);
+
+      auto pickResult = Model::PickResult{};
+      manager.pickCenterHandle(pickRay, *camera, pickResult);
+
+      const auto hits = hitTargets<vm::segment3>(pickResult);
+      CHECK(hits == pickPointsBruteForce(pickRay, *camera, candidates));
+      hitCount += hits.size();
+    }
+
+    CHECK(hitCount > 0u);
+  }
+
+  SECTION("pickGridHandle")
+  {
+    const auto gridSize = GENERATE(2, 4);
+    CAPTURE(gridSize);
+
+    const auto grid = Grid{gridSize};
+
+    auto hitCount = size_t(0);
+    for (const auto& pickRay : pickRays(*camera, targets))
+    {
+      CAPTURE(pickRay);
+
+      auto pickResult = Model::PickResult{};
+      manager.pickGridHandle(pickRay, *camera, grid, pickResult);
+
+      auto expected = std::vector<std::tuple<FloatType, EdgeHandleManager::HitType>>{};
+      for (const auto& edge : edges)
+      {
+        const auto edgeDist =
+          camera->pickLineSegmentHandle(pickRay, edge, handleRadius());
+        if (!vm::is_nan(edgeDist))
+        {
+          const auto pointHandle =
+            grid.snap(vm::point_at_distance(pickRay, edgeDist), edge);
+          const auto pointDist =
+            camera->pickPointHandle(pickRay, pointHandle, handleRadius());
+          if (!vm::is_nan(pointDist))
+          {
+            expected.emplace_back(
+              pointDist, EdgeHandleManager::HitType{edge, pointHandle});
+          }
+        }
+      }
+      std::sort(std::begin(expected), std::end(expected));
+
+      const auto hits = hitTargets<EdgeHandleManager::HitType>(pickResult);
+      CHECK(hits == expected);
+      hitCount += hits.size();
+    }
+
+    CHECK(hitCount > 0u);
+  }
+}
+
+TEST_CASE("FaceHandleManagerTest.pick")
+{
+  const auto perspective = GENERATE(true, false);
+  const auto zoom = GENERATE(0.5f, 2.0f);
+  CAPTURE(perspective, zoom);
+
+  const auto camera = createCamera(perspective, zoom);
+  const auto faces = gridFaces();
+
+  auto manager = FaceHandleManager{};
+  for (const auto& face : faces)
+  {
+    manager.add(face);
+  }
+
+  auto targets = std::vector<vm::vec3>{};
+  for (size_t i = 0; i < faces.size(); i += 31)
+  {
+    targets.push_back(faces[i].center());
+  }
+
+  SECTION("pickCenterHandle")
+  {
+    const auto candidates =
+      pointHandles(faces, [](const auto& face) { return face.center(); });
+
+    auto hitCount = size_t(0);
+    for (const auto& pickRay : pickRays(*camera, targets))
+    {
+      CAPTURE(pickRay);
+
+      auto pickResult = Model::PickResult{};
+      manager.pickCenterHandle(pickRay, *camera, pickResult);
+
+      const auto hits = hitTargets<vm::polygon3>(pickResult);
+      CHECK(hits == pickPointsBruteForce(pickRay, *camera, candidates));
+      hitCount += hits.size();
+    }
+
+    CHECK(hitCount > 0u);
+  }
+
+  SECTION("pickGridHandle")
+  {
+    const auto grid = Grid{4};
+
+    auto hitCount = size_t(0);
+    for (const auto& pickRay : pickRays(*camera, targets))
+    {
+      CAPTURE(pickRay);
+
+      auto pickResult = Model::PickResult{};
+      manager.pickGridHandle(pickRay, *camera, grid, pickResult);
+
+      auto expected = std::vector<std::tuple<FloatType, FaceHandleManager::HitType>>{};
+      for (const auto& face : faces)
+      {
+        const auto [valid, plane] = vm::from_points(std::begin(face), std::end(face));
+        REQUIRE(valid);
+
+        const auto distance =
+          vm::intersect_ray_polygon(pickRay, plane, std::begin(face), std::end(face));
+        if (!vm::is_nan(distance))
+        {
+          const auto pointHandle =
+            grid.snap(vm::point_at_distance(pickRay, distance), plane);
+          const auto pointDist =
+            camera->pickPointHandle(pickRay, pointHandle, handleRadius());
+          if (!vm::is_nan(pointDist))
+          {
+            expected.emplace_back(
+              pointDist, FaceHandleManager::HitType{face, pointHandle});
+          }
+        }
+      }
+      std::sort(std::begin(expected), std::end(expected));
+
+      const auto hits = hitTargets<FaceHandleManager::HitType>(pickResult);
+      CHECK(hits == expected);
+      hitCount += hits.size();
+    }
+
+    CHECK(hitCount > 0u);
+  }
+}
+
+TEST_CASE("VertexHandleManagerTest.handleBounds")
+{
+  CHECK(handleBounds(vm::vec3{1, 2, 3}) == vm::bbox3{{1, 2, 3}, {1, 2, 3}});
+  CHECK(
+    handleBounds(vm::segment3{{4, -2, 3}, {1, 2, 3}})
+    == vm::bbox3{{1, -2, 3}, {4, 2, 3}});
+  CHECK(
+    handleBounds(vm::polygon3{{0, 0, 0}, {4, -2, 0}, {1, 2, 3}})
+    == vm::bbox3{{0, -2, 0}, {4, 2, 3}});
+}
+} // namespace View
+} // namespace TrenchBroom
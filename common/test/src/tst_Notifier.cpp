@@ -417,4 +417,91 @@ TEST_CASE("NotifyBeforeAndAfter")
     CHECK(moveCount <= 3);
   }
 }
+
+TEST_CASE("NotificationCoalescer")
+{
+  auto before = Notifier<const std::vector<int>&>{};
+  auto after = Notifier<const std::vector<int>&>{};
+
+  auto beforeCalls = std::vector<std::vector<int>>{};
+  auto afterCalls = std::vector<std::vector<int>>{};
+  const auto c1 =
+    before.connect([&](const auto& objects) { beforeCalls.push_back(objects); });
+  const auto c2 =
+    after.connect([&](const auto& objects) { afterCalls.push_back(objects); });
+
+  auto coalescer = NotificationCoalescer<int>{before, after};
+
+  SECTION("Notifies immediately without a scope")
+  {
+    coalescer.notifyBefore({1, 2});
+    coalescer.notifyAfter({1, 2});
+    coalescer.notifyBefore({2});
+    coalescer.notifyAfter({2});
+
+    CHECK(beforeCalls == std::vector<std::vector<int>>{{1, 2}, {2}});
+    CHECK(afterCalls == std::vector<std::vector<int>>{{1, 2}, {2}});
+  }
+
+  SECTION("Coalesces notifications within a scope")
+  {
+    coalescer.beginScope(true);
+    coalescer.notifyBefore({1, 2});
+    coalescer.notifyAfter({1, 2});
+    coalescer.notifyBefore({2, 3, 3});
+    coalescer.notifyAfter({2, 3, 3});
+    coalescer.notifyBefore({1});
+    coalescer.notifyAfter({1});
+
+    CHECK(beforeCalls == std::vector<std::vector<int>>{{1, 2}, {3}});
+    CHECK(afterCalls.empty());
+
+    coalescer.endScope();
+    CHECK(afterCalls == std::vector<std::vector<int>>{{1, 2, 3}});
+  }
+
+  SECTION("Flushing sends pending notifications")
+  {
+    coalescer.beginScope(true);
+    coalescer.notifyBefore({1});
+    coalescer.notifyAfter({1});
+    coalescer.flush();
+    CHECK(afterCalls == std::vector<std::vector<int>>{{1}});
+
+    coalescer.notifyBefore({1});
+    coalescer.notifyAfter({1});
+    coalescer.endScope();
+
+    CHECK(beforeCalls == std::vector<std::vector<int>>{{1}, {1}});
+    CHECK(afterCalls == std::vector<std::vector<int>>{{1}, {1}});
+  }
+
+  SECTION("Nested scopes")
+  {
+    coalescer.beginScope(true);
+    coalescer.notifyBefore({1});
+    coalescer.notifyAfter({1});
+
+    coalescer.beginScope(true);
+    coalescer.notifyBefore({2});
+    coalescer.notifyAfter({2});
+    coalescer.endScope();
+    CHECK(afterCalls.empty());
+
+    coalescer.beginScope(false);
+    CHECK(afterCalls == std::vector<std::vector<int>>{{1, 2}});
+
+    coalescer.notifyBefore({3});
+    coalescer.notifyAfter({3});
+    CHECK(afterCalls == std::vector<std::vector<int>>{{1, 2}, {3}});
+    coalescer.endScope();
+
+    coalescer.notifyBefore({4});
+    coalescer.notifyAfter({4});
+    coalescer.endScope();
+
+    CHECK(beforeCalls == std::vector<std::vector<int>>{{1}, {2}, {3}, {4}});
+    CHECK(afterCalls == std::vector<std::vector<int>>{{1, 2}, {3}, {4}});
+  }
+}
 } // namespace TrenchBroom
@@ -0,0 +1,234 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Exceptions.h"
+#include "aabb_tree.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/forward.h>
+#include <vecmath/intersection.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+TEST_CASE("aabb_tree.insert")
+{
+  auto tree = aabb_tree<double, int>{};
+  REQUIRE(tree.empty());
+
+  tree.insert({{0, 0, 0}, {32, 32, 32}}, 1);
+  CHECK_FALSE(tree.empty());
+  CHECK(tree.contains(1));
+  CHECK(tree.height() == 0u);
+
+  tree.insert({{64, 0, 0}, {96, 32, 32}}, 2);
+  CHECK(tree.contains(2));
+  CHECK(tree.height() == 1u);
+
+  CHECK_THROWS_AS(tree.insert({{0, 0, 0}, {1, 1, 1}}, 1), NodeTreeException);
+  CHECK_THROWS_AS(
+    tree.insert({{0, 0, 0}, {vm::nan<double>(), 1, 1}}, 3), NodeTreeException);
+}
+
+TEST_CASE("aabb_tree.remove")
+{
+  auto tree = aabb_tree<double, int>{};
+  tree.insert({{0, 0, 0}, {32, 32, 32}}, 1);
+  tree.insert({{64, 0, 0}, {96, 32, 32}}, 2);
+  tree.insert({{128, 0, 0}, {160, 32, 32}}, 3);
+
+  CHECK_FALSE(tree.remove(4));
+
+  CHECK(tree.remove(2));
+  CHECK_FALSE(tree.contains(2));
+  CHECK(tree.find_containers(vm::vec3d{80, 16, 16}).empty());
+  CHECK(tree.find_containers(vm::vec3d{16, 16, 16}) == std::vector<int>{1});
+
+  CHECK(tree.remove(1));
+  CHECK(tree.remove(3));
+  CHECK(tree.empty());
+
+  tree.insert({{0, 0, 0}, {32, 32, 32}}, 2);
+  CHECK(tree.find_containers(vm::vec3d{16, 16, 16}) == std::vector<int>{2});
+}
+
+TEST_CASE("aabb_tree.update")
+{
+  auto tree = aabb_tree<double, int>{};
+  tree.insert({{0, 0, 0}, {32, 32, 32}}, 1);
+  tree.insert({{64, 0, 0}, {96, 32, 32}}, 2);
+
+  CHECK_THROWS_AS(tree.update({{0, 0, 0}, {1, 1, 1}}, 3), NodeTreeException);
+
+  SECTION("Updating within the parent bounds")
+  {
+    tree.update({{8, 0, 0}, {40, 32, 32}}, 1);
+    CHECK(tree.find_containers(vm::vec3d{4, 16, 16}).empty());
+    CHECK(tree.find_containers(vm::vec3d{36, 16, 16}) == std::vector<int>{1});
+  }
+
+  SECTION("Updating outside of the parent bounds")
+  {
+    tree.update({{512, 512, 512}, {544, 544, 544}}, 1);
+    CHECK(tree.find_containers(vm::vec3d{16, 16, 16}).empty());
+    CHECK(tree.find_containers(vm::vec3d{528, 528, 528}) == std::vector<int>{1});
+    CHECK(tree.find_containers(vm::vec3d{80, 16, 16}) == std::vector<int>{2});
+  }
+}
+
+TEST_CASE("aabb_tree.find_intersectors-ray")
+{
+  auto tree = aabb_tree<double, int>{};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_intersectors(vm::ray3d{{0, 0, 0}, {1, 0, 0}}).empty());
+  }
+
+  SECTION("single node")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+
+    CHECK(tree.find_intersectors(vm::ray3d{{48, 48, 0}, {0, 0, -1}}).empty());
+    CHECK(
+      tree.find_intersectors(vm::ray3d{{48, 48, 48}, {0, 0, -1}}) == std::vector<int>{1});
+    CHECK(
+      tree.find_intersectors(vm::ray3d{{48, 48, 0}, {0, 0, 1}}) == std::vector<int>{1});
+  }
+}
+
+TEST_CASE("aabb_tree.find_intersectors-bbox")
+{
+  auto tree = aabb_tree<double, int>{};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_intersectors(vm::bbox3d{{0, 0, 0}, {1, 1, 1}}).empty());
+  }
+
+  SECTION("single node")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+
+    CHECK(tree.find_intersectors(vm::bbox3d{{0, 0, 0}, {16, 16, 16}}).empty());
+    CHECK(
+      tree.find_intersectors(vm::bbox3d{{0, 0, 0}, {32, 32, 32}}) == std::vector<int>{1});
+    CHECK(
+      tree.find_intersectors(vm::bbox3d{{40, 40, 40}, {48, 48, 48}})
+      == std::vector<int>{1});
+  }
+}
+
+TEST_CASE("aabb_tree.find_if")
+{
+  auto tree = aabb_tree<double, int>{};
+  tree.insert({{0, 0, 0}, {32, 32, 32}}, 1);
+  tree.insert({{64, 0, 0}, {96, 32, 32}}, 2);
+  tree.insert({{128, 0, 0}, {160, 32, 32}}, 3);
+
+  auto result = std::vector<int>{};
+  tree.find_if(
+    [](const vm::bbox3d& bounds) { return bounds.max.x() >= 64.0; },
+    std::back_inserter(result));
+  CHECK_THAT(result, Catch::UnorderedEquals(std::vector<int>{2, 3}));
+}
+
+TEST_CASE("aabb_tree.random")
+{
+  // insert, update and remove many boxes of varying sizes and compare the query results
+  // with brute force
+  auto rng = std::mt19937{12345};
+  auto coord = std::uniform_real_distribution<double>{-4096.0, 4096.0};
+  auto extent = std::uniform_real_distribution<double>{1.0, 512.0};
+
+  const auto makeBox = [&]() {
+    const auto min = vm::vec3d{coord(rng), coord(rng), coord(rng)};
+    return vm::bbox3d{min, min + vm::vec3d{extent(rng), extent(rng), extent(rng)}};
+  };
+
+  auto tree = aabb_tree<double, int>{};
+  auto boxes = std::vector<std::optional<vm::bbox3d>>{};
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    boxes.push_back(makeBox());
+    tree.insert(*boxes.back(), i);
+  }
+
+  for (int i = 0; i < 1000; i += 3)
+  {
+    boxes[size_t(i)] = makeBox();
+    tree.update(*boxes[size_t(i)], i);
+  }
+
+  for (int i = 0; i < 1000; i += 7)
+  {
+    boxes[size_t(i)] = std::nullopt;
+    CHECK(tree.remove(i));
+  }
+
+  // a balanced binary tree with about 850 leaves should be much shallower than this
+  CHECK(tree.height() < 30u);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    const auto point = vm::vec3d{coord(rng), coord(rng), coord(rng)};
+    const auto query = makeBox();
+    const auto ray = vm::ray3d{
+      point, vm::normalize(vm::vec3d{coord(rng), coord(rng), coord(rng)})};
+
+    auto expectedContainers = std::vector<int>{};
+    auto expectedBoxIntersectors = std::vector<int>{};
+    auto expectedRayIntersectors = std::vector<int>{};
+    for (size_t j = 0; j < boxes.size(); ++j)
+    {
+      if (const auto& box = boxes[j])
+      {
+        if (box->contains(point))
+        {
+          expectedContainers.push_back(int(j));
+        }
+        if (box->intersects(query))
+        {
+          expectedBoxIntersectors.push_back(int(j));
+        }
+        if (box->contains(ray.origin) || !vm::is_nan(vm::intersect_ray_bbox(ray, *box)))
+        {
+          expectedRayIntersectors.push_back(int(j));
+        }
+      }
+    }
+
+    CHECK_THAT(
+      tree.find_containers(point), Catch::UnorderedEquals(expectedContainers));
+    CHECK_THAT(
+      tree.find_intersectors(query), Catch::UnorderedEquals(expectedBoxIntersectors));
+    CHECK_THAT(
+      tree.find_intersectors(ray), Catch::UnorderedEquals(expectedRayIntersectors));
+  }
+}
+} // namespace TrenchBroom
@@ -29,6 +29,8 @@
 #include "util.h"
 #include "vec.h"
 
+#include <vector>
+
 namespace vm
 {
 